@@ -37,6 +37,8 @@ public:
   /// Pure abstract methods to be implemented
   virtual std::string toXMLString() const = 0;
   virtual void apply(const coord_t *inputVector, coord_t *outVector) const = 0;
+  virtual void applyToPoints(const coord_t *inputVectors, const size_t inputStride, const size_t numPoints,
+                             coord_t *outVectors) const;
   virtual CoordTransform *clone() const = 0;
   virtual std::string id() const = 0;
 
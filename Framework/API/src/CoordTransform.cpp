@@ -36,6 +36,23 @@ CoordTransform::CoordTransform(const size_t inD, const size_t outD) : inD(inD),
     throw std::runtime_error("CoordTransform: invalid number of input dimensions!");
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the transformation to many points at once, such as the centers of a
+ * list of events. This calls apply() for every point; subclasses override it
+ * with loops over the points that the compiler can vectorise.
+ *
+ * @param inputVectors :: the first inD-length input vector
+ * @param inputStride :: distance in bytes between consecutive input vectors
+ * @param numPoints :: number of vectors to transform
+ * @param outVectors :: array of numPoints * outD output coordinates
+ */
+void CoordTransform::applyToPoints(const coord_t *inputVectors, const size_t inputStride, const size_t numPoints,
+                                   coord_t *outVectors) const {
+  const auto *input = reinterpret_cast<const char *>(inputVectors);
+  for (size_t i = 0; i < numPoints; ++i)
+    this->apply(reinterpret_cast<const coord_t *>(input + i * inputStride), outVectors + i * outD);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Apply the transformation to an input vector (as a VMD type).
  * This wraps the apply(in,out) method (and will be slower!)
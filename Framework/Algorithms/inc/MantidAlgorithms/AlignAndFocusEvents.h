@@ -0,0 +1,44 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+namespace Mantid {
+namespace Algorithms {
+
+/** AlignAndFocusEvents : convert the events of an EventWorkspace from TOF to
+  d-spacing, focus them into the groups of a GroupingWorkspace and histogram
+  them, in a single pass over the events.
+
+  This gives the histograms that ConvertUnits (or AlignDetectors),
+  DiffractionFocussing with PreserveEvents and Rebin with PreserveEvents=False
+  would give, without creating the intermediate workspaces. Each event is
+  converted with the diffractometer constants of its spectrum and added
+  straight into the histogram of its group; the input is not modified.
+*/
+class MANTID_ALGORITHMS_DLL AlignAndFocusEvents : public API::Algorithm {
+public:
+  const std::string name() const override { return "AlignAndFocusEvents"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Diffraction\\Focussing"; }
+  const std::string summary() const override {
+    return "Convert the events of an EventWorkspace to d-spacing, focus them and histogram them in one pass.";
+  }
+  const std::vector<std::string> seeAlso() const override {
+    return {"AlignDetectors", "ConvertUnits", "DiffractionFocussing", "Rebin", "AlignAndFocusPowder"};
+  }
+  std::map<std::string, std::string> validateInputs() override;
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -113,6 +113,40 @@ protected:
   virtual void performBinaryOperation(const HistogramData::Histogram &lhs, const double rhsY, const double rhsE,
                                       HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) = 0;
 
+  /// Whether the operation implements performArrayOperation(), so that
+  /// histogram data can be operated on without a Histogram for each spectrum
+  virtual bool hasArrayOperation() const { return false; }
+
+  /** Carries out the binary operation on the data of a single spectrum, with
+   *the data of another spectrum as the right-hand operand. Only used if
+   *hasArrayOperation() returns true. The output may be the lhs or rhs data.
+   *
+   *  @param lhsY :: Lhs data values
+   *  @param lhsE :: Lhs error values
+   *  @param rhsY :: Rhs data values
+   *  @param rhsE :: Rhs error values
+   *  @param YOut :: Data values resulting from the operation
+   *  @param EOut :: Error values resulting from the operation
+   */
+  virtual void performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                     const HistogramData::HistogramY &rhsY, const HistogramData::HistogramE &rhsE,
+                                     HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut);
+
+  /** Carries out the binary operation on the data of a single spectrum when
+   *the right hand operand is a single number. Only used if
+   *hasArrayOperation() returns true. The output may be the lhs or rhs data.
+   *
+   *  @param lhsY :: Lhs data values
+   *  @param lhsE :: Lhs error values
+   *  @param rhsY :: The rhs data value
+   *  @param rhsE :: The rhs error value
+   *  @param YOut :: Data values resulting from the operation
+   *  @param EOut :: Error values resulting from the operation
+   */
+  virtual void performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                     const double rhsY, const double rhsE, HistogramData::HistogramY &YOut,
+                                     HistogramData::HistogramE &EOut);
+
   // ===================================== EVENT LIST BINARY OPERATIONS
   // ==========================================
 
@@ -234,10 +268,13 @@ private:
   void doSingleSpectrum();
   void doSingleColumn();
   void do2D(bool mismatchedSpectra);
+  void shareLhsX(const size_t index);
 
   void propagateBinMasks(const API::MatrixWorkspace_const_sptr &rhs, const API::MatrixWorkspace_sptr &out);
   /// Progress reporting
   std::unique_ptr<API::Progress> m_progress = nullptr;
+  /// Whether histogram data is operated on with performArrayOperation()
+  bool m_useArrayOperation{false};
 };
 
 } // namespace Algorithms
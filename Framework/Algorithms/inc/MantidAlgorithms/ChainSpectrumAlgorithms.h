@@ -0,0 +1,58 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidAPI/MatrixWorkspace_fwd.h"
+#include "MantidAlgorithms/DllConfig.h"
+
+#include <json/value.h>
+
+namespace Mantid {
+namespace Algorithms {
+
+/** ChainSpectrumAlgorithms : run a chain of spectrum-wise algorithms over a
+  workspace one block of spectra at a time.
+
+  The chain is given as a JSON list of algorithms in the form written by
+  Algorithm::toString. Every algorithm must be a SpectrumAlgorithm,
+  UnaryOperation or BinaryOperation: these treat each spectrum independently, so
+  the chain can be run over a block of spectra that stays in cache from one
+  step to the next. The steps work in place on the block, and no intermediate
+  workspaces are stored in the AnalysisDataService or recorded in the history.
+*/
+class MANTID_ALGORITHMS_DLL ChainSpectrumAlgorithms : public API::Algorithm {
+public:
+  const std::string name() const override { return "ChainSpectrumAlgorithms"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "Arithmetic"; }
+  const std::string summary() const override {
+    return "Run a chain of spectrum-wise algorithms over a workspace, one block of spectra at a time.";
+  }
+  const std::vector<std::string> seeAlso() const override {
+    return {"Plus", "Minus", "Multiply", "Divide", "Power", "ChangeBinOffset"};
+  }
+  std::map<std::string, std::string> validateInputs() override;
+
+  /// One step of the chain
+  struct Step {
+    std::string name;
+    int version;
+    ::Json::Value properties;
+  };
+  static std::vector<Step> parseChain(const std::string &chain);
+
+private:
+  void init() override;
+  void exec() override;
+  API::MatrixWorkspace_sptr extractBlock(const API::MatrixWorkspace_sptr &ws, const size_t start, const size_t end);
+  API::MatrixWorkspace_sptr runStep(const Step &step, const API::MatrixWorkspace_sptr &block, const size_t start,
+                                    const size_t end, const size_t numberOfSpectra);
+};
+
+} // namespace Algorithms
+} // namespace Mantid
@@ -78,6 +78,9 @@ private:
 
   void processSingleValueFilter(double minvalue, double maxvalue, bool filterincrease, bool filterdecrease);
 
+  /// Read the entries of the double log and the direction of their changes
+  void readDoubleLog();
+
   void processMultipleValueFilters(double minvalue, double valueinterval, double maxvalue, bool filterincrease,
                                    bool filterdecrease);
 
@@ -86,9 +89,10 @@ private:
                                Types::Core::DateAndTime stopTime, int wsindex);
 
   /// Make multiple-log-value filters in serial
-  void makeMultipleFiltersByValues(std::map<size_t, int> indexwsindexmap, const std::vector<double> &logvalueranges,
-                                   bool centre, bool filterIncrease, bool filterDecrease,
-                                   Types::Core::DateAndTime startTime, Types::Core::DateAndTime stopTime);
+  void makeMultipleFiltersByValues(const std::map<size_t, int> &indexwsindexmap,
+                                   const std::vector<double> &logvalueranges, bool centre, bool filterIncrease,
+                                   bool filterDecrease, Types::Core::DateAndTime startTime,
+                                   Types::Core::DateAndTime stopTime);
 
   /// Make multiple-log-value filters in serial in parallel
   void makeMultipleFiltersByValuesParallel(const std::map<size_t, int> &indexwsindexmap,
@@ -98,7 +102,8 @@ private:
 
   /// Generate event splitters for partial sample log (serial)
   void makeMultipleFiltersByValuesPartialLog(int istart, int iend, std::vector<Types::Core::DateAndTime> &vecSplitTime,
-                                             std::vector<int> &vecSplitGroup, std::map<size_t, int> indexwsindexmap,
+                                             std::vector<int> &vecSplitGroup,
+                                             const std::map<size_t, int> &indexwsindexmap,
                                              const std::vector<double> &logvalueranges,
                                              const Types::Core::time_duration &tol, bool filterIncrease,
                                              bool filterDecrease, Types::Core::DateAndTime startTime,
@@ -124,9 +129,6 @@ private:
   /// Generate a matrix workspace containing splitters
   void generateSplittersInMatrixWorkspace();
 
-  /// Generate a matrix workspace from the parallel version
-  void generateSplittersInMatrixWorkspaceParallel();
-
   /// Generate a SplittersWorkspace for filtering by log values
   void generateSplittersInSplitterWS();
 
@@ -161,6 +163,13 @@ private:
   Kernel::TimeSeriesProperty<double> *m_dblLog;
   Kernel::TimeSeriesProperty<int> *m_intLog;
 
+  /// Times of the entries of the double log
+  std::vector<Types::Core::DateAndTime> m_logTimes;
+  /// Values of the entries of the double log
+  std::vector<double> m_logValues;
+  /// Direction of the last change of the double log value up to each entry
+  std::vector<int> m_logDirections;
+
   bool m_logAtCentre;
   double m_logTimeTolerance;
 
@@ -175,9 +184,6 @@ private:
 
   /// Processing algorithm type
   bool m_useParallel;
-
-  std::vector<std::vector<Types::Core::DateAndTime>> m_vecSplitterTimeSet;
-  std::vector<std::vector<int>> m_vecGroupIndexSet;
 };
 
 } // namespace Algorithms
@@ -47,6 +47,13 @@ private:
                               HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) override;
   void performBinaryOperation(const HistogramData::Histogram &lhs, const double rhsY, const double rhsE,
                               HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) override;
+  bool hasArrayOperation() const override { return true; }
+  void performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                             const HistogramData::HistogramY &rhsY, const HistogramData::HistogramE &rhsE,
+                             HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) override;
+  void performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                             const double rhsY, const double rhsE, HistogramData::HistogramY &YOut,
+                             HistogramData::HistogramE &EOut) override;
   void performEventBinaryOperation(DataObjects::EventList &lhs, const DataObjects::EventList &rhs) override;
   void performEventBinaryOperation(DataObjects::EventList &lhs, const MantidVec &rhsX, const MantidVec &rhsY,
                                    const MantidVec &rhsE) override;
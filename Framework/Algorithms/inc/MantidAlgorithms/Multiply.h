@@ -46,6 +46,13 @@ private:
                               HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) override;
   void performBinaryOperation(const HistogramData::Histogram &lhs, const double rhsY, const double rhsE,
                               HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) override;
+  bool hasArrayOperation() const override { return true; }
+  void performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                             const HistogramData::HistogramY &rhsY, const HistogramData::HistogramE &rhsE,
+                             HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) override;
+  void performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                             const double rhsY, const double rhsE, HistogramData::HistogramY &YOut,
+                             HistogramData::HistogramE &EOut) override;
 
   void setOutputUnits(const API::MatrixWorkspace_const_sptr lhs, const API::MatrixWorkspace_const_sptr rhs,
                       API::MatrixWorkspace_sptr out) override;
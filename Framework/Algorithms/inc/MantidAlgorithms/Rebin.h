@@ -8,6 +8,9 @@
 
 #include "MantidAPI/DistributedAlgorithm.h"
 #include "MantidAlgorithms/DllConfig.h"
+#include "MantidHistogramData/Rebin.h"
+
+#include <functional>
 
 namespace Mantid {
 namespace Algorithms {
@@ -60,6 +63,10 @@ public:
   static std::vector<double> rebinParamsFromInput(const std::vector<double> &inParams,
                                                   const API::MatrixWorkspace &inputWS, Kernel::Logger &logger);
 
+  static std::vector<std::shared_ptr<const HistogramData::Rebinner>>
+  sharedRebinners(const API::MatrixWorkspace &inputWS,
+                  const std::function<HistogramData::BinEdges(size_t)> &newBinEdges);
+
 protected:
   const std::string workspaceMethodName() const override { return "rebin"; }
   const std::string workspaceMethodOnTypes() const override { return "MatrixWorkspace"; }
@@ -0,0 +1,287 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/AlignAndFocusEvents.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAPI/WorkspaceUnitValidator.h"
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/GroupingWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/ArrayProperty.h"
+#include "MantidKernel/MultiThreaded.h"
+#include "MantidKernel/RebinParamsValidator.h"
+#include "MantidKernel/Unit.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidKernel/VectorHelper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+
+namespace Mantid {
+namespace Algorithms {
+using namespace API;
+using namespace DataObjects;
+using namespace Kernel;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(AlignAndFocusEvents)
+
+namespace {
+/// An input spectrum that is focused, with the constants to convert its events
+struct SpectrumToFocus {
+  size_t workspaceIndex;
+  size_t numEvents;
+  UnitParametersMap diffConstants;
+};
+
+/// Consecutive spectra of one group, which are histogrammed by one thread
+struct Chunk {
+  size_t outputIndex;
+  size_t first;
+  size_t last;
+};
+
+/// The diffractometer constants of each detector in a calibration table, as
+/// made by LoadDiffCal or ConvertDiffCal
+class CalibrationTable {
+public:
+  explicit CalibrationTable(const ITableWorkspace &table) {
+    const auto detIDs = table.getColumn("detid");
+    const auto difc = table.getColumn("difc");
+    const auto difa = table.getColumn("difa");
+    const auto tzero = table.getColumn("tzero");
+    const size_t numRows = table.rowCount();
+    m_constants.reserve(numRows);
+    for (size_t row = 0; row < numRows; ++row)
+      m_constants.emplace(static_cast<detid_t>(detIDs->toDouble(row)),
+                          std::make_tuple(difc->toDouble(row), difa->toDouble(row), tzero->toDouble(row)));
+  }
+
+  /** Average the constants of the detectors of a spectrum that are in the table
+   * @param detIDs :: the detectors of the spectrum
+   * @param diffConstants :: set to the average DIFC, DIFA and TZERO
+   * @return false if none of the detectors are in the table
+   */
+  bool diffConstants(const std::set<detid_t> &detIDs, UnitParametersMap &diffConstants) const {
+    double difc = 0., difa = 0., tzero = 0.;
+    size_t numFound = 0;
+    for (const auto detID : detIDs) {
+      const auto found = m_constants.find(detID);
+      if (found == m_constants.end())
+        continue;
+      difc += std::get<0>(found->second);
+      difa += std::get<1>(found->second);
+      tzero += std::get<2>(found->second);
+      ++numFound;
+    }
+    if (numFound == 0)
+      return false;
+    const double norm = 1. / static_cast<double>(numFound);
+    diffConstants = {
+        {UnitParams::difc, difc * norm}, {UnitParams::difa, difa * norm}, {UnitParams::tzero, tzero * norm}};
+    return true;
+  }
+
+private:
+  std::unordered_map<detid_t, std::tuple<double, double, double>> m_constants;
+};
+
+/** The group of all the detectors of a spectrum, as in DiffractionFocussing
+ * @param detIDs :: the detectors of the spectrum
+ * @param detIDToGroup :: the group of each detector ID
+ * @return the group number, or -1 if the detectors are not all in one group
+ */
+int commonGroup(const std::set<detid_t> &detIDs, const std::vector<int> &detIDToGroup) {
+  int group = -1;
+  for (const auto detID : detIDs) {
+    if (detID < 0 || static_cast<size_t>(detID) >= detIDToGroup.size())
+      return -1;
+    const int detectorGroup = detIDToGroup[static_cast<size_t>(detID)];
+    if (detectorGroup <= 0 || (group != -1 && detectorGroup != group))
+      return -1;
+    group = detectorGroup;
+  }
+  return group;
+}
+} // namespace
+
+void AlignAndFocusEvents::init() {
+  declareProperty(std::make_unique<WorkspaceProperty<EventWorkspace>>("InputWorkspace", "", Direction::Input,
+                                                                      std::make_shared<WorkspaceUnitValidator>("TOF")),
+                  "An EventWorkspace with units of TOF");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "The focused histograms, in d-spacing, with one spectrum per group");
+  declareProperty(std::make_unique<WorkspaceProperty<ITableWorkspace>>("CalibrationWorkspace", "", Direction::Input,
+                                                                       PropertyMode::Optional),
+                  "Optional: a table of the detid, difc, difa and tzero of each detector. If it is not given, the "
+                  "diffractometer constants of the instrument are used, as set by ApplyDiffCal.");
+  declareProperty(std::make_unique<WorkspaceProperty<GroupingWorkspace>>("GroupingWorkspace", "", Direction::Input),
+                  "The group of each detector. Spectra whose detectors are not all in one group are left out.");
+  declareProperty(std::make_unique<ArrayProperty<double>>("Params", std::make_shared<RebinParamsValidator>()),
+                  "The d-spacing bins, as for Rebin: the first bin boundary, width, last bin boundary, optionally "
+                  "followed by more widths and boundaries. Negative widths give logarithmic bins.");
+  declareProperty("FullBinsOnly", false, "Omit the final bin if its width is smaller than the step size");
+}
+
+std::map<std::string, std::string> AlignAndFocusEvents::validateInputs() {
+  std::map<std::string, std::string> result;
+  const std::vector<double> params = getProperty("Params");
+  // The d-spacing range of the events is not known before they are converted
+  if (params.size() < 3)
+    result["Params"] = "The first and last bin boundaries must be given as well as the bin width";
+
+  ITableWorkspace_const_sptr calibrationWS = getProperty("CalibrationWorkspace");
+  if (calibrationWS) {
+    const auto names = calibrationWS->getColumnNames();
+    for (const auto column : {"detid", "difc", "difa", "tzero"}) {
+      if (std::find(names.cbegin(), names.cend(), column) == names.cend())
+        result["CalibrationWorkspace"] = std::string("The table must have a column named ") + column;
+    }
+  }
+  return result;
+}
+
+void AlignAndFocusEvents::exec() {
+  EventWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  GroupingWorkspace_const_sptr groupingWS = getProperty("GroupingWorkspace");
+  ITableWorkspace_const_sptr calibrationWS = getProperty("CalibrationWorkspace");
+  const std::vector<double> params = getProperty("Params");
+  const bool fullBinsOnly = getProperty("FullBinsOnly");
+
+  HistogramData::BinEdges edges(0);
+  static_cast<void>(VectorHelper::createAxisFromRebinParams(params, edges.mutableRawData(), true, fullBinsOnly));
+
+  std::vector<int> detIDToGroup;
+  int64_t numGroups = 0;
+  groupingWS->makeDetectorIDToGroupVector(detIDToGroup, numGroups);
+  std::unique_ptr<CalibrationTable> calibration;
+  if (calibrationWS)
+    calibration = std::make_unique<CalibrationTable>(*calibrationWS);
+
+  // Find the group and diffractometer constants of each spectrum. The spectra
+  // of each group are kept in workspace index order, and the groups in order.
+  progress(0.0, "Grouping spectra");
+  const auto &spectrumInfo = inputWS->spectrumInfo();
+  std::map<int, std::vector<SpectrumToFocus>> groups;
+  size_t numUncalibrated = 0;
+  size_t totalEvents = 0;
+  for (size_t i = 0; i < inputWS->getNumberHistograms(); ++i) {
+    const auto &spectrum = inputWS->getSpectrum(i);
+    const int group = commonGroup(spectrum.getDetectorIDs(), detIDToGroup);
+    if (group <= 0 || (spectrumInfo.hasDetectors(i) && spectrumInfo.isMasked(i)))
+      continue;
+    UnitParametersMap diffConstants;
+    if (calibration) {
+      if (!calibration->diffConstants(spectrum.getDetectorIDs(), diffConstants)) {
+        ++numUncalibrated;
+        continue;
+      }
+    } else {
+      diffConstants = spectrumInfo.diffractometerConstants(i);
+    }
+    try {
+      Units::dSpacing dSpacingUnit;
+      dSpacingUnit.initialize(-1., 0, diffConstants);
+    } catch (const std::runtime_error &e) {
+      g_log.warning() << "Workspace index " << i << " left out: " << e.what() << "\n";
+      continue;
+    }
+    totalEvents += spectrum.getNumberEvents();
+    groups[group].push_back({i, spectrum.getNumberEvents(), std::move(diffConstants)});
+  }
+  if (numUncalibrated > 0)
+    g_log.warning() << numUncalibrated << " spectra left out as none of their detectors are in the calibration table\n";
+  if (groups.empty())
+    throw std::runtime_error("None of the spectra of the input workspace can be focused into a group");
+
+  auto outputWS = create<Workspace2D>(*inputWS, groups.size(), edges);
+  outputWS->getAxis(0)->unit() = UnitFactory::Instance().create("dSpacing");
+
+  // Split the spectra of each group into chunks with enough events to keep all
+  // the threads busy, even when there are fewer groups than threads
+  const auto eventsPerChunk =
+      std::max(totalEvents / (8 * static_cast<size_t>(PARALLEL_GET_MAX_THREADS)), static_cast<size_t>(1));
+  std::vector<const std::vector<SpectrumToFocus> *> groupSpectra;
+  std::vector<Chunk> chunks;
+  for (const auto &group : groups) {
+    const size_t outputIndex = groupSpectra.size();
+    auto &outSpectrum = outputWS->getSpectrum(outputIndex);
+    outSpectrum.setSpectrumNo(group.first);
+    outSpectrum.clearDetectorIDs();
+    const auto &spectra = group.second;
+    size_t first = 0;
+    size_t numEvents = 0;
+    for (size_t i = 0; i < spectra.size(); ++i) {
+      outSpectrum.addDetectorIDs(inputWS->getSpectrum(spectra[i].workspaceIndex).getDetectorIDs());
+      numEvents += spectra[i].numEvents;
+      if (numEvents >= eventsPerChunk || i + 1 == spectra.size()) {
+        chunks.push_back({outputIndex, first, i + 1});
+        first = i + 1;
+        numEvents = 0;
+      }
+    }
+    groupSpectra.emplace_back(&spectra);
+  }
+
+  const EventHistogrammer histogrammer(edges.rawData());
+  const size_t numBins = edges.size() - 1;
+  std::vector<MantidVec> groupCounts(groups.size(), MantidVec(numBins, 0.));
+  std::vector<MantidVec> groupErrorsSquared(groups.size(), MantidVec(numBins, 0.));
+  const bool isEventTypeTOF = inputWS->getEventType() == API::TOF;
+  const bool parallel = Kernel::threadSafe(*inputWS);
+  Progress prog(this, 0.1, 1.0, chunks.size());
+  PRAGMA_OMP(parallel for schedule(dynamic, 1) if (parallel))
+  for (int64_t chunkIndex = 0; chunkIndex < static_cast<int64_t>(chunks.size()); ++chunkIndex) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto &chunk = chunks[chunkIndex];
+    const auto &spectra = *groupSpectra[chunk.outputIndex];
+    MantidVec counts(numBins, 0.), errorsSquared(numBins, 0.);
+    std::vector<double> dSpacings, weights, errors;
+    for (size_t i = chunk.first; i < chunk.last; ++i) {
+      const auto &eventList = inputWS->getSpectrum(spectra[i].workspaceIndex);
+      Units::dSpacing dSpacingUnit;
+      dSpacingUnit.initialize(-1., 0, spectra[i].diffConstants);
+      eventList.getTofs(dSpacings);
+      dSpacingUnit.valuesFromTOF(dSpacings.data(), dSpacings.data(), dSpacings.size());
+      if (isEventTypeTOF) {
+        histogrammer.accumulate(dSpacings, {}, {}, counts, errorsSquared);
+      } else {
+        eventList.getWeights(weights);
+        eventList.getWeightErrors(errors);
+        std::transform(errors.cbegin(), errors.cend(), errors.begin(),
+                       [](const double error) { return error * error; });
+        histogrammer.accumulate(dSpacings, weights, errors, counts, errorsSquared);
+      }
+    }
+    PARALLEL_CRITICAL(AlignAndFocusEvents_addChunk) {
+      auto &outCounts = groupCounts[chunk.outputIndex];
+      auto &outErrorsSquared = groupErrorsSquared[chunk.outputIndex];
+      std::transform(outCounts.cbegin(), outCounts.cend(), counts.cbegin(), outCounts.begin(), std::plus<double>());
+      std::transform(outErrorsSquared.cbegin(), outErrorsSquared.cend(), errorsSquared.cbegin(),
+                     outErrorsSquared.begin(), std::plus<double>());
+    }
+    prog.report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  for (size_t outputIndex = 0; outputIndex < groupCounts.size(); ++outputIndex) {
+    auto &errors = groupErrorsSquared[outputIndex];
+    std::transform(errors.cbegin(), errors.cend(), errors.begin(), static_cast<double (*)(double)>(std::sqrt));
+    outputWS->mutableY(outputIndex) = std::move(groupCounts[outputIndex]);
+    outputWS->mutableE(outputIndex) = std::move(errors);
+  }
+  setProperty("OutputWorkspace", std::move(outputWS));
+}
+
+} // namespace Algorithms
+} // namespace Mantid
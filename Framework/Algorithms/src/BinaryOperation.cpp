@@ -239,6 +239,10 @@ void BinaryOperation::exec() {
   // Initialise the progress reporting object
   m_progress = std::make_unique<Progress>(this, 0.0, 1.0, m_lhs->getNumberHistograms());
 
+  // The histogram data of event workspaces is only generated on request, so
+  // their histograms are needed
+  m_useArrayOperation = hasArrayOperation() && !m_elhs && !m_erhs && !m_eout;
+
   // There are now 4 possible scenarios, shown schematically here:
   // xxx x   xxx xxx   xxx xxx   xxx x
   // xxx   , xxx xxx , xxx     , xxx x
@@ -461,14 +465,17 @@ void BinaryOperation::doSingleValue() {
     PARALLEL_FOR_IF(Kernel::threadSafe(*m_lhs, *m_rhs, *m_out))
     for (int64_t i = 0; i < numHists; ++i) {
       PARALLEL_START_INTERUPT_REGION
-      m_out->setSharedX(i, m_lhs->sharedX(i));
+      shareLhsX(i);
       // Get reference to output vectors here to break any sharing outside the
       // function call below
       // where the order of argument evaluation is not guaranteed (if it's L->R
       // there would be a data race)
       HistogramData::HistogramY &outY = m_out->mutableY(i);
       HistogramData::HistogramE &outE = m_out->mutableE(i);
-      performBinaryOperation(m_lhs->histogram(i), rhsY, rhsE, outY, outE);
+      if (m_useArrayOperation)
+        performArrayOperation(m_lhs->y(i), m_lhs->e(i), rhsY, rhsE, outY, outE);
+      else
+        performBinaryOperation(m_lhs->histogram(i), rhsY, rhsE, outY, outE);
       m_progress->report(this->name());
       PARALLEL_END_INTERUPT_REGION
     }
@@ -513,7 +520,7 @@ void BinaryOperation::doSingleColumn() {
       const double rhsY = m_rhs->y(i)[0];
       const double rhsE = m_rhs->e(i)[0];
 
-      m_out->setSharedX(i, m_lhs->sharedX(i));
+      shareLhsX(i);
       if (propagateSpectraMask(lhsSpectrumInfo, rhsSpectrumInfo, i, *m_out, outSpectrumInfo)) {
         // Get reference to output vectors here to break any sharing outside the
         // function call below
@@ -521,7 +528,10 @@ void BinaryOperation::doSingleColumn() {
         // L->R there would be a data race)
         HistogramData::HistogramY &outY = m_out->mutableY(i);
         HistogramData::HistogramE &outE = m_out->mutableE(i);
-        performBinaryOperation(m_lhs->histogram(i), rhsY, rhsE, outY, outE);
+        if (m_useArrayOperation)
+          performArrayOperation(m_lhs->y(i), m_lhs->e(i), rhsY, rhsE, outY, outE);
+        else
+          performBinaryOperation(m_lhs->histogram(i), rhsY, rhsE, outY, outE);
       }
       m_progress->report(this->name());
       PARALLEL_END_INTERUPT_REGION
@@ -597,14 +607,17 @@ void BinaryOperation::doSingleSpectrum() {
     PARALLEL_FOR_IF(Kernel::threadSafe(*m_lhs, *m_rhs, *m_out))
     for (int64_t i = 0; i < numHists; ++i) {
       PARALLEL_START_INTERUPT_REGION
-      m_out->setSharedX(i, m_lhs->sharedX(i));
+      shareLhsX(i);
       // Get reference to output vectors here to break any sharing outside the
       // function call below
       // where the order of argument evaluation is not guaranteed (if it's L->R
       // there would be a data race)
       HistogramData::HistogramY &outY = m_out->mutableY(i);
       HistogramData::HistogramE &outE = m_out->mutableE(i);
-      performBinaryOperation(m_lhs->histogram(i), rhs, outY, outE);
+      if (m_useArrayOperation)
+        performArrayOperation(m_lhs->y(i), m_lhs->e(i), rhs.y(), rhs.e(), outY, outE);
+      else
+        performBinaryOperation(m_lhs->histogram(i), rhs, outY, outE);
       m_progress->report(this->name());
       PARALLEL_END_INTERUPT_REGION
     }
@@ -713,7 +726,7 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
     for (int64_t i = 0; i < numHists; ++i) {
       PARALLEL_START_INTERUPT_REGION
       m_progress->report(this->name());
-      m_out->setSharedX(i, m_lhs->sharedX(i));
+      shareLhsX(i);
       int64_t rhs_wi = i;
       if (mismatchedSpectra && table) {
         rhs_wi = (*table)[i];
@@ -731,7 +744,10 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
       // there would be a data race)
       HistogramData::HistogramY &outY = m_out->mutableY(i);
       HistogramData::HistogramE &outE = m_out->mutableE(i);
-      performBinaryOperation(m_lhs->histogram(i), m_rhs->histogram(rhs_wi), outY, outE);
+      if (m_useArrayOperation)
+        performArrayOperation(m_lhs->y(i), m_lhs->e(i), m_rhs->y(rhs_wi), m_rhs->e(rhs_wi), outY, outE);
+      else
+        performBinaryOperation(m_lhs->histogram(i), m_rhs->histogram(rhs_wi), outY, outE);
 
       // Free up memory on the RHS if that is possible
       if (m_ClearRHSWorkspace)
@@ -746,6 +762,16 @@ void BinaryOperation::do2D(bool mismatchedSpectra) {
     m_erhs->clearMRU();
 }
 
+/** Makes the output spectrum share the X data of the lhs spectrum. The output
+ * usually shares it already, and is then left untouched so that the threads do
+ * not all update the reference count of the same X data.
+ *  @param index :: The workspace index of the spectrum
+ */
+void BinaryOperation::shareLhsX(const size_t index) {
+  if (&m_out->x(index) != &m_lhs->x(index))
+    m_out->setSharedX(index, m_lhs->sharedX(index));
+}
+
 /** Copies any bin masking from the smaller/rhs input workspace to the output.
  *  Masks on the other input workspace are copied automatically by the workspace
  * factory.
@@ -770,6 +796,57 @@ void BinaryOperation::propagateBinMasks(const API::MatrixWorkspace_const_sptr &r
   }
 }
 
+// ------- Default implementations of array binary operations --------
+
+/**
+ * Carries out the binary operation on the data of a single spectrum, with the
+ * data of another spectrum as the right-hand operand.
+ *
+ *  @param lhsY :: Lhs data values
+ *  @param lhsE :: Lhs error values
+ *  @param rhsY :: Rhs data values
+ *  @param rhsE :: Rhs error values
+ *  @param YOut :: Data values resulting from the operation
+ *  @param EOut :: Error values resulting from the operation
+ */
+void BinaryOperation::performArrayOperation(const HistogramData::HistogramY &lhsY,
+                                            const HistogramData::HistogramE &lhsE,
+                                            const HistogramData::HistogramY &rhsY,
+                                            const HistogramData::HistogramE &rhsE, HistogramData::HistogramY &YOut,
+                                            HistogramData::HistogramE &EOut) {
+  UNUSED_ARG(lhsY);
+  UNUSED_ARG(lhsE);
+  UNUSED_ARG(rhsY);
+  UNUSED_ARG(rhsE);
+  UNUSED_ARG(YOut);
+  UNUSED_ARG(EOut);
+  throw Exception::NotImplementedError("BinaryOperation::performArrayOperation() not implemented.");
+}
+
+/**
+ * Carries out the binary operation on the data of a single spectrum, with a
+ * single value as the right-hand operand.
+ *
+ *  @param lhsY :: Lhs data values
+ *  @param lhsE :: Lhs error values
+ *  @param rhsY :: The rhs data value
+ *  @param rhsE :: The rhs error value
+ *  @param YOut :: Data values resulting from the operation
+ *  @param EOut :: Error values resulting from the operation
+ */
+void BinaryOperation::performArrayOperation(const HistogramData::HistogramY &lhsY,
+                                            const HistogramData::HistogramE &lhsE, const double rhsY,
+                                            const double rhsE, HistogramData::HistogramY &YOut,
+                                            HistogramData::HistogramE &EOut) {
+  UNUSED_ARG(lhsY);
+  UNUSED_ARG(lhsE);
+  UNUSED_ARG(rhsY);
+  UNUSED_ARG(rhsE);
+  UNUSED_ARG(YOut);
+  UNUSED_ARG(EOut);
+  throw Exception::NotImplementedError("BinaryOperation::performArrayOperation() not implemented.");
+}
+
 // ------- Default implementations of Event binary operations --------
 
 /**
@@ -0,0 +1,226 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidAlgorithms/ChainSpectrumAlgorithms.h"
+#include "MantidAPI/AlgorithmManager.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/HistoWorkspace.h"
+#include "MantidAPI/IWorkspaceProperty.h"
+#include "MantidAPI/Progress.h"
+#include "MantidAPI/SpectrumInfo.h"
+#include "MantidAlgorithms/BinaryOperation.h"
+#include "MantidAlgorithms/SpectrumAlgorithm.h"
+#include "MantidAlgorithms/UnaryOperation.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidJson/Json.h"
+#include "MantidKernel/BoundedValidator.h"
+#include "MantidKernel/MandatoryValidator.h"
+
+#include <algorithm>
+
+namespace Mantid {
+namespace Algorithms {
+using namespace API;
+using namespace DataObjects;
+using namespace Kernel;
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(ChainSpectrumAlgorithms)
+
+namespace {
+/// Size of the blocks of spectra when SpectraPerBlock is not given
+constexpr size_t DEFAULT_BLOCK_BYTES = 8 * 1024 * 1024;
+
+/// The workspace properties of an algorithm
+struct WorkspaceProperties {
+  /// The input workspaces, in the order they were declared
+  std::vector<std::string> inputs;
+  std::string output;
+};
+
+WorkspaceProperties workspaceProperties(const Algorithm &alg) {
+  WorkspaceProperties names;
+  for (const auto *prop : alg.getProperties()) {
+    if (!dynamic_cast<const IWorkspaceProperty *>(prop))
+      continue;
+    if (prop->direction() == Direction::Input)
+      names.inputs.emplace_back(prop->name());
+    else if (prop->direction() == Direction::Output && names.output.empty())
+      names.output = prop->name();
+  }
+  return names;
+}
+
+/// True if the algorithm treats each spectrum of its input independently
+bool isSpectrumWise(const Algorithm &alg) {
+  return dynamic_cast<const SpectrumAlgorithm *>(&alg) || dynamic_cast<const UnaryOperation *>(&alg) ||
+         dynamic_cast<const BinaryOperation *>(&alg);
+}
+} // namespace
+
+/** Read the steps of a chain from a JSON list of algorithms
+ * @param chain :: a list of objects with a name, an optional version and
+ * optional properties, in the form written by Algorithm::toString
+ * @return the steps of the chain
+ * @throws std::invalid_argument if the chain cannot be read
+ */
+std::vector<ChainSpectrumAlgorithms::Step> ChainSpectrumAlgorithms::parseChain(const std::string &chain) {
+  ::Json::Value root;
+  std::string errors;
+  if (!Mantid::JsonHelpers::parse(chain, &root, &errors))
+    throw std::invalid_argument("The chain is not valid JSON: " + errors);
+  if (!root.isArray() || root.empty())
+    throw std::invalid_argument("The chain must be a non-empty list of algorithms");
+
+  std::vector<Step> steps;
+  steps.reserve(root.size());
+  for (const auto &entry : root) {
+    if (!entry.isObject() || !entry["name"].isString())
+      throw std::invalid_argument("Each algorithm of the chain must be an object with a name");
+    steps.push_back({entry["name"].asString(), entry.get("version", -1).asInt(), entry["properties"]});
+  }
+  return steps;
+}
+
+void ChainSpectrumAlgorithms::init() {
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>("InputWorkspace", "", Direction::Input),
+                  "The workspace the first algorithm of the chain is run on.");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "The output of the last algorithm of the chain.");
+  declareProperty("Algorithms", "", std::make_shared<MandatoryValidator<std::string>>(),
+                  "A JSON list of the algorithms to run, each given as an object with a "
+                  "name and optionally a version and properties, "
+                  "e.g. [{\"name\": \"Power\", \"properties\": {\"Exponent\": 2}}]. "
+                  "The input and output workspaces of each algorithm are set by the chain.");
+  auto mustBePositive = std::make_shared<BoundedValidator<int>>();
+  mustBePositive->setLower(0);
+  declareProperty("SpectraPerBlock", 0, mustBePositive,
+                  "The number of spectra run through the chain at a time. By default the blocks "
+                  "hold about 8 MB of data.");
+}
+
+std::map<std::string, std::string> ChainSpectrumAlgorithms::validateInputs() {
+  std::map<std::string, std::string> result;
+  MatrixWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  if (std::dynamic_pointer_cast<const EventWorkspace>(inputWS))
+    result["InputWorkspace"] = "EventWorkspaces are not supported, the events must be histogrammed first";
+  else if (inputWS && inputWS->getNumberHistograms() == 0)
+    result["InputWorkspace"] = "The input workspace has no spectra";
+
+  try {
+    for (const auto &step : parseChain(getPropertyValue("Algorithms"))) {
+      auto alg = AlgorithmManager::Instance().createUnmanaged(step.name, step.version);
+      alg->initialize();
+      if (!isSpectrumWise(*alg)) {
+        result["Algorithms"] = step.name + " is not a SpectrumAlgorithm, UnaryOperation or BinaryOperation";
+        break;
+      }
+      const auto names = workspaceProperties(*alg);
+      alg->setProperties(step.properties, {names.inputs.front(), names.output});
+    }
+  } catch (std::exception &e) {
+    result["Algorithms"] = e.what();
+  }
+  return result;
+}
+
+void ChainSpectrumAlgorithms::exec() {
+  MatrixWorkspace_sptr inputWS = getProperty("InputWorkspace");
+  const auto steps = parseChain(getPropertyValue("Algorithms"));
+  const size_t numberOfSpectra = inputWS->getNumberHistograms();
+
+  const int blockSize = getProperty("SpectraPerBlock");
+  auto spectraPerBlock = static_cast<size_t>(blockSize);
+  if (spectraPerBlock == 0) {
+    const auto &histogram = inputWS->histogram(0);
+    const size_t spectrumBytes = (histogram.x().size() + 2 * histogram.y().size()) * sizeof(double);
+    spectraPerBlock = std::max(DEFAULT_BLOCK_BYTES / std::max(spectrumBytes, size_t(1)), size_t(1));
+  }
+  const size_t numberOfBlocks = (numberOfSpectra + spectraPerBlock - 1) / spectraPerBlock;
+
+  MatrixWorkspace_sptr outputWS;
+  Progress progress(this, 0.0, 1.0, numberOfBlocks * steps.size());
+  for (size_t start = 0; start < numberOfSpectra; start += spectraPerBlock) {
+    interruption_point();
+    const size_t end = std::min(start + spectraPerBlock, numberOfSpectra);
+    auto block = extractBlock(inputWS, start, end);
+    for (const auto &step : steps) {
+      block = runStep(step, block, start, end, numberOfSpectra);
+      progress.report(step.name);
+    }
+
+    if (!outputWS) {
+      outputWS = create<HistoWorkspace>(*inputWS, block->histogram(0));
+      outputWS->getAxis(0)->unit() = block->getAxis(0)->unit();
+      outputWS->setYUnit(block->YUnit());
+      outputWS->setYUnitLabel(block->YUnitLabel());
+      outputWS->setDistribution(block->isDistribution());
+    }
+    const auto &blockInfo = block->spectrumInfo();
+    auto &outputInfo = outputWS->mutableSpectrumInfo();
+    for (size_t i = 0; i < end - start; ++i) {
+      outputWS->setHistogram(start + i, block->histogram(i));
+      if (block->hasMaskedBins(i)) {
+        for (const auto &mask : block->maskedBins(i))
+          outputWS->flagMasked(start + i, mask.first, mask.second);
+      }
+      if (blockInfo.hasDetectors(i) && blockInfo.isMasked(i))
+        outputInfo.setMasked(start + i, true);
+    }
+  }
+  setProperty("OutputWorkspace", outputWS);
+}
+
+/** Copy a block of spectra out of a workspace
+ * @param ws :: the workspace to copy from
+ * @param start :: the first workspace index of the block
+ * @param end :: one past the last workspace index of the block
+ * @return a workspace holding the spectra of the block
+ */
+MatrixWorkspace_sptr ChainSpectrumAlgorithms::extractBlock(const MatrixWorkspace_sptr &ws, const size_t start,
+                                                           const size_t end) {
+  auto extract = createChildAlgorithm("ExtractSpectra");
+  extract->setProperty("InputWorkspace", ws);
+  extract->setProperty("StartWorkspaceIndex", static_cast<int>(start));
+  extract->setProperty("EndWorkspaceIndex", static_cast<int>(end - 1));
+  extract->executeAsChildAlg();
+  return extract->getProperty("OutputWorkspace");
+}
+
+/** Run one step of the chain in place on a block of spectra
+ * @param step :: the algorithm to run
+ * @param block :: the spectra of the block
+ * @param start :: the first workspace index of the block
+ * @param end :: one past the last workspace index of the block
+ * @param numberOfSpectra :: the number of spectra of the input workspace
+ * @return the output of the algorithm
+ */
+MatrixWorkspace_sptr ChainSpectrumAlgorithms::runStep(const Step &step, const MatrixWorkspace_sptr &block,
+                                                      const size_t start, const size_t end,
+                                                      const size_t numberOfSpectra) {
+  auto alg = createChildAlgorithm(step.name, -1, -1, false, step.version);
+  const auto names = workspaceProperties(*alg);
+  alg->setProperties(step.properties, {names.inputs.front(), names.output});
+  alg->setProperty(names.inputs.front(), block);
+  // The other operand of a binary operation is cut into the same blocks if it
+  // has a spectrum for each spectrum of the input
+  if (names.inputs.size() > 1 && end - start < numberOfSpectra) {
+    MatrixWorkspace_sptr other = alg->getProperty(names.inputs[1]);
+    if (other && other->getNumberHistograms() == numberOfSpectra)
+      alg->setProperty(names.inputs[1], extractBlock(other, start, end));
+  }
+  alg->setProperty(names.output, block);
+  alg->executeAsChildAlg();
+
+  MatrixWorkspace_sptr output = alg->getProperty(names.output);
+  if (output->getNumberHistograms() != end - start)
+    throw std::runtime_error(step.name + " changed the number of spectra, so it cannot be run as part of a chain");
+  return output;
+}
+
+} // namespace Algorithms
+} // namespace Mantid
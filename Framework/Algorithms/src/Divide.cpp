@@ -31,30 +31,37 @@ void Divide::exec() {
 
 void Divide::performBinaryOperation(const HistogramData::Histogram &lhs, const HistogramData::Histogram &rhs,
                                     HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
-  const auto bins = static_cast<int>(lhs.e().size());
-
-  for (int j = 0; j < bins; ++j) {
-    // Get references to the input Y's
-    const double leftY = lhs.y()[j];
-    const double rightY = rhs.y()[j];
-
-    //  error dividing two uncorrelated numbers, re-arrange so that you don't
-    //  get infinity if leftY==0 (when rightY=0 the Y value and the result will
-    //  both be infinity)
-    // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
-    // (Sa c/a)2 + (Sb c/b)2 = (Sc)2
-    // = (Sa 1/b)2 + (Sb (a/b2))2
-    // (Sc)2 = (1/b)2( (Sa)2 + (Sb a/b)2 )
-    EOut[j] = sqrt(pow(lhs.e()[j], 2) + pow(leftY * rhs.e()[j] / rightY, 2)) / fabs(rightY);
-
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY / rightY;
-  }
+  performArrayOperation(lhs.y(), lhs.e(), rhs.y(), rhs.e(), YOut, EOut);
 }
 
 void Divide::performBinaryOperation(const HistogramData::Histogram &lhs, const double rhsY, const double rhsE,
                                     HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
+  performArrayOperation(lhs.y(), lhs.e(), rhsY, rhsE, YOut, EOut);
+}
+
+void Divide::performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                   const HistogramData::HistogramY &rhsY, const HistogramData::HistogramE &rhsE,
+                                   HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
+  const size_t bins = lhsE.size();
+  //  error dividing two uncorrelated numbers, re-arrange so that you don't
+  //  get infinity if leftY==0 (when rightY=0 the Y value and the result will
+  //  both be infinity)
+  // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
+  // (Sa c/a)2 + (Sb c/b)2 = (Sc)2
+  // = (Sa 1/b)2 + (Sb (a/b2))2
+  // (Sc)2 = (1/b)2( (Sa)2 + (Sb a/b)2 )
+  // The errors are calculated first in case one of the input workspaces is
+  // also the output, and separately from the values so that the loop over
+  // the values can be vectorised
+  for (size_t j = 0; j < bins; ++j)
+    EOut[j] = sqrt(pow(lhsE[j], 2) + pow(lhsY[j] * rhsE[j] / rhsY[j], 2)) / fabs(rhsY[j]);
+  for (size_t j = 0; j < bins; ++j)
+    YOut[j] = lhsY[j] / rhsY[j];
+}
+
+void Divide::performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                   const double rhsY, const double rhsE, HistogramData::HistogramY &YOut,
+                                   HistogramData::HistogramE &EOut) {
   if (rhsY == 0 && m_warnOnZeroDivide)
     g_log.warning() << "Division by zero: the RHS is a single-valued vector "
                        "with value zero."
@@ -62,17 +69,12 @@ void Divide::performBinaryOperation(const HistogramData::Histogram &lhs, const d
 
   // Do the right-hand part of the error calculation just once
   const double rhsFactor = pow(rhsE / rhsY, 2);
-  const auto bins = static_cast<int>(lhs.e().size());
-  for (int j = 0; j < bins; ++j) {
-    // Get reference to input Y
-    const double leftY = lhs.y()[j];
-
-    // see comment in the function above for the error formula
-    EOut[j] = sqrt(pow(lhs.e()[j], 2) + pow(leftY, 2) * rhsFactor) / fabs(rhsY);
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY / rhsY;
-  }
+  const size_t bins = lhsE.size();
+  // see comment in the function above for the error formula
+  for (size_t j = 0; j < bins; ++j)
+    EOut[j] = sqrt(pow(lhsE[j], 2) + pow(lhsY[j], 2) * rhsFactor) / fabs(rhsY);
+  for (size_t j = 0; j < bins; ++j)
+    YOut[j] = lhsY[j] / rhsY;
 }
 
 void Divide::setOutputUnits(const API::MatrixWorkspace_const_sptr lhs, const API::MatrixWorkspace_const_sptr rhs,
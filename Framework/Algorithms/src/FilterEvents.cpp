@@ -15,6 +15,7 @@
 #include "MantidAlgorithms/TimeAtSampleStrategyDirect.h"
 #include "MantidAlgorithms/TimeAtSampleStrategyElastic.h"
 #include "MantidAlgorithms/TimeAtSampleStrategyIndirect.h"
+#include "MantidDataObjects/EventSplitter.h"
 #include "MantidDataObjects/SplittersWorkspace.h"
 #include "MantidDataObjects/TableWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -727,7 +728,8 @@ void FilterEvents::splitTimeSeriesProperty(Kernel::TimeSeriesProperty<TYPE> *tsp
     // use vector of raw pointers for splitting
     std::transform(output_vector.begin(), output_vector.end(), split_properties.begin(),
                    [](const std::unique_ptr<TimeSeriesProperty<TYPE>> &x) { return x.get(); });
-    tsp->splitByTimeVector(split_datetime_vec, m_vecSplitterGroup, split_properties);
+    // the outputs only copy their values when they are used
+    tsp->splitByTimeVectorDeferred(split_datetime_vec, m_vecSplitterGroup, split_properties);
   }
 
   // assign to output workspaces
@@ -1602,21 +1604,27 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
   // to N event list
   g_log.debug() << "Number of spectra in input/source EventWorkspace = " << numberOfSpectra << ".\n";
 
-  // FIXME - Turn on parallel:
+  // Compile the splitters once, and find the output workspace of each of
+  // their targets
+  const DataObjects::EventSplitter splitter(m_splitters);
+  std::vector<DataObjects::EventWorkspace *> outputWorkspaces;
+  for (const auto target : splitter.targets()) {
+    const auto ws = m_outputWorkspacesMap.find(target);
+    outputWorkspaces.emplace_back(ws != m_outputWorkspacesMap.end() ? ws->second.get() : nullptr);
+  }
+
   PARALLEL_FOR_NO_WSP_CHECK()
   for (int64_t iws = 0; iws < int64_t(numberOfSpectra); ++iws) {
     PARALLEL_START_INTERUPT_REGION
 
     // Filter the non-skipped
     if (!m_vecSkip[iws]) {
-      // Get the output event lists (should be empty) to be a map
-      std::map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      // Get the output event lists (should be empty), in the order of the
+      // targets of the splitter
+      std::vector<DataObjects::EventList *> outputs(outputWorkspaces.size(), nullptr);
+      for (size_t i = 0; i < outputWorkspaces.size(); ++i) {
+        if (outputWorkspaces[i])
+          outputs[i] = &outputWorkspaces[i]->getSpectrum(iws);
       }
       // Get a holder on input workspace's event list of this spectrum
       const DataObjects::EventList &input_el = m_eventWS->getSpectrum(iws);
@@ -1624,11 +1632,11 @@ void FilterEvents::filterEventsBySplitters(double progressamount) {
       // Perform the filtering (using the splitting function and just one
       // output)
       if (m_filterByPulseTime) {
-        input_el.splitByPulseTime(m_splitters, outputs);
+        input_el.splitByPulseTime(splitter, outputs);
       } else if (m_tofCorrType != NoneCorrect) {
-        input_el.splitByFullTime(m_splitters, outputs, true, m_detTofFactors[iws], m_detTofOffsets[iws]);
+        input_el.splitByFullTime(splitter, outputs, true, m_detTofFactors[iws], m_detTofOffsets[iws]);
       } else {
-        input_el.splitByFullTime(m_splitters, outputs, false, 1.0, 0.0);
+        input_el.splitByFullTime(splitter, outputs, false, 1.0, 0.0);
       }
     }
 
@@ -1681,12 +1689,10 @@ void FilterEvents::filterEventsByVectorSplitters(double progressamount) {
     if (!m_vecSkip[iws]) {
       // Get the output event lists (should be empty) to be a map
       map<int, DataObjects::EventList *> outputs;
-      PARALLEL_CRITICAL(build_elist) {
-        for (auto &ws : m_outputWorkspacesMap) {
-          int index = ws.first;
-          auto &output_el = ws.second->getSpectrum(iws);
-          outputs.emplace(index, &output_el);
-        }
+      for (auto &ws : m_outputWorkspacesMap) {
+        int index = ws.first;
+        auto &output_el = ws.second->getSpectrum(iws);
+        outputs.emplace(index, &output_el);
       }
 
       // Get a holder on input workspace's event list of this spectrum
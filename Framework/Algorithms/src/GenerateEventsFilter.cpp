@@ -40,7 +40,7 @@ GenerateEventsFilter::GenerateEventsFilter()
     : API::Algorithm(), m_dataWS(), m_splitWS(), m_filterWS(), m_filterInfoWS(), m_startTime(), m_stopTime(),
       m_runEndTime(), m_timeUnitConvertFactorToNS(0.), m_dblLog(nullptr), m_intLog(nullptr), m_logAtCentre(false),
       m_logTimeTolerance(0.), m_forFastLog(false), m_splitters(), m_vecSplitterTime(), m_vecSplitterGroup(),
-      m_useParallel(false), m_vecSplitterTimeSet(), m_vecGroupIndexSet() {}
+      m_useParallel(false) {}
 
 /** Declare input
  */
@@ -177,11 +177,7 @@ void GenerateEventsFilter::exec() {
 
   // Set output workspaces
   if (m_forFastLog) {
-    if (m_useParallel) {
-      generateSplittersInMatrixWorkspaceParallel();
-    } else {
-      generateSplittersInMatrixWorkspace();
-    }
+    generateSplittersInMatrixWorkspace();
     setProperty("OutputWorkspace", m_filterWS);
   } else {
     generateSplittersInSplitterWS();
@@ -471,6 +467,7 @@ void GenerateEventsFilter::setFilterByLogValue(const std::string &logname) {
     if (m_runEndTime > m_dblLog->lastTime())
       m_dblLog->addValue(m_runEndTime, 0.);
     m_dblLog->eliminateDuplicates();
+    readDoubleLog();
   } else {
     g_log.debug("Attempting to remove duplicates in integer series log.");
     m_intLog->addValue(m_runEndTime, 0);
@@ -615,6 +612,37 @@ void GenerateEventsFilter::processSingleValueFilter(double minvalue, double maxv
   row << 0 << ss.str();
 }
 
+//----------------------------------------------------------------------------------------------
+/** Read the times and values of the double log once, for the filters to walk
+ * along plain vectors rather than to look up each entry in the log. The
+ * direction of the value at an entry is that of the last change up to it, or
+ * of the first change for the entries before it, and is 0 if the log is flat.
+ */
+void GenerateEventsFilter::readDoubleLog() {
+  m_logTimes = m_dblLog->timesAsVector();
+  m_logValues = m_dblLog->valuesAsVector();
+
+  const size_t numEntries = m_logValues.size();
+  m_logDirections.assign(numEntries, 0);
+  int direction = 0;
+  for (size_t i = 0; i + 1 < numEntries; ++i) {
+    const double diff = m_logValues[i + 1] - m_logValues[i];
+    if (diff > 0)
+      direction = 1;
+    else if (diff < 0)
+      direction = -1;
+    m_logDirections[i] = direction;
+  }
+  if (numEntries > 0)
+    m_logDirections.back() = direction;
+
+  // The entries before the first change take its direction
+  const auto firstChange =
+      std::find_if(m_logDirections.begin(), m_logDirections.end(), [](const int dir) { return dir != 0; });
+  if (firstChange != m_logDirections.end())
+    std::fill(m_logDirections.begin(), firstChange, *firstChange);
+}
+
 //----------------------------------------------------------------------------------------------
 /** Generate filters from multiple values
  * @param minvalue :: minimum value of the allowed log value;
@@ -740,7 +768,8 @@ void GenerateEventsFilter::makeFilterBySingleValue(double min, double max, doubl
                                                    bool filterIncrease, bool filterDecrease, DateAndTime startTime,
                                                    Types::Core::DateAndTime stopTime, int wsindex) {
   // Do nothing if the log is empty.
-  if (m_dblLog->size() == 0) {
+  const auto numEntries = static_cast<int>(m_logValues.size());
+  if (numEntries == 0) {
     g_log.warning() << "There is no entry in this property " << this->name() << "\n";
     return;
   }
@@ -757,10 +786,10 @@ void GenerateEventsFilter::makeFilterBySingleValue(double min, double max, doubl
   DateAndTime start, stop;
 
   size_t progslot = 0;
-  for (int i = 0; i < m_dblLog->size(); i++) {
+  for (int i = 0; i < numEntries; i++) {
     lastTime = currT;
     // The new entry
-    currT = m_dblLog->nthTime(i);
+    currT = m_logTimes[i];
 
     // A good value?
     bool isGood = identifyLogEntry(i, currT, lastGood, min, max, startTime, stopTime, filterIncrease, filterDecrease);
@@ -794,7 +823,7 @@ void GenerateEventsFilter::makeFilterBySingleValue(double min, double max, doubl
     }
 
     // Progress bar..
-    size_t tmpslot = i * 90 / m_dblLog->size();
+    size_t tmpslot = i * 90 / numEntries;
     if (tmpslot > progslot) {
       progslot = tmpslot;
       double prog = double(progslot) / 100.0 + 0.1;
@@ -832,21 +861,21 @@ bool GenerateEventsFilter::identifyLogEntry(const int &index, const Types::Core:
                                             const Types::Core::DateAndTime &startT,
                                             const Types::Core::DateAndTime &stopT, const bool &filterIncrease,
                                             const bool &filterDecrease) {
-  double val = m_dblLog->nthValue(index);
+  double val = m_logValues[index];
 
   // Identify by time and value
   bool isgood = (val >= minvalue && val < maxvalue) && (currT >= startT && currT < stopT);
 
   // Consider direction: not both (i.e., not increase or not decrease)
   if (isgood && (!filterIncrease || !filterDecrease)) {
-    int numlogentries = m_dblLog->size();
+    auto numlogentries = static_cast<int>(m_logValues.size());
     double diff;
     if (index < numlogentries - 1) {
       // For a non-last log entry
-      diff = m_dblLog->nthValue(index + 1) - val;
+      diff = m_logValues[index + 1] - val;
     } else {
       // Last log entry: follow the last direction
-      diff = val - m_dblLog->nthValue(index - 1);
+      diff = index > 0 ? val - m_logValues[index - 1] : 0.;
     }
 
     if (diff > 0 && filterIncrease)
@@ -878,14 +907,14 @@ bool GenerateEventsFilter::identifyLogEntry(const int &index, const Types::Core:
  * @param startTime :: Start time.
  * @param stopTime :: Stop time.
  */
-void GenerateEventsFilter::makeMultipleFiltersByValues(map<size_t, int> indexwsindexmap,
+void GenerateEventsFilter::makeMultipleFiltersByValues(const map<size_t, int> &indexwsindexmap,
                                                        const vector<double> &logvalueranges, bool centre,
                                                        bool filterIncrease, bool filterDecrease, DateAndTime startTime,
                                                        DateAndTime stopTime) {
   g_log.notice("Starting method 'makeMultipleFiltersByValues'. ");
 
   // Return if the log is empty.
-  int logsize = m_dblLog->size();
+  auto logsize = static_cast<int>(m_logValues.size());
   if (logsize == 0) {
     g_log.warning() << "There is no entry in this property " << m_dblLog->name() << '\n';
     return;
@@ -898,18 +927,10 @@ void GenerateEventsFilter::makeMultipleFiltersByValues(map<size_t, int> indexwsi
   }
   time_duration tol = DateAndTime::durationFromSeconds(timetolerance);
 
-  // Determine the number of threads to use
-  // int numThreads = 1;
-  vector<DateAndTime> tempvectimes;
-  // tempvectimes.reserve(m_dblLog->size());
-  vector<int> tempvecgroup;
-  // tempvecgroup.reserve(m_dblLog->size());
-  m_vecSplitterTimeSet.emplace_back(tempvectimes);
-  m_vecGroupIndexSet.emplace_back(tempvecgroup);
   int istart = 0;
   auto iend = static_cast<int>(logsize - 1);
 
-  makeMultipleFiltersByValuesPartialLog(istart, iend, m_vecSplitterTime, m_vecSplitterGroup, std::move(indexwsindexmap),
+  makeMultipleFiltersByValuesPartialLog(istart, iend, m_vecSplitterTime, m_vecSplitterGroup, indexwsindexmap,
                                         logvalueranges, tol, filterIncrease, filterDecrease, startTime, stopTime);
 
   progress(1.0);
@@ -937,7 +958,7 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
                                                                bool filterIncrease, bool filterDecrease,
                                                                DateAndTime startTime, DateAndTime stopTime) {
   // Return if the log is empty.
-  int logsize = m_dblLog->size();
+  auto logsize = static_cast<int>(m_logValues.size());
   if (logsize == 0) {
     g_log.warning() << "There is no entry in this property " << m_dblLog->name() << '\n';
     return;
@@ -956,7 +977,7 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
     numThreads = static_cast<int>(PARALLEL_GET_MAX_THREADS);
 
   // Limit the number of threads.
-  numThreads = std::min(numThreads, logsize / 8);
+  numThreads = std::max(1, std::min(numThreads, logsize / 8));
 
   // Determine the istart and iend
   // For split, log should be [0, n], [n, 2n], [2n, 3n], ... as to look into n
@@ -989,19 +1010,10 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
     g_log.information(dbss.str());
   }
 
-  // Create partial vectors
-  m_vecSplitterTimeSet.clear();
-  m_vecGroupIndexSet.clear();
-  for (int i = 0; i < numThreads; ++i) {
-    vector<DateAndTime> tempvectimes;
-    tempvectimes.reserve(m_dblLog->size());
-    vector<int> tempvecgroup;
-    tempvecgroup.reserve(m_dblLog->size());
-    m_vecSplitterTimeSet.emplace_back(tempvectimes);
-    m_vecGroupIndexSet.emplace_back(tempvecgroup);
-  }
-
-  // Create event filters/splitters in parallel
+  // Create event filters/splitters in parallel, each thread with its own
+  // vectors of splitters
+  vector<vector<DateAndTime>> vecSplitterTimeSet(numThreads);
+  vector<vector<int>> vecGroupIndexSet(numThreads);
   // cppcheck-suppress syntaxError
     PRAGMA_OMP(parallel for schedule(dynamic, 1) )
     for (int i = 0; i < numThreads; ++i) {
@@ -1010,36 +1022,36 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
       int istart = vecStart[i];
       int iend = vecEnd[i];
 
-      makeMultipleFiltersByValuesPartialLog(istart, iend, m_vecSplitterTimeSet[i], m_vecGroupIndexSet[i],
-                                            indexwsindexmap, logvalueranges, tol, filterIncrease, filterDecrease,
-                                            startTime, stopTime);
+      makeMultipleFiltersByValuesPartialLog(istart, iend, vecSplitterTimeSet[i], vecGroupIndexSet[i], indexwsindexmap,
+                                            logvalueranges, tol, filterIncrease, filterDecrease, startTime, stopTime);
       PARALLEL_END_INTERUPT_REGION
     }
     PARALLEL_CHECK_INTERUPT_REGION
 
     // Concatenate splitters on different threads together
     for (int i = 1; i < numThreads; ++i) {
-      if (m_vecSplitterTimeSet[i - 1].back() == m_vecSplitterTimeSet[i].front()) {
+      if (vecSplitterTimeSet[i - 1].back() == vecSplitterTimeSet[i].front()) {
         // T_(i).back() = T_(i+1).front()
-        if (m_vecGroupIndexSet[i - 1].back() == m_vecGroupIndexSet[i].front()) {
+        if (vecGroupIndexSet[i - 1].back() == vecGroupIndexSet[i].front()) {
           // G_(i).back() = G_(i+1).front(), combine these adjacent 2 splitters
           // Rule out impossible situation
-          if (m_vecGroupIndexSet[i - 1].back() == -1) {
+          if (vecGroupIndexSet[i - 1].back() == -1) {
             // Throw with detailed error message
             stringstream errss;
             errss << "Previous vector of group index set (" << (i - 1) << ") is equal to -1. "
                   << "It is not likely to happen!  Size of previous vector of "
                      "group is "
-                  << m_vecGroupIndexSet[i - 1].size() << ". \nSuggest to use sequential mode. ";
+                  << vecGroupIndexSet[i - 1].size() << ". \nSuggest to use sequential mode. ";
             throw runtime_error(errss.str());
           }
 
-          // Pop back last element
-          m_vecGroupIndexSet[i - 1].pop_back();
-          DateAndTime newt0 = m_vecSplitterTimeSet[i - 1].front();
-          m_vecSplitterTimeSet[i - 1].pop_back();
-          DateAndTime origtime = m_vecSplitterTimeSet[i][0];
-          m_vecSplitterTimeSet[i][0] = newt0;
+          // Pop back last element: the splitter starts at the start of the
+          // last one of the previous thread
+          vecGroupIndexSet[i - 1].pop_back();
+          vecSplitterTimeSet[i - 1].pop_back();
+          DateAndTime newt0 = vecSplitterTimeSet[i - 1].back();
+          DateAndTime origtime = vecSplitterTimeSet[i][0];
+          vecSplitterTimeSet[i][0] = newt0;
           g_log.debug() << "Splitter at the end of thread " << i << " is extended from " << origtime << " to " << newt0
                         << "\n";
         } else {
@@ -1049,23 +1061,23 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
         }
       } else {
         // T_(i).back() != T_(i+1).front(): need to fill the gap in time
-        int lastindex = m_vecGroupIndexSet[i - 1].back();
-        int firstindex = m_vecGroupIndexSet[i].front();
+        int lastindex = vecGroupIndexSet[i - 1].back();
+        int firstindex = vecGroupIndexSet[i].front();
 
         if (lastindex != -1 && firstindex != -1) {
           // T_stop < T_start, I_stop != -1, I_start != 1. : Insert a minus-one
           // entry to make it complete
-          m_vecGroupIndexSet[i - 1].emplace_back(-1);
-          m_vecSplitterTimeSet[i - 1].emplace_back(m_vecSplitterTimeSet[i].front());
-        } else if (lastindex == -1 && m_vecGroupIndexSet[i - 1].size() == 1) {
+          vecGroupIndexSet[i - 1].emplace_back(-1);
+          vecSplitterTimeSet[i - 1].emplace_back(vecSplitterTimeSet[i].front());
+        } else if (lastindex == -1 && vecGroupIndexSet[i - 1].size() == 1) {
           // Empty splitter of the thread. Extend this to next
-          m_vecSplitterTimeSet[i - 1].back() = m_vecSplitterTimeSet[i].front();
+          vecSplitterTimeSet[i - 1].back() = vecSplitterTimeSet[i].front();
           g_log.debug() << "Thread = " << i << ", change ending time of " << i - 1 << " to "
-                        << m_vecSplitterTimeSet[i].front() << "\n";
-        } else if (firstindex == -1 && m_vecGroupIndexSet[i].size() == 1) {
+                        << vecSplitterTimeSet[i].front() << "\n";
+        } else if (firstindex == -1 && vecGroupIndexSet[i].size() == 1) {
           // Empty splitter of the thread. Extend last one to this
-          m_vecSplitterTimeSet[i].front() = m_vecSplitterTimeSet[i - 1].back();
-          g_log.debug() << "Thread = " << i << ", change starting time to " << m_vecSplitterTimeSet[i].front() << "\n";
+          vecSplitterTimeSet[i].front() = vecSplitterTimeSet[i - 1].back();
+          g_log.debug() << "Thread = " << i << ", change starting time to " << vecSplitterTimeSet[i].front() << "\n";
         } else {
           throw runtime_error("It is not possible to have start or end of "
                               "filter to be minus-one index. ");
@@ -1073,6 +1085,24 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
       }
     }
 
+    // Write the splitters of all threads into the vectors of splitters: the
+    // stop time of each thread's last splitter is the start of the next one's
+    size_t numSplitters = 0;
+    for (const auto &groups : vecGroupIndexSet)
+      numSplitters += groups.size();
+    m_vecSplitterTime.clear();
+    m_vecSplitterGroup.clear();
+    m_vecSplitterTime.reserve(numSplitters + 1);
+    m_vecSplitterGroup.reserve(numSplitters);
+    for (int i = 0; i < numThreads; ++i) {
+      const auto &times = vecSplitterTimeSet[i];
+      const auto &groups = vecGroupIndexSet[i];
+      m_vecSplitterTime.insert(m_vecSplitterTime.end(), times.cbegin(),
+                               times.cbegin() + static_cast<std::ptrdiff_t>(groups.size()));
+      m_vecSplitterGroup.insert(m_vecSplitterGroup.end(), groups.cbegin(), groups.cend());
+    }
+    m_vecSplitterTime.emplace_back(vecSplitterTimeSet.back().back());
+
     progress(1.0);
 }
 
@@ -1081,10 +1111,10 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesParallel(const map<size_t,
  */
 void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
     int istart, int iend, std::vector<Types::Core::DateAndTime> &vecSplitTime, std::vector<int> &vecSplitGroup,
-    map<size_t, int> indexwsindexmap, const vector<double> &logvalueranges, const time_duration &tol,
+    const map<size_t, int> &indexwsindexmap, const vector<double> &logvalueranges, const time_duration &tol,
     bool filterIncrease, bool filterDecrease, DateAndTime startTime, DateAndTime stopTime) {
   // Check
-  int logsize = m_dblLog->size();
+  auto logsize = static_cast<int>(m_logValues.size());
   if (istart < 0 || iend >= logsize)
     throw runtime_error("Input index of makeMultipleFiltersByValuesPartialLog "
                         "is out of boundary. ");
@@ -1101,12 +1131,18 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
   // size_t progslot = 0;
 
   g_log.information() << "Log time coverage (index: " << istart << ", " << iend << ") from "
-                      << m_dblLog->nthTime(istart) << ", " << m_dblLog->nthTime(iend) << "\n";
+                      << m_logTimes[istart] << ", " << m_logTimes[iend] << "\n";
 
   DateAndTime laststoptime(0);
-  int lastlogindex = m_dblLog->size() - 1;
 
-  int prevDirection = determineChangingDirection(istart);
+  // Throw if the log is flat
+  determineChangingDirection(istart);
+  // The group of a value, 0 for values out of the ranges
+  const auto groupOf = [&indexwsindexmap](const size_t range) {
+    const auto group = indexwsindexmap.find(range);
+    return group == indexwsindexmap.cend() ? 0 : group->second;
+  };
+  const bool debug = g_log.is(Logger::Priority::PRIO_DEBUG);
 
   for (int i = istart; i <= iend; i++) {
     // Initialize status flags and new entry
@@ -1114,8 +1150,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
     bool createsplitter = false;
 
     lastTime = currTime;
-    currTime = m_dblLog->nthTime(i);
-    double currValue = m_dblLog->nthValue(i);
+    currTime = m_logTimes[i];
+    double currValue = m_logValues[i];
 
     // Filter out by time and direction (optional)
     if (currTime < startTime) {
@@ -1134,22 +1170,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
     // Check log within given time range
     bool newsplitter = false; // Flag to start a new split in this loop
 
-    // Determine direction
-    int direction = 0;
-    if (i < lastlogindex) {
-      // Not the last log entry
-      double diff = m_dblLog->nthValue(i + 1) - m_dblLog->nthValue(i);
-      if (diff > 0)
-        direction = 1;
-      else if (diff < 0)
-        direction = -1;
-      else
-        direction = prevDirection;
-    } else {
-      // Last log entry: use the previous direction
-      direction = prevDirection;
-    }
-    prevDirection = direction;
+    // Direction of the last change of the value
+    const int direction = m_logDirections[i];
 
     // Examine log value for filter
     // Determine whether direction is fine
@@ -1180,11 +1202,11 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
         valueWithinMinMax = false;
       }
 
-      if (g_log.is(Logger::Priority::PRIO_DEBUG)) {
+      if (debug) {
         stringstream dbss;
         dbss << "[DBx257] Examine Log Index " << i << ", Value = " << currValue << ", Data Range Index = " << index
              << "; "
-             << "Group Index = " << indexwsindexmap[index / 2]
+             << "Group Index = " << groupOf(index / 2)
              << " (log value range vector size = " << logvalueranges.size() << "): ";
         if (index == 0)
           dbss << logvalueranges[index] << ", " << logvalueranges[index + 1];
@@ -1198,7 +1220,7 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
       if (valueWithinMinMax) {
         if (index % 2 == 0) {
           // [Situation] Falls in the interval
-          currindex = indexwsindexmap[index / 2];
+          currindex = groupOf(index / 2);
 
           if (currindex != lastindex && start.totalNanoseconds() == 0) {
             // Group index is different from last and start is not set up: new
@@ -1225,7 +1247,7 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
           } else {
             // An impossible situation
             std::stringstream errmsg;
-            double lastvalue = m_dblLog->nthValue(i - 1);
+            double lastvalue = m_logValues[i > 0 ? i - 1 : 0];
             errmsg << "Impossible to have currindex == lastindex == " << currindex
                    << ", while start is not init.  Log Index = " << i << "\t value = " << currValue
                    << "\t, Index = " << index << " in range " << logvalueranges[index] << ", "
@@ -1294,8 +1316,8 @@ void GenerateEventsFilter::makeMultipleFiltersByValuesPartialLog(
   // time
   // To make it non-empty
   if (vecSplitTime.empty()) {
-    start = m_dblLog->nthTime(istart);
-    stop = m_dblLog->nthTime(iend);
+    start = m_logTimes[istart];
+    stop = m_logTimes[iend];
     lastindex = -1;
     makeSplitterInVector(vecSplitTime, vecSplitGroup, start, stop, lastindex, tol_ns, laststoptime);
   }
@@ -1497,36 +1519,8 @@ size_t GenerateEventsFilter::searchValue(const std::vector<double> &sorteddata,
 /** Determine starting value changing direction
  */
 int GenerateEventsFilter::determineChangingDirection(int startindex) {
-  int direction = 0;
-
-  // Search to earlier entries
-  int index = startindex;
-  while (direction == 0 && index > 0) {
-    double diff = m_dblLog->nthValue(index) - m_dblLog->nthValue(index - 1);
-    if (diff > 0)
-      direction = 1;
-    else if (diff < 0)
-      direction = -1;
-
-    --index;
-  }
-
-  if (direction != 0)
-    return direction;
-
-  // Search to later entries
-  index = startindex;
-  int maxindex = m_dblLog->size() - 1;
-  while (direction == 0 && index < maxindex) {
-    double diff = m_dblLog->nthValue(index + 1) - m_dblLog->nthValue(index);
-    if (diff > 0)
-      direction = 1;
-    else if (diff < 0)
-      direction = -1;
-
-    ++index;
-  }
-
+  // The direction of the last change before the entry, or of the first one
+  const int direction = m_logDirections.empty() ? 0 : m_logDirections[std::max(startindex, 1) - 1];
   if (direction == 0)
     throw runtime_error("Sample log is flat.  Use option 'Both' instead! ");
 
@@ -1645,41 +1639,6 @@ void GenerateEventsFilter::generateSplittersInMatrixWorkspace() {
   }
 }
 
-//----------------------------------------------------------------------------------------------
-/** Generate matrix workspace for splitters from vector of splitter time and
- * group
- * in the parallel-version
- */
-void GenerateEventsFilter::generateSplittersInMatrixWorkspaceParallel() {
-  // Determine size of output matrix workspace
-  size_t numtimes = 0;
-  size_t numThreads = m_vecSplitterTimeSet.size();
-  for (size_t i = 0; i < numThreads; ++i) {
-    numtimes += m_vecGroupIndexSet[i].size();
-    g_log.debug() << "[DB] Thread " << i << " have " << m_vecGroupIndexSet[i].size() << " splitter "
-                  << "\n";
-  }
-  ++numtimes;
-
-  size_t sizex = numtimes;
-
-  m_filterWS = create<Workspace2D>(1, BinEdges(sizex));
-  auto &dataX = m_filterWS->mutableX(0);
-  auto &dataY = m_filterWS->mutableY(0);
-
-  size_t index = 0;
-  for (size_t i = 0; i < numThreads; ++i) {
-    for (size_t j = 0; j < m_vecGroupIndexSet[i].size(); ++j) {
-      // x is in the unit as second
-      dataX[index] = static_cast<double>(m_vecSplitterTimeSet[i][j].totalNanoseconds()) * 1.E-9;
-      dataY[index] = static_cast<double>(m_vecGroupIndexSet[i][j]);
-      ++index;
-    }
-  }
-  // x is in the unit as second
-  dataX[index] = static_cast<double>(m_vecSplitterTimeSet.back().back().totalNanoseconds()) * 1.E-9;
-}
-
 //----------------------------------------------------------------------------------------------
 /** Convert splitters vector to splitters and add to SplittersWorskpace
  */
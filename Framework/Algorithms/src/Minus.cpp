@@ -19,21 +19,33 @@ const std::string Minus::alias() const { return "Subtract"; }
 
 void Minus::performBinaryOperation(const HistogramData::Histogram &lhs, const HistogramData::Histogram &rhs,
                                    HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
-  std::transform(lhs.y().begin(), lhs.y().end(), rhs.y().begin(), YOut.begin(), std::minus<>());
-  std::transform(lhs.e().begin(), lhs.e().end(), rhs.e().begin(), EOut.begin(), VectorHelper::SumGaussError<double>());
+  performArrayOperation(lhs.y(), lhs.e(), rhs.y(), rhs.e(), YOut, EOut);
 }
 
 void Minus::performBinaryOperation(const HistogramData::Histogram &lhs, const double rhsY, const double rhsE,
                                    HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
+  performArrayOperation(lhs.y(), lhs.e(), rhsY, rhsE, YOut, EOut);
+}
+
+void Minus::performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                  const HistogramData::HistogramY &rhsY, const HistogramData::HistogramE &rhsE,
+                                  HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
+  std::transform(lhsY.begin(), lhsY.end(), rhsY.begin(), YOut.begin(), std::minus<>());
+  std::transform(lhsE.begin(), lhsE.end(), rhsE.begin(), EOut.begin(), VectorHelper::SumGaussError<double>());
+}
+
+void Minus::performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                  const double rhsY, const double rhsE, HistogramData::HistogramY &YOut,
+                                  HistogramData::HistogramE &EOut) {
   using std::placeholders::_1;
-  std::transform(lhs.y().begin(), lhs.y().end(), YOut.begin(), [rhsY](double l) { return l - rhsY; });
+  std::transform(lhsY.begin(), lhsY.end(), YOut.begin(), [rhsY](double l) { return l - rhsY; });
   // Only do E if non-zero, otherwise just copy
   if (rhsE != 0) {
     double rhsE2 = rhsE * rhsE;
-    std::transform(lhs.e().begin(), lhs.e().end(), EOut.begin(),
+    std::transform(lhsE.begin(), lhsE.end(), EOut.begin(),
                    [rhsE2](double l) { return std::sqrt(l * l + rhsE2); });
   } else
-    EOut = lhs.e();
+    EOut = lhsE;
 }
 
 // ===================================== EVENT LIST BINARY OPERATIONS
@@ -18,39 +18,41 @@ DECLARE_ALGORITHM(Multiply)
 
 void Multiply::performBinaryOperation(const HistogramData::Histogram &lhs, const HistogramData::Histogram &rhs,
                                       HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
-  const size_t bins = lhs.e().size();
-  for (size_t j = 0; j < bins; ++j) {
-    // Get references to the input Y's
-    const double leftY = lhs.y()[j];
-    const double rightY = rhs.y()[j];
-
-    // error multiplying two uncorrelated numbers, re-arrange so that you don't
-    // get infinity if leftY or rightY == 0
-    // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
-    // (Sc)2 = (Sa c/a)2 + (Sb c/b)2
-    //       = (Sa b)2 + (Sb a)2
-    EOut[j] = sqrt(pow(lhs.e()[j] * rightY, 2) + pow(rhs.e()[j] * leftY, 2));
-
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY * rightY;
-  }
+  performArrayOperation(lhs.y(), lhs.e(), rhs.y(), rhs.e(), YOut, EOut);
 }
 
 void Multiply::performBinaryOperation(const HistogramData::Histogram &lhs, const double rhsY, const double rhsE,
                                       HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
-  const size_t bins = lhs.e().size();
-  for (size_t j = 0; j < bins; ++j) {
-    // Get reference to input Y
-    const double leftY = lhs.y()[j];
+  performArrayOperation(lhs.y(), lhs.e(), rhsY, rhsE, YOut, EOut);
+}
 
-    // see comment in the function above for the error formula
-    EOut[j] = sqrt(pow(lhs.e()[j] * rhsY, 2) + pow(rhsE * leftY, 2));
+void Multiply::performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                     const HistogramData::HistogramY &rhsY, const HistogramData::HistogramE &rhsE,
+                                     HistogramData::HistogramY &YOut, HistogramData::HistogramE &EOut) {
+  const size_t bins = lhsE.size();
+  // error multiplying two uncorrelated numbers, re-arrange so that you don't
+  // get infinity if leftY or rightY == 0
+  // (Sa/a)2 + (Sb/b)2 = (Sc/c)2
+  // (Sc)2 = (Sa c/a)2 + (Sb c/b)2
+  //       = (Sa b)2 + (Sb a)2
+  // The errors are calculated first in case one of the input workspaces is
+  // also the output, and separately from the values so that the loop over
+  // the values can be vectorised
+  for (size_t j = 0; j < bins; ++j)
+    EOut[j] = sqrt(pow(lhsE[j] * rhsY[j], 2) + pow(rhsE[j] * lhsY[j], 2));
+  for (size_t j = 0; j < bins; ++j)
+    YOut[j] = lhsY[j] * rhsY[j];
+}
 
-    // Copy the result last in case one of the input workspaces is also any
-    // output
-    YOut[j] = leftY * rhsY;
-  }
+void Multiply::performArrayOperation(const HistogramData::HistogramY &lhsY, const HistogramData::HistogramE &lhsE,
+                                     const double rhsY, const double rhsE, HistogramData::HistogramY &YOut,
+                                     HistogramData::HistogramE &EOut) {
+  const size_t bins = lhsE.size();
+  // see comment in the function above for the error formula
+  for (size_t j = 0; j < bins; ++j)
+    EOut[j] = sqrt(pow(lhsE[j] * rhsY, 2) + pow(rhsE * lhsY[j], 2));
+  for (size_t j = 0; j < bins; ++j)
+    YOut[j] = lhsY[j] * rhsY;
 }
 
 void Multiply::setOutputUnits(const API::MatrixWorkspace_const_sptr lhs, const API::MatrixWorkspace_const_sptr rhs,
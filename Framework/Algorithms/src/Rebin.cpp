@@ -18,6 +18,8 @@
 #include "MantidKernel/RebinParamsValidator.h"
 #include "MantidKernel/VectorHelper.h"
 
+#include <map>
+
 namespace Mantid {
 namespace Algorithms {
 
@@ -34,6 +36,7 @@ using HistogramData::BinEdges;
 using HistogramData::Frequencies;
 using HistogramData::FrequencyStandardDeviations;
 using HistogramData::Histogram;
+using HistogramData::Rebinner;
 using HistogramData::Exception::InvalidBinEdgesError;
 
 //---------------------------------------------------------------------------------------------
@@ -74,6 +77,42 @@ std::vector<double> Rebin::rebinParamsFromInput(const std::vector<double> &inPar
   return rbParams;
 }
 
+/**
+ * Create the Rebinners of the spectra whose old and new bin edges are shared
+ * with other spectra, so the overlaps of their bins are worked out once for
+ * all of them rather than once per spectrum.
+ * @param inputWS The workspace to be rebinned
+ * @param newBinEdges Gives the new bin edges of a spectrum from its index
+ * @returns The Rebinner of each spectrum, or nullptr for spectra whose bin
+ * edges are not shared or are invalid, which should be rebinned on their own
+ */
+std::vector<std::shared_ptr<const Rebinner>>
+Rebin::sharedRebinners(const API::MatrixWorkspace &inputWS, const std::function<BinEdges(size_t)> &newBinEdges) {
+  const size_t numberOfSpectra = inputWS.getNumberHistograms();
+  std::map<std::pair<const void *, const void *>, std::vector<size_t>> spectraByEdges;
+  for (size_t i = 0; i < numberOfSpectra; ++i) {
+    const auto edges = newBinEdges(i);
+    spectraByEdges[{inputWS.sharedX(i).get(), edges.cowData().get()}].emplace_back(i);
+  }
+
+  std::vector<std::shared_ptr<const Rebinner>> rebinners(numberOfSpectra);
+  for (const auto &spectra : spectraByEdges) {
+    if (spectra.second.size() < 2)
+      continue;
+    const auto first = spectra.second.front();
+    std::shared_ptr<const Rebinner> rebinner;
+    try {
+      rebinner = std::make_shared<const Rebinner>(inputWS.binEdges(first), newBinEdges(first));
+    } catch (InvalidBinEdgesError &) {
+      // Rebinning each spectrum reports the error, or ignores it
+      continue;
+    }
+    for (const auto i : spectra.second)
+      rebinners[i] = rebinner;
+  }
+  return rebinners;
+}
+
 //---------------------------------------------------------------------------------------------
 // Public methods
 //---------------------------------------------------------------------------------------------
@@ -228,6 +267,7 @@ void Rebin::exec() {
     if (inputWS->axes() > 1)
       outputWS->replaceAxis(1, std::unique_ptr<Axis>(inputWS->getAxis(1)->clone(outputWS.get())));
     bool ignoreBinErrors = getProperty("IgnoreBinErrors");
+    const auto rebinners = sharedRebinners(*inputWS, [&XValues_new](size_t) { return XValues_new; });
 
     Progress prog(this, 0.0, 1.0, histnumber);
     PARALLEL_FOR_IF(Kernel::threadSafe(*inputWS, *outputWS))
@@ -235,7 +275,9 @@ void Rebin::exec() {
       PARALLEL_START_INTERUPT_REGION
 
       try {
-        outputWS->setHistogram(hist, HistogramData::rebin(inputWS->histogram(hist), XValues_new));
+        const auto &rebinner = rebinners[hist];
+        outputWS->setHistogram(hist, rebinner ? rebinner->rebin(inputWS->histogram(hist))
+                                              : HistogramData::rebin(inputWS->histogram(hist), XValues_new));
       } catch (InvalidBinEdgesError &) {
         if (ignoreBinErrors)
           outputWS->setBinEdges(hist, XValues_new);
@@ -7,6 +7,7 @@
 #include "MantidAlgorithms/RebinToWorkspace.h"
 #include "MantidAPI/HistogramValidator.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidAlgorithms/Rebin.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
 #include "MantidDataObjects/WorkspaceCreation.h"
@@ -121,14 +122,20 @@ void RebinToWorkspace::rebin(MatrixWorkspace_sptr &toRebin, MatrixWorkspace_sptr
 
   // everything gets the same bin boundaries as the first spectrum
   const bool matchingX = (toRebin->getNumberHistograms() != toMatch->getNumberHistograms());
+  const auto newBinEdges = [&toMatch, matchingX](size_t i) { return toMatch->binEdges(matchingX ? 0 : i); };
+  std::vector<std::shared_ptr<const HistogramData::Rebinner>> rebinners;
+  if (!m_isEvents)
+    rebinners = Rebin::sharedRebinners(*toRebin, newBinEdges);
 
   // rebin
   PARALLEL_FOR_IF(Kernel::threadSafe(*toMatch, *outputWS))
   for (int i = 0; i < numHist; ++i) {
     PARALLEL_START_INTERUPT_REGION
-    const auto &edges = matchingX ? toMatch->histogram(0).binEdges() : toMatch->histogram(i).binEdges();
+    const auto edges = newBinEdges(i);
     if (m_isEvents) {
       outputWSEvents->getSpectrum(i).setHistogram(edges);
+    } else if (rebinners[i]) {
+      outputWS->setHistogram(i, rebinners[i]->rebin(toRebin->histogram(i)));
     } else {
       outputWS->setHistogram(i, HistogramData::rebin(toRebin->histogram(i), edges));
     }
@@ -0,0 +1,154 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAPI/ITableWorkspace.h"
+#include "MantidAPI/TableRow.h"
+#include "MantidAPI/WorkspaceFactory.h"
+#include "MantidAlgorithms/AlignAndFocusEvents.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidKernel/UnitFactory.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using namespace Mantid::Kernel;
+using Mantid::Algorithms::AlignAndFocusEvents;
+
+class AlignAndFocusEventsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static AlignAndFocusEventsTest *createSuite() { return new AlignAndFocusEventsTest(); }
+  static void destroySuite(AlignAndFocusEventsTest *suite) { delete suite; }
+
+  AlignAndFocusEventsTest() { FrameworkManager::Instance(); }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_init() {
+    AlignAndFocusEvents alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_params_need_a_range() {
+    createInputs();
+    AlignAndFocusEvents alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", INPUT_NAME);
+    alg.setPropertyValue("GroupingWorkspace", GROUPING_NAME);
+    alg.setPropertyValue("Params", "0.1");
+    alg.setPropertyValue("OutputWorkspace", "AlignAndFocusEventsTest_out");
+    TS_ASSERT_THROWS(alg.execute(), const std::runtime_error &)
+  }
+
+  void test_calibration_table() {
+    createInputs();
+    // Events are at 0.5, 1.5, ... 99.5 us, twice each, so with DIFC=10 every
+    // bin of 0.5 Angstrom holds 10 events of each pixel
+    const auto output = runAlgorithm("0,0.5,10", createCalibrationTable(10.));
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 2)
+    TS_ASSERT_EQUALS(output->getAxis(0)->unit()->unitID(), "dSpacing")
+    TS_ASSERT_EQUALS(output->blocksize(), 20)
+    for (size_t i = 0; i < output->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(output->getSpectrum(i).getSpectrumNo(), static_cast<int>(i + 1))
+      TS_ASSERT_EQUALS(output->getSpectrum(i).getDetectorIDs().size(), 4)
+      for (size_t bin = 0; bin < output->blocksize(); ++bin) {
+        TS_ASSERT_EQUALS(output->y(i)[bin], 40.)
+        TS_ASSERT_DELTA(output->e(i)[bin], std::sqrt(40.), 1e-12)
+      }
+    }
+  }
+
+  void test_weighted_events() {
+    createInputs();
+    auto inputWS = AnalysisDataService::Instance().retrieveWS<EventWorkspace>(INPUT_NAME);
+    for (size_t i = 0; i < inputWS->getNumberHistograms(); ++i)
+      inputWS->getSpectrum(i).multiply(2.0, 0.0);
+    const auto output = runAlgorithm("0,0.5,10", createCalibrationTable(10.));
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), 2)
+    for (size_t bin = 0; bin < output->blocksize(); ++bin) {
+      TS_ASSERT_EQUALS(output->y(0)[bin], 80.)
+      TS_ASSERT_DELTA(output->e(0)[bin], std::sqrt(160.), 1e-12)
+    }
+  }
+
+  void test_matches_ConvertUnits_DiffractionFocussing_and_Rebin() {
+    createInputs();
+    auto &framework = FrameworkManager::Instance();
+    framework.exec("ConvertUnits", 6, "InputWorkspace", INPUT_NAME.c_str(), "OutputWorkspace", "aligned", "Target",
+                   "dSpacing");
+    framework.exec("DiffractionFocussing", 6, "InputWorkspace", "aligned", "OutputWorkspace", "focused",
+                   "GroupingWorkspace", GROUPING_NAME.c_str());
+    auto focused = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("focused");
+    const std::string params = std::to_string(focused->getTofMin() * 0.9) + ",-0.002," +
+                               std::to_string(focused->getTofMax() * 1.1);
+    framework.exec("Rebin", 8, "InputWorkspace", "focused", "OutputWorkspace", "expected", "Params", params.c_str(),
+                   "PreserveEvents", "0");
+    auto expected = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("expected");
+
+    const auto output = runAlgorithm(params);
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), expected->getNumberHistograms())
+    for (size_t i = 0; i < output->getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(output->getSpectrum(i).getSpectrumNo(), expected->getSpectrum(i).getSpectrumNo())
+      TS_ASSERT_EQUALS(output->x(i).rawData(), expected->x(i).rawData())
+      TS_ASSERT_EQUALS(output->y(i).rawData(), expected->y(i).rawData())
+      TS_ASSERT_DELTA(output->e(i).sum(), expected->e(i).sum(), 1e-9)
+    }
+  }
+
+private:
+  const std::string INPUT_NAME = "AlignAndFocusEventsTest_input";
+  const std::string GROUPING_NAME = "AlignAndFocusEventsTest_grouping";
+
+  /// Three banks of 2x2 pixels in TOF, with the last two banks in groups 1 and 2
+  void createInputs() {
+    auto inputWS = WorkspaceCreationHelper::createEventWorkspaceWithFullInstrument(3, 2);
+    inputWS->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+    AnalysisDataService::Instance().addOrReplace(INPUT_NAME, inputWS);
+    FrameworkManager::Instance().exec("CreateGroupingWorkspace", 6, "InputWorkspace", INPUT_NAME.c_str(),
+                                      "GroupNames", "bank2,bank3", "OutputWorkspace", GROUPING_NAME.c_str());
+  }
+
+  ITableWorkspace_sptr createCalibrationTable(const double difc) {
+    auto table = WorkspaceFactory::Instance().createTable();
+    table->addColumn("int", "detid");
+    table->addColumn("double", "difc");
+    table->addColumn("double", "difa");
+    table->addColumn("double", "tzero");
+    const auto inputWS = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>(INPUT_NAME);
+    for (const auto detID : inputWS->getInstrument()->getDetectorIDs(true)) {
+      TableRow row = table->appendRow();
+      row << detID << difc << 0. << 0.;
+    }
+    return table;
+  }
+
+  MatrixWorkspace_sptr runAlgorithm(const std::string &params, const ITableWorkspace_sptr &calibration = nullptr) {
+    AlignAndFocusEvents alg;
+    alg.setChild(true);
+    alg.initialize();
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("InputWorkspace", INPUT_NAME))
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("GroupingWorkspace", GROUPING_NAME))
+    if (calibration)
+      TS_ASSERT_THROWS_NOTHING(alg.setProperty("CalibrationWorkspace", calibration))
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Params", params))
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    TS_ASSERT_THROWS_NOTHING(alg.execute())
+    TS_ASSERT(alg.isExecuted())
+    return alg.getProperty("OutputWorkspace");
+  }
+};
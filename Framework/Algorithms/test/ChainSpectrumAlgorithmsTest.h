@@ -0,0 +1,156 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/FrameworkManager.h"
+#include "MantidAlgorithms/ChainSpectrumAlgorithms.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/Workspace2D.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+using Mantid::Algorithms::ChainSpectrumAlgorithms;
+
+class ChainSpectrumAlgorithmsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static ChainSpectrumAlgorithmsTest *createSuite() { return new ChainSpectrumAlgorithmsTest(); }
+  static void destroySuite(ChainSpectrumAlgorithmsTest *suite) { delete suite; }
+
+  ChainSpectrumAlgorithmsTest() { FrameworkManager::Instance(); }
+
+  void setUp() override {
+    auto &ads = AnalysisDataService::Instance();
+    ads.addOrReplace("input", createWorkspace(1.));
+    ads.addOrReplace("offsets", createWorkspace(0.5));
+    ads.addOrReplace("factor", WorkspaceCreationHelper::createWorkspaceSingleValue(3.));
+  }
+
+  void tearDown() override { AnalysisDataService::Instance().clear(); }
+
+  void test_init() {
+    ChainSpectrumAlgorithms alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_parseChain() {
+    const auto steps = ChainSpectrumAlgorithms::parseChain(
+        R"([{"name": "Power", "version": 1, "properties": {"Exponent": 2}}, {"name": "Logarithm"}])");
+    TS_ASSERT_EQUALS(steps.size(), 2)
+    TS_ASSERT_EQUALS(steps[0].name, "Power")
+    TS_ASSERT_EQUALS(steps[0].version, 1)
+    TS_ASSERT_EQUALS(steps[0].properties["Exponent"].asInt(), 2)
+    TS_ASSERT_EQUALS(steps[1].name, "Logarithm")
+    TS_ASSERT_EQUALS(steps[1].version, -1)
+  }
+
+  void test_blocks_that_do_not_divide_the_spectra_match_running_the_algorithms_in_turn() {
+    const auto output = runChain(3);
+    checkMatchesAlgorithmsInTurn(*output);
+  }
+
+  void test_default_block_size_matches_running_the_algorithms_in_turn() {
+    const auto output = runChain(0);
+    checkMatchesAlgorithmsInTurn(*output);
+  }
+
+  void test_input_is_not_modified() {
+    runChain(4);
+    const auto inputWS = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("input");
+    TS_ASSERT_EQUALS(inputWS->y(5)[1], 7.)
+  }
+
+  void test_algorithms_that_are_not_spectrum_wise_are_rejected() {
+    ChainSpectrumAlgorithms alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", "input");
+    alg.setPropertyValue("Algorithms", R"([{"name": "Power"}, {"name": "Rebin", "properties": {"Params": "1"}}])");
+    const auto errors = alg.validateInputs();
+    TS_ASSERT_EQUALS(errors.count("Algorithms"), 1)
+  }
+
+  void test_invalid_chains_are_rejected() {
+    ChainSpectrumAlgorithms alg;
+    alg.initialize();
+    alg.setPropertyValue("InputWorkspace", "input");
+    for (const auto &chain : {R"({"name": "Power"})", R"([{"name": "Power")", R"([])", R"([{"version": 1}])",
+                              R"([{"name": "Power", "properties": {"NoSuchProperty": 2}}])"}) {
+      alg.setPropertyValue("Algorithms", chain);
+      TS_ASSERT_EQUALS(alg.validateInputs().count("Algorithms"), 1)
+    }
+  }
+
+  void test_event_workspaces_are_rejected() {
+    ChainSpectrumAlgorithms alg;
+    alg.initialize();
+    alg.setProperty<MatrixWorkspace_sptr>("InputWorkspace", WorkspaceCreationHelper::createEventWorkspace());
+    alg.setPropertyValue("Algorithms", R"([{"name": "Power"}])");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("InputWorkspace"), 1)
+  }
+
+  void test_workspaces_without_spectra_are_rejected() {
+    ChainSpectrumAlgorithms alg;
+    alg.initialize();
+    alg.setProperty<MatrixWorkspace_sptr>("InputWorkspace", std::make_shared<Workspace2D>());
+    alg.setPropertyValue("Algorithms", R"([{"name": "Power"}])");
+    TS_ASSERT_EQUALS(alg.validateInputs().count("InputWorkspace"), 1)
+  }
+
+private:
+  const std::string CHAIN = R"([{"name": "Power", "properties": {"Exponent": 2}},
+                                {"name": "Multiply", "properties": {"RHSWorkspace": "factor"}},
+                                {"name": "Plus", "properties": {"RHSWorkspace": "offsets"}}])";
+
+  /// Ten spectra of five bins, with the values of each spectrum different
+  MatrixWorkspace_sptr createWorkspace(const double scale) {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceBinned(10, 5);
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      auto &y = ws->mutableY(i);
+      auto &e = ws->mutableE(i);
+      for (size_t bin = 0; bin < y.size(); ++bin) {
+        y[bin] = scale * static_cast<double>(i + bin + 1);
+        e[bin] = 0.1 * y[bin];
+      }
+    }
+    return ws;
+  }
+
+  MatrixWorkspace_sptr runChain(const int spectraPerBlock) {
+    ChainSpectrumAlgorithms alg;
+    alg.setChild(true);
+    alg.initialize();
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("InputWorkspace", "input"))
+    TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("Algorithms", CHAIN))
+    TS_ASSERT_THROWS_NOTHING(alg.setProperty("SpectraPerBlock", spectraPerBlock))
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    TS_ASSERT_THROWS_NOTHING(alg.execute())
+    TS_ASSERT(alg.isExecuted())
+    return alg.getProperty("OutputWorkspace");
+  }
+
+  void checkMatchesAlgorithmsInTurn(const MatrixWorkspace &output) {
+    auto &framework = FrameworkManager::Instance();
+    framework.exec("Power", 6, "InputWorkspace", "input", "OutputWorkspace", "expected", "Exponent", "2");
+    framework.exec("Multiply", 6, "LHSWorkspace", "expected", "RHSWorkspace", "factor", "OutputWorkspace", "expected");
+    framework.exec("Plus", 6, "LHSWorkspace", "expected", "RHSWorkspace", "offsets", "OutputWorkspace", "expected");
+    const auto expected = AnalysisDataService::Instance().retrieveWS<MatrixWorkspace>("expected");
+
+    TS_ASSERT_EQUALS(output.getNumberHistograms(), expected->getNumberHistograms())
+    for (size_t i = 0; i < output.getNumberHistograms(); ++i) {
+      TS_ASSERT_EQUALS(output.getSpectrum(i).getSpectrumNo(), expected->getSpectrum(i).getSpectrumNo())
+      TS_ASSERT_EQUALS(output.x(i).rawData(), expected->x(i).rawData())
+      TS_ASSERT_EQUALS(output.y(i).rawData(), expected->y(i).rawData())
+      TS_ASSERT_EQUALS(output.e(i).rawData(), expected->e(i).rawData())
+    }
+  }
+};
@@ -853,6 +853,52 @@ public:
     AnalysisDataService::Instance().remove("InfoWS09");
   }
 
+  //----------------------------------------------------------------------------------------------
+  /** Generate the same matrix splitters by log values in serial and in parallel
+   */
+  void test_genLogValuesFilterMatrixSplitterParallelMatchesSerial() {
+    DataObjects::EventWorkspace_sptr eventWS = createEventWorkspace();
+    AnalysisDataService::Instance().addOrReplace("TestEventWS09B", eventWS);
+
+    for (const std::string &interval : {"", "0.2"}) {
+      std::vector<MatrixWorkspace_sptr> outputs;
+      for (const std::string &processing : {"Serial", "Parallel"}) {
+        GenerateEventsFilter alg;
+        alg.initialize();
+        alg.setChild(true);
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("InputWorkspace", "TestEventWS09B"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("OutputWorkspace", "Splitters09B"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("InformationWorkspace", "InfoWS09B"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("FastLog", true));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("LogName", "FastSineLog"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("MinimumLogValue", "-1.0"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("MaximumLogValue", "1.0"));
+        TS_ASSERT_THROWS_NOTHING(alg.setPropertyValue("LogValueInterval", interval));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("LogValueTolerance", 0.05));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("FilterLogValueByChangingDirection", "Both"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("TimeTolerance", 1.0E-8));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("LogBoundary", "Centre"));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("UseParallelProcessing", processing));
+        TS_ASSERT_THROWS_NOTHING(alg.setProperty("NumberOfThreads", 3));
+        TS_ASSERT_THROWS_NOTHING(alg.execute());
+        TS_ASSERT(alg.isExecuted());
+        outputs.emplace_back(alg.getProperty("OutputWorkspace"));
+      }
+      std::vector<Kernel::SplittingInterval> serial, parallel;
+      convertMatrixSplitterToSplitters(outputs[0], serial);
+      convertMatrixSplitterToSplitters(outputs[1], parallel);
+      TS_ASSERT(!serial.empty());
+      TS_ASSERT_EQUALS(parallel.size(), serial.size());
+      for (size_t i = 0; i < std::min(parallel.size(), serial.size()); ++i) {
+        TS_ASSERT_EQUALS(parallel[i].start(), serial[i].start());
+        TS_ASSERT_EQUALS(parallel[i].stop(), serial[i].stop());
+        TS_ASSERT_EQUALS(parallel[i].index(), serial[i].index());
+      }
+    }
+
+    AnalysisDataService::Instance().remove("TestEventWS09B");
+  }
+
   //----------------------------------------------------------------------------------------------
   /** Generate filter by integer log values in increasing in matrix workspace
    * (1) No time tolerance
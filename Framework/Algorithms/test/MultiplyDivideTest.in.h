@@ -137,6 +137,16 @@ public:
         DO_DIVIDE ? 1.0 : 4.0, DO_DIVIDE ? 1.0 : 4.0, false, false, true /*in place*/);
   }
 
+  void test_2D_2D_inPlace_on_rhs()
+  {
+    // The output is the rhs, so its values must only be overwritten once the
+    // errors have been calculated from them
+    MatrixWorkspace_sptr work_in1 = histWS_5x10_bin;
+    MatrixWorkspace_sptr work_in2 = WorkspaceCreationHelper::create2DWorkspace(5,10);
+    performTest(work_in1,work_in2, false /*not event*/,
+        DO_DIVIDE ? 1.0 : 4.0, DO_DIVIDE ? 1.0 : 4.0, false, true /*output is rhs*/, true /*in place*/);
+  }
+
   void test_2D_1D_different_spectrum_number()
   {
     if(DO_DIVIDE)
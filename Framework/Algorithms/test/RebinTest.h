@@ -238,6 +238,25 @@ public:
     AnalysisDataService::Instance().remove("test_out");
   }
 
+  void test_sharedRebinners_are_only_created_for_shared_bin_edges() {
+    auto ws = WorkspaceCreationHelper::create2DWorkspaceBinned(4, 10);
+    // The last spectrum gets a copy of the bin edges of its own
+    ws->setBinEdges(3, BinEdges(ws->x(3).rawData()));
+    const BinEdges newEdges(5, HistogramData::LinearGenerator(0., 2.));
+
+    const auto rebinners = Rebin::sharedRebinners(*ws, [&newEdges](size_t) { return newEdges; });
+
+    TS_ASSERT_EQUALS(rebinners.size(), 4);
+    TS_ASSERT(rebinners[0]);
+    TS_ASSERT_EQUALS(rebinners[1], rebinners[0]);
+    TS_ASSERT_EQUALS(rebinners[2], rebinners[0]);
+    TS_ASSERT(!rebinners[3]);
+    const auto shared = rebinners[0]->rebin(ws->histogram(0));
+    const auto single = HistogramData::rebin(ws->histogram(3), newEdges);
+    TS_ASSERT_EQUALS(shared.y(), single.y());
+    TS_ASSERT_EQUALS(shared.e(), single.e());
+  }
+
   void do_test_EventWorkspace(EventType eventType, bool inPlace, bool PreserveEvents, bool expectOutputEvent) {
     // Two events per bin
     EventWorkspace_sptr test_in = WorkspaceCreationHelper::createEventWorkspace2(50, 100);
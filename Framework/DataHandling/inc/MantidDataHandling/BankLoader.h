@@ -8,36 +8,44 @@
 
 #include "MantidAPI/Progress.h"
 #include "MantidDataHandling/DllConfig.h"
-#include "MantidKernel/Task.h"
-#include "MantidKernel/ThreadScheduler.h"
 
+#include <memory>
+#include <mutex>
 #include <nexus/NeXusFile.hpp>
+#include <string>
+#include <vector>
 
 class BankPulseTimes;
 
 namespace Mantid {
 namespace DataHandling {
 class DefaultEventLoader;
+class EventProcessingQueue;
 
-/** This task does the disk IO from loading the NXS file, and so will be on a
-  disk IO mutex
+/** This does the disk IO from loading the NXS file. It is run directly by the
+  single thread reading the file, one bank after the other, rather than
+  scheduled, and hands the events it reads to a ProcessBankData task on an
+  EventProcessingQueue. Banks with more than DefaultEventLoader::eventsPerSlice
+  events are read, and handed on, in slices of that size.
 */
-class MANTID_DATAHANDLING_DLL LoadBankFromDiskTask : public Kernel::Task {
+class MANTID_DATAHANDLING_DLL BankLoader {
 
 public:
-  LoadBankFromDiskTask(DefaultEventLoader &loader, const std::string &entry_name, const std::string &entry_type,
-                       const std::size_t numEvents, const bool oldNeXusFileNames, API::Progress *prog,
-                       std::shared_ptr<std::mutex> ioMutex, Kernel::ThreadScheduler &scheduler,
-                       const std::vector<int> &framePeriodNumbers);
+  BankLoader(DefaultEventLoader &loader, const std::string &entry_name, const std::string &entry_type,
+             const bool oldNeXusFileNames, API::Progress *prog, EventProcessingQueue &queue,
+             const std::vector<int> &framePeriodNumbers);
 
-  void run() override;
+  void run();
 
 private:
   void loadPulseTimes(::NeXus::File &file);
   std::vector<uint64_t> loadEventIndex(::NeXus::File &file);
   void prepareEventId(::NeXus::File &file, int64_t &start_event, int64_t &stop_event,
                       const std::vector<uint64_t> &event_index);
+  void loadSlice(::NeXus::File &file, const std::shared_ptr<std::vector<uint64_t>> &event_index,
+                 std::shared_ptr<std::mutex> &bankMutex);
   std::unique_ptr<std::vector<uint32_t>> loadEventId(::NeXus::File &file);
+  bool selectWantedEvents(std::vector<uint32_t> &event_id);
   std::unique_ptr<std::vector<float>> loadTof(::NeXus::File &file);
   std::unique_ptr<std::vector<float>> loadEventWeights(::NeXus::File &file);
   int64_t recalculateDataSize(const int64_t &size);
@@ -50,8 +58,8 @@ private:
   std::string entry_type;
   /// Progress reporting
   API::Progress *prog;
-  /// ThreadScheduler running this task
-  Kernel::ThreadScheduler &scheduler;
+  /// Queue running the processing of the events read
+  EventProcessingQueue &m_queue;
   /// Object with the pulse times for this bank
   std::shared_ptr<BankPulseTimes> thisBankPulseTimes;
   /// Did we get an error in loading
@@ -70,7 +78,7 @@ private:
   bool m_have_weight;
   /// Frame period numbers
   const std::vector<int> m_framePeriodNumbers;
-}; // END-DEF-CLASS LoadBankFromDiskTask
+}; // END-DEF-CLASS BankLoader
 
 } // namespace DataHandling
 } // namespace Mantid
@@ -18,14 +18,14 @@ class LoadEventNexus;
 
 /** Helper class for LoadEventNexus that is specific to the current default
   loading code for NXevent_data entries in Nexus files, in particular
-  LoadBankFromDiskTask and ProcessBankData.
+  BankLoader and ProcessBankData.
 */
 class MANTID_DATAHANDLING_DLL DefaultEventLoader {
 public:
   static void load(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights, bool event_id_is_spec,
                    std::vector<std::string> bankNames, const std::vector<int> &periodLog, const std::string &classType,
                    std::vector<std::size_t> bankNumEvents, const bool oldNeXusFileNames, const bool precount,
-                   const int chunk, const int totalChunks);
+                   const int chunk, const int totalChunks, const int readQueueDepth, const int readQueueMemory);
 
   /// Flag for dealing with a simulated file
   bool m_haveWeights;
@@ -33,9 +33,15 @@ public:
   /// True if the event_id is spectrum no not pixel ID
   bool event_id_is_spec;
 
-  /// whether or not to launch multiple ProcessBankData jobs per bank
+  /// whether or not to share the processing of every bank between threads
   bool splitProcessing;
 
+  /// Banks with at least this many events are processed by several threads
+  size_t partitionThreshold{std::numeric_limits<size_t>::max()};
+
+  /// Most events read from a bank at once
+  size_t eventsPerSlice{std::numeric_limits<size_t>::max()};
+
   /// Do we pre-count the # of events in each pixel ID?
   bool precount;
 
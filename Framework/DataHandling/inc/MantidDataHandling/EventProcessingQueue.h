@@ -0,0 +1,80 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/DllConfig.h"
+#include "MantidKernel/Task.h"
+
+#include "tbb/task_group.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** EventProcessingQueue : runs the tasks that process event data while the
+  reader of a file carries on reading.
+
+  A single thread reads the file and pushes a task for each block of events
+  it has read. The tasks are run straight away by the TBB worker threads, so
+  reading overlaps the processing of the data read before. push() blocks the
+  reader while the queue is full: when maxTasks tasks are waiting or running,
+  or when the event arrays they hold add up to more than maxBytes. A task is
+  always accepted when the queue is empty, however large it is.
+
+  Tasks that share a mutex (Task::getMutex) are run one at a time, in the
+  order they were pushed. They wait in the queue rather than in a worker
+  thread, so the other tasks are not held up.
+*/
+class MANTID_DATAHANDLING_DLL EventProcessingQueue {
+public:
+  EventProcessingQueue(const size_t maxTasks, const size_t maxBytes);
+  ~EventProcessingQueue();
+
+  void push(std::shared_ptr<Kernel::Task> task, const size_t bytes);
+  void wait();
+
+  /// Number of tasks waiting or running
+  size_t size() const;
+  /// Bytes held by the tasks waiting or running
+  size_t bytes() const;
+
+private:
+  void runTask(Kernel::Task &task, const size_t bytes);
+  void runSerial(std::mutex *mutex);
+  void release(const size_t bytes, const bool failed);
+
+  /// Most tasks waiting or running at once
+  const size_t m_maxTasks;
+  /// Most bytes held by the tasks waiting or running at once
+  const size_t m_maxBytes;
+  /// Tasks waiting or running
+  size_t m_numTasks{0};
+  /// Bytes held by the tasks waiting or running
+  size_t m_numBytes{0};
+  /// Set when a task has thrown
+  bool m_failed{false};
+  /// Error of a task run while the reader was waiting
+  std::exception_ptr m_error;
+  /// Protects the counters
+  mutable std::mutex m_mutex;
+  /// Signalled when a task finishes
+  std::condition_variable m_finished;
+  /// Tasks sharing each mutex, with their bytes. The first one is running.
+  std::unordered_map<std::mutex *, std::deque<std::pair<std::shared_ptr<Kernel::Task>, size_t>>> m_serialTasks;
+  /// The running tasks
+  tbb::task_group m_tasks;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
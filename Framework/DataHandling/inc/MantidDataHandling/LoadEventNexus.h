@@ -186,6 +186,11 @@ public:
 
   /// Tolerance for CompressEvents; use -1 to mean don't compress.
   double compressTolerance;
+  /// Tolerance on the pulse times, in seconds, when compressing, or EMPTY_DBL()
+  /// to compress all the pulse times together
+  double compressWallClockTolerance;
+  /// Start of the first pulse time bin when compressing
+  Mantid::Types::Core::DateAndTime compressStartTime;
 
   /// Pulse times for ALL banks, taken from proton_charge log.
   std::shared_ptr<BankPulseTimes> m_allBanksPulseTimes;
@@ -0,0 +1,35 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataHandling/DllConfig.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** LoadMappedEvents : map a file written by SaveMappedEvents into memory and
+  create an EventWorkspace whose event lists use the events in place. The
+  events are only copied into memory when a list is modified.
+*/
+class MANTID_DATAHANDLING_DLL LoadMappedEvents : public API::Algorithm {
+public:
+  const std::string name() const override { return "LoadMappedEvents"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling\\Events"; }
+  const std::string summary() const override {
+    return "Create an EventWorkspace using the events of a file written by SaveMappedEvents in place.";
+  }
+  const std::vector<std::string> seeAlso() const override { return {"SaveMappedEvents", "LoadEventNexus"}; }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
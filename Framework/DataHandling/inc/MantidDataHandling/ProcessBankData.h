@@ -22,7 +22,12 @@ namespace DataHandling {
 class DefaultEventLoader;
 
 /** This task does the disk IO from loading the NXS file,
- * and so will be on a disk IO mutex */
+ * and so will be on a disk IO mutex.
+ *
+ * Banks with at least DefaultEventLoader::partitionThreshold events are
+ * filled by several threads at once: the events are split into blocks, the
+ * events each block sends to each event list are counted, and every block
+ * then copies its events into its own slots of the pre-sized lists. */
 class ProcessBankData : public Mantid::Kernel::Task {
 public:
   /** Constructor
@@ -53,7 +58,17 @@ public:
   void run() override;
 
 private:
+  void runSingleThreaded();
+  void runPartitioned();
+  template <typename EventType, typename MakeEvent>
+  void ingestPartitioned(std::vector<std::vector<std::vector<EventType> *>> &eventVectors, const MakeEvent &makeEvent);
+  template <typename Callback> void forEachEvent(const size_t first, const size_t last, const Callback &callback) const;
+  void compressEventLists(const std::vector<detid_t> &usedDetIds);
+  void mergeTofLimits(const double shortestTof, const double longestTof, const size_t badTofs,
+                      const size_t discardedEvents);
   size_t getWorkspaceIndexFromPixelID(const detid_t pixID);
+  void checkEventIndices() const;
+  size_t getFirstPulseIndex(const size_t eventIndex) const;
   size_t getFirstEventIndex(const size_t pulseIndex) const;
   size_t getLastEventIndex(const size_t pulseIndex, const size_t numPulses) const;
 
@@ -0,0 +1,35 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/Algorithm.h"
+#include "MantidDataHandling/DllConfig.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+/** SaveMappedEvents : save the events of an EventWorkspace to a file that
+  LoadMappedEvents maps into memory rather than reading. See
+  DataObjects::MappedEventFile for the format.
+*/
+class MANTID_DATAHANDLING_DLL SaveMappedEvents : public API::Algorithm {
+public:
+  const std::string name() const override { return "SaveMappedEvents"; }
+  int version() const override { return 1; }
+  const std::string category() const override { return "DataHandling\\Events"; }
+  const std::string summary() const override {
+    return "Save the events of an EventWorkspace to a file that LoadMappedEvents can map into memory.";
+  }
+  const std::vector<std::string> seeAlso() const override { return {"LoadMappedEvents"}; }
+
+private:
+  void init() override;
+  void exec() override;
+};
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -4,9 +4,10 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
-#include "MantidDataHandling/LoadBankFromDiskTask.h"
+#include "MantidDataHandling/BankLoader.h"
 #include "MantidDataHandling/BankPulseTimes.h"
 #include "MantidDataHandling/DefaultEventLoader.h"
+#include "MantidDataHandling/EventProcessingQueue.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
 #include "MantidKernel/Unit.h"
@@ -21,23 +22,17 @@ namespace DataHandling {
  * @param loader :: Handle to the main loader
  * @param entry_name :: The pathname of the bank to load
  * @param entry_type :: The classtype of the entry to load
- * @param numEvents :: The number of events in the bank.
  * @param oldNeXusFileNames :: Identify if file is of old variety.
  * @param prog :: an optional Progress object
- * @param ioMutex :: a mutex shared for all Disk I-O tasks
- * @param scheduler :: the ThreadScheduler that runs this task.
+ * @param queue :: the queue that processes the events read
  * @param framePeriodNumbers :: Period numbers corresponding to each frame
  */
-LoadBankFromDiskTask::LoadBankFromDiskTask(DefaultEventLoader &loader, const std::string &entry_name,
-                                           const std::string &entry_type, const std::size_t numEvents,
-                                           const bool oldNeXusFileNames, API::Progress *prog,
-                                           std::shared_ptr<std::mutex> ioMutex, Kernel::ThreadScheduler &scheduler,
-                                           const std::vector<int> &framePeriodNumbers)
-    : m_loader(loader), entry_name(entry_name), entry_type(entry_type), prog(prog), scheduler(scheduler),
+BankLoader::BankLoader(DefaultEventLoader &loader, const std::string &entry_name, const std::string &entry_type,
+                       const bool oldNeXusFileNames, API::Progress *prog, EventProcessingQueue &queue,
+                       const std::vector<int> &framePeriodNumbers)
+    : m_loader(loader), entry_name(entry_name), entry_type(entry_type), prog(prog), m_queue(queue),
       m_loadError(false), m_oldNexusFileNames(oldNeXusFileNames), m_have_weight(false),
       m_framePeriodNumbers(framePeriodNumbers) {
-  setMutex(ioMutex);
-  m_cost = static_cast<double>(numEvents);
   m_min_id = std::numeric_limits<uint32_t>::max();
   m_max_id = 0;
 }
@@ -45,7 +40,7 @@ LoadBankFromDiskTask::LoadBankFromDiskTask(DefaultEventLoader &loader, const std
 /** Load the pulse times, if needed. This sets
  * thisBankPulseTimes to the right pointer.
  * */
-void LoadBankFromDiskTask::loadPulseTimes(::NeXus::File &file) {
+void BankLoader::loadPulseTimes(::NeXus::File &file) {
   try {
     // First, get info about the event_time_zero field in this bank
     file.openData("event_time_zero");
@@ -89,7 +84,7 @@ void LoadBankFromDiskTask::loadPulseTimes(::NeXus::File &file) {
     pulse)
  * @param file :: File handle for the NeXus file
  */
-std::vector<uint64_t> LoadBankFromDiskTask::loadEventIndex(::NeXus::File &file) {
+std::vector<uint64_t> BankLoader::loadEventIndex(::NeXus::File &file) {
   // Get the event_index (a list of size of # of pulses giving the index in
   // the event list for that pulse) as a uint64 vector.
   // The Nexus standard does not specify if this is to be 32-bit or 64-bit
@@ -107,7 +102,8 @@ std::vector<uint64_t> LoadBankFromDiskTask::loadEventIndex(::NeXus::File &file)
   return event_index;
 }
 
-/** Open the event_id field and validate the contents
+/** Work out the range of events to load from the size of the event_id
+ * field and the filters
  *
  * @param file :: File handle for the NeXus file
  * @param start_event :: set to the index of the first event
@@ -115,8 +111,8 @@ std::vector<uint64_t> LoadBankFromDiskTask::loadEventIndex(::NeXus::File &file)
  * @param event_index ::  (a list of size of # of pulses giving the index in
  *the event list for that pulse)
  */
-void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file, int64_t &start_event, int64_t &stop_event,
-                                          const std::vector<uint64_t> &event_index) {
+void BankLoader::prepareEventId(::NeXus::File &file, int64_t &start_event, int64_t &stop_event,
+                                const std::vector<uint64_t> &event_index) {
   // Get the list of pixel ID's
   if (m_oldNexusFileNames)
     file.openData("event_pixel_id");
@@ -131,13 +127,27 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file, int64_t &start_ev
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
   stop_event = dim0;
 
-  // Handle the time filtering by changing the start/end offsets.
-  for (size_t i = 0; i < thisBankPulseTimes->numPulses; i++) {
-    if (thisBankPulseTimes->pulseTimes[i] >= m_loader.alg->filter_time_start) {
-      start_event = static_cast<int64_t>(event_index[i]);
-      break; // stop looking
-    }
+  // Handle the time filtering by changing the start/end offsets, so only the
+  // events of the pulses in the time window are read.
+  const auto *pulseTimes = thisBankPulseTimes->pulseTimes;
+  const size_t numPulses = std::min(thisBankPulseTimes->numPulses, event_index.size());
+  const auto &timeStart = m_loader.alg->filter_time_start;
+  const auto &timeStop = m_loader.alg->filter_time_stop;
+  const auto *pulsesEnd = pulseTimes + numPulses;
+  const Types::Core::DateAndTime *firstPulseIter, *stopPulseIter;
+  if (std::is_sorted(pulseTimes, pulsesEnd)) {
+    firstPulseIter = std::lower_bound(pulseTimes, pulsesEnd, timeStart);
+    stopPulseIter = std::upper_bound(pulseTimes, pulsesEnd, timeStop);
+  } else {
+    firstPulseIter = std::find_if(pulseTimes, pulsesEnd, [&timeStart](const auto &t) { return t >= timeStart; });
+    stopPulseIter = std::find_if(pulseTimes, pulsesEnd, [&timeStop](const auto &t) { return t > timeStop; });
   }
+  const auto firstPulse = static_cast<size_t>(std::distance(pulseTimes, firstPulseIter));
+  const auto stopPulse = static_cast<size_t>(std::distance(pulseTimes, stopPulseIter));
+  if (firstPulse < numPulses)
+    start_event = static_cast<int64_t>(event_index[firstPulse]);
+  else if (numPulses > 0)
+    start_event = dim0; // every pulse is before the time window
 
   if (start_event > dim0) {
     // If the frame indexes are bad then we can't construct the times of the
@@ -150,13 +160,8 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file, int64_t &start_ev
                                            "will not be possible on this data.\n";
     start_event = 0;
     stop_event = dim0;
-  } else {
-    for (size_t i = 0; i < thisBankPulseTimes->numPulses; i++) {
-      if (thisBankPulseTimes->pulseTimes[i] > m_loader.alg->filter_time_stop) {
-        stop_event = event_index[i];
-        break;
-      }
-    }
+  } else if (stopPulse < numPulses) {
+    stop_event = std::max(start_event, static_cast<int64_t>(event_index[stopPulse]));
   }
   // We are loading part - work out the event number range
   if (m_loader.chunk != EMPTY_INT()) {
@@ -170,16 +175,22 @@ void LoadBankFromDiskTask::prepareEventId(::NeXus::File &file, int64_t &start_ev
   // Make sure it is within range
   if (stop_event > dim0)
     stop_event = dim0;
+  file.closeData();
 
   m_loader.alg->getLogger().debug() << entry_name << ": start_event " << start_event << " stop_event " << stop_event
                                     << "\n";
 }
 
-/** Load the event_id field, which has been opened
+/** Load the slice of the event_id field given by m_loadStart and m_loadSize
  * @param file An NeXus::File object opened at the correct group
- * @returns A new array containing the event Ids for this bank
+ * @returns A new array containing the event Ids for this slice
  */
-std::unique_ptr<std::vector<uint32_t>> LoadBankFromDiskTask::loadEventId(::NeXus::File &file) {
+std::unique_ptr<std::vector<uint32_t>> BankLoader::loadEventId(::NeXus::File &file) {
+  if (m_oldNexusFileNames)
+    file.openData("event_pixel_id");
+  else
+    file.openData("event_id");
+
   // This is the data size
   ::NeXus::Info id_info = file.getInfo();
   int64_t dim0 = recalculateDataSize(id_info.dims[0]);
@@ -208,38 +219,51 @@ std::unique_ptr<std::vector<uint32_t>> LoadBankFromDiskTask::loadEventId(::NeXus
       m_loadError = true;
     }
     file.closeData();
-
-    // determine the range of pixel ids
-    m_min_id = *(std::min_element(event_id->data(), event_id->data() + m_loadSize[0]));
-    m_max_id = *(std::max_element(event_id->data(), event_id->data() + m_loadSize[0]));
-
-    if (m_min_id > static_cast<uint32_t>(m_loader.eventid_max)) {
-      // All the detector IDs in the bank are higher than the highest 'known'
-      // (from the IDF)
-      // ID. Setting this will abort the loading of the bank.
-      m_loadError = true;
-    }
-    // fixup the minimum pixel id in the case that it's lower than the lowest
-    // 'known' id. We test this by checking that when we add the offset we
-    // would not get a negative index into the vector. Note that m_min_id is
-    // a uint so we have to be cautious about adding it to an int which may be
-    // negative.
-    if (static_cast<int32_t>(m_min_id) + m_loader.pixelID_to_wi_offset < 0) {
-      m_min_id = static_cast<uint32_t>(abs(m_loader.pixelID_to_wi_offset));
-    }
-    // fixup the maximum pixel id in the case that it's higher than the
-    // highest 'known' id
-    if (m_max_id > static_cast<uint32_t>(m_loader.eventid_max))
-      m_max_id = static_cast<uint32_t>(m_loader.eventid_max);
   }
   return event_id;
 }
 
+/** Narrow the slice to the events between the first and the last one with a
+ * detector ID that is loaded, and work out the range of their IDs. The rest
+ * of the fields are then only read for those events.
+ * @param event_id :: the event IDs of the slice, trimmed to the wanted events
+ * @returns false if none of the events are wanted
+ */
+bool BankLoader::selectWantedEvents(std::vector<uint32_t> &event_id) {
+  // IDs below this would give a negative index into pixelID_to_wi_vector and
+  // IDs above the last 'known' one (from the IDF) are not in the workspace
+  int64_t lowest = std::max(int64_t{0}, -static_cast<int64_t>(m_loader.pixelID_to_wi_offset));
+  int64_t highest = m_loader.eventid_max;
+  // Only the spectra requested, if any
+  if (m_loader.alg->m_specMin != EMPTY_INT())
+    lowest = std::max(lowest, static_cast<int64_t>(m_loader.alg->m_specMin));
+  if (m_loader.alg->m_specMax != EMPTY_INT())
+    highest = std::min(highest, static_cast<int64_t>(m_loader.alg->m_specMax));
+
+  const auto isWanted = [lowest, highest](const uint32_t id) { return id >= lowest && id <= highest; };
+  const auto first = std::find_if(event_id.cbegin(), event_id.cend(), isWanted);
+  if (first == event_id.cend())
+    return false;
+  const auto last = std::find_if(event_id.crbegin(), event_id.crend(), isWanted).base();
+
+  // These are the arguments to getSlab() for the other fields
+  m_loadStart[0] += std::distance(event_id.cbegin(), first);
+  m_loadSize[0] = std::distance(first, last);
+  event_id.erase(last, event_id.cend());
+  event_id.erase(event_id.cbegin(), first);
+
+  // determine the range of pixel ids
+  const auto minmax = std::minmax_element(event_id.cbegin(), event_id.cend());
+  m_min_id = static_cast<uint32_t>(std::max(static_cast<int64_t>(*minmax.first), lowest));
+  m_max_id = static_cast<uint32_t>(std::min(static_cast<int64_t>(*minmax.second), highest));
+  return true;
+}
+
 /** Open and load the times-of-flight data
  * @param file An NeXus::File object opened at the correct group
  * @returns A new array containing the time of flights for this bank
  */
-std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File &file) {
+std::unique_ptr<std::vector<float>> BankLoader::loadTof(::NeXus::File &file) {
   // Allocate the array
   auto event_time_of_flight = std::make_unique<std::vector<float>>(m_loadSize[0]);
 
@@ -282,7 +306,7 @@ std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadTof(::NeXus::File
  * @returns A new array containing the weights or a nullptr if the weights
  * are not present
  */
-std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadEventWeights(::NeXus::File &file) {
+std::unique_ptr<std::vector<float>> BankLoader::loadEventWeights(::NeXus::File &file) {
   try {
     // First, get info about the event_weight field in this bank
     file.openData("event_weight");
@@ -320,7 +344,7 @@ std::unique_ptr<std::vector<float>> LoadBankFromDiskTask::loadEventWeights(::NeX
   return event_weight;
 }
 
-void LoadBankFromDiskTask::run() {
+void BankLoader::run() {
   // These give the limits in each file as to which events we actually load
   // (when filtering by time).
   m_loadStart.resize(1, 0);
@@ -331,12 +355,6 @@ void LoadBankFromDiskTask::run() {
 
   prog->report(entry_name + ": load from disk");
 
-  // arrays to load into
-  std::unique_ptr<std::vector<uint32_t>> event_id;
-  std::unique_ptr<std::vector<float>> event_time_of_flight;
-  std::unique_ptr<std::vector<float>> event_weight;
-  std::vector<uint64_t> event_index;
-
   // Open the file
   ::NeXus::File file(m_loader.alg->m_filename);
   try {
@@ -346,7 +364,7 @@ void LoadBankFromDiskTask::run() {
     file.openGroup(entry_name, entry_type);
 
     // Load the event_index field.
-    event_index = this->loadEventIndex(file);
+    auto event_index = this->loadEventIndex(file);
 
     if (!m_loadError) {
       // Load and validate the pulse times
@@ -359,36 +377,36 @@ void LoadBankFromDiskTask::run() {
                                             << " has a mismatch between the number of event_index entries "
                                                "and the number of pulse times in event_time_zero.\n";
 
-      // Open and validate event_id field.
+      // Work out the range of events to load
       int64_t start_event = 0;
       int64_t stop_event = 0;
       this->prepareEventId(file, start_event, stop_event, event_index);
 
-      // These are the arguments to getSlab()
-      m_loadStart[0] = start_event;
-      m_loadSize[0] = stop_event - start_event;
-
-      if ((m_loadSize[0] > 0) && (m_loadStart[0] >= 0)) {
-        // Load pixel IDs
-        event_id = this->loadEventId(file);
-        if (m_loader.alg->getCancel()) {
-          m_loader.alg->getLogger().error() << "Loading bank " << entry_name << " is cancelled.\n";
-          m_loadError = true; // To allow cancelling the algorithm
-        }
-
-        // And TOF.
-        if (!m_loadError) {
-          event_time_of_flight = this->loadTof(file);
-          if (m_have_weight) {
-            event_weight = this->loadEventWeights(file);
-          }
+      if (stop_event == start_event) {
+        // Nothing in the time window or chunk
+        m_loader.alg->getLogger().debug() << "Bank " << entry_name << " has no events to load.\n";
+      } else if ((stop_event > start_event) && (start_event >= 0)) {
+        // Shared by the tasks processing the slices of the bank
+        auto event_index_shrd = std::make_shared<std::vector<uint64_t>>(std::move(event_index));
+        // The slices of a bank are processed one after the other as they fill
+        // the same event lists
+        auto bankMutex = std::make_shared<std::mutex>();
+        const auto sliceSize = static_cast<int64_t>(
+            std::min(m_loader.eventsPerSlice, static_cast<size_t>(std::numeric_limits<int64_t>::max())));
+        for (int64_t sliceStart = start_event; sliceStart < stop_event && !m_loadError; sliceStart += sliceSize) {
+          if (sliceStart != start_event)
+            prog->report(entry_name + ": load from disk");
+          // These are the arguments to getSlab()
+          m_loadStart[0] = sliceStart;
+          m_loadSize[0] = std::min(sliceSize, stop_event - sliceStart);
+          this->loadSlice(file, event_index_shrd, bankMutex);
         }
       } // Size is at least 1
       else {
         // Found a size that was 0 or less; stop processing
         m_loader.alg->getLogger().error()
             << "Loading bank " << entry_name << " is stopped due to either zero/negative loading size ("
-            << m_loadStart[0] << ") or negative load start index (" << m_loadStart[0] << ")\n";
+            << stop_event - start_event << ") or negative load start index (" << start_event << ")\n";
         m_loadError = true;
       }
 
@@ -407,67 +425,56 @@ void LoadBankFromDiskTask::run() {
   // Close up the file even if errors occured.
   file.closeGroup();
   file.close();
+}
 
-  // Abort if anything failed
-  if (m_loadError) {
-    return;
+/** Load the slice of the bank given by m_loadStart and m_loadSize and queue
+ * a task to add its events to the workspace. The arrays read are freed once
+ * the task has run.
+ * @param file :: File handle for the NeXus file, opened at the bank
+ * @param event_index :: the event_index field of the bank
+ * @param bankMutex :: the mutex shared by the tasks processing this bank
+ */
+void BankLoader::loadSlice(::NeXus::File &file, const std::shared_ptr<std::vector<uint64_t>> &event_index,
+                           std::shared_ptr<std::mutex> &bankMutex) {
+  // Load pixel IDs
+  auto event_id = this->loadEventId(file);
+  if (m_loader.alg->getCancel()) {
+    m_loader.alg->getLogger().error() << "Loading bank " << entry_name << " is cancelled.\n";
+    m_loadError = true; // To allow cancelling the algorithm
   }
+  if (m_loadError)
+    return;
 
-  const auto bank_size = m_max_id - m_min_id;
-  const auto minSpectraToLoad = static_cast<uint32_t>(m_loader.alg->m_specMin);
-  const auto maxSpectraToLoad = static_cast<uint32_t>(m_loader.alg->m_specMax);
-  const auto emptyInt = static_cast<uint32_t>(EMPTY_INT());
-  // check that if a range of spectra were requested that these fit within
-  // this bank
-  if (minSpectraToLoad != emptyInt && m_min_id < minSpectraToLoad) {
-    if (minSpectraToLoad > m_max_id) { // the minimum spectra to load is more
-                                       // than the max of this bank
-      return;
-    }
-    // the min spectra to load is higher than the min for this bank
-    m_min_id = minSpectraToLoad;
-  }
-  if (maxSpectraToLoad != emptyInt && m_max_id > maxSpectraToLoad) {
-    if (maxSpectraToLoad < m_min_id) {
-      // the maximum spectra to load is less than the minimum of this bank
-      return;
-    }
-    // the max spectra to load is lower than the max for this bank
-    m_max_id = maxSpectraToLoad;
-  }
-  if (m_min_id > m_max_id) {
-    // the min is now larger than the max, this means the entire block of
-    // spectra to load is outside this bank
+  // Only read the times-of-flight and weights of the events that are kept
+  if (!this->selectWantedEvents(*event_id))
     return;
+
+  // And TOF.
+  auto event_time_of_flight = this->loadTof(file);
+  std::unique_ptr<std::vector<float>> event_weight;
+  if (m_have_weight) {
+    event_weight = this->loadEventWeights(file);
   }
 
-  // schedule the job to generate the event lists
-  auto mid_id = m_max_id;
-  if (m_loader.splitProcessing && m_max_id > (m_min_id + (bank_size / 4)))
-    // only split if told to and the section to load is at least 1/4 the size
-    // of the whole bank
-    mid_id = (m_max_id + m_min_id) / 2;
+  // Abort if anything failed
+  if (m_loadError) {
+    return;
+  }
 
-  // No error? Launch a new task to process that data.
+  // No error? Launch a new task to process that data. Large slices are shared
+  // between threads by the task itself.
   auto numEvents = static_cast<size_t>(m_loadSize[0]);
   auto startAt = static_cast<size_t>(m_loadStart[0]);
 
-  // convert things to shared_arrays to share between tasks
-  std::shared_ptr<std::vector<uint32_t>> event_id_shrd(event_id.release());
-  std::shared_ptr<std::vector<float>> event_time_of_flight_shrd(event_time_of_flight.release());
-  std::shared_ptr<std::vector<float>> event_weight_shrd(event_weight.release());
-  auto event_index_shrd = std::make_shared<std::vector<uint64_t>>(std::move(event_index));
-
-  std::shared_ptr<Task> newTask1 = std::make_shared<ProcessBankData>(
-      m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
-      thisBankPulseTimes, m_have_weight, event_weight_shrd, m_min_id, mid_id);
-  scheduler.push(newTask1);
-  if (m_loader.splitProcessing && (mid_id < m_max_id)) {
-    std::shared_ptr<Task> newTask2 = std::make_shared<ProcessBankData>(
-        m_loader, entry_name, prog, event_id_shrd, event_time_of_flight_shrd, numEvents, startAt, event_index_shrd,
-        thisBankPulseTimes, m_have_weight, event_weight_shrd, (mid_id + 1), m_max_id);
-    scheduler.push(newTask2);
-  }
+  // The task holds the only references to the arrays, so they are freed as
+  // soon as it has run
+  std::shared_ptr<Kernel::Task> newTask = std::make_shared<ProcessBankData>(
+      m_loader, entry_name, prog, std::move(event_id), std::move(event_time_of_flight), numEvents, startAt,
+      event_index, thisBankPulseTimes, m_have_weight, std::move(event_weight), m_min_id, m_max_id);
+  newTask->setMutex(bankMutex);
+  // Memory held by the task until it has run
+  const size_t bytes = numEvents * (sizeof(uint32_t) + sizeof(float) + (m_have_weight ? sizeof(float) : 0));
+  m_queue.push(newTask, bytes);
 }
 
 /**
@@ -476,7 +483,7 @@ void LoadBankFromDiskTask::run() {
  * If the value is negative (can happen at ISIS) add 2^32 to it.
  * @param size :: The size of events value.
  */
-int64_t LoadBankFromDiskTask::recalculateDataSize(const int64_t &size) {
+int64_t BankLoader::recalculateDataSize(const int64_t &size) {
   if (size < 0) {
     const int64_t shift = int64_t(1) << 32;
     return shift + size;
@@ -6,45 +6,101 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidAPI/Progress.h"
-#include "MantidDataHandling/LoadBankFromDiskTask.h"
+#include "MantidDataHandling/BankLoader.h"
+#include "MantidDataHandling/EventProcessingQueue.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidKernel/ThreadPool.h"
-#include "MantidKernel/ThreadSchedulerMutexes.h"
+
+#include <algorithm>
+#include <numeric>
 
 using namespace Mantid::Kernel;
 
 namespace Mantid {
 namespace DataHandling {
 
+namespace {
+/// Banks with fewer events than this are always processed by a single thread
+constexpr size_t MIN_EVENTS_TO_PARTITION = 1 << 20;
+/// Most events read from a bank at once when compressing while loading
+constexpr size_t MAX_EVENTS_PER_COMPRESSED_SLICE = 1 << 24;
+} // namespace
+
+/** Load the events of the banks into the workspace. This thread reads the
+ * banks, largest first, while the events already read are processed by the
+ * TBB threads.
+ * @param readQueueDepth :: most banks read but not processed yet, or
+ * EMPTY_INT() for two per core
+ * @param readQueueMemory :: most memory, in MB, held by events read but not
+ * processed yet, or EMPTY_INT() for no limit. When given, the banks are read
+ * in slices small enough to keep within it.
+ */
 void DefaultEventLoader::load(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights,
                               bool event_id_is_spec, std::vector<std::string> bankNames,
                               const std::vector<int> &periodLog, const std::string &classType,
                               std::vector<std::size_t> bankNumEvents, const bool oldNeXusFileNames, const bool precount,
-                              const int chunk, const int totalChunks) {
+                              const int chunk, const int totalChunks, const int readQueueDepth,
+                              const int readQueueMemory) {
   DefaultEventLoader loader(alg, ws, haveWeights, event_id_is_spec, bankNames.size(), precount, chunk, totalChunks);
 
   auto bankRange = loader.setupChunking(bankNames, bankNumEvents);
 
-  // Make the thread pool
-  auto scheduler = new ThreadSchedulerMutexes;
-  ThreadPool pool(scheduler);
-  auto diskIOMutex = std::make_shared<std::mutex>();
+  // A bank with more than its share of the events would be the last to
+  // finish, so it is shared between threads. All banks are shared if there are
+  // few of them.
+  const auto totalEvents = std::accumulate(bankNumEvents.cbegin() + bankRange.first,
+                                           bankNumEvents.cbegin() + bankRange.second, size_t{0});
+  loader.partitionThreshold =
+      loader.splitProcessing ? MIN_EVENTS_TO_PARTITION
+                             : std::max(MIN_EVENTS_TO_PARTITION, totalEvents / ThreadPool::getNumPhysicalCores());
+
+  const size_t maxQueued = readQueueDepth == EMPTY_INT() ? 2 * ThreadPool::getNumPhysicalCores()
+                                                         : static_cast<size_t>(readQueueDepth);
+  const size_t maxQueuedBytes = readQueueMemory == EMPTY_INT() ? std::numeric_limits<size_t>::max()
+                                                               : static_cast<size_t>(readQueueMemory) << 20;
+  if (readQueueMemory != EMPTY_INT()) {
+    // Read the banks in slices small enough for a full queue and the slice
+    // being read to fit in the memory limit
+    const size_t bytesPerEvent = sizeof(uint32_t) + sizeof(float) + (haveWeights ? sizeof(float) : 0);
+    loader.eventsPerSlice = std::max(size_t{1}, maxQueuedBytes / ((maxQueued + 1) * bytesPerEvent));
+    // The slices of a bank are processed one after the other, so each one is
+    // shared between threads
+    loader.partitionThreshold = std::min(loader.partitionThreshold, MIN_EVENTS_TO_PARTITION);
+  }
+  if (alg->compressTolerance >= 0 && loader.eventsPerSlice > MAX_EVENTS_PER_COMPRESSED_SLICE) {
+    // The events of each slice are compressed into the event lists once it is
+    // processed, so slicing keeps the uncompressed events of a large bank from
+    // all being in memory at once. The compressed events fall in fixed bins,
+    // so they do not depend on where the slices start.
+    loader.eventsPerSlice = MAX_EVENTS_PER_COMPRESSED_SLICE;
+    loader.partitionThreshold = std::min(loader.partitionThreshold, MIN_EVENTS_TO_PARTITION);
+  }
 
   // set up progress bar for the rest of the (multi-threaded) process
-  size_t numProg = bankNames.size() * (1 + 3); // 1 = disktask, 3 = proc task
-  if (loader.splitProcessing)
-    numProg += bankNames.size() * 3; // 3 = second proc task
+  size_t numProg = 0;
+  for (size_t i = bankRange.first; i < bankRange.second; ++i) {
+    const size_t numSlices = bankNumEvents[i] / loader.eventsPerSlice + (bankNumEvents[i] % loader.eventsPerSlice != 0);
+    numProg += std::max(size_t{1}, numSlices) * (1 + 3); // 1 = disktask, 3 = proc task
+  }
   auto prog = std::make_unique<API::Progress>(loader.alg, 0.3, 1.0, numProg);
 
-  for (size_t i = bankRange.first; i < bankRange.second; i++) {
-    if (bankNumEvents[i] > 0)
-      pool.schedule(std::make_shared<LoadBankFromDiskTask>(loader, bankNames[i], classType, bankNumEvents[i],
-                                                           oldNeXusFileNames, prog.get(), diskIOMutex, *scheduler,
-                                                           periodLog));
+  EventProcessingQueue queue(maxQueued, maxQueuedBytes);
+
+  // Read the largest banks first so they are not left running on their own
+  // at the end
+  std::vector<size_t> banks(bankRange.second - bankRange.first);
+  std::iota(banks.begin(), banks.end(), bankRange.first);
+  std::stable_sort(banks.begin(), banks.end(),
+                   [&bankNumEvents](const size_t a, const size_t b) { return bankNumEvents[a] > bankNumEvents[b]; });
+  for (const auto i : banks) {
+    if (alg->getCancel())
+      break;
+    if (bankNumEvents[i] > 0) {
+      BankLoader bankLoader(loader, bankNames[i], classType, oldNeXusFileNames, prog.get(), queue, periodLog);
+      bankLoader.run();
+    }
   }
-  // Start and end all threads
-  pool.joinAll();
-  diskIOMutex.reset();
+  queue.wait();
 }
 
 DefaultEventLoader::DefaultEventLoader(LoadEventNexus *alg, EventWorkspaceCollection &ws, bool haveWeights,
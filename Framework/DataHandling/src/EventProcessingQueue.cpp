@@ -0,0 +1,160 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/EventProcessingQueue.h"
+
+#include "tbb/task_arena.h"
+
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataHandling {
+
+/** Constructor
+ * @param maxTasks :: most tasks waiting or running at once
+ * @param maxBytes :: most bytes held by the tasks waiting or running at once
+ * @throw std::invalid_argument if maxTasks is zero
+ */
+EventProcessingQueue::EventProcessingQueue(const size_t maxTasks, const size_t maxBytes)
+    : m_maxTasks(maxTasks), m_maxBytes(maxBytes) {
+  if (maxTasks == 0)
+    throw std::invalid_argument("EventProcessingQueue: the queue must hold at least one task");
+}
+
+/// Destructor. Waits for the tasks still running, ignoring their errors.
+EventProcessingQueue::~EventProcessingQueue() {
+  try {
+    m_tasks.wait();
+  } catch (...) {
+  }
+}
+
+/** Queue a task, first blocking until the queue has room for it.
+ * @param task :: the task to run
+ * @param bytes :: the memory held by the task, given back to the reader when
+ * run() returns. The task should have freed it by then.
+ */
+void EventProcessingQueue::push(std::shared_ptr<Kernel::Task> task, const size_t bytes) {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    // Once a task has failed the rest may never run, so stop waiting for them
+    const auto full = [this, bytes]() {
+      return !m_failed && m_numTasks > 0 && (m_numTasks >= m_maxTasks || m_numBytes + bytes > m_maxBytes);
+    };
+    while (full()) {
+      if (tbb::this_task_arena::max_concurrency() > 1) {
+        m_finished.wait(lock);
+      } else {
+        // Without worker threads the tasks only run when they are waited for.
+        // An error is kept to be rethrown by wait().
+        lock.unlock();
+        try {
+          m_tasks.wait();
+        } catch (...) {
+          m_error = std::current_exception();
+        }
+        lock.lock();
+      }
+    }
+    ++m_numTasks;
+    m_numBytes += bytes;
+
+    // Queue behind the tasks sharing its mutex, if there are any
+    if (auto mutex = task->getMutex()) {
+      auto &serialTasks = m_serialTasks[mutex.get()];
+      serialTasks.emplace_back(std::move(task), bytes);
+      if (serialTasks.size() == 1)
+        m_tasks.run([this, mutex]() { runSerial(mutex.get()); });
+      return;
+    }
+  }
+
+  m_tasks.run([this, task, bytes]() { runTask(*task, bytes); });
+}
+
+/** Run a task and take it off the counters
+ * @param task :: the task to run
+ * @param bytes :: the memory held by the task
+ */
+void EventProcessingQueue::runTask(Kernel::Task &task, const size_t bytes) {
+  try {
+    task.run();
+  } catch (...) {
+    release(bytes, true);
+    throw;
+  }
+  release(bytes, false);
+}
+
+/** Run the tasks sharing a mutex until there are none left
+ * @param mutex :: the mutex of the tasks
+ */
+void EventProcessingQueue::runSerial(std::mutex *mutex) {
+  while (true) {
+    std::pair<std::shared_ptr<Kernel::Task>, size_t> next;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      next = m_serialTasks[mutex].front();
+    }
+    try {
+      std::lock_guard<std::mutex> taskLock(*mutex);
+      runTask(*next.first, next.second);
+    } catch (...) {
+      // The tasks after a failed one are dropped
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto serialTasks = m_serialTasks.find(mutex);
+      for (auto task = serialTasks->second.cbegin() + 1; task != serialTasks->second.cend(); ++task) {
+        --m_numTasks;
+        m_numBytes -= task->second;
+      }
+      m_serialTasks.erase(serialTasks);
+      throw;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto serialTasks = m_serialTasks.find(mutex);
+    serialTasks->second.pop_front();
+    if (serialTasks->second.empty()) {
+      m_serialTasks.erase(serialTasks);
+      return;
+    }
+  }
+}
+
+/** Wait for all the queued tasks to finish
+ * @throw rethrows the first exception thrown by a task
+ */
+void EventProcessingQueue::wait() {
+  m_tasks.wait();
+  if (m_error)
+    std::rethrow_exception(m_error);
+}
+
+size_t EventProcessingQueue::size() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_numTasks;
+}
+
+size_t EventProcessingQueue::bytes() const {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_numBytes;
+}
+
+/** Take a finished task off the counters and wake up the reader
+ * @param bytes :: the memory held by the task
+ * @param failed :: true if the task threw
+ */
+void EventProcessingQueue::release(const size_t bytes, const bool failed) {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_numTasks;
+    m_numBytes -= bytes;
+    m_failed = m_failed || failed;
+  }
+  m_finished.notify_all();
+}
+
+} // namespace DataHandling
+} // namespace Mantid
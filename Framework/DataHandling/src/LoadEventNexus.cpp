@@ -30,6 +30,7 @@
 #include "MantidNexus/NexusIOHelper.h"
 
 #include <H5Cpp.h>
+#include <algorithm>
 #include <memory>
 
 #include <regex>
@@ -77,7 +78,8 @@ bool exists(const std::map<std::string, std::string> &entries, const std::string
  */
 LoadEventNexus::LoadEventNexus()
     : filter_tof_min(0), filter_tof_max(0), m_specMin(0), m_specMax(0), longest_tof(0), shortest_tof(0), bad_tofs(0),
-      discarded_events(0), compressTolerance(0), m_instrument_loaded_correctly(false), loadlogs(false),
+      discarded_events(0), compressTolerance(0), compressWallClockTolerance(EMPTY_DBL()),
+      m_instrument_loaded_correctly(false), loadlogs(false),
       event_id_is_spec(false) {}
 
 //----------------------------------------------------------------------------------------------
@@ -171,6 +173,16 @@ void LoadEventNexus::init() {
                   "negative to not do). "
                   "This specified the tolerance to use (in microseconds) when "
                   "compressing.");
+  auto mustBePositiveDouble = std::make_shared<BoundedValidator<double>>();
+  mustBePositiveDouble->setLower(0.0);
+  declareProperty("CompressWallClockTolerance", EMPTY_DBL(), mustBePositiveDouble,
+                  "When compressing while loading, the tolerance (in seconds) on the "
+                  "wall-clock time, as for the WallClockTolerance of CompressEvents. The "
+                  "compressed events keep their pulse times, averaged within each "
+                  "tolerance from the start of the run. Unset means compressing all "
+                  "wall-clock times together.");
+  setPropertySettings("CompressWallClockTolerance",
+                      std::make_unique<VisibleWhenProperty>("CompressTolerance", IS_NOT_DEFAULT));
 
   auto mustBePositive = std::make_shared<BoundedValidator<int>>();
   mustBePositive->setLower(1);
@@ -185,11 +197,22 @@ void LoadEventNexus::init() {
   // validation
   setPropertySettings("TotalChunks", std::make_unique<VisibleWhenProperty>("ChunkNumber", IS_NOT_DEFAULT));
 
+  declareProperty("ReadQueueDepth", EMPTY_INT(), mustBePositive,
+                  "The number of banks, or slices of banks, that can be read ahead of "
+                  "the processing of their events (optional, default two per core).");
+  declareProperty("ReadQueueMemory", EMPTY_INT(), mustBePositive,
+                  "The memory, in MB, that the events read ahead of their processing "
+                  "can use (optional, default no limit). When set, the banks are read "
+                  "in slices small enough to keep within it.");
+
   std::string grp3 = "Reduce Memory Use";
   setPropertyGroup("Precount", grp3);
   setPropertyGroup("CompressTolerance", grp3);
+  setPropertyGroup("CompressWallClockTolerance", grp3);
   setPropertyGroup("ChunkNumber", grp3);
   setPropertyGroup("TotalChunks", grp3);
+  setPropertyGroup("ReadQueueDepth", grp3);
+  setPropertyGroup("ReadQueueMemory", grp3);
 
   declareProperty(std::make_unique<PropertyWithValue<bool>>("LoadMonitors", false, Direction::Input),
                   "Load the monitors from the file (optional, default False).");
@@ -355,6 +378,7 @@ void LoadEventNexus::execLoader() {
   m_filename = getPropertyValue("Filename");
 
   compressTolerance = getProperty("CompressTolerance");
+  compressWallClockTolerance = getProperty("CompressWallClockTolerance");
 
   loadlogs = getProperty("LoadLogs");
 
@@ -940,6 +964,16 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
 
   if (takeTimesFromEvents)
     run_start = firstPulseT;
+  // The wall-clock bins of the compressed events start with the run, as in
+  // CompressEvents, or with the first pulse if that is earlier, as the events
+  // before the start of the bins would be dropped. Every spectrum uses the
+  // same bins.
+  compressStartTime = run_start;
+  if (m_allBanksPulseTimes->numPulses > 0) {
+    const auto *firstPulse = m_allBanksPulseTimes->pulseTimes;
+    const auto *lastPulse = firstPulse + m_allBanksPulseTimes->numPulses;
+    compressStartTime = std::min(compressStartTime, *std::min_element(firstPulse, lastPulse));
+  }
 
   loadSampleDataISIScompatibility(*m_file, *m_ws);
 
@@ -1101,8 +1135,11 @@ void LoadEventNexus::loadEvents(API::Progress *const prog, const bool monitors)
     bool precount = getProperty("Precount");
     int chunk = getProperty("ChunkNumber");
     int totalChunks = getProperty("TotalChunks");
+    int readQueueDepth = getProperty("ReadQueueDepth");
+    int readQueueMemory = getProperty("ReadQueueMemory");
     DefaultEventLoader::load(this, *m_ws, haveWeights, event_id_is_spec, bankNames, periodLog->valuesAsVector(),
-                             classType, bankNumEvents, oldNeXusFileNames, precount, chunk, totalChunks);
+                             classType, bankNumEvents, oldNeXusFileNames, precount, chunk, totalChunks,
+                             readQueueDepth, readQueueMemory);
   }
 
   // Info reporting
@@ -0,0 +1,59 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/LoadMappedEvents.h"
+#include "MantidAPI/Axis.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/MappedEventFile.h"
+#include "MantidDataObjects/WorkspaceCreation.h"
+#include "MantidKernel/UnitFactory.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(LoadMappedEvents)
+
+using namespace Kernel;
+using namespace API;
+using namespace DataObjects;
+
+void LoadMappedEvents::init() {
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Load, ".mevents"),
+                  "The file written by SaveMappedEvents");
+  declareProperty(std::make_unique<WorkspaceProperty<MatrixWorkspace>>("TemplateWorkspace", "", Direction::Input,
+                                                                       PropertyMode::Optional),
+                  "A workspace with the same number of spectra to copy the instrument, logs and units from, for "
+                  "example the output of LoadEventNexus with MetaDataOnly");
+  declareProperty(std::make_unique<WorkspaceProperty<EventWorkspace>>("OutputWorkspace", "", Direction::Output),
+                  "The workspace using the events of the file");
+}
+
+void LoadMappedEvents::exec() {
+  const std::string filename = getPropertyValue("Filename");
+  MatrixWorkspace_const_sptr templateWS = getProperty("TemplateWorkspace");
+
+  const auto file = MappedEventFile::open(filename);
+  EventWorkspace_sptr outputWS;
+  if (templateWS) {
+    if (templateWS->getNumberHistograms() != file->getNumberHistograms())
+      throw std::invalid_argument("TemplateWorkspace has " + std::to_string(templateWS->getNumberHistograms()) +
+                                  " spectra, the file has " + std::to_string(file->getNumberHistograms()));
+    outputWS = create<EventWorkspace>(*templateWS, HistogramData::BinEdges(2));
+  } else {
+    outputWS = create<EventWorkspace>(file->getNumberHistograms(), HistogramData::BinEdges(2));
+    outputWS->getAxis(0)->unit() = UnitFactory::Instance().create("TOF");
+    outputWS->setYUnit("Counts");
+  }
+  outputWS->setMappedEvents(file);
+  outputWS->resetAllXToSingleBin();
+
+  setProperty("OutputWorkspace", outputWS);
+}
+
+} // namespace DataHandling
+} // namespace Mantid
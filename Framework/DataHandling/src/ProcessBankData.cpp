@@ -4,11 +4,20 @@
 //   NScD Oak Ridge National Laboratory, European Spallation Source,
 //   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
 // SPDX - License - Identifier: GPL - 3.0 +
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <unordered_map>
 #include <utility>
 
 #include "MantidDataHandling/DefaultEventLoader.h"
 #include "MantidDataHandling/LoadEventNexus.h"
 #include "MantidDataHandling/ProcessBankData.h"
+#include "MantidKernel/EmptyValues.h"
+#include "MantidKernel/ThreadPool.h"
+
+#include "tbb/parallel_for.h"
 
 using namespace Mantid::DataObjects;
 
@@ -33,34 +42,207 @@ ProcessBankData::ProcessBankData(DefaultEventLoader &m_loader, std::string entry
 }
 
 namespace {
-// this assumes that last_pulse_index is already to the point of including this
-// one so we only need to search forward
-inline size_t getPulseIndex(const size_t event_index, const size_t last_pulse_index,
-                            const std::shared_ptr<std::vector<uint64_t>> &event_index_vec) {
-  if (last_pulse_index + 1 >= event_index_vec->size())
-    return last_pulse_index;
-
-  // linear search is used because it is more likely that the next pulse index
-  // is the correct one to use the + last_pulse_index + 1 is because we are
-  // confirm that the next index is bigger, not the current
-  const auto event_index_end = event_index_vec->cend();
-  auto event_index_iter = event_index_vec->cbegin() + last_pulse_index;
-
-  while ((event_index < *event_index_iter) || (event_index >= *(event_index_iter + 1))) {
-    event_index_iter++;
-
-    // make sure not to go past the end
-    if (event_index_iter + 1 == event_index_end)
-      break;
+/// Smallest number of events given to a block of the partitioned ingest
+constexpr size_t MIN_PARTITION_BLOCK_SIZE = 1 << 16;
+
+/// True if the list stores its events in vectors of this type of event
+bool storesEventsAs(const EventList &el, const std::vector<Types::Event::TofEvent> &) {
+  return el.getEventType() == API::TOF;
+}
+bool storesEventsAs(const EventList &el, const std::vector<WeightedEvent> &) {
+  return el.getEventType() == API::WEIGHTED;
+}
+
+/** The fixed bins of the events compressed while loading: tolerance-wide tof
+ * bins and, when the pulse times are kept, wall-clock bins from the start of
+ * the run. The bins do not depend on the events, so compressing the slices of
+ * a bank one after the other gives the same events as compressing it whole.
+ */
+class CompressionBins {
+public:
+  /// The bin of an event, ordered by pulse time bin then tof bin
+  using Key = std::pair<int64_t, double>;
+
+  explicit CompressionBins(const LoadEventNexus &alg)
+      : m_tolerance(alg.compressTolerance), m_keepPulseTimes(alg.compressWallClockTolerance != EMPTY_DBL()),
+        m_startNs(alg.compressStartTime.totalNanoseconds()),
+        m_pulseWidthNs(
+            std::max(int64_t{1}, static_cast<int64_t>(m_keepPulseTimes ? alg.compressWallClockTolerance * 1e9 : 0.))) {}
+
+  bool keepsPulseTimes() const { return m_keepPulseTimes; }
+
+  template <typename EventType> Key key(const EventType &event) const {
+    return {m_keepPulseTimes ? pulseBin(event.pulseTime().totalNanoseconds()) : 0, tofBin(event.tof())};
+  }
+
+  /** Combine events of the same bin into one, with the summed weights and
+   * errors, and the tof and pulse time averaged with the squared errors. The
+   * squared errors add up like the events, so the average is the same however
+   * the events were combined before.
+   */
+  template <typename CompressedType, typename Iterator>
+  CompressedType combine(const Iterator first, const Iterator last, const Key &key) const {
+    if (std::next(first) == last)
+      return CompressedType(first->tof(), Types::Core::DateAndTime(pulseNs(*first)), first->weight(),
+                            first->errorSquared());
+    const int64_t binStart = m_startNs + key.first * m_pulseWidthNs;
+    double weight = 0.;
+    double errorSquared = 0.;
+    double tof = 0.;
+    double pulse = 0.;
+    for (auto it = first; it != last; ++it) {
+      weight += it->weight();
+      errorSquared += it->errorSquared();
+      tof += it->errorSquared() * it->tof();
+      pulse += it->errorSquared() * static_cast<double>(pulseNs(*it) - binStart);
+    }
+    if (errorSquared > 0.) {
+      tof /= errorSquared;
+      pulse /= errorSquared;
+    } else {
+      tof = first->tof();
+      pulse = static_cast<double>(pulseNs(*first) - binStart);
+    }
+    const int64_t binEnd = binStart + m_pulseWidthNs - 1;
+    const int64_t pulseTime =
+        m_keepPulseTimes ? std::clamp(binStart + static_cast<int64_t>(std::llround(pulse)), binStart, binEnd) : 0;
+    return CompressedType(keepInTofBin(tof, key.second), Types::Core::DateAndTime(pulseTime), weight, errorSquared);
+  }
+
+private:
+  double tofBin(const double tof) const { return m_tolerance > 0. ? std::floor(tof / m_tolerance) : tof; }
+
+  int64_t pulseBin(const int64_t ns) const {
+    const int64_t offset = ns - m_startNs;
+    return offset >= 0 ? offset / m_pulseWidthNs : -((m_pulseWidthNs - 1 - offset) / m_pulseWidthNs);
+  }
+
+  template <typename EventType> int64_t pulseNs(const EventType &event) const {
+    return m_keepPulseTimes ? event.pulseTime().totalNanoseconds() : 0;
+  }
+
+  /// Move an averaged tof that rounding took out of its bin back into it
+  double keepInTofBin(double tof, const double bin) const {
+    if (m_tolerance <= 0.)
+      return bin;
+    while (tofBin(tof) < bin)
+      tof = std::nextafter(tof, std::numeric_limits<double>::max());
+    while (tofBin(tof) > bin)
+      tof = std::nextafter(tof, std::numeric_limits<double>::lowest());
+    return tof;
+  }
+
+  const double m_tolerance;
+  const bool m_keepPulseTimes;
+  const int64_t m_startNs;
+  const int64_t m_pulseWidthNs;
+};
+
+/// Replace events sorted by bin with one event for each bin
+template <typename EventType, typename CompressedType>
+void combineSortedEvents(const std::vector<EventType> &events, std::vector<CompressedType> &out,
+                         const CompressionBins &bins) {
+  out.clear();
+  for (auto it = events.cbegin(); it != events.cend();) {
+    const auto key = bins.key(*it);
+    const auto binEnd = std::find_if(std::next(it), events.cend(),
+                                     [&bins, &key](const EventType &event) { return bins.key(event) != key; });
+    out.emplace_back(bins.combine<CompressedType>(it, binEnd, key));
+    it = binEnd;
+  }
+  // If you have over-allocated by more than 5%, reduce the size.
+  if (out.capacity() - out.size() > out.size() / 20)
+    out.shrink_to_fit();
+}
+
+/// The compressed events of the list, switching an empty list to them
+template <typename CompressedType> std::vector<CompressedType> &compressedEvents(EventList &el);
+template <> std::vector<WeightedEventNoTime> &compressedEvents<WeightedEventNoTime>(EventList &el) {
+  el.switchTo(API::WEIGHTED_NOTIME);
+  el.setSortOrder(TOF_SORT);
+  return el.getWeightedEventsNoTime();
+}
+template <> std::vector<WeightedEvent> &compressedEvents<WeightedEvent>(EventList &el) {
+  el.switchTo(API::WEIGHTED);
+  // The sort order is pulsetimetof as we've compressed out the tolerance
+  el.setSortOrder(PULSETIMETOF_SORT);
+  return el.getWeightedEvents();
+}
+
+/** Compress the events just read for a list and merge them with the events
+ * the list already has. The loader keeps appending the events it reads to the
+ * vector it cached for the list. That vector is the storage of the list until
+ * the list is first compressed, and it still is for weighted events with
+ * their pulse times; the compressed events then come first in it, already
+ * sorted by bin.
+ * @param el :: the event list
+ * @param newEvents :: the vector of events the loader cached for the list
+ * @param bins :: the bins of the compressed events
+ */
+template <typename CompressedType, typename EventType>
+void compressWithNewEvents(EventList &el, std::vector<EventType> &newEvents, const CompressionBins &bins) {
+  const auto byBin = [&bins](const auto &a, const auto &b) { return bins.key(a) < bins.key(b); };
+  std::vector<CompressedType> compressed;
+  if (storesEventsAs(el, newEvents)) {
+    const auto sortedEnd = std::is_sorted_until(newEvents.begin(), newEvents.end(), byBin);
+    std::sort(sortedEnd, newEvents.end(), byBin);
+    std::inplace_merge(newEvents.begin(), sortedEnd, newEvents.end(), byBin);
+    combineSortedEvents(newEvents, compressed, bins);
+    std::vector<EventType>().swap(newEvents);
+    compressedEvents<CompressedType>(el).swap(compressed);
+    return;
   }
-  return std::distance(event_index_vec->cbegin(), event_index_iter);
+  // Only the new events are sorted; the ones of the list already are
+  std::sort(newEvents.begin(), newEvents.end(), byBin);
+  combineSortedEvents(newEvents, compressed, bins);
+  std::vector<EventType>().swap(newEvents);
+  auto &events = compressedEvents<CompressedType>(el);
+  std::vector<CompressedType> merged;
+  merged.reserve(events.size() + compressed.size());
+  std::merge(events.cbegin(), events.cend(), compressed.cbegin(), compressed.cend(), std::back_inserter(merged),
+             byBin);
+  combineSortedEvents(merged, events, bins);
+}
+
+/// Compress the events just read for a list into its fixed bins
+template <typename EventType>
+void compressWithNewEvents(EventList &el, std::vector<EventType> &newEvents, const LoadEventNexus &alg) {
+  const CompressionBins bins(alg);
+  if (bins.keepsPulseTimes())
+    compressWithNewEvents<WeightedEvent>(el, newEvents, bins);
+  else
+    compressWithNewEvents<WeightedEventNoTime>(el, newEvents, bins);
 }
 } // namespace
 
 /** Run the data processing
- * FIXME/TODO - split run() into readable methods
  */
 void ProcessBankData::run() { // override {
+  // The queue gives the memory of the arrays read from the file back to the
+  // reader as soon as this returns, so free them here, even on failure,
+  // rather than when the task is destroyed.
+  const auto freeArrays = [this]() {
+    event_id.reset();
+    event_time_of_flight.reset();
+    event_weight.reset();
+  };
+  try {
+    // Large banks are shared between threads
+    if (numEvents >= m_loader.partitionThreshold)
+      runPartitioned();
+    else
+      runSingleThreaded();
+  } catch (...) {
+    freeArrays();
+    throw;
+  }
+  freeArrays();
+}
+
+/** Fill the events using this thread only
+ * FIXME/TODO - split into readable methods
+ */
+void ProcessBankData::runSingleThreaded() {
   // Local tof limits
   double my_shortest_tof = static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
   double my_longest_tof = 0.;
@@ -72,7 +254,10 @@ void ProcessBankData::run() { // override {
   // ---- Pre-counting events per pixel ID ----
   auto &outputWS = m_loader.m_ws;
   auto *alg = m_loader.alg;
-  if (m_loader.precount) {
+  // Will we need to compress?
+  const bool compress = (alg->compressTolerance >= 0);
+  // The events of a compressed list are not stored where they are counted
+  if (m_loader.precount && !compress) {
 
     std::vector<size_t> counts(m_max_id - m_min_id + 1, 0);
     for (size_t i = 0; i < numEvents; i++) {
@@ -108,14 +293,12 @@ void ProcessBankData::run() { // override {
       std::is_sorted(thisBankPulseTimes->pulseTimes, thisBankPulseTimes->pulseTimes + thisBankPulseTimes->numPulses);
   if (!std::is_sorted(event_index->cbegin(), event_index->cend()))
     throw std::runtime_error("Event index is not sorted");
+  checkEventIndices();
 
   // And there are this many pulses
   const auto NUM_PULSES = thisBankPulseTimes->numPulses;
   prog->report(entry_name + ": filling events");
 
-  // Will we need to compress?
-  const bool compress = (alg->compressTolerance >= 0);
-
   // Which detector IDs were touched? - only matters if compress is on
   std::vector<bool> usedDetIds;
   if (compress)
@@ -124,7 +307,7 @@ void ProcessBankData::run() { // override {
   const double TOF_MIN = alg->filter_tof_min;
   const double TOF_MAX = alg->filter_tof_max;
 
-  for (std::size_t pulseIndex = getPulseIndex(startAt, 0, event_index); pulseIndex < NUM_PULSES; pulseIndex++) {
+  for (std::size_t pulseIndex = getFirstPulseIndex(0); pulseIndex < NUM_PULSES; pulseIndex++) {
     // Save the pulse time at this index for creating those events
     const auto pulsetime = thisBankPulseTimes->pulseTimes[pulseIndex];
     const int logPeriodNumber = thisBankPulseTimes->periodNumbers[pulseIndex];
@@ -137,14 +320,6 @@ void ProcessBankData::run() { // override {
     const auto lastEventIndex = getLastEventIndex(pulseIndex, NUM_PULSES);
     if (firstEventIndex == lastEventIndex)
       continue;
-    else if (firstEventIndex > lastEventIndex) {
-      std::stringstream msg;
-      msg << "Something went really wrong: " << firstEventIndex << " > " << lastEventIndex << "| " << entry_name
-          << " startAt=" << startAt << " numEvents=" << event_index->size() << " RAWINDICES=["
-          << firstEventIndex + startAt << ",?)"
-          << " pulseIndex=" << pulseIndex << " of " << event_index->size();
-      throw std::runtime_error(msg.str());
-    }
 
     for (std::size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex) {
       // We cached a pointer to the vector<tofEvent> -> so retrieve it and add
@@ -208,48 +383,302 @@ void ProcessBankData::run() { // override {
     return;
   }
 
-  //------------ Compress Events (or set sort order) ------------------
+  //------------ Compress Events ------------------
   // Do it on all the detector IDs we touched
   if (compress) {
+    std::vector<detid_t> touchedDetIds;
     for (detid_t pixID = m_min_id; pixID <= m_max_id; ++pixID) {
-      if (usedDetIds[pixID - m_min_id]) {
-        // Find the the workspace index corresponding to that pixel ID
-        size_t wi = getWorkspaceIndexFromPixelID(pixID);
-        auto &el = outputWS.getSpectrum(wi);
-        if (compress)
-          el.compressEvents(alg->compressTolerance, &el);
-        else {
-          if (pulsetimesincreasing)
-            el.setSortOrder(DataObjects::PULSETIME_SORT);
-          else
-            el.setSortOrder(DataObjects::UNSORTED);
-        }
-      }
+      if (usedDetIds[pixID - m_min_id])
+        touchedDetIds.emplace_back(pixID);
     }
+    compressEventLists(touchedDetIds);
   }
   prog->report(entry_name + ": filled events");
 
   alg->getLogger().debug() << entry_name << (pulsetimesincreasing ? " had " : " DID NOT have ")
                            << "monotonically increasing pulse times\n";
 
-  // Join back up the tof limits to the global ones
+  mergeTofLimits(my_shortest_tof, my_longest_tof, badTofs, my_discarded_events);
+} // END-OF-RUNSINGLETHREADED()
+
+/** Call a function for each event in a range, in order, along with the pulse
+ * time and period index of the pulse it belongs to.
+ * @param first :: index of the first event
+ * @param last :: index one past the last event
+ * @param callback :: called with the event index, pulse time and period index
+ */
+template <typename Callback>
+void ProcessBankData::forEachEvent(const size_t first, const size_t last, const Callback &callback) const {
+  const auto NUM_PULSES = thisBankPulseTimes->numPulses;
+  for (size_t pulseIndex = getFirstPulseIndex(first); pulseIndex < NUM_PULSES; ++pulseIndex) {
+    const auto firstEventIndex = std::max(getFirstEventIndex(pulseIndex), first);
+    if (firstEventIndex >= last)
+      break;
+    const auto lastEventIndex = std::min(getLastEventIndex(pulseIndex, NUM_PULSES), last);
+    const auto &pulsetime = thisBankPulseTimes->pulseTimes[pulseIndex];
+    const int periodIndex = thisBankPulseTimes->periodNumbers[pulseIndex] - 1;
+    for (size_t eventIndex = firstEventIndex; eventIndex < lastEventIndex; ++eventIndex)
+      callback(eventIndex, pulsetime, periodIndex);
+  }
+}
+
+/** Two pass ingest of the events into the event lists.
+ * @param eventVectors :: the event vector of each period and detector ID
+ * @param makeEvent :: creates an event from its index, tof and pulse time
+ */
+template <typename EventType, typename MakeEvent>
+void ProcessBankData::ingestPartitioned(std::vector<std::vector<std::vector<EventType> *>> &eventVectors,
+                                        const MakeEvent &makeEvent) {
+  auto *alg = m_loader.alg;
+  if (!std::is_sorted(event_index->cbegin(), event_index->cend()))
+    throw std::runtime_error("Event index is not sorted");
+  checkEventIndices();
+
+  const double TOF_MIN = alg->filter_tof_min;
+  const double TOF_MAX = alg->filter_tof_max;
+  // Events are counted for each (period, detector ID) pair
+  const auto numIds = static_cast<size_t>(m_max_id - m_min_id) + 1;
+  const size_t numKeys = numIds * eventVectors.size();
+  const auto keyOf = [this, numIds](const int periodIndex, const detid_t detId) {
+    return static_cast<size_t>(periodIndex) * numIds + static_cast<size_t>(detId - m_min_id);
+  };
+
+  // Every block needs a count for each key, so give each one enough events
+  // for the counts to be small in comparison.
+  const size_t minBlockSize = std::max(MIN_PARTITION_BLOCK_SIZE, numKeys);
+  const size_t numBlocks =
+      std::max(size_t{1}, std::min(numEvents / minBlockSize, 2 * Kernel::ThreadPool::getNumPhysicalCores()));
+  const size_t blockSize = (numEvents + numBlocks - 1) / numBlocks;
+
+  struct Block {
+    size_t first;
+    size_t last;
+    /// Events for each key, later the index of the next slot for each key
+    std::vector<size_t> slots;
+    double shortestTof;
+    double longestTof;
+    size_t badTofs;
+    size_t discardedEvents;
+  };
+  std::vector<Block> blocks(numBlocks);
+  for (size_t i = 0; i < numBlocks; ++i)
+    blocks[i].first = std::min(i * blockSize, numEvents);
+  for (size_t i = 0; i < numBlocks; ++i)
+    blocks[i].last = std::min(blocks[i].first + blockSize, numEvents);
+
+  // ---- First pass: count the events each block sends to each list ----
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), [&](const tbb::blocked_range<size_t> &range) {
+    for (size_t i = range.begin(); i < range.end(); ++i) {
+      auto &block = blocks[i];
+      block.slots.assign(numKeys, 0);
+      block.shortestTof = static_cast<double>(std::numeric_limits<uint32_t>::max()) * 0.1;
+      block.longestTof = 0.;
+      block.badTofs = 0;
+      block.discardedEvents = 0;
+      forEachEvent(block.first, block.last,
+                   [&](const size_t eventIndex, const Types::Core::DateAndTime &, const int periodIndex) {
+                     const detid_t detId = (*event_id)[eventIndex];
+                     if (detId < m_min_id || detId > m_max_id)
+                       return;
+                     const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
+                     if ((tof - TOF_MIN) * (tof - TOF_MAX) > 0.)
+                       return;
+                     // NULL eventVector indicates a bad spectrum lookup
+                     if (eventVectors[periodIndex][detId])
+                       ++block.slots[keyOf(periodIndex, detId)];
+                     else
+                       ++block.discardedEvents;
+                     // Same limits as the single threaded fill
+                     if (tof < 2e8) {
+                       block.longestTof = std::max(block.longestTof, tof);
+                       block.shortestTof = std::min(block.shortestTof, tof);
+                     } else
+                       ++block.badTofs;
+                   });
+    }
+  });
+  if (alg->getCancel())
+    return;
+
+  // ---- Give each block its own range of slots at the end of each list ----
+  // Several detector IDs can share a list, so lists are sized by pointer.
+  prog->report(entry_name + ": filling events");
+  std::unordered_map<std::vector<EventType> *, size_t> newSizes;
+  std::vector<detid_t> usedDetIds;
+  for (size_t key = 0; key < numKeys; ++key) {
+    size_t total = 0;
+    for (const auto &block : blocks)
+      total += block.slots[key];
+    if (total == 0)
+      continue;
+    const auto detId = m_min_id + static_cast<detid_t>(key % numIds);
+    auto *eventVector = eventVectors[key / numIds][detId];
+    auto size = newSizes.emplace(eventVector, eventVector->size()).first;
+    for (auto &block : blocks) {
+      const size_t count = block.slots[key];
+      block.slots[key] = size->second;
+      size->second += count;
+    }
+    usedDetIds.emplace_back(detId);
+  }
+  const std::vector<std::pair<std::vector<EventType> *, size_t>> resizes(newSizes.cbegin(), newSizes.cend());
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, resizes.size()), [&resizes](const tbb::blocked_range<size_t> &range) {
+    for (size_t i = range.begin(); i < range.end(); ++i)
+      resizes[i].first->resize(resizes[i].second);
+  });
+
+  // ---- Second pass: copy the events into the slots ----
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), [&](const tbb::blocked_range<size_t> &range) {
+    for (size_t i = range.begin(); i < range.end(); ++i) {
+      auto &nextSlot = blocks[i].slots;
+      forEachEvent(blocks[i].first, blocks[i].last,
+                   [&](const size_t eventIndex, const Types::Core::DateAndTime &pulsetime, const int periodIndex) {
+                     const detid_t detId = (*event_id)[eventIndex];
+                     if (detId < m_min_id || detId > m_max_id)
+                       return;
+                     const auto tof = static_cast<double>((*event_time_of_flight)[eventIndex]);
+                     if ((tof - TOF_MIN) * (tof - TOF_MAX) > 0.)
+                       return;
+                     auto *eventVector = eventVectors[periodIndex][detId];
+                     if (eventVector)
+                       (*eventVector)[nextSlot[keyOf(periodIndex, detId)]++] = makeEvent(eventIndex, tof, pulsetime);
+                   });
+    }
+  });
+  if (alg->getCancel())
+    return;
+
+  //------------ Compress Events ------------------
+  if (alg->compressTolerance >= 0)
+    compressEventLists(usedDetIds);
+  prog->report(entry_name + ": filled events");
+
+  double shortestTof = std::numeric_limits<double>::max();
+  double longestTof = 0.;
+  size_t badTofs = 0;
+  size_t discardedEvents = 0;
+  for (const auto &block : blocks) {
+    shortestTof = std::min(shortestTof, block.shortestTof);
+    longestTof = std::max(longestTof, block.longestTof);
+    badTofs += block.badTofs;
+    discardedEvents += block.discardedEvents;
+  }
+  mergeTofLimits(shortestTof, longestTof, badTofs, discardedEvents);
+}
+
+/** Fill the events of a large bank using several threads. See the class
+ * description for how the work is split.
+ */
+void ProcessBankData::runPartitioned() {
+  prog->report(entry_name + ": counting events");
+  if (have_weight) {
+    const auto &weights = *event_weight;
+    ingestPartitioned(m_loader.weightedEventVectors,
+                      [&weights](const size_t eventIndex, const double tof, const Types::Core::DateAndTime &pulsetime) {
+                        const auto weight = static_cast<double>(weights[eventIndex]);
+                        return WeightedEvent(tof, pulsetime, weight, weight * weight);
+                      });
+  } else {
+    ingestPartitioned(m_loader.eventVectors,
+                      [](const size_t, const double tof, const Types::Core::DateAndTime &pulsetime) {
+                        return Types::Event::TofEvent(tof, pulsetime);
+                      });
+  }
+}
+
+/** Compress the event lists that received events from this task, in every
+ * period. The lists keep their compressed events from the tasks before, so
+ * each slice of a bank only adds its own events to the memory in use.
+ * @param usedDetIds :: the detector IDs that received events
+ */
+void ProcessBankData::compressEventLists(const std::vector<detid_t> &usedDetIds) {
+  auto *alg = m_loader.alg;
+  auto &outputWS = m_loader.m_ws;
+  // Several detector IDs can share a list, so keep one ID for each list
+  std::vector<std::pair<size_t, detid_t>> usedIndices;
+  usedIndices.reserve(usedDetIds.size());
+  for (const auto detId : usedDetIds)
+    usedIndices.emplace_back(getWorkspaceIndexFromPixelID(detId), detId);
+  std::sort(usedIndices.begin(), usedIndices.end());
+  usedIndices.erase(std::unique(usedIndices.begin(), usedIndices.end(),
+                                [](const auto &a, const auto &b) { return a.first == b.first; }),
+                    usedIndices.end());
+
+  const size_t numPeriods = outputWS.nPeriods();
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, usedIndices.size() * numPeriods),
+                    [this, &usedIndices, &outputWS, alg, numPeriods](const tbb::blocked_range<size_t> &range) {
+                      for (size_t i = range.begin(); i < range.end(); ++i) {
+                        const auto &used = usedIndices[i / numPeriods];
+                        const size_t periodIndex = i % numPeriods;
+                        auto &el = outputWS.getSpectrum(used.first, periodIndex);
+                        if (have_weight) {
+                          if (auto *newEvents = m_loader.weightedEventVectors[periodIndex][used.second])
+                            compressWithNewEvents(el, *newEvents, *alg);
+                        } else if (auto *newEvents = m_loader.eventVectors[periodIndex][used.second]) {
+                          compressWithNewEvents(el, *newEvents, *alg);
+                        }
+                      }
+                    });
+}
+
+/** Join the tof limits and event counts of this bank to the global ones of
+ * the algorithm.
+ * @param shortestTof :: shortest tof seen in the bank
+ * @param longestTof :: longest tof seen in the bank
+ * @param badTofs :: number of events with tofs that were too high
+ * @param discardedEvents :: number of events without an event list
+ */
+void ProcessBankData::mergeTofLimits(const double shortestTof, const double longestTof, const size_t badTofs,
+                                     const size_t discardedEvents) {
+  auto *alg = m_loader.alg;
   // This is not thread safe, so only one thread at a time runs this.
   {
     std::lock_guard<std::mutex> _lock(alg->m_tofMutex);
-    if (my_shortest_tof < alg->shortest_tof) {
-      alg->shortest_tof = my_shortest_tof;
+    if (shortestTof < alg->shortest_tof) {
+      alg->shortest_tof = shortestTof;
     }
-    if (my_longest_tof > alg->longest_tof) {
-      alg->longest_tof = my_longest_tof;
+    if (longestTof > alg->longest_tof) {
+      alg->longest_tof = longestTof;
     }
     alg->bad_tofs += badTofs;
-    alg->discarded_events += my_discarded_events;
+    alg->discarded_events += discardedEvents;
   }
 
 #ifndef _WIN32
   alg->getLogger().debug() << "Time to process " << entry_name << " " << m_timer << "\n";
 #endif
-} // END-OF-RUN()
+}
+
+/** Check that the events of every pulse end after they start
+ * @throw std::runtime_error if a pulse ends before its first event
+ */
+void ProcessBankData::checkEventIndices() const {
+  const auto NUM_PULSES = thisBankPulseTimes->numPulses;
+  for (std::size_t pulseIndex = getFirstPulseIndex(0); pulseIndex < NUM_PULSES; pulseIndex++) {
+    const auto firstEventIndex = getFirstEventIndex(pulseIndex);
+    if (firstEventIndex > numEvents)
+      break;
+    const auto lastEventIndex = getLastEventIndex(pulseIndex, NUM_PULSES);
+    if (firstEventIndex > lastEventIndex) {
+      std::stringstream msg;
+      msg << "Something went really wrong: " << firstEventIndex << " > " << lastEventIndex << "| " << entry_name
+          << " startAt=" << startAt << " numEvents=" << event_index->size() << " RAWINDICES=["
+          << firstEventIndex + startAt << ",?)"
+          << " pulseIndex=" << pulseIndex << " of " << event_index->size();
+      throw std::runtime_error(msg.str());
+    }
+  }
+}
+
+/** Find the pulse holding an event, the last one starting at or before it
+ * @param eventIndex :: the index of the event in the arrays
+ * @return the index of the pulse
+ */
+size_t ProcessBankData::getFirstPulseIndex(const size_t eventIndex) const {
+  const auto next =
+      std::upper_bound(event_index->cbegin(), event_index->cend(), static_cast<uint64_t>(startAt + eventIndex));
+  return next == event_index->cbegin() ? 0 : std::distance(event_index->cbegin(), next) - 1;
+}
 
 size_t ProcessBankData::getFirstEventIndex(const size_t pulseIndex) const {
   const auto firstEventIndex = event_index->operator[](pulseIndex);
@@ -0,0 +1,36 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataHandling/SaveMappedEvents.h"
+#include "MantidAPI/FileProperty.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/MappedEventFile.h"
+
+namespace Mantid {
+namespace DataHandling {
+
+// Register the algorithm into the AlgorithmFactory
+DECLARE_ALGORITHM(SaveMappedEvents)
+
+using namespace Kernel;
+using namespace API;
+using namespace DataObjects;
+
+void SaveMappedEvents::init() {
+  declareProperty(std::make_unique<WorkspaceProperty<EventWorkspace>>("InputWorkspace", "", Direction::Input),
+                  "The EventWorkspace to save");
+  declareProperty(std::make_unique<FileProperty>("Filename", "", FileProperty::Save, ".mevents"),
+                  "The name of the file to write");
+}
+
+void SaveMappedEvents::exec() {
+  EventWorkspace_const_sptr inputWS = getProperty("InputWorkspace");
+  const std::string filename = getPropertyValue("Filename");
+  MappedEventFile::save(*inputWS, filename);
+}
+
+} // namespace DataHandling
+} // namespace Mantid
@@ -0,0 +1,121 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataHandling/EventProcessingQueue.h"
+#include "MantidKernel/FunctionTask.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <atomic>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+using Mantid::DataHandling::EventProcessingQueue;
+using Mantid::Kernel::FunctionTask;
+
+class EventProcessingQueueTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventProcessingQueueTest *createSuite() { return new EventProcessingQueueTest(); }
+  static void destroySuite(EventProcessingQueueTest *suite) { delete suite; }
+
+  void test_constructor_requires_room_for_a_task() {
+    TS_ASSERT_THROWS(EventProcessingQueue(0, 100), const std::invalid_argument &);
+  }
+
+  void test_runs_all_tasks() {
+    std::atomic<int> count{0};
+    EventProcessingQueue queue(4, 1000);
+    for (int i = 0; i < 100; ++i)
+      queue.push(makeTask([&count]() { ++count; }), 10);
+    queue.wait();
+    TS_ASSERT_EQUALS(count, 100);
+    TS_ASSERT_EQUALS(queue.size(), 0);
+    TS_ASSERT_EQUALS(queue.bytes(), 0);
+  }
+
+  void test_limits_tasks_and_bytes() {
+    std::atomic<size_t> running{0};
+    std::atomic<size_t> mostRunning{0};
+    EventProcessingQueue queue(3, 50);
+    for (int i = 0; i < 50; ++i) {
+      queue.push(makeTask([&]() {
+                   const size_t now = ++running;
+                   size_t most = mostRunning;
+                   while (now > most && !mostRunning.compare_exchange_weak(most, now)) {
+                   }
+                   --running;
+                 }),
+                 20);
+      TS_ASSERT_LESS_THAN_EQUALS(queue.size(), 2);
+      TS_ASSERT_LESS_THAN_EQUALS(queue.bytes(), 40);
+    }
+    queue.wait();
+    TS_ASSERT_LESS_THAN_EQUALS(mostRunning, 2);
+  }
+
+  void test_accepts_a_task_larger_than_the_memory_limit_when_empty() {
+    bool ran = false;
+    EventProcessingQueue queue(2, 10);
+    queue.push(makeTask([&ran]() { ran = true; }), 100);
+    queue.wait();
+    TS_ASSERT(ran);
+  }
+
+  void test_tasks_sharing_a_mutex_run_one_at_a_time() {
+    auto mutex = std::make_shared<std::mutex>();
+    std::atomic<int> running{0};
+    std::atomic<bool> overlapped{false};
+    EventProcessingQueue queue(8, 1000);
+    for (int i = 0; i < 20; ++i) {
+      auto task = makeTask([&]() {
+        if (++running > 1)
+          overlapped = true;
+        --running;
+      });
+      task->setMutex(mutex);
+      queue.push(task, 1);
+    }
+    queue.wait();
+    TS_ASSERT(!overlapped);
+  }
+
+  void test_tasks_sharing_a_mutex_run_in_order() {
+    auto mutex = std::make_shared<std::mutex>();
+    std::vector<int> order;
+    EventProcessingQueue queue(4, 1000);
+    for (int i = 0; i < 20; ++i) {
+      auto task = makeTask([&order, i]() { order.emplace_back(i); });
+      task->setMutex(mutex);
+      queue.push(task, 1);
+      // Tasks without the mutex are not held up by those with it
+      queue.push(makeTask([]() {}), 1);
+    }
+    queue.wait();
+    std::vector<int> expected(20);
+    std::iota(expected.begin(), expected.end(), 0);
+    TS_ASSERT_EQUALS(order, expected);
+    TS_ASSERT_EQUALS(queue.size(), 0);
+  }
+
+  void test_wait_rethrows_task_errors() {
+    EventProcessingQueue queue(1, 1000);
+    queue.push(makeTask([]() { throw std::runtime_error("failed"); }), 1);
+    // The queue must not block on the failed task
+    queue.push(makeTask([]() {}), 1);
+    TS_ASSERT_THROWS(queue.wait(), const std::runtime_error &);
+  }
+
+private:
+  std::shared_ptr<FunctionTask> makeTask(std::function<void()> func) {
+    return std::make_shared<FunctionTask>(std::move(func));
+  }
+};
@@ -152,6 +152,51 @@ void run_MPI_load(const Parallel::Communicator &comm, const std::shared_ptr<std:
 
 class LoadEventNexusTest : public CxxTest::TestSuite {
 private:
+  EventWorkspace_sptr loadWithReadQueue(const int readQueueDepth, const int readQueueMemory,
+                                        const std::string &compressTolerance = "-1",
+                                        const double compressWallClockTolerance = EMPTY_DBL()) {
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setRethrows(true);
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_read_queue");
+    ld.setProperty("ReadQueueDepth", readQueueDepth);
+    ld.setProperty("ReadQueueMemory", readQueueMemory);
+    ld.setPropertyValue("CompressTolerance", compressTolerance);
+    ld.setProperty("CompressWallClockTolerance", compressWallClockTolerance);
+    ld.setProperty<bool>("LoadLogs", false); // Time-saver
+    ld.execute();
+    TS_ASSERT(ld.isExecuted());
+    return AnalysisDataService::Instance().retrieveWS<EventWorkspace>("cncs_read_queue");
+  }
+
+  void compareCompressedEvents(EventWorkspace &expected, EventWorkspace &actual) {
+    TS_ASSERT_EQUALS(actual.getNumberHistograms(), expected.getNumberHistograms());
+    TS_ASSERT_EQUALS(actual.getNumberEvents(), expected.getNumberEvents());
+    for (size_t wi = 0; wi < expected.getNumberHistograms(); ++wi) {
+      auto &expectedList = expected.getSpectrum(wi);
+      auto &actualList = actual.getSpectrum(wi);
+      TS_ASSERT_EQUALS(actualList.getEventType(), expectedList.getEventType());
+      if (actualList.getNumberEvents() != expectedList.getNumberEvents()) {
+        TS_FAIL("Number of events of workspace index " + std::to_string(wi) + " differ");
+        return;
+      }
+      for (size_t i = 0; i < expectedList.getNumberEvents(); ++i) {
+        const auto expectedEvent = expectedList.getEvent(i);
+        const auto actualEvent = actualList.getEvent(i);
+        // The averaged pulse times are rounded to the nanosecond
+        if (std::abs(actualEvent.tof() - expectedEvent.tof()) > 1e-6 ||
+            std::abs(actualEvent.weight() - expectedEvent.weight()) > 1e-10 ||
+            std::abs(actualEvent.errorSquared() - expectedEvent.errorSquared()) > 1e-10 ||
+            std::abs(actualEvent.pulseTime().totalNanoseconds() - expectedEvent.pulseTime().totalNanoseconds()) >
+                1000) {
+          TS_FAIL("Events of workspace index " + std::to_string(wi) + " differ");
+          return;
+        }
+      }
+    }
+  }
+
   void do_test_filtering_start_and_end_filtered_loading(const bool metadataonly) {
     const std::string wsName = "test_filtering";
     const double filterStart = 1;
@@ -447,6 +492,49 @@ public:
     }
   }
 
+  void test_load_in_slices_matches_whole_banks() {
+    auto wholeBanks = loadWithReadQueue(EMPTY_INT(), EMPTY_INT());
+    // 1 MB shared by 1000 slices makes them a few hundred events each
+    auto slices = loadWithReadQueue(1000, 1);
+    TS_ASSERT_EQUALS(slices->getNumberHistograms(), wholeBanks->getNumberHistograms());
+    TS_ASSERT_EQUALS(slices->getNumberEvents(), wholeBanks->getNumberEvents());
+    for (size_t i = 0; i < wholeBanks->getNumberHistograms(); ++i) {
+      // The slices of a bank are added in order, so the events are too
+      if (slices->getSpectrum(i) != wholeBanks->getSpectrum(i)) {
+        TS_FAIL("Events of workspace index " + std::to_string(i) + " differ");
+        break;
+      }
+    }
+  }
+
+  void test_load_with_ReadQueueMemory_and_CompressTolerance_keeps_all_events() {
+    // With a zero tolerance only identical tofs are combined, so compressing
+    // each slice gives the same events as compressing whole banks
+    auto wholeBanks = loadWithReadQueue(EMPTY_INT(), EMPTY_INT(), "0");
+    auto limited = loadWithReadQueue(1000, 1, "0");
+    TS_ASSERT_EQUALS(limited->getNumberEvents(), wholeBanks->getNumberEvents());
+    for (size_t i = 0; i < wholeBanks->getNumberHistograms(); ++i) {
+      if (limited->getSpectrum(i) != wholeBanks->getSpectrum(i)) {
+        TS_FAIL("Events of workspace index " + std::to_string(i) + " differ");
+        break;
+      }
+    }
+  }
+
+  void test_load_with_CompressTolerance_does_not_depend_on_the_slices() {
+    // The events are compressed into fixed bins of the tolerance, so only the
+    // rounding of the averaged tofs depends on the slices
+    auto wholeBanks = loadWithReadQueue(EMPTY_INT(), EMPTY_INT(), "0.05");
+    auto slices = loadWithReadQueue(1000, 1, "0.05");
+    compareCompressedEvents(*wholeBanks, *slices);
+  }
+
+  void test_load_with_CompressWallClockTolerance_does_not_depend_on_the_slices() {
+    auto wholeBanks = loadWithReadQueue(EMPTY_INT(), EMPTY_INT(), "0.05", 10.);
+    auto slices = loadWithReadQueue(1000, 1, "0.05", 10.);
+    compareCompressedEvents(*wholeBanks, *slices);
+  }
+
   void test_TOF_filtered_loading() {
     const std::string wsName = "test_filtering";
     const double filterStart = 45000;
@@ -668,13 +756,31 @@ public:
     // Pixels have to be padded
     TS_ASSERT_EQUALS(WS->getNumberHistograms(), 51200);
     // Events
-    TS_ASSERT_EQUALS(WS->getNumberEvents(),
-                     111274); // There are (slightly) fewer events
+    double totalWeight = 0.;
     for (size_t wi = 0; wi < WS->getNumberHistograms(); wi++) {
       // Pixels with at least one event will have switched
       if (WS->getSpectrum(wi).getNumberEvents() > 0)
         TS_ASSERT_EQUALS(WS->getSpectrum(wi).getEventType(), WEIGHTED_NOTIME)
+      totalWeight += WS->getSpectrum(wi).integrate(0., 0., true);
+    }
+    // There are (slightly) fewer events, but they add up to all those in the file
+    TS_ASSERT_LESS_THAN(WS->getNumberEvents(), 112266);
+    TS_ASSERT_DELTA(totalWeight, 112266., 1e-6);
+  }
+
+  void test_Load_And_CompressFatEvents_in_slices() {
+    auto WS = loadWithReadQueue(1000, 1, "0.05", 10.);
+    double totalWeight = 0.;
+    for (size_t wi = 0; wi < WS->getNumberHistograms(); wi++) {
+      const auto &el = WS->getSpectrum(wi);
+      if (el.getNumberEvents() > 0) {
+        TS_ASSERT_EQUALS(el.getEventType(), WEIGHTED);
+      }
+      totalWeight += el.integrate(0., 0., true);
     }
+    // Fewer events, but they add up to all those in the file
+    TS_ASSERT_LESS_THAN(WS->getNumberEvents(), 112266);
+    TS_ASSERT_DELTA(totalWeight, 112266., 1e-6);
   }
 
   void test_Monitors() {
@@ -860,6 +966,37 @@ public:
     do_test_filtering_start_and_end_filtered_loading(metadataonly);
   }
 
+  void test_time_filtered_loading_reads_only_the_pulses_in_the_window() {
+    LoadEventNexus ldAll;
+    ldAll.initialize();
+    ldAll.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ldAll.setPropertyValue("OutputWorkspace", "cncs_all_pulses");
+    TS_ASSERT(ldAll.execute());
+    auto all = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("cncs_all_pulses");
+
+    LoadEventNexus ld;
+    ld.initialize();
+    ld.setPropertyValue("Filename", "CNCS_7860_event.nxs");
+    ld.setPropertyValue("OutputWorkspace", "cncs_pulses_in_window");
+    ld.setProperty("FilterByTimeStart", 10.);
+    ld.setProperty("FilterByTimeStop", 20.);
+    TS_ASSERT(ld.execute());
+    auto filtered = AnalysisDataService::Instance().retrieveWS<EventWorkspace>("cncs_pulses_in_window");
+
+    const auto start = all->getFirstPulseTime() + 10.;
+    const auto stop = all->getFirstPulseTime() + 20.;
+    size_t expected = 0;
+    for (size_t i = 0; i < all->getNumberHistograms(); ++i) {
+      const auto &events = all->getSpectrum(i).getEvents();
+      expected += std::count_if(events.cbegin(), events.cend(), [&start, &stop](const TofEvent &event) {
+        return event.pulseTime() >= start && event.pulseTime() <= stop;
+      });
+    }
+    TS_ASSERT_LESS_THAN(0, expected);
+    TS_ASSERT_LESS_THAN(expected, all->getNumberEvents());
+    TS_ASSERT_EQUALS(filtered->getNumberEvents(), expected);
+  }
+
   void test_start_and_end_time_filtered_loading() {
     const bool metadataonly = false;
     do_test_filtering_start_and_end_filtered_loading(metadataonly);
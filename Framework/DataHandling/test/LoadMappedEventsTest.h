@@ -0,0 +1,93 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/Axis.h"
+#include "MantidDataHandling/LoadMappedEvents.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/MappedEventFile.h"
+#include "MantidGeometry/Instrument.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/TemporaryFile.h>
+
+using namespace Mantid::API;
+using namespace Mantid::DataHandling;
+using namespace Mantid::DataObjects;
+
+class LoadMappedEventsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static LoadMappedEventsTest *createSuite() { return new LoadMappedEventsTest(); }
+  static void destroySuite(LoadMappedEventsTest *suite) { delete suite; }
+
+  LoadMappedEventsTest() : m_input(WorkspaceCreationHelper::createEventWorkspace2(10, 20)) {
+    MappedEventFile::save(*m_input, m_file.path());
+  }
+
+  void test_Init() {
+    LoadMappedEvents alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT(alg.isInitialized());
+  }
+
+  void test_load() {
+    const auto output = load();
+    TS_ASSERT_EQUALS(output->getNumberHistograms(), m_input->getNumberHistograms());
+    TS_ASSERT_EQUALS(output->getNumberEvents(), m_input->getNumberEvents());
+    TS_ASSERT_EQUALS(output->getAxis(0)->unit()->unitID(), "TOF");
+    for (size_t i = 0; i < output->getNumberHistograms(); ++i) {
+      const auto &eventList = output->getSpectrum(i);
+      TS_ASSERT(eventList.hasMappedStorage());
+      TS_ASSERT_EQUALS(eventList.getSpectrumNo(), m_input->getSpectrum(i).getSpectrumNo());
+      TS_ASSERT_EQUALS(eventList.getDetectorIDs(), m_input->getSpectrum(i).getDetectorIDs());
+      TS_ASSERT(eventList == m_input->getSpectrum(i));
+    }
+    // A single bin covering every event
+    TS_ASSERT_EQUALS(output->x(0).size(), 2);
+    TS_ASSERT_EQUALS(output->x(0).front(), m_input->getTofMin());
+    TS_ASSERT_DELTA(output->y(0)[0], static_cast<double>(m_input->getSpectrum(0).getNumberEvents()), 1e-9);
+  }
+
+  void test_load_with_template() {
+    const auto output = load(m_input);
+    TS_ASSERT_EQUALS(output->getInstrument()->getName(), m_input->getInstrument()->getName());
+    TS_ASSERT_EQUALS(output->getNumberEvents(), m_input->getNumberEvents());
+    TS_ASSERT(output->getSpectrum(0).hasMappedStorage());
+  }
+
+  void test_template_with_wrong_number_of_spectra_throws() {
+    LoadMappedEvents alg;
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.initialize();
+    alg.setPropertyValue("Filename", m_file.path());
+    alg.setProperty("TemplateWorkspace", WorkspaceCreationHelper::createEventWorkspace2(5, 20));
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    TS_ASSERT_THROWS(alg.execute(), const std::invalid_argument &);
+  }
+
+private:
+  EventWorkspace_sptr load(const MatrixWorkspace_sptr &templateWS = nullptr) {
+    LoadMappedEvents alg;
+    alg.setChild(true);
+    alg.setRethrows(true);
+    alg.initialize();
+    alg.setPropertyValue("Filename", m_file.path());
+    if (templateWS)
+      alg.setProperty("TemplateWorkspace", templateWS);
+    alg.setPropertyValue("OutputWorkspace", "unused");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    return alg.getProperty("OutputWorkspace");
+  }
+
+  EventWorkspace_sptr m_input;
+  Poco::TemporaryFile m_file;
+};
@@ -0,0 +1,51 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidDataHandling/SaveMappedEvents.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/MappedEventFile.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <Poco/File.h>
+
+using namespace Mantid::DataHandling;
+using namespace Mantid::DataObjects;
+
+class SaveMappedEventsTest : public CxxTest::TestSuite {
+public:
+  void test_Init() {
+    SaveMappedEvents alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize());
+    TS_ASSERT(alg.isInitialized());
+  }
+
+  void test_save() {
+    const auto ws = WorkspaceCreationHelper::createEventWorkspace2(10, 20);
+    SaveMappedEvents alg;
+    alg.initialize();
+    alg.setProperty("InputWorkspace", ws);
+    alg.setPropertyValue("Filename", "SaveMappedEventsTest.mevents");
+    const std::string filename = alg.getPropertyValue("Filename");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    TS_ASSERT(alg.isExecuted());
+
+    const auto file = MappedEventFile::open(filename);
+    TS_ASSERT_EQUALS(file->getNumberHistograms(), 10);
+    TS_ASSERT_EQUALS(file->getEvents(0).size(), ws->getSpectrum(0).getNumberEvents());
+    Poco::File(filename).remove();
+  }
+
+  void test_histogram_workspace_is_not_accepted() {
+    SaveMappedEvents alg;
+    alg.initialize();
+    TS_ASSERT_THROWS(alg.setProperty("InputWorkspace", WorkspaceCreationHelper::create2DWorkspace(2, 3)),
+                     const std::invalid_argument &);
+  }
+};
@@ -0,0 +1,74 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** CompactEvents : 8 bytes per event storage for the TofEvents of an
+  EventList.
+
+  The time-of-flight of each event is held as a float, which is how it is
+  stored in NeXus event files, and the pulse time as a 32-bit index into a
+  table of the distinct pulse times. The table is shared by all the lists of a
+  workspace (see EventWorkspace::setCompactStorage()), so its memory is
+  negligible next to the events, and each event takes half the 16 bytes of a
+  TofEvent.
+
+  Unpacking gives back the events with their tof rounded to float precision,
+  so the events are unchanged if their tofs came from a float in the first
+  place.
+*/
+class MANTID_DATAOBJECTS_DLL CompactEvents {
+public:
+  /// Sorted distinct pulse times, indexed by the events
+  using PulseTimeTable = std::vector<Types::Core::DateAndTime>;
+
+  static std::shared_ptr<const PulseTimeTable> makePulseTimeTable(const std::vector<Types::Event::TofEvent> &events);
+
+  CompactEvents(const std::vector<Types::Event::TofEvent> &events, std::shared_ptr<const PulseTimeTable> pulseTimes);
+
+  void unpack(std::vector<Types::Event::TofEvent> &events) const;
+
+  /// Number of events
+  size_t size() const { return m_tof.size(); }
+  /// True if there are no events
+  bool empty() const { return m_tof.empty(); }
+  size_t getMemorySize() const;
+
+  /// The time-of-flight of each event
+  const std::vector<float> &tofs() const { return m_tof; }
+  /// The table the pulse time indices refer to
+  const std::shared_ptr<const PulseTimeTable> &pulseTimeTable() const { return m_pulseTimes; }
+
+  void sortTof();
+  void reverse();
+
+  double getTofMin(const bool sorted) const;
+  double getTofMax(const bool sorted) const;
+
+  void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
+  void integrate(const double minX, const double maxX, const bool entireRange, double &sum, double &error) const;
+
+private:
+  /// Time-of-flight (or whichever unit the list is in) of each event
+  std::vector<float> m_tof;
+  /// Index of the pulse time of each event in the table
+  std::vector<uint32_t> m_pulseIndex;
+  /// The pulse times, shared with other lists
+  std::shared_ptr<const PulseTimeTable> m_pulseTimes;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -51,6 +51,8 @@ public:
                           const Mantid::Kernel::VMD &scaling);
 
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyToPoints(const coord_t *inputVectors, const size_t inputStride, const size_t numPoints,
+                     coord_t *outVectors) const override;
 
   static CoordTransformAffine *combineTransformations(CoordTransform *first, CoordTransform *second);
 
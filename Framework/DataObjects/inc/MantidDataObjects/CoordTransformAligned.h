@@ -46,6 +46,8 @@ public:
   std::string toXMLString() const override;
   std::string id() const override;
   void apply(const coord_t *inputVector, coord_t *outVector) const override;
+  void applyToPoints(const coord_t *inputVectors, const size_t inputStride, const size_t numPoints,
+                     coord_t *outVectors) const override;
   Mantid::Kernel::Matrix<coord_t> makeAffineMatrix() const override;
 
 protected:
@@ -0,0 +1,102 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class Unit;
+}
+namespace DataObjects {
+
+/** EventColumns : structure-of-arrays storage for the events of an EventList.
+
+  Every property of the events lives in its own contiguous column, so passes
+  that only look at the time-of-flight (conversion, masking, sorting keys,
+  histogramming of counts) stream through 8 bytes per event rather than the
+  16 or 24 bytes of the TofEvent/WeightedEvent structs, and the loops over the
+  tof column can be vectorized by the compiler.
+
+  Which columns are filled depends on the event type that was packed:
+   - TOF             : tof, pulse time
+   - WEIGHTED        : tof, pulse time, weight, error squared
+   - WEIGHTED_NOTIME : tof, weight, error squared
+
+  The EventList owns an instance of this class when it is switched to column
+  storage; see EventList::setColumnStorage().
+*/
+class MANTID_DATAOBJECTS_DLL EventColumns {
+public:
+  EventColumns() = default;
+  explicit EventColumns(const std::vector<Types::Event::TofEvent> &events);
+  explicit EventColumns(const std::vector<WeightedEvent> &events);
+  explicit EventColumns(const std::vector<WeightedEventNoTime> &events);
+
+  void unpack(std::vector<Types::Event::TofEvent> &events) const;
+  void unpack(std::vector<WeightedEvent> &events) const;
+  void unpack(std::vector<WeightedEventNoTime> &events) const;
+
+  /// The type of events held in the columns
+  API::EventType getEventType() const { return m_eventType; }
+  /// Number of events held in the columns
+  size_t size() const { return m_tof.size(); }
+  /// True if there are no events
+  bool empty() const { return m_tof.empty(); }
+  size_t getMemorySize() const;
+  void clear();
+
+  /// The time-of-flight column
+  const std::vector<double> &tofs() const { return m_tof; }
+  /// The pulse time column in nanoseconds. Empty for WEIGHTED_NOTIME.
+  const std::vector<int64_t> &pulseTimes() const { return m_pulseTime; }
+  /// The weight column. Empty for TOF.
+  const std::vector<float> &weights() const { return m_weight; }
+  /// The error squared column. Empty for TOF.
+  const std::vector<float> &errorSquareds() const { return m_errorSquared; }
+
+  void sortTof();
+  void reverse();
+
+  void convertTof(const double factor, const double offset);
+  void convertTof(const std::function<double(double)> &func);
+  void convertUnitsViaTof(const Kernel::Unit &fromUnit, const Kernel::Unit &toUnit);
+  size_t maskTof(const double tofMin, const double tofMax);
+
+  double getTofMin(const bool sorted) const;
+  double getTofMax(const bool sorted) const;
+  void getWeights(std::vector<double> &weights) const;
+  void getWeightErrors(std::vector<double> &weightErrors) const;
+
+  void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
+  void generateWeightedHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E) const;
+  void integrate(const double minX, const double maxX, const bool entireRange, double &sum, double &error) const;
+
+private:
+  void eraseRange(const size_t first, const size_t last);
+  std::vector<size_t> binStarts(const MantidVec &X) const;
+
+  /// Which event type was packed
+  API::EventType m_eventType{API::TOF};
+  /// Time-of-flight (or whichever unit the list is in) of each event
+  std::vector<double> m_tof;
+  /// Pulse time of each event in nanoseconds
+  std::vector<int64_t> m_pulseTime;
+  /// Weight of each event
+  std::vector<float> m_weight;
+  /// Square of the error of each event
+  std::vector<float> m_errorSquared;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,74 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventHistogrammer : histograms events into linear or logarithmic bins
+  without sorting them first.
+
+  When the bin edges are (close to) evenly spaced in x or in log(x), as
+  produced by Rebin with a positive or negative step, the bin of an event can
+  be estimated arithmetically rather than by searching the edges. The
+  estimates are computed in fixed size batches with branch-free loops that the
+  compiler can vectorize, and are then corrected against the actual edges so
+  the result is identical to a search: an event is counted in bin i when
+  X[i] <= tof < X[i+1]. Events outside [X.front(), X.back()) are ignored.
+
+  For any other set of edges isRegular() returns false and the caller must
+  use the sorted histogramming of EventList instead. Only accumulate() also
+  accepts irregular edges, which it searches.
+*/
+class MANTID_DATAOBJECTS_DLL EventHistogrammer {
+public:
+  /// The kind of bin edges recognised
+  enum class Binning { Linear, Logarithmic, Irregular };
+
+  explicit EventHistogrammer(const MantidVec &X);
+
+  /// The kind of bin edges that were supplied
+  Binning binning() const { return m_binning; }
+  /// True if the bins can be found arithmetically
+  bool isRegular() const { return m_binning != Binning::Irregular; }
+
+  void histogram(const std::vector<Types::Event::TofEvent> &events, MantidVec &Y) const;
+  void histogram(const std::vector<WeightedEvent> &events, MantidVec &Y, MantidVec &E) const;
+  void histogram(const std::vector<WeightedEventNoTime> &events, MantidVec &Y, MantidVec &E) const;
+  void histogram(const std::vector<double> &tofs, MantidVec &Y) const;
+  void histogram(const std::vector<float> &tofs, MantidVec &Y) const;
+  void histogram(const std::vector<double> &tofs, const std::vector<float> &weights,
+                 const std::vector<float> &errorSquareds, MantidVec &Y, MantidVec &E) const;
+  void accumulate(const std::vector<double> &xs, const std::vector<double> &weights,
+                  const std::vector<double> &errorSquareds, MantidVec &Y, MantidVec &E2) const;
+
+private:
+  template <typename TofAt, typename Accumulate>
+  void forEachBin(const size_t numEvents, const TofAt &tofAt, const Accumulate &accumulate) const;
+  void estimateBins(const double *tofs, const size_t count, int *bins) const;
+  void resetHistogram(MantidVec &Y) const;
+  template <typename T> void weightedHistogram(const std::vector<T> &events, MantidVec &Y, MantidVec &E) const;
+
+  /// The bin edges. Must outlive the histogrammer.
+  const MantidVec &m_X;
+  /// The kind of bin edges
+  Binning m_binning{Binning::Irregular};
+  /// The value the arithmetic estimate is measured from: X[0] or log(X[0])
+  double m_origin{0.};
+  /// Inverse of the bin width, in x or in log(x)
+  double m_inverseStep{0.};
+  /// The index of the last bin
+  int m_lastBin{0};
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -11,7 +11,9 @@
 #include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/System.h"
 #include "MantidKernel/cow_ptr.h"
+#include <atomic>
 #include <iosfwd>
+#include <memory>
 #include <vector>
 
 namespace Mantid {
@@ -26,7 +28,12 @@ using TimeSplitterType = std::vector<SplittingInterval>;
 class Unit;
 } // namespace Kernel
 namespace DataObjects {
+class CompactEvents;
+class EventColumns;
+class EventHistogrammer;
+class EventSplitter;
 class EventWorkspaceMRU;
+class MappedEvents;
 
 /// How the event list is sorted.
 enum EventSortType {
@@ -50,6 +57,19 @@ enum EventSortType {
     or WeightedEvent (where each neutron can have a non-1 weight).
     This is done transparently.
 
+    The events can optionally be held as columns (see EventColumns) rather
+    than as a vector of event structs. The tof-only operations (convertTof,
+    maskTof, sortTof, generateHistogram, integrate...) then work directly on
+    the contiguous tof column; any other operation transparently converts
+    the list back to a vector of events first.
+
+    Lists of TofEvents can also be stored compactly, in 8 bytes per event (see
+    CompactEvents), in the same transparent way.
+
+    Finally the events can be a read-only view of a memory-mapped file (see
+    MappedEventFile), which is copied into a vector of events the first time
+    the list is modified.
+
     @author Janik Zikovsky, SNS ORNL
     @date 4/02/2010
 */
@@ -103,6 +123,8 @@ public:
    * @param event :: TofEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const Types::Event::TofEvent &event) {
+    if (m_packed)
+      unpackEvents();
     this->events.emplace_back(event);
     this->order = UNSORTED;
   }
@@ -113,6 +135,8 @@ public:
    * @param event :: WeightedEvent to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEvent &event) {
+    if (m_packed)
+      unpackEvents();
     this->weightedEvents.emplace_back(event);
     this->order = UNSORTED;
   }
@@ -123,6 +147,8 @@ public:
    * @param event :: WeightedEventNoTime to add at the end of the list.
    * */
   inline void addEventQuickly(const WeightedEventNoTime &event) {
+    if (m_packed)
+      unpackEvents();
     this->weightedEventsNoTime.emplace_back(event);
     this->order = UNSORTED;
   }
@@ -151,6 +177,19 @@ public:
 
   void reserve(size_t num) override;
 
+  void setColumnStorage(const bool useColumns);
+
+  bool hasColumnStorage() const;
+
+  void setCompactStorage(const bool useCompact,
+                         std::shared_ptr<const std::vector<Types::Core::DateAndTime>> pulseTimes = nullptr);
+
+  bool hasCompactStorage() const;
+
+  void setMappedEvents(const MappedEvents &events);
+
+  bool hasMappedStorage() const;
+
   void sort(const EventSortType order) const;
 
   void setSortOrder(const EventSortType order) const;
@@ -270,6 +309,9 @@ public:
   void splitByFullTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs, bool docorrection,
                        double toffactor, double tofshift) const;
 
+  void splitByFullTime(const EventSplitter &splitter, const std::vector<EventList *> &outputs, bool docorrection,
+                       double toffactor, double tofshift) const;
+
   /// Split ...
   std::string splitByFullTimeMatrixSplitter(const std::vector<int64_t> &vec_splitters_time,
                                             const std::vector<int> &vecgroups,
@@ -278,6 +320,7 @@ public:
 
   /// Split events by pulse time
   void splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs) const;
+  void splitByPulseTime(const EventSplitter &splitter, const std::vector<EventList *> &outputs) const;
 
   /// Split events by pulse time with Matrix splitters
   void splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
@@ -339,6 +382,19 @@ private:
   /// List of WeightedEvent's
   mutable std::vector<WeightedEventNoTime> weightedEventsNoTime;
 
+  /// The events, when the list uses column storage. Null otherwise.
+  mutable std::unique_ptr<EventColumns> m_columns;
+
+  /// The events, when the list uses compact storage. Null otherwise.
+  mutable std::unique_ptr<CompactEvents> m_compact;
+
+  /// The events, when the list is a view of a mapped file. Null otherwise.
+  mutable std::unique_ptr<MappedEvents> m_mapped;
+
+  /// True while the events are held as columns, compactly or in a mapped
+  /// file. Checked before taking m_sortMutex to unpack them.
+  mutable std::atomic<bool> m_packed{false};
+
   /// What type of event is in our list.
   Mantid::API::EventType eventType;
 
@@ -369,8 +425,15 @@ private:
 
   void generateErrorsHistogram(const MantidVec &Y, MantidVec &E) const;
 
+  void histogramUnsorted(const EventHistogrammer &histogrammer, MantidVec &Y, MantidVec &E,
+                         const bool skipError) const;
+
   void switchToWeightedEvents();
   void switchToWeightedEventsNoTime();
+  void unpackColumns() const;
+  void unpackCompact() const;
+  void unpackMapped() const;
+  void unpackEvents() const;
   // should not be called externally
   void sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start, const double seconds) const;
 
@@ -419,14 +482,14 @@ private:
   template <class T>
   void splitByTimeHelper(Kernel::TimeSplitterType &splitter, std::vector<EventList *> outputs,
                          typename std::vector<T> &events) const;
-  template <class T>
-  void splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
-                             typename std::vector<T> &events, bool docorrection, double toffactor,
-                             double tofshift) const;
-  /// Split events by pulse time
-  template <class T>
-  void splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
-                              typename std::vector<T> &events) const;
+  void prepareSplitOutputs(const EventSplitter &splitter, const std::vector<EventList *> &outputs) const;
+  /// Split events with an EventSplitter, by the time given by timeOfEvent
+  template <class TimeOfEvent>
+  void splitByEventTime(const EventSplitter &splitter, const std::vector<EventList *> &outputs,
+                        const TimeOfEvent &timeOfEvent) const;
+  template <class T, class TimeOfEvent>
+  static void splitByEventTimeHelper(const EventSplitter &splitter, const std::vector<EventList *> &outputs,
+                                     const std::vector<T> &events, const TimeOfEvent &timeOfEvent);
 
   /// Split events (template) by pulse time with matrix splitters
   template <class T>
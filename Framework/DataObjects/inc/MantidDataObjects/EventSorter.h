@@ -0,0 +1,55 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** EventSorter : sorts event vectors by time-of-flight and/or pulse time with
+  a least significant digit radix sort.
+
+  The tof (double or float) and pulse time (nanoseconds as int64) of each
+  event are mapped to unsigned integers that sort in the same order, and the
+  events are distributed on 11 bits of that key at a time. A pass is skipped
+  when all the events share its digit, which is the case for the high bits of
+  the pulse times of a run, so the sort usually takes four or five linear
+  passes over the events whatever their number. Sorting by pulse time then
+  tof is a pass over the tofs followed by passes over the pulse times, since
+  each pass is stable.
+
+  Large vectors are split into blocks that are counted and scattered by
+  different threads, so a single very large spectrum is sorted in parallel.
+  Small vectors are sorted with std::sort. The radix sort needs a second
+  buffer as large as the events it sorts.
+
+  NaN tofs are placed at the end (or the start if their sign bit is set)
+  rather than anywhere, and -0 is placed before +0.
+*/
+class MANTID_DATAOBJECTS_DLL EventSorter {
+public:
+  static void sortTof(std::vector<Types::Event::TofEvent> &events);
+  static void sortTof(std::vector<WeightedEvent> &events);
+  static void sortTof(std::vector<WeightedEventNoTime> &events);
+  static void sortTof(std::vector<std::pair<double, size_t>> &keys);
+  static void sortTof(std::vector<std::pair<float, uint32_t>> &events);
+
+  static void sortPulseTime(std::vector<Types::Event::TofEvent> &events);
+  static void sortPulseTime(std::vector<WeightedEvent> &events);
+
+  static void sortPulseTimeTof(std::vector<Types::Event::TofEvent> &events);
+  static void sortPulseTimeTof(std::vector<WeightedEvent> &events);
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -0,0 +1,97 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/DllConfig.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <vector>
+
+namespace Mantid {
+namespace Kernel {
+class SplittingInterval;
+using TimeSplitterType = std::vector<SplittingInterval>;
+} // namespace Kernel
+namespace DataObjects {
+class EventList;
+
+/** EventSplitter : a TimeSplitterType compiled into a flat array of time
+  boundaries, for routing the events of many EventLists to their outputs.
+
+  The time line is cut into regions, each starting at a boundary and ending at
+  the next one, and each region sends its events to one output or to none.
+  The outputs are numbered densely in the order of targets(), which holds the
+  index of every splitting interval and -1, the target of the events that are
+  in no interval. Compiling the splitter follows EventList::splitByFullTime():
+  the intervals are taken in order, the events before an interval and in the
+  gaps between intervals go to -1, and the events after the last interval go
+  to no output.
+
+  findRegion() takes the region of the previous event as a hint. For events
+  sorted by time it only ever steps to the next regions, so routing a list is
+  a merge of its events with the boundaries rather than a search per event.
+*/
+class MANTID_DATAOBJECTS_DLL EventSplitter {
+public:
+  /// Output of the regions whose events are not kept
+  static constexpr size_t NO_OUTPUT = std::numeric_limits<size_t>::max();
+
+  explicit EventSplitter(const Kernel::TimeSplitterType &splitter);
+
+  /// The target index of each output
+  const std::vector<int> &targets() const { return m_targets; }
+  /// Number of outputs
+  size_t numberOfOutputs() const { return m_targets.size(); }
+  size_t outputIndex(const int target) const;
+  std::vector<EventList *> selectOutputs(const std::map<int, EventList *> &outputs) const;
+
+  /// Number of regions
+  size_t numberOfRegions() const { return m_boundaries.size(); }
+  /// Start time of a region in nanoseconds
+  int64_t regionStart(const size_t region) const { return m_boundaries[region]; }
+  /// Output of a region, or NO_OUTPUT
+  size_t regionOutput(const size_t region) const { return m_outputs[region]; }
+
+  /** Find the region holding a time
+   * @param time :: the time in nanoseconds
+   * @param hint :: a region to look at first, usually that of the previous
+   * event
+   * @return the region that holds the time
+   */
+  inline size_t findRegion(const int64_t time, size_t hint) const {
+    if (time < m_boundaries[hint])
+      return static_cast<size_t>(
+                 std::distance(m_boundaries.cbegin(),
+                               std::upper_bound(m_boundaries.cbegin(), m_boundaries.cbegin() + hint, time))) -
+             1;
+    // Events sorted by time mostly stay in the same region or go to the next
+    const size_t numRegions = m_boundaries.size();
+    for (size_t step = 0; step < 4; ++step, ++hint) {
+      if (hint + 1 == numRegions || time < m_boundaries[hint + 1])
+        return hint;
+    }
+    return static_cast<size_t>(std::distance(m_boundaries.cbegin(),
+                                             std::upper_bound(m_boundaries.cbegin() + hint, m_boundaries.cend(), time))) -
+           1;
+  }
+
+private:
+  void addRegion(const int64_t start, const size_t output);
+
+  /// Start time of each region in nanoseconds. The first is the lowest int64.
+  std::vector<int64_t> m_boundaries;
+  /// Output of each region
+  std::vector<size_t> m_outputs;
+  /// Target index of each output, in ascending order
+  std::vector<int> m_targets;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
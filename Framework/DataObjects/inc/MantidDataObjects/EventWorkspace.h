@@ -20,6 +20,7 @@ class Progress;
 
 namespace DataObjects {
 class EventWorkspaceMRU;
+class MappedEventFile;
 
 /** \class EventWorkspace
 
@@ -130,6 +131,13 @@ public:
   // Change the event type
   void switchEventType(const Mantid::API::EventType type);
 
+  // Store the events of every list as columns (or back as event vectors)
+  void setColumnStorage(const bool useColumns);
+  // Store the TofEvents of every list compactly (or back as event vectors)
+  void setCompactStorage(const bool useCompact);
+  // Use the events of a mapped file in place
+  void setMappedEvents(const std::shared_ptr<const MappedEventFile> &file);
+
   // Returns true always - an EventWorkspace always represents histogramm-able
   // data
   bool isHistogramData() const override;
@@ -0,0 +1,363 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDBox.h"
+#include "MantidDataObjects/MDEventWorkspace.h"
+#include "MantidDataObjects/MortonIndex/BitInterleaving.h"
+#include "MantidDataObjects/MortonIndex/CoordinateConversion.h"
+#include "MantidKernel/MultiThreaded.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+
+/** An axis-aligned box to query an MDEventSpatialIndex with. Events on the
+ * faces of the box are inside it.
+ */
+template <size_t nd> class MDQueryBox {
+public:
+  MDQueryBox(const coord_t *min, const coord_t *max) {
+    std::copy(min, min + nd, m_min.begin());
+    std::copy(max, max + nd, m_max.begin());
+  }
+  /// Get the bounding box of the query
+  void getBounds(coord_t *min, coord_t *max) const {
+    std::copy(m_min.cbegin(), m_min.cend(), min);
+    std::copy(m_max.cbegin(), m_max.cend(), max);
+  }
+  /// Can any point of the box [min, max] be in the query?
+  bool intersects(const coord_t *min, const coord_t *max) const {
+    for (size_t d = 0; d < nd; ++d) {
+      if (min[d] > m_max[d] || max[d] < m_min[d])
+        return false;
+    }
+    return true;
+  }
+  /// Is the point in the query?
+  bool contains(const coord_t *point) const {
+    for (size_t d = 0; d < nd; ++d) {
+      if (point[d] < m_min[d] || point[d] > m_max[d])
+        return false;
+    }
+    return true;
+  }
+
+private:
+  std::array<coord_t, nd> m_min, m_max;
+};
+
+/** A sphere to query an MDEventSpatialIndex with. As for
+ * MDBoxBase::integrateSphere, events on the surface are outside the sphere.
+ */
+template <size_t nd> class MDQuerySphere {
+public:
+  MDQuerySphere(const coord_t *center, const coord_t radius) : m_radius(radius), m_radiusSquared(radius * radius) {
+    std::copy(center, center + nd, m_center.begin());
+  }
+  /// Get the bounding box of the query
+  void getBounds(coord_t *min, coord_t *max) const {
+    for (size_t d = 0; d < nd; ++d) {
+      min[d] = m_center[d] - m_radius;
+      max[d] = m_center[d] + m_radius;
+    }
+  }
+  /// Can any point of the box [min, max] be in the query?
+  bool intersects(const coord_t *min, const coord_t *max) const {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d) {
+      const coord_t nearest = std::min(std::max(m_center[d], min[d]), max[d]);
+      distanceSquared += (nearest - m_center[d]) * (nearest - m_center[d]);
+    }
+    return distanceSquared < m_radiusSquared;
+  }
+  /// Is the point in the query?
+  bool contains(const coord_t *point) const {
+    coord_t distanceSquared = 0;
+    for (size_t d = 0; d < nd; ++d)
+      distanceSquared += (point[d] - m_center[d]) * (point[d] - m_center[d]);
+    return distanceSquared < m_radiusSquared;
+  }
+
+private:
+  std::array<coord_t, nd> m_center;
+  coord_t m_radius, m_radiusSquared;
+};
+
+/** An ellipsoid to query an MDEventSpatialIndex with, given by its center,
+ * its (orthonormal) principal axes and its radius along each axis. Events on
+ * the surface are outside the ellipsoid.
+ */
+template <size_t nd> class MDQueryEllipsoid {
+public:
+  MDQueryEllipsoid(const coord_t *center, const std::vector<std::vector<double>> &axes,
+                   const std::vector<double> &radii) {
+    if (axes.size() != nd || radii.size() != nd)
+      throw std::invalid_argument("MDQueryEllipsoid: expected one axis and one radius per dimension");
+    std::copy(center, center + nd, m_center.begin());
+    for (size_t k = 0; k < nd; ++k) {
+      if (axes[k].size() != nd)
+        throw std::invalid_argument("MDQueryEllipsoid: the axes must have one component per dimension");
+      if (radii[k] <= 0.)
+        throw std::invalid_argument("MDQueryEllipsoid: the radii must be positive");
+      for (size_t d = 0; d < nd; ++d)
+        m_scaledAxes[k][d] = static_cast<coord_t>(axes[k][d] / radii[k]);
+    }
+    // The half width of the bounding box along d is the length of the
+    // projection of the ellipsoid on that axis
+    for (size_t d = 0; d < nd; ++d) {
+      double halfWidthSquared = 0.;
+      for (size_t k = 0; k < nd; ++k)
+        halfWidthSquared += radii[k] * radii[k] * axes[k][d] * axes[k][d];
+      m_halfWidth[d] = static_cast<coord_t>(std::sqrt(halfWidthSquared));
+    }
+  }
+  /// Get the bounding box of the query
+  void getBounds(coord_t *min, coord_t *max) const {
+    for (size_t d = 0; d < nd; ++d) {
+      min[d] = m_center[d] - m_halfWidth[d];
+      max[d] = m_center[d] + m_halfWidth[d];
+    }
+  }
+  /// Can any point of the box [min, max] be in the query? This only compares
+  /// the bounding boxes, so may be true for a box just off the ellipsoid.
+  bool intersects(const coord_t *min, const coord_t *max) const {
+    for (size_t d = 0; d < nd; ++d) {
+      if (min[d] > m_center[d] + m_halfWidth[d] || max[d] < m_center[d] - m_halfWidth[d])
+        return false;
+    }
+    return true;
+  }
+  /// Is the point in the query?
+  bool contains(const coord_t *point) const {
+    coord_t sum = 0;
+    for (size_t k = 0; k < nd; ++k) {
+      coord_t projection = 0;
+      for (size_t d = 0; d < nd; ++d)
+        projection += (point[d] - m_center[d]) * m_scaledAxes[k][d];
+      sum += projection * projection;
+    }
+    return sum < 1;
+  }
+
+private:
+  std::array<coord_t, nd> m_center, m_halfWidth;
+  /// The axes divided by the radius along them
+  std::array<std::array<coord_t, nd>, nd> m_scaledAxes;
+};
+
+/** MDEventSpatialIndex : finds the events of an MDEventWorkspace in a region
+ * of space without walking the box tree.
+ *
+ * The leaf boxes holding events are kept in a flat array sorted by the
+ * Morton index of their centers. A query looks for the boxes whose centers are
+ * within its bounding box, grown by the largest half width of a leaf box. The
+ * Morton range of that box is split at the highest bit where its corners
+ * differ until each range holds a handful of boxes, so the boxes scanned are
+ * those along the query rather than along the whole Z curve.
+ *
+ * Any of the query shapes above, or a class with the same getBounds,
+ * intersects and contains methods, can be used. Masked boxes are skipped.
+ * The index refers to the boxes of the workspace, so must be built again if
+ * they are split or deleted.
+ *
+ * The Morton index is defined for 3 and 4 dimensions only.
+ */
+template <typename MDE, size_t nd> class MDEventSpatialIndex {
+public:
+  explicit MDEventSpatialIndex(MDEventWorkspace<MDE, nd> &ws);
+
+  /// Number of (non-empty) leaf boxes in the index
+  size_t numBoxes() const { return m_leaves.size(); }
+
+  /** Calls visit(box, events) for each unmasked leaf box that may hold
+   * events in the query. The events of the box are loaded for the call. */
+  template <typename Query, typename Visitor> void forEachBox(const Query &query, Visitor &&visit) const {
+    std::array<coord_t, nd> min, max;
+    query.getBounds(min.data(), max.data());
+    for (size_t d = 0; d < nd; ++d) {
+      min[d] -= m_maxHalfWidth[d];
+      max[d] += m_maxHalfWidth[d];
+    }
+    visitRange(query, toIntCoord(min.data()), toIntCoord(max.data()), visit);
+  }
+
+  /// Calls visit(event) for each event in the query
+  template <typename Query, typename Visitor> void forEachEvent(const Query &query, Visitor &&visit) const {
+    forEachBox(query, [&query, &visit](const MDBox<MDE, nd> &, const std::vector<MDE> &events) {
+      for (const auto &event : events) {
+        if (query.contains(event.getCenter()))
+          visit(event);
+      }
+    });
+  }
+
+  /// Adds the signal and error squared of the events in the query
+  template <typename Query> void integrate(const Query &query, signal_t &signal, signal_t &errorSquared) const {
+    forEachEvent(query, [&signal, &errorSquared](const MDE &event) {
+      signal += static_cast<signal_t>(event.getSignal());
+      errorSquared += static_cast<signal_t>(event.getErrorSquared());
+    });
+  }
+
+  /** Integrates each of the queries, returning the signal and error squared
+   * for each. The queries are run in Morton order of their centers, in
+   * parallel unless the workspace is file backed. */
+  template <typename Query>
+  std::vector<std::pair<signal_t, signal_t>> integrate(const std::vector<Query> &queries) const {
+    std::vector<MortonT> centers(queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+      std::array<coord_t, nd> min, max;
+      queries[i].getBounds(min.data(), max.data());
+      for (size_t d = 0; d < nd; ++d)
+        min[d] = (min[d] + max[d]) / 2;
+      centers[i] = toIndex(toIntCoord(min.data()));
+    }
+    std::vector<size_t> order(queries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&centers](const size_t a, const size_t b) { return centers[a] < centers[b]; });
+
+    std::vector<std::pair<signal_t, signal_t>> result(queries.size(), {0., 0.});
+    const auto numQueries = static_cast<int64_t>(queries.size());
+    PRAGMA_OMP(parallel for schedule(dynamic) if (!m_fileBacked))
+    for (int64_t i = 0; i < numQueries; ++i) {
+      const size_t query = order[i];
+      integrate(queries[query], result[query].first, result[query].second);
+    }
+    return result;
+  }
+
+private:
+  using IntT = typename morton_index::IndexTypes<nd, coord_t>::IntType;
+  using MortonT = typename morton_index::IndexTypes<nd, coord_t>::MortonType;
+  using IntCoord = morton_index::IntArray<nd, IntT>;
+
+  /// A leaf box, with the Morton index of its center
+  struct Leaf {
+    MortonT index;
+    MDBox<MDE, nd> *box;
+    std::array<coord_t, nd> min, max;
+  };
+
+  /// Integer coordinates of a point, which is brought into the workspace
+  IntCoord toIntCoord(const coord_t *point) const {
+    std::array<coord_t, nd> clamped;
+    for (size_t d = 0; d < nd; ++d)
+      clamped[d] = std::min(std::max(point[d], m_space(d, 0)), m_space(d, 1));
+    return morton_index::ConvertCoordinatesToIntegerRange<nd, IntT>(m_space, clamped.data());
+  }
+
+  MortonT toIndex(const IntCoord &coord) const {
+    return morton_index::Interleaver<nd, IntT, MortonT>::interleave(coord);
+  }
+
+  /// Visits the leaves with centers in the integer box [lower, upper]
+  template <typename Query, typename Visitor>
+  void visitRange(const Query &query, const IntCoord &lower, const IntCoord &upper, Visitor &visit) const {
+    auto first = std::lower_bound(m_leaves.cbegin(), m_leaves.cend(), toIndex(lower),
+                                  [](const Leaf &leaf, const MortonT &index) { return leaf.index < index; });
+    auto last = std::upper_bound(first, m_leaves.cend(), toIndex(upper),
+                                 [](const MortonT &index, const Leaf &leaf) { return index < leaf.index; });
+    if (last - first <= MAX_LEAVES_TO_SCAN || (lower == upper).all()) {
+      for (; first != last; ++first) {
+        if (query.intersects(first->min.data(), first->max.data()) && !first->box->getIsMasked()) {
+          const auto &events = first->box->getConstEvents();
+          visit(*first->box, events);
+          first->box->releaseEvents();
+        }
+      }
+      return;
+    }
+    // Split at the highest bit of the Morton index that differs between the
+    // corners: all of the lower half then comes before the upper half.
+    int bit = static_cast<int>(sizeof(IntT)) * 8 - 1;
+    size_t dim = nd;
+    for (; dim == nd; --bit) {
+      for (size_t d = nd; d-- > 0;) {
+        if (((lower[d] ^ upper[d]) >> bit) & 1) {
+          dim = d;
+          break;
+        }
+      }
+    }
+    ++bit;
+    const auto lowBits = static_cast<IntT>((IntT(1) << bit) - 1);
+    IntCoord lowerHalfUpper = upper;
+    lowerHalfUpper[dim] = lower[dim] | lowBits;
+    IntCoord upperHalfLower = lower;
+    upperHalfLower[dim] = upper[dim] & static_cast<IntT>(~lowBits);
+    visitRange(query, lower, lowerHalfUpper, visit);
+    visitRange(query, upperHalfLower, upper, visit);
+  }
+
+  /// Ranges with no more leaves than this are scanned rather than split
+  static constexpr std::ptrdiff_t MAX_LEAVES_TO_SCAN = 16;
+
+  /// The non-empty leaf boxes, sorted by index
+  std::vector<Leaf> m_leaves;
+  /// The extents of the workspace
+  morton_index::MDSpaceBounds<nd> m_space;
+  /// The largest half width of a leaf box along each dimension
+  std::array<coord_t, nd> m_maxHalfWidth;
+  /// Whether the events may have to be loaded from a file
+  bool m_fileBacked;
+};
+
+/** Constructor
+ * @param ws :: the workspace to index
+ * @throw std::invalid_argument if the workspace is not 3 or 4 dimensional
+ */
+template <typename MDE, size_t nd>
+MDEventSpatialIndex<MDE, nd>::MDEventSpatialIndex(MDEventWorkspace<MDE, nd> &ws) : m_fileBacked(ws.isFileBacked()) {
+  if (nd != 3 && nd != 4)
+    throw std::invalid_argument("MDEventSpatialIndex: only 3 and 4 dimensional workspaces can be indexed");
+  auto *root = ws.getBox();
+  for (size_t d = 0; d < nd; ++d) {
+    m_space(d, 0) = root->getExtents(d).getMin();
+    m_space(d, 1) = root->getExtents(d).getMax();
+  }
+  m_maxHalfWidth.fill(0);
+
+  std::vector<API::IMDNode *> boxes;
+  root->getBoxes(boxes, 1000, true);
+  m_leaves.reserve(boxes.size());
+  for (auto *node : boxes) {
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(node);
+    if (!box || box->getNPoints() == 0)
+      continue;
+    Leaf leaf;
+    leaf.box = box;
+    std::array<coord_t, nd> center;
+    for (size_t d = 0; d < nd; ++d) {
+      const auto &extents = box->getExtents(d);
+      leaf.min[d] = extents.getMin();
+      leaf.max[d] = extents.getMax();
+      center[d] = (leaf.min[d] + leaf.max[d]) / 2;
+      m_maxHalfWidth[d] = std::max(m_maxHalfWidth[d], (leaf.max[d] - leaf.min[d]) / 2);
+    }
+    leaf.index = toIndex(toIntCoord(center.data()));
+    m_leaves.emplace_back(std::move(leaf));
+  }
+  // Allow for the rounding of the centers of the boxes
+  for (size_t d = 0; d < nd; ++d) {
+    const coord_t largest = std::max(std::abs(m_space(d, 0)), std::abs(m_space(d, 1)));
+    m_maxHalfWidth[d] += 4 * std::numeric_limits<coord_t>::epsilon() * largest;
+  }
+  std::sort(m_leaves.begin(), m_leaves.end(), [](const Leaf &a, const Leaf &b) { return a.index < b.index; });
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -208,12 +208,13 @@ public:
   }
 #endif
   //---------------------------------------------------------------------------------------------
-  /** Copy constructor
+  /** Copy constructor. Copies the whole union as the index may be wider
+   * than the coordinates.
    * @param rhs :: mdevent to copy
    * */
   MDLeanEvent(const MDLeanEvent &rhs) : signal(rhs.signal), errorSquared(rhs.errorSquared) {
-    for (size_t i = 0; i < nd; i++)
-      center[i] = rhs.center[i];
+    std::memcpy(static_cast<void *>(center), static_cast<const void *>(rhs.center),
+                std::max(sizeof(center), sizeof(index)));
   }
 
   //---------------------------------------------------------------------------------------------
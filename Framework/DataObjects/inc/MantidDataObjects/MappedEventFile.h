@@ -0,0 +1,146 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidAPI/IEventList.h"
+#include "MantidDataObjects/DllConfig.h"
+#include "MantidDataObjects/Events.h"
+#include "MantidGeometry/IDTypes.h"
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Mantid {
+namespace DataObjects {
+class EventWorkspace;
+class MappedEventFile;
+
+/** MappedEvents : read-only view of the events of one EventList held in a
+  MappedEventFile.
+
+  The events are used in place, in the layout of TofEvent, WeightedEvent or
+  WeightedEventNoTime, and are always sorted by time-of-flight. The view keeps
+  the file mapped for as long as it exists.
+*/
+class MANTID_DATAOBJECTS_DLL MappedEvents {
+public:
+  MappedEvents(std::shared_ptr<const MappedEventFile> file, const API::EventType eventType, const void *events,
+               const size_t size);
+
+  /// Type of the events
+  API::EventType getEventType() const { return m_eventType; }
+  /// Number of events
+  size_t size() const { return m_size; }
+  /// True if there are no events
+  bool empty() const { return m_size == 0; }
+  size_t getMemorySize() const;
+
+  const Types::Event::TofEvent *tofEvents() const;
+  const WeightedEvent *weightedEvents() const;
+  const WeightedEventNoTime *weightedEventsNoTime() const;
+
+  double getTofMin() const;
+  double getTofMax() const;
+  void getTofs(std::vector<double> &tofs) const;
+  void getWeights(std::vector<double> &weights) const;
+  void getWeightErrors(std::vector<double> &weightErrors) const;
+
+  void generateCountsHistogram(const MantidVec &X, MantidVec &Y) const;
+  void generateWeightedHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E) const;
+  void integrate(const double minX, const double maxX, const bool entireRange, double &sum, double &error) const;
+
+private:
+  template <typename Function> auto visit(const Function &function) const;
+
+  /// The file holding the events
+  std::shared_ptr<const MappedEventFile> m_file;
+  /// Type of the events
+  API::EventType m_eventType;
+  /// The first event
+  const void *m_events;
+  /// Number of events
+  size_t m_size;
+};
+
+/** MappedEventFile : a file holding the events of an EventWorkspace in the
+  layout they have in memory, mapped read-only so that the EventLists of a
+  workspace use the events in place.
+
+  Opening the file reads nothing but the table of spectra: the operating
+  system pages in the events as they are used, and the pages are shared by
+  every process that maps the same file. An EventList only copies its events
+  into memory when it is modified (see EventList::setMappedEvents()).
+
+  The file is written in the byte order of the machine, and starts with a
+  header:
+
+  | Offset | Type     | Content                                 |
+  | ------ | -------- | --------------------------------------- |
+  | 0      | char[8]  | "MTDEVMAP"                              |
+  | 8      | uint32   | version of the format                   |
+  | 12     | uint32   | 0x01020304, to check the byte order     |
+  | 16     | uint64   | number of spectra                       |
+  | 24     | uint64   | offset of the table of spectra          |
+
+  followed by a table with one record per spectrum:
+
+  | Offset | Type     | Content                                 |
+  | ------ | -------- | --------------------------------------- |
+  | 0      | uint64   | offset of the events                    |
+  | 8      | uint64   | number of events                        |
+  | 16     | uint64   | offset of the detector IDs              |
+  | 24     | uint64   | number of detector IDs                  |
+  | 32     | int32    | spectrum number                         |
+  | 36     | uint32   | event type (API::EventType)             |
+
+  The events of each spectrum are sorted by time-of-flight and stored as an
+  array of TofEvent (16 bytes), WeightedEvent (24 bytes) or
+  WeightedEventNoTime (16 bytes), starting on a 64 byte boundary. The
+  detector IDs are arrays of int32. Offsets are from the start of the file.
+*/
+class MANTID_DATAOBJECTS_DLL MappedEventFile : public std::enable_shared_from_this<MappedEventFile> {
+public:
+  /// Version of the file format written
+  static constexpr uint32_t VERSION = 1;
+
+  static void save(const EventWorkspace &workspace, const std::string &filename);
+  static std::shared_ptr<const MappedEventFile> open(const std::string &filename);
+
+  ~MappedEventFile();
+
+  /// Name of the file
+  const std::string &filename() const { return m_filename; }
+  size_t getNumberHistograms() const;
+  specnum_t getSpectrumNo(const size_t index) const;
+  std::set<detid_t> getDetectorIDs(const size_t index) const;
+  MappedEvents getEvents(const size_t index) const;
+
+private:
+  struct Mapping;
+  struct SpectrumRecord;
+
+  explicit MappedEventFile(const std::string &filename);
+  const SpectrumRecord &record(const size_t index) const;
+
+  /// Name of the file
+  std::string m_filename;
+  /// The mapped file
+  std::unique_ptr<Mapping> m_mapping;
+  /// Start of the mapped file
+  const char *m_data;
+  /// Size of the mapped file
+  size_t m_size;
+  /// Number of spectra in the file
+  size_t m_numSpectra;
+  /// The table of spectra
+  const SpectrumRecord *m_records;
+};
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -8,23 +8,60 @@
 
 #include <cinttypes>
 #include <cstddef>
+#include <limits>
 
 #include "Types.h"
 
 namespace morton_index {
 
 /**
- * Pad an integer with a given number of padding bits.
+ * Pad an integer with a given number of padding bits one bit at a time. This
+ * works for any combination of types, but is slower than the specialisations
+ * of pad() using bit masks.
  *
  * @tparam N Number of padding bits to add
  * @tparam IntT Integer type
  * @tparam MortonT Padded integer type
  * @return Padded integer
  */
-template <size_t N, typename IntT, typename MortonT> MortonT pad(IntT) {
-  throw std::runtime_error("No pad() specialisation.");
+template <size_t N, typename IntT, typename MortonT> MortonT padBits(IntT v) {
+  MortonT x(0);
+  for (size_t bit = 0; bit < static_cast<size_t>(std::numeric_limits<IntT>::digits); ++bit) {
+    if ((v >> bit) & 1u)
+      x |= MortonT(1) << static_cast<int>(bit * (N + 1));
+  }
+  return x;
 }
 
+/**
+ * Compacts (removes padding from) an integer with a given number of padding
+ * bits one bit at a time. This works for any combination of types, but is
+ * slower than the specialisations of compact() using bit masks.
+ *
+ * @tparam N Number of padding bits to remove
+ * @tparam IntT Integer type
+ * @tparam MortonT Padded integer type
+ * @return Original integer
+ */
+template <size_t N, typename IntT, typename MortonT> IntT compactBits(MortonT x) {
+  IntT v(0);
+  for (size_t bit = 0; bit < static_cast<size_t>(std::numeric_limits<IntT>::digits); ++bit) {
+    if ((x >> static_cast<int>(bit * (N + 1))) & MortonT(1))
+      v = static_cast<IntT>(v | (IntT(1) << bit));
+  }
+  return v;
+}
+
+/**
+ * Pad an integer with a given number of padding bits.
+ *
+ * @tparam N Number of padding bits to add
+ * @tparam IntT Integer type
+ * @tparam MortonT Padded integer type
+ * @return Padded integer
+ */
+template <size_t N, typename IntT, typename MortonT> MortonT pad(IntT v) { return padBits<N, IntT, MortonT>(v); }
+
 /**
  * Compacts (removes padding from) an integer with a given number of padding
  * bits.
@@ -34,8 +71,8 @@ template <size_t N, typename IntT, typename MortonT> MortonT pad(IntT) {
  * @tparam MortonT Padded integer type
  * @return Original integer
  */
-template <size_t N, typename IntT, typename MortonT> IntT compact(MortonT) {
-  throw std::runtime_error("No compact() specialisation.");
+template <size_t N, typename IntT, typename MortonT> IntT compact(MortonT x) {
+  return compactBits<N, IntT, MortonT>(x);
 }
 
 /* Bit masks used for pad and compact operations are derived using
@@ -0,0 +1,180 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/CompactEvents.h"
+#include "MantidDataObjects/EventSorter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+
+/** Make a table of the distinct pulse times of some events
+ * @param events :: the events
+ * @return the sorted distinct pulse times
+ */
+std::shared_ptr<const CompactEvents::PulseTimeTable>
+CompactEvents::makePulseTimeTable(const std::vector<TofEvent> &events) {
+  auto pulseTimes = std::make_shared<PulseTimeTable>();
+  pulseTimes->reserve(events.size());
+  for (const auto &event : events)
+    pulseTimes->emplace_back(event.pulseTime());
+  std::sort(pulseTimes->begin(), pulseTimes->end());
+  pulseTimes->erase(std::unique(pulseTimes->begin(), pulseTimes->end()), pulseTimes->end());
+  pulseTimes->shrink_to_fit();
+  return pulseTimes;
+}
+
+/** Pack a vector of TofEvent
+ * @param events :: the events to copy
+ * @param pulseTimes :: sorted table holding the pulse time of every event
+ * @throw std::invalid_argument if the pulse time of an event is not in the
+ * table, or the table is too large to index with 32 bits
+ */
+CompactEvents::CompactEvents(const std::vector<TofEvent> &events, std::shared_ptr<const PulseTimeTable> pulseTimes)
+    : m_pulseTimes(std::move(pulseTimes)) {
+  if (!m_pulseTimes || m_pulseTimes->size() > std::numeric_limits<uint32_t>::max())
+    throw std::invalid_argument("CompactEvents: the pulse time table must have fewer than 2^32 entries");
+  m_tof.reserve(events.size());
+  m_pulseIndex.reserve(events.size());
+  // Consecutive events very often share a pulse, so the last one found is
+  // checked before searching the table.
+  const auto &table = *m_pulseTimes;
+  auto pulse = table.cbegin();
+  for (const auto &event : events) {
+    if (pulse == table.cend() || *pulse != event.pulseTime()) {
+      pulse = std::lower_bound(table.cbegin(), table.cend(), event.pulseTime());
+      if (pulse == table.cend() || *pulse != event.pulseTime())
+        throw std::invalid_argument("CompactEvents: the pulse time of an event is not in the table");
+    }
+    m_tof.emplace_back(static_cast<float>(event.tof()));
+    m_pulseIndex.emplace_back(static_cast<uint32_t>(std::distance(table.cbegin(), pulse)));
+  }
+}
+
+/** Copy the events back into a vector of TofEvent. Any existing content of the
+ * vector is replaced.
+ * @param events :: the vector to fill
+ */
+void CompactEvents::unpack(std::vector<TofEvent> &events) const {
+  events.clear();
+  events.reserve(m_tof.size());
+  const auto &table = *m_pulseTimes;
+  for (size_t i = 0; i < m_tof.size(); ++i)
+    events.emplace_back(static_cast<double>(m_tof[i]), table[m_pulseIndex[i]]);
+}
+
+/** Memory used by the events. Like EventList::getMemorySize() this reports the
+ * capacity of the vectors rather than their size. The shared pulse time table
+ * is not included.
+ * @return :: the memory used, in bytes.
+ */
+size_t CompactEvents::getMemorySize() const {
+  return m_tof.capacity() * sizeof(float) + m_pulseIndex.capacity() * sizeof(uint32_t) + sizeof(CompactEvents);
+}
+
+// --------------------------------------------------------------------------
+/// Sort the events by time-of-flight
+void CompactEvents::sortTof() {
+  if (std::is_sorted(m_tof.cbegin(), m_tof.cend()))
+    return;
+
+  std::vector<std::pair<float, uint32_t>> events(m_tof.size());
+  for (size_t i = 0; i < m_tof.size(); ++i)
+    events[i] = std::make_pair(m_tof[i], m_pulseIndex[i]);
+  EventSorter::sortTof(events);
+  for (size_t i = 0; i < events.size(); ++i) {
+    m_tof[i] = events[i].first;
+    m_pulseIndex[i] = events[i].second;
+  }
+}
+
+/// Reverse the order of the events
+void CompactEvents::reverse() {
+  std::reverse(m_tof.begin(), m_tof.end());
+  std::reverse(m_pulseIndex.begin(), m_pulseIndex.end());
+}
+
+// --------------------------------------------------------------------------
+/** @param sorted :: true if the events are sorted by tof
+ * @return the smallest tof, or the largest double if there are no events.
+ */
+double CompactEvents::getTofMin(const bool sorted) const {
+  if (m_tof.empty())
+    return std::numeric_limits<double>::max();
+  if (sorted)
+    return m_tof.front();
+  return *std::min_element(m_tof.cbegin(), m_tof.cend());
+}
+
+/** @param sorted :: true if the events are sorted by tof
+ * @return the largest tof, or the lowest double if there are no events.
+ */
+double CompactEvents::getTofMax(const bool sorted) const {
+  if (m_tof.empty())
+    return std::numeric_limits<double>::lowest();
+  if (sorted)
+    return m_tof.back();
+  return *std::max_element(m_tof.cbegin(), m_tof.cend());
+}
+
+// --------------------------------------------------------------------------
+/** Fill a counts histogram. The events must be sorted by tof; the counts of a
+ * bin are then the distance between the first events of the two edges.
+ * @param X :: the bin edges
+ * @param Y :: the generated counts, resized to X.size()-1 and overwritten
+ */
+void CompactEvents::generateCountsHistogram(const MantidVec &X, MantidVec &Y) const {
+  if (X.size() <= 1) {
+    Y.resize(0, 0);
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  if (m_tof.empty())
+    return;
+  // Each search starts from the previous edge
+  auto binStart = std::lower_bound(m_tof.cbegin(), m_tof.cend(), X.front());
+  for (size_t bin = 0; bin + 1 < X.size(); ++bin) {
+    const auto binEnd = std::lower_bound(binStart, m_tof.cend(), X[bin + 1]);
+    Y[bin] = static_cast<double>(std::distance(binStart, binEnd));
+    binStart = binEnd;
+  }
+}
+
+/** Integrate the events between a range of X values, or all events. The events
+ * must be sorted by tof unless the entire range is used.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range.
+ * @param sum :: the number of events
+ * @param error :: the error of the sum
+ */
+void CompactEvents::integrate(const double minX, const double maxX, const bool entireRange, double &sum,
+                              double &error) const {
+  sum = 0;
+  error = 0;
+  if (m_tof.empty())
+    return;
+
+  size_t numEvents = m_tof.size();
+  if (!entireRange) {
+    if (maxX < minX)
+      return;
+    const auto first = std::lower_bound(m_tof.cbegin(), m_tof.cend(), minX);
+    numEvents = static_cast<size_t>(std::distance(first, std::upper_bound(first, m_tof.cend(), maxX)));
+  }
+  sum = static_cast<double>(numEvents);
+  error = std::sqrt(sum);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
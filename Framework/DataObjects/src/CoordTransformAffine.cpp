@@ -273,6 +273,37 @@ void CoordTransformAffine::apply(const coord_t *inputVector, coord_t *outVector)
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many points. Each output coordinate
+ * is summed in the same order as in apply(), but for all the points at once so
+ * that the loop over the points can be vectorised.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance in bytes between consecutive input vectors
+ * @param numPoints :: number of vectors to transform
+ * @param outVectors :: array of output coordinates, of size numPoints * outD
+ */
+void CoordTransformAffine::applyToPoints(const coord_t *inputVectors, const size_t inputStride,
+                                         const size_t numPoints, coord_t *outVectors) const {
+  const auto *input = reinterpret_cast<const char *>(inputVectors);
+  for (size_t out = 0; out < outD; ++out) {
+    const coord_t *rawMatrixRow = m_rawMatrix[out];
+    coord_t *outVal = outVectors + out;
+    for (size_t i = 0; i < numPoints; ++i)
+      outVal[i * outD] = 0.0;
+    for (size_t in = 0; in < inD; ++in) {
+      const coord_t factor = rawMatrixRow[in];
+      const char *inputCoord = input + in * sizeof(coord_t);
+      for (size_t i = 0; i < numPoints; ++i)
+        outVal[i * outD] += factor * *reinterpret_cast<const coord_t *>(inputCoord + i * inputStride);
+    }
+    // The homogenous coordinate is added last, as in apply()
+    const coord_t translation = rawMatrixRow[inD];
+    for (size_t i = 0; i < numPoints; ++i)
+      outVal[i * outD] += translation;
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Serialize the coordinate transform
  *
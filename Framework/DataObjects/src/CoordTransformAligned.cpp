@@ -102,6 +102,28 @@ void CoordTransformAligned::apply(const coord_t *inputVector, coord_t *outVector
   }
 }
 
+//----------------------------------------------------------------------------------------------
+/** Apply the coordinate transformation to many points, one output dimension
+ * at a time so that the loop over the points can be vectorised.
+ *
+ * @param inputVectors :: the first input vector, of size inD
+ * @param inputStride :: distance in bytes between consecutive input vectors
+ * @param numPoints :: number of vectors to transform
+ * @param outVectors :: array of output coordinates, of size numPoints * outD
+ */
+void CoordTransformAligned::applyToPoints(const coord_t *inputVectors, const size_t inputStride,
+                                          const size_t numPoints, coord_t *outVectors) const {
+  for (size_t out = 0; out < outD; ++out) {
+    const auto *input = reinterpret_cast<const char *>(inputVectors + m_dimensionToBinFrom[out]);
+    const coord_t origin = m_origin[out];
+    const coord_t scaling = m_scaling[out];
+    for (size_t i = 0; i < numPoints; ++i) {
+      const coord_t x = *reinterpret_cast<const coord_t *>(input + i * inputStride);
+      outVectors[i * outD + out] = (x - origin) * scaling;
+    }
+  }
+}
+
 //----------------------------------------------------------------------------------------------
 /** Create an equivalent affine transformation matrix out of the
  * parameters of this axis-aligned transformation.
@@ -0,0 +1,373 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventSorter.h"
+#include "MantidKernel/Unit.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Core::DateAndTime;
+using Types::Event::TofEvent;
+
+namespace {
+/// Re-order a column following the permutation given by the sorted keys
+template <typename T>
+void permute(std::vector<T> &column, const std::vector<std::pair<double, size_t>> &keys) {
+  if (column.empty())
+    return;
+  std::vector<T> sorted(column.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    sorted[i] = column[keys[i].second];
+  column.swap(sorted);
+}
+
+/// Release the memory held by a column
+template <typename T> void release(std::vector<T> &column) { std::vector<T>().swap(column); }
+} // namespace
+
+/** Pack a vector of TofEvent into columns
+ * @param events :: the events to copy
+ */
+EventColumns::EventColumns(const std::vector<TofEvent> &events) : m_eventType(API::TOF) {
+  m_tof.reserve(events.size());
+  m_pulseTime.reserve(events.size());
+  for (const auto &event : events) {
+    m_tof.emplace_back(event.tof());
+    m_pulseTime.emplace_back(event.pulseTime().totalNanoseconds());
+  }
+}
+
+/** Pack a vector of WeightedEvent into columns
+ * @param events :: the events to copy
+ */
+EventColumns::EventColumns(const std::vector<WeightedEvent> &events) : m_eventType(API::WEIGHTED) {
+  m_tof.reserve(events.size());
+  m_pulseTime.reserve(events.size());
+  m_weight.reserve(events.size());
+  m_errorSquared.reserve(events.size());
+  for (const auto &event : events) {
+    m_tof.emplace_back(event.tof());
+    m_pulseTime.emplace_back(event.pulseTime().totalNanoseconds());
+    m_weight.emplace_back(event.m_weight);
+    m_errorSquared.emplace_back(event.m_errorSquared);
+  }
+}
+
+/** Pack a vector of WeightedEventNoTime into columns
+ * @param events :: the events to copy
+ */
+EventColumns::EventColumns(const std::vector<WeightedEventNoTime> &events) : m_eventType(API::WEIGHTED_NOTIME) {
+  m_tof.reserve(events.size());
+  m_weight.reserve(events.size());
+  m_errorSquared.reserve(events.size());
+  for (const auto &event : events) {
+    m_tof.emplace_back(event.tof());
+    m_weight.emplace_back(event.m_weight);
+    m_errorSquared.emplace_back(event.m_errorSquared);
+  }
+}
+
+/** Copy the columns back into a vector of TofEvent. Any existing content of the
+ * vector is replaced.
+ * @param events :: the vector to fill
+ */
+void EventColumns::unpack(std::vector<TofEvent> &events) const {
+  events.clear();
+  events.reserve(m_tof.size());
+  for (size_t i = 0; i < m_tof.size(); ++i)
+    events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]));
+}
+
+/** Copy the columns back into a vector of WeightedEvent. Any existing content of
+ * the vector is replaced.
+ * @param events :: the vector to fill
+ */
+void EventColumns::unpack(std::vector<WeightedEvent> &events) const {
+  events.clear();
+  events.reserve(m_tof.size());
+  for (size_t i = 0; i < m_tof.size(); ++i)
+    events.emplace_back(m_tof[i], DateAndTime(m_pulseTime[i]), m_weight[i], m_errorSquared[i]);
+}
+
+/** Copy the columns back into a vector of WeightedEventNoTime. Any existing
+ * content of the vector is replaced.
+ * @param events :: the vector to fill
+ */
+void EventColumns::unpack(std::vector<WeightedEventNoTime> &events) const {
+  events.clear();
+  events.reserve(m_tof.size());
+  for (size_t i = 0; i < m_tof.size(); ++i)
+    events.emplace_back(m_tof[i], m_weight[i], m_errorSquared[i]);
+}
+
+/** Memory used by the columns. Like EventList::getMemorySize() this reports the
+ * capacity of the vectors rather than their size.
+ * @return :: the memory used, in bytes.
+ */
+size_t EventColumns::getMemorySize() const {
+  return m_tof.capacity() * sizeof(double) + m_pulseTime.capacity() * sizeof(int64_t) +
+         m_weight.capacity() * sizeof(float) + m_errorSquared.capacity() * sizeof(float) + sizeof(EventColumns);
+}
+
+/// Remove all the events and free the memory of the columns
+void EventColumns::clear() {
+  release(m_tof);
+  release(m_pulseTime);
+  release(m_weight);
+  release(m_errorSquared);
+}
+
+// --------------------------------------------------------------------------
+/** Sort all the columns by time-of-flight. Only the tof column and the
+ * (tof, index) keys are touched while sorting; the other columns are
+ * gathered once afterwards.
+ */
+void EventColumns::sortTof() {
+  if (std::is_sorted(m_tof.cbegin(), m_tof.cend()))
+    return;
+
+  std::vector<std::pair<double, size_t>> keys(m_tof.size());
+  for (size_t i = 0; i < m_tof.size(); ++i)
+    keys[i] = std::make_pair(m_tof[i], i);
+  EventSorter::sortTof(keys);
+
+  for (size_t i = 0; i < keys.size(); ++i)
+    m_tof[i] = keys[i].first;
+  permute(m_pulseTime, keys);
+  permute(m_weight, keys);
+  permute(m_errorSquared, keys);
+}
+
+/// Reverse the order of the events in all the columns
+void EventColumns::reverse() {
+  std::reverse(m_tof.begin(), m_tof.end());
+  std::reverse(m_pulseTime.begin(), m_pulseTime.end());
+  std::reverse(m_weight.begin(), m_weight.end());
+  std::reverse(m_errorSquared.begin(), m_errorSquared.end());
+}
+
+// --------------------------------------------------------------------------
+/** Convert the time of flight by tof'=tof*factor+offset. Does NOT reverse the
+ * events if the factor < 0.
+ * @param factor :: multiply by this
+ * @param offset :: add this
+ */
+void EventColumns::convertTof(const double factor, const double offset) {
+  double *tof = m_tof.data();
+  const size_t numEvents = m_tof.size();
+  for (size_t i = 0; i < numEvents; ++i)
+    tof[i] = tof[i] * factor + offset;
+}
+
+/** Convert the time of flight using a function
+ * @param func :: the function applied to every tof
+ */
+void EventColumns::convertTof(const std::function<double(double)> &func) {
+  std::transform(m_tof.begin(), m_tof.end(), m_tof.begin(), func);
+}
+
+/** Convert the tof column between units, in place, via time-of-flight
+ * @param fromUnit :: the current unit of the column. Must be initialized.
+ * @param toUnit :: the unit to convert to. Must be initialized.
+ */
+void EventColumns::convertUnitsViaTof(const Kernel::Unit &fromUnit, const Kernel::Unit &toUnit) {
+  double *tof = m_tof.data();
+  const size_t numEvents = m_tof.size();
+  fromUnit.valuesToTOF(tof, tof, numEvents);
+  toUnit.valuesFromTOF(tof, tof, numEvents);
+}
+
+/** Remove the events with tofMin <= tof <= tofMax. The columns must be sorted
+ * by tof.
+ * @param tofMin :: lower bound of TOF to filter out
+ * @param tofMax :: upper bound of TOF to filter out
+ * @return the number of events removed
+ */
+size_t EventColumns::maskTof(const double tofMin, const double tofMax) {
+  if (m_tof.empty() || tofMin > m_tof.back() || tofMax < m_tof.front())
+    return 0;
+
+  const auto first = std::lower_bound(m_tof.cbegin(), m_tof.cend(), tofMin);
+  if (first == m_tof.cend() || *first >= tofMax)
+    return 0;
+  const auto last = std::upper_bound(first, m_tof.cend(), tofMax);
+
+  const auto firstIndex = static_cast<size_t>(std::distance(m_tof.cbegin(), first));
+  const auto lastIndex = static_cast<size_t>(std::distance(m_tof.cbegin(), last));
+  eraseRange(firstIndex, lastIndex);
+  return lastIndex - firstIndex;
+}
+
+/// Erase the events [first, last) from every column
+void EventColumns::eraseRange(const size_t first, const size_t last) {
+  m_tof.erase(m_tof.begin() + first, m_tof.begin() + last);
+  if (!m_pulseTime.empty())
+    m_pulseTime.erase(m_pulseTime.begin() + first, m_pulseTime.begin() + last);
+  if (!m_weight.empty()) {
+    m_weight.erase(m_weight.begin() + first, m_weight.begin() + last);
+    m_errorSquared.erase(m_errorSquared.begin() + first, m_errorSquared.begin() + last);
+  }
+}
+
+// --------------------------------------------------------------------------
+/** @param sorted :: true if the columns are sorted by tof
+ * @return the smallest tof, or the largest double if there are no events.
+ */
+double EventColumns::getTofMin(const bool sorted) const {
+  if (m_tof.empty())
+    return std::numeric_limits<double>::max();
+  if (sorted)
+    return m_tof.front();
+  return *std::min_element(m_tof.cbegin(), m_tof.cend());
+}
+
+/** @param sorted :: true if the columns are sorted by tof
+ * @return the largest tof, or the lowest double if there are no events.
+ */
+double EventColumns::getTofMax(const bool sorted) const {
+  if (m_tof.empty())
+    return std::numeric_limits<double>::lowest();
+  if (sorted)
+    return m_tof.back();
+  return *std::max_element(m_tof.cbegin(), m_tof.cend());
+}
+
+/** Fill a vector with the weights of the events. Unweighted events have a
+ * weight of 1.
+ * @param weights :: the vector to fill
+ */
+void EventColumns::getWeights(std::vector<double> &weights) const {
+  if (m_weight.empty())
+    weights.assign(m_tof.size(), 1.0);
+  else
+    weights.assign(m_weight.cbegin(), m_weight.cend());
+}
+
+/** Fill a vector with the errors of the events. Unweighted events have an
+ * error of 1.
+ * @param weightErrors :: the vector to fill
+ */
+void EventColumns::getWeightErrors(std::vector<double> &weightErrors) const {
+  if (m_errorSquared.empty()) {
+    weightErrors.assign(m_tof.size(), 1.0);
+    return;
+  }
+  weightErrors.resize(m_errorSquared.size());
+  std::transform(m_errorSquared.cbegin(), m_errorSquared.cend(), weightErrors.begin(),
+                 [](const float errorSquared) { return std::sqrt(static_cast<double>(errorSquared)); });
+}
+
+// --------------------------------------------------------------------------
+/** Find, for every bin edge, the index of the first event with tof >= edge.
+ * The columns must be sorted by tof. Each search starts from the previous
+ * result so the cost is O(nBins * log(nEvents)) at worst.
+ * @param X :: the bin edges
+ * @return the index of the first event of each bin, and one past the last
+ */
+std::vector<size_t> EventColumns::binStarts(const MantidVec &X) const {
+  std::vector<size_t> starts(X.size());
+  auto it = m_tof.cbegin();
+  for (size_t i = 0; i < X.size(); ++i) {
+    it = std::lower_bound(it, m_tof.cend(), X[i]);
+    starts[i] = static_cast<size_t>(std::distance(m_tof.cbegin(), it));
+  }
+  return starts;
+}
+
+/** Fill a counts histogram. The columns must be sorted by tof; the counts of a
+ * bin are then the distance between the first events of the two edges, so
+ * only O(nBins * log(nEvents)) tof values are read.
+ * @param X :: the bin edges
+ * @param Y :: the generated counts, resized to X.size()-1 and overwritten
+ */
+void EventColumns::generateCountsHistogram(const MantidVec &X, MantidVec &Y) const {
+  if (X.size() <= 1) {
+    Y.resize(0, 0);
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  if (m_tof.empty())
+    return;
+  const auto starts = binStarts(X);
+  for (size_t bin = 0; bin + 1 < starts.size(); ++bin)
+    Y[bin] = static_cast<double>(starts[bin + 1] - starts[bin]);
+}
+
+/** Fill the counts and errors histograms from the weight columns. The columns
+ * must be sorted by tof. Each bin sums a contiguous range of the weight and
+ * error columns.
+ * @param X :: the bin edges
+ * @param Y :: the summed weights
+ * @param E :: the errors (square root of the summed error squared)
+ */
+void EventColumns::generateWeightedHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E) const {
+  if (X.size() <= 1) {
+    Y.resize(0, 0);
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  E.assign(X.size() - 1, 0.0);
+  if (m_tof.empty())
+    return;
+  const auto starts = binStarts(X);
+  for (size_t bin = 0; bin + 1 < starts.size(); ++bin) {
+    double weight = 0.;
+    double errorSquared = 0.;
+    for (size_t i = starts[bin]; i < starts[bin + 1]; ++i) {
+      weight += m_weight[i];
+      errorSquared += m_errorSquared[i];
+    }
+    Y[bin] = weight;
+    E[bin] = std::sqrt(errorSquared);
+  }
+}
+
+/** Integrate the events between a range of X values, or all events. The columns
+ * must be sorted by tof unless the entire range is used.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range.
+ * @param sum :: the summed weights
+ * @param error :: the error of the sum
+ */
+void EventColumns::integrate(const double minX, const double maxX, const bool entireRange, double &sum,
+                             double &error) const {
+  sum = 0;
+  error = 0;
+  if (m_tof.empty())
+    return;
+
+  size_t first = 0;
+  size_t last = m_tof.size();
+  if (!entireRange) {
+    if (maxX < minX)
+      return;
+    first = static_cast<size_t>(
+        std::distance(m_tof.cbegin(), std::lower_bound(m_tof.cbegin(), m_tof.cend(), minX)));
+    last = static_cast<size_t>(
+        std::distance(m_tof.cbegin(), std::upper_bound(m_tof.cbegin() + first, m_tof.cend(), maxX)));
+  }
+
+  if (m_weight.empty()) {
+    sum = static_cast<double>(last - first);
+    error = std::sqrt(sum);
+    return;
+  }
+  for (size_t i = first; i < last; ++i) {
+    sum += m_weight[i];
+    error += m_errorSquared[i];
+  }
+  error = std::sqrt(error);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
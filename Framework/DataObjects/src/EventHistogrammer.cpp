@@ -0,0 +1,284 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventHistogrammer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Event::TofEvent;
+
+namespace {
+/// Number of events whose bins are estimated in one go
+constexpr size_t BATCH_SIZE = 512;
+/// Largest distance of an edge from its evenly spaced position, as a fraction
+/// of the bin width, that still leaves every estimate within one bin
+constexpr double MAX_DEVIATION = 0.25;
+
+/** Check that the first numSpaced + 1 edges are evenly spaced after applying
+ * transform to them.
+ * @param X :: the bin edges
+ * @param numSpaced :: the number of evenly spaced bins to check
+ * @param transform :: applied to each edge, e.g. identity or log
+ * @param origin :: set to the transformed first edge
+ * @param inverseStep :: set to the inverse of the transformed bin width
+ * @return true if the edges are evenly spaced
+ */
+template <typename Transform>
+bool evenlySpaced(const MantidVec &X, const size_t numSpaced, const Transform &transform, double &origin,
+                  double &inverseStep) {
+  const double first = transform(X.front());
+  const double step = (transform(X[numSpaced]) - first) / static_cast<double>(numSpaced);
+  if (!std::isfinite(first) || !std::isfinite(step) || step <= 0.)
+    return false;
+  for (size_t i = 1; i < numSpaced; ++i) {
+    const double expected = first + static_cast<double>(i) * step;
+    if (std::fabs(transform(X[i]) - expected) > MAX_DEVIATION * step)
+      return false;
+  }
+  origin = first;
+  inverseStep = 1. / step;
+  return true;
+}
+} // namespace
+
+/** Work out whether the bin edges are linear or logarithmic.
+ * @param X :: the bin edges. They are not copied, so must outlive this object.
+ */
+EventHistogrammer::EventHistogrammer(const MantidVec &X) : m_X(X) {
+  const size_t numEdges = X.size();
+  if (numEdges < 2 || numEdges - 2 > static_cast<size_t>(std::numeric_limits<int>::max()))
+    return;
+  if (!std::isfinite(X.front()) || !std::isfinite(X.back()))
+    return;
+  for (size_t i = 0; i + 1 < numEdges; ++i) {
+    if (!(X[i] < X[i + 1]))
+      return;
+  }
+  m_lastBin = static_cast<int>(numEdges - 2);
+
+  // Rebin shortens the last bin to finish at the upper limit, so the spacing
+  // is taken from the other edges. Estimates beyond the last edge are clamped.
+  const size_t numSpaced = numEdges > 2 ? numEdges - 2 : 1;
+  if (evenlySpaced(
+          X, numSpaced, [](const double x) { return x; }, m_origin, m_inverseStep)) {
+    m_binning = Binning::Linear;
+  } else if (X.front() > 0. && evenlySpaced(
+                                   X, numSpaced, [](const double x) { return std::log(x); }, m_origin,
+                                   m_inverseStep)) {
+    m_binning = Binning::Logarithmic;
+  }
+}
+
+/** Find the bin of each event and pass it on. Bins are estimated for a batch of
+ * events at a time, then each estimate is corrected against the edges.
+ * @param numEvents :: the number of events
+ * @param tofAt :: returns the tof of the event with the given index
+ * @param accumulate :: called with the index and bin of each event in range
+ */
+template <typename TofAt, typename Accumulate>
+void EventHistogrammer::forEachBin(const size_t numEvents, const TofAt &tofAt, const Accumulate &accumulate) const {
+  const double xMin = m_X.front();
+  const double xMax = m_X.back();
+  std::array<double, BATCH_SIZE> tofs;
+  std::array<int, BATCH_SIZE> bins;
+  for (size_t start = 0; start < numEvents; start += BATCH_SIZE) {
+    const size_t count = std::min(BATCH_SIZE, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      tofs[i] = tofAt(start + i);
+    estimateBins(tofs.data(), count, bins.data());
+    for (size_t i = 0; i < count; ++i) {
+      const double tof = tofs[i];
+      // Also skips NaN
+      if (!(tof >= xMin && tof < xMax))
+        continue;
+      // The estimate may be a bin out because of rounding or uneven edges.
+      // These loops stop at the first and last bins as tof is in range.
+      auto bin = static_cast<size_t>(bins[i]);
+      while (tof < m_X[bin])
+        --bin;
+      while (tof >= m_X[bin + 1])
+        ++bin;
+      accumulate(start + i, bin);
+    }
+  }
+}
+
+/** Estimate the bin of each tof arithmetically, clamped to the valid bins.
+ * There are no branches in the loops so they can be vectorized.
+ * @param tofs :: the tof values
+ * @param count :: the number of tof values
+ * @param bins :: filled with the estimated bins
+ */
+void EventHistogrammer::estimateBins(const double *tofs, const size_t count, int *bins) const {
+  const double origin = m_origin;
+  const double inverseStep = m_inverseStep;
+  const auto lastBin = static_cast<double>(m_lastBin);
+  // Written so that NaN, from the log of a non-positive tof, becomes 0
+  const auto clamp = [lastBin](const double estimate) {
+    const double positive = estimate > 0. ? estimate : 0.;
+    return static_cast<int>(positive < lastBin ? positive : lastBin);
+  };
+  if (m_binning == Binning::Linear) {
+    for (size_t i = 0; i < count; ++i)
+      bins[i] = clamp((tofs[i] - origin) * inverseStep);
+  } else {
+    for (size_t i = 0; i < count; ++i)
+      bins[i] = clamp((std::log(tofs[i]) - origin) * inverseStep);
+  }
+}
+
+/** Size a histogram for the bins and set it to zero
+ * @param Y :: the histogram
+ * @throw std::runtime_error if the bins are not linear or logarithmic
+ */
+void EventHistogrammer::resetHistogram(MantidVec &Y) const {
+  if (!isRegular())
+    throw std::runtime_error("EventHistogrammer: the bin edges are neither linear nor logarithmic");
+  Y.assign(m_X.size() - 1, 0.0);
+}
+
+/** Histogram the weights of events
+ * @param events :: the events, in any order
+ * @param Y :: set to the sum of the weights in each bin
+ * @param E :: set to the error of each bin
+ */
+template <typename T>
+void EventHistogrammer::weightedHistogram(const std::vector<T> &events, MantidVec &Y, MantidVec &E) const {
+  resetHistogram(Y);
+  resetHistogram(E);
+  // Errors are squared until the last step
+  forEachBin(
+      events.size(), [&events](const size_t i) { return events[i].tof(); },
+      [&](const size_t i, const size_t bin) {
+        Y[bin] += events[i].weight();
+        E[bin] += events[i].errorSquared();
+      });
+  std::transform(E.begin(), E.end(), E.begin(), static_cast<double (*)(double)>(sqrt));
+}
+
+/** Histogram the tof of each event
+ * @param events :: the events, in any order
+ * @param Y :: set to the number of events in each bin
+ */
+void EventHistogrammer::histogram(const std::vector<TofEvent> &events, MantidVec &Y) const {
+  resetHistogram(Y);
+  forEachBin(
+      events.size(), [&events](const size_t i) { return events[i].tof(); },
+      [&Y](const size_t, const size_t bin) { ++Y[bin]; });
+}
+
+/** Histogram the weights of each event
+ * @param events :: the events, in any order
+ * @param Y :: set to the sum of the weights in each bin
+ * @param E :: set to the error of each bin
+ */
+void EventHistogrammer::histogram(const std::vector<WeightedEvent> &events, MantidVec &Y, MantidVec &E) const {
+  weightedHistogram(events, Y, E);
+}
+
+/** Histogram the weights of each event
+ * @param events :: the events, in any order
+ * @param Y :: set to the sum of the weights in each bin
+ * @param E :: set to the error of each bin
+ */
+void EventHistogrammer::histogram(const std::vector<WeightedEventNoTime> &events, MantidVec &Y, MantidVec &E) const {
+  weightedHistogram(events, Y, E);
+}
+
+/** Histogram a column of tof values
+ * @param tofs :: the tof values, in any order
+ * @param Y :: set to the number of values in each bin
+ */
+void EventHistogrammer::histogram(const std::vector<double> &tofs, MantidVec &Y) const {
+  resetHistogram(Y);
+  forEachBin(
+      tofs.size(), [&tofs](const size_t i) { return tofs[i]; }, [&Y](const size_t, const size_t bin) { ++Y[bin]; });
+}
+
+/** Histogram a column of single precision tof values
+ * @param tofs :: the tof values, in any order
+ * @param Y :: set to the number of values in each bin
+ */
+void EventHistogrammer::histogram(const std::vector<float> &tofs, MantidVec &Y) const {
+  resetHistogram(Y);
+  forEachBin(
+      tofs.size(), [&tofs](const size_t i) { return static_cast<double>(tofs[i]); },
+      [&Y](const size_t, const size_t bin) { ++Y[bin]; });
+}
+
+/** Histogram columns of tof, weight and error squared values
+ * @param tofs :: the tof values, in any order
+ * @param weights :: the weight of each tof
+ * @param errorSquareds :: the error squared of each tof
+ * @param Y :: set to the sum of the weights in each bin
+ * @param E :: set to the error of each bin
+ */
+void EventHistogrammer::histogram(const std::vector<double> &tofs, const std::vector<float> &weights,
+                                  const std::vector<float> &errorSquareds, MantidVec &Y, MantidVec &E) const {
+  if (weights.size() != tofs.size() || errorSquareds.size() != tofs.size())
+    throw std::invalid_argument("EventHistogrammer: the weight and error columns must be the same size as the tofs");
+  resetHistogram(Y);
+  resetHistogram(E);
+  forEachBin(
+      tofs.size(), [&tofs](const size_t i) { return tofs[i]; },
+      [&](const size_t i, const size_t bin) {
+        Y[bin] += static_cast<double>(weights[i]);
+        E[bin] += static_cast<double>(errorSquareds[i]);
+      });
+  std::transform(E.begin(), E.end(), E.begin(), static_cast<double (*)(double)>(sqrt));
+}
+
+/** Add values to existing histograms, without resetting them first. Unlike the
+ * other methods the edges may be irregular, as long as they are increasing, in
+ * which case each value is found by a binary search.
+ * @param xs :: the values, in any order
+ * @param weights :: the weight of each value, or empty for a weight of 1
+ * @param errorSquareds :: the error squared of each value, or empty for 1
+ * @param Y :: the weights in each bin are added to this
+ * @param E2 :: the errors squared in each bin are added to this
+ */
+void EventHistogrammer::accumulate(const std::vector<double> &xs, const std::vector<double> &weights,
+                                   const std::vector<double> &errorSquareds, MantidVec &Y, MantidVec &E2) const {
+  const size_t numBins = m_X.size() > 1 ? m_X.size() - 1 : 0;
+  if (Y.size() != numBins || E2.size() != numBins)
+    throw std::invalid_argument("EventHistogrammer: the histograms must have one value per bin");
+  if ((!weights.empty() && weights.size() != xs.size()) ||
+      (!errorSquareds.empty() && errorSquareds.size() != xs.size()))
+    throw std::invalid_argument("EventHistogrammer: the weights and errors must be the same size as the values");
+  if (numBins == 0)
+    return;
+
+  const bool weighted = !weights.empty();
+  const bool hasErrors = !errorSquareds.empty();
+  const auto add = [&](const size_t i, const size_t bin) {
+    Y[bin] += weighted ? weights[i] : 1.;
+    E2[bin] += hasErrors ? errorSquareds[i] : 1.;
+  };
+  if (isRegular()) {
+    forEachBin(
+        xs.size(), [&xs](const size_t i) { return xs[i]; }, add);
+    return;
+  }
+  const double xMin = m_X.front();
+  const double xMax = m_X.back();
+  for (size_t i = 0; i < xs.size(); ++i) {
+    const double x = xs[i];
+    if (!(x >= xMin && x < xMax))
+      continue;
+    const auto upper = std::upper_bound(m_X.cbegin(), m_X.cend(), x);
+    add(i, static_cast<size_t>(std::distance(m_X.cbegin(), upper)) - 1);
+  }
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -6,8 +6,14 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #include "MantidDataObjects/EventList.h"
 #include "MantidAPI/MatrixWorkspace.h"
+#include "MantidDataObjects/CompactEvents.h"
+#include "MantidDataObjects/EventColumns.h"
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidDataObjects/EventSorter.h"
+#include "MantidDataObjects/EventSplitter.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidDataObjects/MappedEventFile.h"
 #include "MantidKernel/DateAndTime.h"
 #include "MantidKernel/DateAndTimeHelpers.h"
 #include "MantidKernel/Exception.h"
@@ -23,6 +29,7 @@
 #pragma warning(default : 4180)
 #endif
 
+#include <array>
 #include <cfloat>
 #include <cmath>
 #include <functional>
@@ -88,29 +95,6 @@ public:
 /// --------------------- TofEvent Comparators
 /// ----------------------------------
 //==========================================================================
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTime(const TofEvent &e1, const TofEvent &e2) { return (e1.pulseTime() < e2.pulseTime()); }
-
-/** Compare two events' FRAME id, return true if e1 should be before e2.
- *  Assuming that if e1's pulse time is earlier than e2's, then e1 must be
- * earlier regardless TOF value
- * @param e1 :: first event
- * @param e2 :: second event
- *  */
-bool compareEventPulseTimeTOF(const TofEvent &e1, const TofEvent &e2) {
-
-  if (e1.pulseTime() < e2.pulseTime()) {
-    return true;
-  } else if ((e1.pulseTime() == e2.pulseTime()) && (e1.tof() < e2.tof())) {
-    return true;
-  }
-
-  return false;
-}
-
 // comparator for pulse time with tolerance
 struct comparePulseTimeTOFDelta {
   explicit comparePulseTimeTOFDelta(const Types::Core::DateAndTime &start, const double seconds)
@@ -207,6 +191,10 @@ void EventList::copyDataInto(EventList &sink) const {
   sink.events = events;
   sink.weightedEvents = weightedEvents;
   sink.weightedEventsNoTime = weightedEventsNoTime;
+  sink.m_columns = m_columns ? std::make_unique<EventColumns>(*m_columns) : nullptr;
+  sink.m_compact = m_compact ? std::make_unique<CompactEvents>(*m_compact) : nullptr;
+  sink.m_mapped = m_mapped ? std::make_unique<MappedEvents>(*m_mapped) : nullptr;
+  sink.m_packed = m_columns || m_compact || m_mapped;
   sink.eventType = eventType;
   sink.order = order;
 }
@@ -313,6 +301,10 @@ EventList &EventList::operator=(const EventList &rhs) {
   events = rhs.events;
   weightedEvents = rhs.weightedEvents;
   weightedEventsNoTime = rhs.weightedEventsNoTime;
+  m_columns = rhs.m_columns ? std::make_unique<EventColumns>(*rhs.m_columns) : nullptr;
+  m_compact = rhs.m_compact ? std::make_unique<CompactEvents>(*rhs.m_compact) : nullptr;
+  m_mapped = rhs.m_mapped ? std::make_unique<MappedEvents>(*rhs.m_mapped) : nullptr;
+  m_packed = m_columns || m_compact || m_mapped;
   eventType = rhs.eventType;
   order = rhs.order;
   return *this;
@@ -324,6 +316,7 @@ EventList &EventList::operator=(const EventList &rhs) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const TofEvent &event) {
+  this->unpackEvents();
 
   switch (this->eventType) {
   case TOF:
@@ -352,6 +345,7 @@ EventList &EventList::operator+=(const TofEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
+  this->unpackEvents();
   switch (this->eventType) {
   case TOF:
     // Simply push the events
@@ -389,6 +383,7 @@ EventList &EventList::operator+=(const std::vector<TofEvent> &more_events) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const WeightedEvent &event) {
+  this->unpackEvents();
   this->switchTo(WEIGHTED);
   this->weightedEvents.emplace_back(event);
   this->order = UNSORTED;
@@ -404,6 +399,7 @@ EventList &EventList::operator+=(const WeightedEvent &event) {
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<WeightedEvent> &more_events) {
+  this->unpackEvents();
   switch (this->eventType) {
   case TOF:
     // Need to switch to weighted
@@ -438,6 +434,7 @@ EventList &EventList::operator+=(const std::vector<WeightedEvent> &more_events)
  * @return reference to this
  * */
 EventList &EventList::operator+=(const std::vector<WeightedEventNoTime> &more_events) {
+  this->unpackEvents();
   switch (this->eventType) {
   case TOF:
   case WEIGHTED:
@@ -465,6 +462,7 @@ EventList &EventList::operator+=(const std::vector<WeightedEventNoTime> &more_ev
  * @return reference to this
  * */
 EventList &EventList::operator+=(const EventList &more_events) {
+  more_events.unpackEvents();
   // We'll let the += operator for the given vector of event lists handle it
   switch (more_events.getEventType()) {
   case TOF:
@@ -529,6 +527,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
     this->clearData();
     return *this;
   }
+  this->unpackEvents();
+  more_events.unpackEvents();
 
   // We'll let the -= operator for the given vector of event lists handle it
   switch (this->getEventType()) {
@@ -579,6 +579,8 @@ EventList &EventList::operator-=(const EventList &more_events) {
  * @return :: true if equal.
  */
 bool EventList::operator==(const EventList &rhs) const {
+  this->unpackEvents();
+  rhs.unpackEvents();
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
   if (this->eventType != rhs.eventType)
@@ -601,6 +603,8 @@ bool EventList::operator!=(const EventList &rhs) const { return (!this->operator
 
 bool EventList::equals(const EventList &rhs, const double tolTof, const double tolWeight,
                        const int64_t tolPulse) const {
+  this->unpackEvents();
+  rhs.unpackEvents();
   // generic checks
   if (this->getNumberEvents() != rhs.getNumberEvents())
     return false;
@@ -647,6 +651,7 @@ EventType EventList::getEventType() const { return eventType; }
  * WEIGHTED_NOTIME)
  */
 void EventList::switchTo(EventType newType) {
+  this->unpackEvents();
   switch (newType) {
   case TOF:
     if (eventType != TOF)
@@ -738,6 +743,7 @@ void EventList::switchToWeightedEventsNoTime() {
  * @return a WeightedEvent
  */
 WeightedEvent EventList::getEvent(size_t event_number) {
+  this->unpackEvents();
   switch (eventType) {
   case TOF:
     return WeightedEvent(events[event_number]);
@@ -763,6 +769,7 @@ WeightedEvent EventList::getEvent(size_t event_number) {
  * @return a const reference to the list of non-weighted events
  * */
 const std::vector<TofEvent> &EventList::getEvents() const {
+  this->unpackEvents();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -778,6 +785,7 @@ const std::vector<TofEvent> &EventList::getEvents() const {
  * @return a reference to the list of non-weighted events
  * */
 std::vector<TofEvent> &EventList::getEvents() {
+  this->unpackEvents();
   if (eventType != TOF)
     throw std::runtime_error("EventList::getEvents() called for an EventList "
                              "that has weights. Use getWeightedEvents() or "
@@ -793,6 +801,7 @@ std::vector<TofEvent> &EventList::getEvents() {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEvent> &EventList::getWeightedEvents() {
+  this->unpackEvents();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -808,6 +817,7 @@ std::vector<WeightedEvent> &EventList::getWeightedEvents() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
+  this->unpackEvents();
   if (eventType != WEIGHTED)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEvent. Use "
@@ -821,6 +831,7 @@ const std::vector<WeightedEvent> &EventList::getWeightedEvents() const {
  * @return a reference to the list of weighted events
  * */
 std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
+  this->unpackEvents();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEvents() called for an "
                              "EventList not of type WeightedEventNoTime. Use "
@@ -834,6 +845,7 @@ std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() {
  * @return a const reference to the list of weighted events
  * */
 const std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() const {
+  this->unpackEvents();
   if (eventType != WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::getWeightedEventsNoTime() called for "
                              "an EventList not of type WeightedEventNoTime. "
@@ -847,6 +859,10 @@ const std::vector<WeightedEventNoTime> &EventList::getWeightedEventsNoTime() con
 void EventList::clear(const bool removeDetIDs) {
   if (mru)
     mru->deleteIndex(this);
+  m_packed = false;
+  m_columns.reset();
+  m_compact.reset();
+  m_mapped.reset();
   this->events.clear();
   std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
   this->weightedEvents.clear();
@@ -893,6 +909,7 @@ void EventList::setMRU(EventWorkspaceMRU *newMRU) { mru = newMRU; }
  * @param num :: number of events that will be in this EventList
  */
 void EventList::reserve(size_t num) {
+  this->unpackEvents();
   switch (this->eventType) {
   case TOF:
     this->events.reserve(num);
@@ -906,6 +923,190 @@ void EventList::reserve(size_t num) {
   }
 }
 
+/** Switch the storage of the events between a vector of event structs (the
+ * default) and columns, with one contiguous vector per event property.
+ *
+ * Column storage roughly halves the memory traffic of the tof-only operations
+ * (convertTof, maskTof, sortTof, generateHistogram, integrate, getTofs...).
+ * Any operation that needs the events themselves switches the list back to
+ * a vector of events first.
+ *
+ * @param useColumns :: true to store the events as columns
+ */
+void EventList::setColumnStorage(const bool useColumns) {
+  if (!useColumns) {
+    this->unpackColumns();
+    return;
+  }
+  this->unpackCompact();
+  this->unpackMapped();
+  if (m_columns)
+    return;
+
+  switch (eventType) {
+  case TOF:
+    m_columns = std::make_unique<EventColumns>(events);
+    break;
+  case WEIGHTED:
+    m_columns = std::make_unique<EventColumns>(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns = std::make_unique<EventColumns>(weightedEventsNoTime);
+    break;
+  }
+  m_packed = true;
+  std::vector<TofEvent>().swap(this->events);                         // STL Trick to release memory
+  std::vector<WeightedEvent>().swap(this->weightedEvents);             // STL Trick to release memory
+  std::vector<WeightedEventNoTime>().swap(this->weightedEventsNoTime); // STL Trick to release memory
+}
+
+/// Return true if the events are stored as columns
+bool EventList::hasColumnStorage() const { return static_cast<bool>(m_columns); }
+
+/** Move the events held in columns back into the vector matching the event
+ * type. Does nothing if the list does not use column storage.
+ */
+void EventList::unpackColumns() const {
+  if (!m_packed)
+    return;
+
+  // Avoid unpacking from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // The storage is only read under the lock, as another thread may be
+  // unpacking it.
+  if (!m_columns)
+    return;
+
+  switch (eventType) {
+  case TOF:
+    m_columns->unpack(events);
+    break;
+  case WEIGHTED:
+    m_columns->unpack(weightedEvents);
+    break;
+  case WEIGHTED_NOTIME:
+    m_columns->unpack(weightedEventsNoTime);
+    break;
+  }
+  m_columns.reset();
+  m_packed = false;
+}
+
+/** Store the TofEvents of the list in 8 bytes each, as a float tof and the
+ * index of the pulse time in a table (see CompactEvents), or switch back to a
+ * vector of TofEvent.
+ *
+ * The tofs are rounded to float precision. Counting and tof-only read
+ * operations (sortTof, generateHistogram, integrate, getTofs...) use the
+ * compact events directly; any other operation transparently converts the
+ * list back to a vector of TofEvent first.
+ *
+ * @param useCompact :: true to store the events compactly
+ * @param pulseTimes :: sorted table holding the pulse times of all the events,
+ * usually shared between the lists of a workspace. If null, a table is made
+ * for this list.
+ * @throw std::runtime_error if the events have weights
+ */
+void EventList::setCompactStorage(const bool useCompact,
+                                  std::shared_ptr<const std::vector<Types::Core::DateAndTime>> pulseTimes) {
+  if (!useCompact) {
+    this->unpackCompact();
+    return;
+  }
+  if (m_compact)
+    return;
+  this->unpackColumns();
+  this->unpackMapped();
+  if (eventType != TOF)
+    throw std::runtime_error("EventList::setCompactStorage() called for an EventList that has weights. Only TofEvents "
+                             "can be stored compactly.");
+
+  if (!pulseTimes)
+    pulseTimes = CompactEvents::makePulseTimeTable(events);
+  m_compact = std::make_unique<CompactEvents>(events, std::move(pulseTimes));
+  m_packed = true;
+  std::vector<TofEvent>().swap(this->events); // STL Trick to release memory
+}
+
+/// Return true if the events are stored compactly
+bool EventList::hasCompactStorage() const { return static_cast<bool>(m_compact); }
+
+/** Move the compact events back into the vector of TofEvent. Does nothing if
+ * the list does not use compact storage.
+ */
+void EventList::unpackCompact() const {
+  if (!m_packed)
+    return;
+
+  // Avoid unpacking from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // The storage is only read under the lock, as another thread may be
+  // unpacking it.
+  if (!m_compact)
+    return;
+
+  m_compact->unpack(events);
+  m_compact.reset();
+  m_packed = false;
+}
+
+/** Make the list a read-only view of events in a mapped file, replacing its
+ * events. The events of the file are sorted by tof and are used in place by
+ * counting and tof-only read operations (generateHistogram, integrate,
+ * getTofs...); any other operation, and any change, transparently copies them
+ * into a vector of events first.
+ *
+ * @param events :: the events of a spectrum of a MappedEventFile
+ */
+void EventList::setMappedEvents(const MappedEvents &events) {
+  this->clear(false);
+  m_mapped = std::make_unique<MappedEvents>(events);
+  m_packed = true;
+  this->eventType = events.getEventType();
+  this->order = TOF_SORT;
+}
+
+/// Return true if the events are a view of a mapped file
+bool EventList::hasMappedStorage() const { return static_cast<bool>(m_mapped); }
+
+/** Copy the mapped events into an event vector. Does nothing if the list is
+ * not a view of a mapped file.
+ */
+void EventList::unpackMapped() const {
+  if (!m_packed)
+    return;
+
+  // Avoid unpacking from multiple threads
+  std::lock_guard<std::mutex> _lock(m_sortMutex);
+  // The storage is only read under the lock, as another thread may be
+  // unpacking it.
+  if (!m_mapped)
+    return;
+
+  const size_t size = m_mapped->size();
+  switch (eventType) {
+  case TOF:
+    events.assign(m_mapped->tofEvents(), m_mapped->tofEvents() + size);
+    break;
+  case WEIGHTED:
+    weightedEvents.assign(m_mapped->weightedEvents(), m_mapped->weightedEvents() + size);
+    break;
+  case WEIGHTED_NOTIME:
+    weightedEventsNoTime.assign(m_mapped->weightedEventsNoTime(), m_mapped->weightedEventsNoTime() + size);
+    break;
+  }
+  m_mapped.reset();
+  m_packed = false;
+}
+
+/// Move the events held as columns, compactly or in a mapped file back into an
+/// event vector
+void EventList::unpackEvents() const {
+  this->unpackColumns();
+  this->unpackCompact();
+  this->unpackMapped();
+}
+
 // ==============================================================================================
 // --- Sorting functions -----------------------------------------------------
 // ==============================================================================================
@@ -943,7 +1144,7 @@ void EventList::sort(const EventSortType order) const {
 void EventList::setSortOrder(const EventSortType order) const { this->order = order; }
 
 // --------------------------------------------------------------------------
-/** Sort events by TOF in one thread */
+/** Sort events by TOF */
 void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return; // nothing to do
@@ -954,15 +1155,31 @@ void EventList::sortTof() const {
   if (this->order == TOF_SORT)
     return;
 
+  if (m_columns) {
+    m_columns->sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  if (m_compact) {
+    m_compact->sortTof();
+    this->order = TOF_SORT;
+    return;
+  }
+  if (m_mapped) {
+    // Mapped events are always sorted by tof
+    this->order = TOF_SORT;
+    return;
+  }
+
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end());
+    EventSorter::sortTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end());
+    EventSorter::sortTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
-    tbb::parallel_sort(weightedEventsNoTime.begin(), weightedEventsNoTime.end());
+    EventSorter::sortTof(weightedEventsNoTime);
     break;
   }
   // Save the order to avoid unnecessary re-sorting.
@@ -979,6 +1196,7 @@ void EventList::sortTof() const {
  * resort using forceResort = true. False by default.
  */
 void EventList::sortTimeAtSample(const double &tofFactor, const double &tofShift, bool forceResort) const {
+  this->unpackEvents();
   // Check pre-cached sort flag.
   if (this->order == TIMEATSAMPLE_SORT && !forceResort)
     return;
@@ -1011,6 +1229,7 @@ void EventList::sortTimeAtSample(const double &tofFactor, const double &tofShift
 // --------------------------------------------------------------------------
 /** Sort events by Frame */
 void EventList::sortPulseTime() const {
+  this->unpackEvents();
   if (this->order == PULSETIME_SORT)
     return; // nothing to do
 
@@ -1023,10 +1242,10 @@ void EventList::sortPulseTime() const {
   // Perform sort.
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTime);
+    EventSorter::sortPulseTime(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(), compareEventPulseTime);
+    EventSorter::sortPulseTime(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1041,6 +1260,7 @@ void EventList::sortPulseTime() const {
  * (the absolute time)
  */
 void EventList::sortPulseTimeTOF() const {
+  this->unpackEvents();
   if (this->order == PULSETIMETOF_SORT)
     return; // already ordered.
 
@@ -1052,10 +1272,10 @@ void EventList::sortPulseTimeTOF() const {
 
   switch (eventType) {
   case TOF:
-    tbb::parallel_sort(events.begin(), events.end(), compareEventPulseTimeTOF);
+    EventSorter::sortPulseTimeTof(events);
     break;
   case WEIGHTED:
-    tbb::parallel_sort(weightedEvents.begin(), weightedEvents.end(), compareEventPulseTimeTOF);
+    EventSorter::sortPulseTimeTof(weightedEvents);
     break;
   case WEIGHTED_NOTIME:
     // Do nothing; there is no time to sort
@@ -1074,6 +1294,7 @@ void EventList::sortPulseTimeTOF() const {
  * @param seconds The tolerance of pulse time in seconds.
  */
 void EventList::sortPulseTimeTOFDelta(const Types::Core::DateAndTime &start, const double seconds) const {
+  this->unpackEvents();
   // Avoid sorting from multiple threads
   std::lock_guard<std::mutex> _lock(m_sortMutex);
 
@@ -1114,7 +1335,13 @@ void EventList::reverse() {
   std::reverse(x.begin(), x.end());
 
   // flip the events if they are tof sorted
-  if (this->isSortedByTof()) {
+  if (this->isSortedByTof())
+    this->unpackMapped();
+  if (this->isSortedByTof() && m_columns) {
+    m_columns->reverse();
+  } else if (this->isSortedByTof() && m_compact) {
+    m_compact->reverse();
+  } else if (this->isSortedByTof()) {
     switch (eventType) {
     case TOF:
       std::reverse(this->events.begin(), this->events.end());
@@ -1140,6 +1367,12 @@ void EventList::reverse() {
  * @return the number of events in the list.
  *  */
 size_t EventList::getNumberEvents() const {
+  if (m_columns)
+    return m_columns->size();
+  if (m_compact)
+    return m_compact->size();
+  if (m_mapped)
+    return m_mapped->size();
   switch (eventType) {
   case TOF:
     return this->events.size();
@@ -1155,6 +1388,12 @@ size_t EventList::getNumberEvents() const {
  * Much like stl containers, returns true if there is nothing in the event list.
  */
 bool EventList::empty() const {
+  if (m_columns)
+    return m_columns->empty();
+  if (m_compact)
+    return m_compact->empty();
+  if (m_mapped)
+    return m_mapped->empty();
   switch (eventType) {
   case TOF:
     return this->events.empty();
@@ -1174,6 +1413,12 @@ bool EventList::empty() const {
  * @return :: the memory used by the EventList, in bytes.
  * */
 size_t EventList::getMemorySize() const {
+  if (m_columns)
+    return m_columns->getMemorySize() + sizeof(EventList);
+  if (m_compact)
+    return m_compact->getMemorySize() + sizeof(EventList);
+  if (m_mapped)
+    return m_mapped->getMemorySize() + sizeof(EventList);
   switch (eventType) {
   case TOF:
     return this->events.capacity() * sizeof(TofEvent) + sizeof(EventList);
@@ -1598,6 +1843,8 @@ inline void EventList::compressFatEventsHelper(const std::vector<T> &events, std
     if (it->m_pulsetime >= timeStart)
       break;
   }
+  if (it == events.cend())
+    return;
 
   // bin if the pulses are histogrammed
   int64_t lastPulseBin = (it->m_pulsetime.totalNanoseconds() - pulsetimeStart) / pulsetimeDelta;
@@ -1673,6 +1920,8 @@ inline void EventList::compressFatEventsHelper(const std::vector<T> &events, std
  *be == this.
  */
 void EventList::compressEvents(double tolerance, EventList *destination) {
+  this->unpackEvents();
+  destination->unpackEvents();
   if (!this->empty()) {
     this->sortTof();
     switch (eventType) {
@@ -1725,6 +1974,8 @@ void EventList::compressEvents(double tolerance, EventList *destination) {
 
 void EventList::compressFatEvents(const double tolerance, const Mantid::Types::Core::DateAndTime &timeStart,
                                   const double seconds, EventList *destination) {
+  destination->unpackEvents();
+  this->unpackEvents();
 
   // only worry about non-empty EventLists
   if (!this->empty()) {
@@ -2007,10 +2258,28 @@ void EventList::generateHistogramTimeAtSample(const MantidVec &X, MantidVec &Y,
  *        events; you can just ignore the returned E vector.
  */
 void EventList::generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E, bool skipError) const {
-  // All types of weights need to be sorted by TOF
+  // Linear and logarithmic bins can be filled without sorting the events.
+  // Sorted lists are already histogrammed in a single pass below.
+  if (!this->isSortedByTof()) {
+    const EventHistogrammer histogrammer(X);
+    if (histogrammer.isRegular()) {
+      this->histogramUnsorted(histogrammer, Y, E, skipError);
+      return;
+    }
+  }
 
+  // All types of weights need to be sorted by TOF
   this->sortTof();
 
+  if (m_columns && eventType != TOF) {
+    m_columns->generateWeightedHistogram(X, Y, E);
+    return;
+  }
+  if (m_mapped && eventType != TOF) {
+    m_mapped->generateWeightedHistogram(X, Y, E);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     // Make the single ones
@@ -2037,6 +2306,7 @@ void EventList::generateHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E
  * @param Y :: The generated counts histogram
  */
 void EventList::generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &Y) const {
+  this->unpackEvents();
   // For slight speed=up.
   size_t x_size = X.size();
 
@@ -2112,6 +2382,7 @@ void EventList::generateCountsHistogramPulseTime(const MantidVec &X, MantidVec &
  */
 void EventList::generateCountsHistogramPulseTime(const double &xMin, const double &xMax, MantidVec &Y,
                                                  const double TOF_min, const double TOF_max) const {
+  this->unpackEvents();
 
   if (this->events.empty())
     return;
@@ -2146,6 +2417,7 @@ void EventList::generateCountsHistogramPulseTime(const double &xMin, const doubl
  */
 void EventList::generateCountsHistogramTimeAtSample(const MantidVec &X, MantidVec &Y, const double &tofFactor,
                                                     const double &tofOffset) const {
+  this->unpackEvents();
   // For slight speed=up.
   const size_t x_size = X.size();
 
@@ -2219,8 +2491,32 @@ void EventList::generateCountsHistogram(const MantidVec &X, MantidVec &Y) const
     return;
   }
 
+  // Linear and logarithmic bins can be filled without sorting the events
+  if (eventType == TOF && !this->isSortedByTof()) {
+    const EventHistogrammer histogrammer(X);
+    if (histogrammer.isRegular()) {
+      MantidVec E_ignored;
+      this->histogramUnsorted(histogrammer, Y, E_ignored, true);
+      return;
+    }
+  }
+
   // Sort the events by tof
   this->sortTof();
+
+  if (m_columns) {
+    m_columns->generateCountsHistogram(X, Y);
+    return;
+  }
+  if (m_compact) {
+    m_compact->generateCountsHistogram(X, Y);
+    return;
+  }
+  if (m_mapped) {
+    m_mapped->generateCountsHistogram(X, Y);
+    return;
+  }
+
   // Clear the Y data, assign all to 0.
   Y.resize(x_size - 1, 0);
 
@@ -2245,6 +2541,42 @@ void EventList::generateCountsHistogram(const MantidVec &X, MantidVec &Y) const
   } // end if (there are any events to histogram)
 }
 
+// --------------------------------------------------------------------------
+/** Fill the histograms from events in any order, using the arithmetic bin
+ * lookup of an EventHistogrammer. Does not modify the eventlist.
+ * @param histogrammer :: holds linear or logarithmic bin edges
+ * @param Y :: The generated counts histogram
+ * @param E :: The generated error histogram
+ * @param skipError :: skip calculating the error. This has no effect for
+ *        weighted events.
+ */
+void EventList::histogramUnsorted(const EventHistogrammer &histogrammer, MantidVec &Y, MantidVec &E,
+                                  const bool skipError) const {
+  this->unpackMapped();
+  if (m_compact) {
+    histogrammer.histogram(m_compact->tofs(), Y);
+  } else if (m_columns) {
+    if (eventType == TOF)
+      histogrammer.histogram(m_columns->tofs(), Y);
+    else
+      histogrammer.histogram(m_columns->tofs(), m_columns->weights(), m_columns->errorSquareds(), Y, E);
+  } else {
+    switch (eventType) {
+    case TOF:
+      histogrammer.histogram(this->events, Y);
+      break;
+    case WEIGHTED:
+      histogrammer.histogram(this->weightedEvents, Y, E);
+      break;
+    case WEIGHTED_NOTIME:
+      histogrammer.histogram(this->weightedEventsNoTime, Y, E);
+      break;
+    }
+  }
+  if (eventType == TOF && !skipError)
+    this->generateErrorsHistogram(Y, E);
+}
+
 // --------------------------------------------------------------------------
 /**
  * Generate the Error histogram for the provided counts histogram.
@@ -2359,6 +2691,19 @@ void EventList::integrate(const double minX, const double maxX, const bool entir
     this->sortTof();
   }
 
+  if (m_columns) {
+    m_columns->integrate(minX, maxX, entireRange, sum, error);
+    return;
+  }
+  if (m_compact) {
+    m_compact->integrate(minX, maxX, entireRange, sum, error);
+    return;
+  }
+  if (m_mapped) {
+    m_mapped->integrate(minX, maxX, entireRange, sum, error);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2401,6 +2746,13 @@ void EventList::convertTof(std::function<double(double)> func, const int sorting
   if (this->getNumberEvents() <= 0)
     return;
 
+  this->unpackCompact();
+  this->unpackMapped();
+  if (m_columns) {
+    m_columns->convertTof(func);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2443,6 +2795,13 @@ void EventList::convertTof(const double factor, const double offset) {
   if (this->getNumberEvents() <= 0)
     return;
 
+  this->unpackCompact();
+  this->unpackMapped();
+  if (m_columns) {
+    m_columns->convertTof(factor, offset);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2522,6 +2881,7 @@ template <class T> void EventList::addPulsetimesHelper(std::vector<T> &events, c
  * @param seconds :: The value to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetime(const double seconds) {
+  this->unpackEvents();
   if (this->getNumberEvents() <= 0)
     return;
 
@@ -2547,6 +2907,7 @@ void EventList::addPulsetime(const double seconds) {
  * @param seconds :: A set of values to shift the pulsetime by, in seconds
  */
 void EventList::addPulsetimes(const std::vector<double> &seconds) {
+  this->unpackEvents();
   if (this->getNumberEvents() <= 0)
     return;
   if (this->getNumberEvents() != seconds.size()) {
@@ -2629,6 +2990,15 @@ void EventList::maskTof(const double tofMin, const double tofMax) {
   // Convert the list
   size_t numOrig = 0;
   size_t numDel = 0;
+  this->unpackCompact();
+  this->unpackMapped();
+  if (m_columns) {
+    numOrig = m_columns->size();
+    numDel = m_columns->maskTof(tofMin, tofMax);
+    if (numDel >= numOrig)
+      this->clear(false);
+    return;
+  }
   switch (eventType) {
   case TOF:
     numOrig = this->events.size();
@@ -2684,6 +3054,7 @@ template <class T> std::size_t EventList::maskConditionHelper(std::vector<T> &ev
  * @param mask :: condition vector
  */
 void EventList::maskCondition(const std::vector<bool> &mask) {
+  this->unpackEvents();
 
   // mask size must match the number of events
   if (this->getNumberEvents() != mask.size())
@@ -2734,6 +3105,19 @@ void EventList::getTofs(std::vector<double> &tofs) const {
   // Set the capacity of the vector to avoid multiple resizes
   tofs.reserve(this->getNumberEvents());
 
+  if (m_columns) {
+    tofs.assign(m_columns->tofs().cbegin(), m_columns->tofs().cend());
+    return;
+  }
+  if (m_compact) {
+    tofs.assign(m_compact->tofs().cbegin(), m_compact->tofs().cend());
+    return;
+  }
+  if (m_mapped) {
+    m_mapped->getTofs(tofs);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case TOF:
@@ -2778,6 +3162,19 @@ void EventList::getWeights(std::vector<double> &weights) const {
   // Set the capacity of the vector to avoid multiple resizes
   weights.reserve(this->getNumberEvents());
 
+  if (m_columns) {
+    m_columns->getWeights(weights);
+    return;
+  }
+  if (m_compact) {
+    weights.assign(m_compact->size(), 1.0);
+    return;
+  }
+  if (m_mapped) {
+    m_mapped->getWeights(weights);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case WEIGHTED:
@@ -2824,6 +3221,19 @@ void EventList::getWeightErrors(std::vector<double> &weightErrors) const {
   // Set the capacity of the vector to avoid multiple resizes
   weightErrors.reserve(this->getNumberEvents());
 
+  if (m_columns) {
+    m_columns->getWeightErrors(weightErrors);
+    return;
+  }
+  if (m_compact) {
+    weightErrors.assign(m_compact->size(), 1.0);
+    return;
+  }
+  if (m_mapped) {
+    m_mapped->getWeightErrors(weightErrors);
+    return;
+  }
+
   // Convert the list
   switch (eventType) {
   case WEIGHTED:
@@ -2869,6 +3279,7 @@ void EventList::getPulseTimesHelper(const std::vector<T> &events,
  * @return by copy a vector of DateAndTime times
  */
 std::vector<Mantid::Types::Core::DateAndTime> EventList::getPulseTimes() const {
+  this->unpackEvents();
   std::vector<Mantid::Types::Core::DateAndTime> times;
   // Set the capacity of the vector to avoid multiple resizes
   times.reserve(this->getNumberEvents());
@@ -2900,6 +3311,13 @@ double EventList::getTofMin() const {
   if (this->empty())
     return tMin;
 
+  if (m_columns)
+    return m_columns->getTofMin(this->order == TOF_SORT);
+  if (m_compact)
+    return m_compact->getTofMin(this->order == TOF_SORT);
+  if (m_mapped)
+    return m_mapped->getTofMin();
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2944,6 +3362,13 @@ double EventList::getTofMax() const {
   if (this->empty())
     return tMax;
 
+  if (m_columns)
+    return m_columns->getTofMax(this->order == TOF_SORT);
+  if (m_compact)
+    return m_compact->getTofMax(this->order == TOF_SORT);
+  if (m_mapped)
+    return m_mapped->getTofMax();
+
   // when events are ordered by tof just need the first value
   if (this->order == TOF_SORT) {
     switch (eventType) {
@@ -2982,6 +3407,7 @@ double EventList::getTofMax() const {
  * @return The minimum tof value for the list of the events.
  */
 DateAndTime EventList::getPulseTimeMin() const {
+  this->unpackEvents();
   // set up as the maximum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3026,6 +3452,7 @@ DateAndTime EventList::getPulseTimeMin() const {
  * @return The maximum tof value for the list of events.
  */
 DateAndTime EventList::getPulseTimeMax() const {
+  this->unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3068,6 +3495,7 @@ DateAndTime EventList::getPulseTimeMax() const {
 
 void EventList::getPulseTimeMinMax(Mantid::Types::Core::DateAndTime &tMin,
                                    Mantid::Types::Core::DateAndTime &tMax) const {
+  this->unpackEvents();
   // set up as the minimum available date time.
   tMax = DateAndTime::minimum();
   tMin = DateAndTime::maximum();
@@ -3117,6 +3545,7 @@ void EventList::getPulseTimeMinMax(Mantid::Types::Core::DateAndTime &tMin,
 }
 
 DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor, const double &tofOffset) const {
+  this->unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMax = DateAndTime::minimum();
 
@@ -3158,6 +3587,7 @@ DateAndTime EventList::getTimeAtSampleMax(const double &tofFactor, const double
 }
 
 DateAndTime EventList::getTimeAtSampleMin(const double &tofFactor, const double &tofOffset) const {
+  this->unpackEvents();
   // set up as the minimum available date time.
   DateAndTime tMin = DateAndTime::maximum();
 
@@ -3223,6 +3653,7 @@ template <class T> void EventList::setTofsHelper(std::vector<T> &events, const s
  * @param tofs :: The vector of doubles to set the tofs to.
  */
 void EventList::setTofs(const MantidVec &tofs) {
+  this->unpackEvents();
   this->order = UNSORTED;
 
   // Convert the list
@@ -3321,6 +3752,7 @@ EventList &EventList::operator*=(const double value) {
  * @param error: error on 'value'. Can be 0.
  */
 void EventList::multiply(const double value, const double error) {
+  this->unpackEvents();
   // Do nothing if multiplying by exactly one and there is no error
   if ((value == 1.0) && (error == 0.0))
     return;
@@ -3446,6 +3878,7 @@ void EventList::multiplyHistogramHelper(std::vector<T> &events, const MantidVec
  * @throw invalid_argument if the sizes of X, Y, E are not consistent.
  */
 void EventList::multiply(const MantidVec &X, const MantidVec &Y, const MantidVec &E) {
+  this->unpackEvents();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3583,6 +4016,7 @@ void EventList::divideHistogramHelper(std::vector<T> &events, const MantidVec &X
  * @throw invalid_argument if the sizes of X, Y, E are not consistent.
  */
 void EventList::divide(const MantidVec &X, const MantidVec &Y, const MantidVec &E) {
+  this->unpackEvents();
   switch (eventType) {
   case TOF:
     // Switch to weights if needed.
@@ -3706,6 +4140,7 @@ void EventList::filterByTimeAtSampleHelper(std::vector<T> &events, DateAndTime s
  * @throws std::invalid_argument If output is a reference to this EventList
  */
 void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop, EventList &output) const {
+  this->unpackEvents();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3737,6 +4172,7 @@ void EventList::filterByPulseTime(DateAndTime start, DateAndTime stop, EventList
 
 void EventList::filterByTimeAtSample(Types::Core::DateAndTime start, Types::Core::DateAndTime stop, double tofFactor,
                                      double tofOffset, EventList &output) const {
+  this->unpackEvents();
   if (this == &output) {
     throw std::invalid_argument("In-place filtering is not allowed");
   }
@@ -3849,6 +4285,7 @@ void EventList::filterInPlaceHelper(Kernel::TimeSplitterType &splitter, typename
  *     that will be kept. Any other events will be deleted.
  */
 void EventList::filterInPlace(Kernel::TimeSplitterType &splitter) {
+  this->unpackEvents();
   // Start by sorting the event list by pulse time.
   this->sortPulseTime();
 
@@ -3938,6 +4375,7 @@ void EventList::splitByTimeHelper(Kernel::TimeSplitterType &splitter, std::vecto
  *        be big enough to accommodate the indices.
  */
 void EventList::splitByTime(Kernel::TimeSplitterType &splitter, std::vector<EventList *> outputs) const {
+  this->unpackEvents();
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
                              "that no longer has time information.");
@@ -3972,86 +4410,108 @@ void EventList::splitByTime(Kernel::TimeSplitterType &splitter, std::vector<Even
 }
 
 //------------------------------------------------------------------------------------------------
-/** Split the event list into n outputs, operating on a vector of either
- *TofEvent's or WeightedEvent's
- *  The comparison between neutron event and splitter is based on neutron
- *event's pulse time plus
+/** Check the outputs of a split and get them ready: sort the event list by
+ * pulse time then TOF, and set up every output as an empty list of the same
+ * type and detectors.
  *
- * @param splitter :: a TimeSplitterType giving where to split
- * @param outputs :: a vector of where the split events will end up. The # of
- *entries in there should
- *        be big enough to accommodate the indices.
- * @param events :: either this->events or this->weightedEvents.
- * @param docorrection :: flag to determine whether or not to apply correction
- * @param toffactor :: factor to correct TOF in formula toffactor*tof+tofshift
- * @param tofshift :: amount to shift (in SECOND) to correct TOF in formula:
- *toffactor*tof+tofshift
+ * @param splitter :: the EventSplitter giving where to split
+ * @param outputs :: an event list, or nullptr, for each output of splitter
  */
-template <class T>
-void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
-                                      typename std::vector<T> &events, bool docorrection, double toffactor,
-                                      double tofshift) const {
-  // 1. Prepare to Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-
-  // 2. Prepare to Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
+void EventList::prepareSplitOutputs(const EventSplitter &splitter, const std::vector<EventList *> &outputs) const {
+  if (outputs.size() != splitter.numberOfOutputs())
+    throw std::invalid_argument("EventList: the number of outputs does not match the EventSplitter.");
+  this->unpackEvents();
+  if (eventType == WEIGHTED_NOTIME)
+    throw std::runtime_error("EventList::splitByTime() called on an EventList "
+                             "that no longer has time information.");
 
-  // 3. This is the time of the first section. Anything before is thrown out.
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination
-    int64_t start = itspl->start().totalNanoseconds();
-    int64_t stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
+  // Start by sorting the event list by pulse time.
+  this->sortPulseTimeTOF();
 
-    // a) Skip the events before the start of the time
-    // TODO This step can be
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      int64_t fulltime;
-      if (docorrection)
-        fulltime = calculateCorrectedFullTime(*itev, toffactor, tofshift);
-      else
-        fulltime = itev->m_pulsetime.totalNanoseconds() + static_cast<int64_t>(itev->m_tof * 1000);
-      if (fulltime < start) {
-        // a1) Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        itev++;
-      } else {
-        break;
-      }
-    }
+  for (auto *opeventlist : outputs) {
+    if (!opeventlist)
+      continue;
+    opeventlist->clear();
+    opeventlist->setDetectorIDs(this->getDetectorIDs());
+    opeventlist->setHistogram(m_histogram);
+    // Match the output event type.
+    opeventlist->switchTo(eventType);
+  }
+}
 
-    // b) Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-      int64_t fulltime;
-      if (docorrection)
-        fulltime = itev->m_pulsetime.totalNanoseconds() +
-                   static_cast<int64_t>(toffactor * itev->m_tof * 1000 + tofshift * 1.0E9);
-      else
-        fulltime = itev->m_pulsetime.totalNanoseconds() + static_cast<int64_t>(itev->m_tof * 1000);
-      if (fulltime < stop) {
-        // b1) Add a copy to the output
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        break;
-      }
-    }
+//------------------------------------------------------------------------------------------------
+/** Route each event of a vector of either TofEvent's or WeightedEvent's to
+ * the output of the region of the splitter holding its time. The events are
+ * sorted by pulse time, so the region of an event is searched from that of
+ * the previous one.
+ *
+ * @param splitter :: the EventSplitter giving where to split
+ * @param outputs :: an event list, or nullptr, for each output of splitter
+ * @param events :: either this->events or this->weightedEvents.
+ * @param timeOfEvent :: gives the time of an event in nanoseconds
+ */
+template <class T, class TimeOfEvent>
+void EventList::splitByEventTimeHelper(const EventSplitter &splitter, const std::vector<EventList *> &outputs,
+                                       const std::vector<T> &events, const TimeOfEvent &timeOfEvent) {
+  size_t region = 0;
+  for (const auto &event : events) {
+    region = splitter.findRegion(timeOfEvent(event), region);
+    const size_t output = splitter.regionOutput(region);
+    if (output != EventSplitter::NO_OUTPUT && outputs[output])
+      outputs[output]->addEventQuickly(event);
+  }
+}
 
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
+//------------------------------------------------------------------------------------------------
+/** Split the (prepared) event list with an EventSplitter
+ *
+ * @param splitter :: the EventSplitter giving where to split
+ * @param outputs :: an event list, or nullptr, for each output of splitter
+ * @param timeOfEvent :: gives the time of an event in nanoseconds
+ */
+template <class TimeOfEvent>
+void EventList::splitByEventTime(const EventSplitter &splitter, const std::vector<EventList *> &outputs,
+                                 const TimeOfEvent &timeOfEvent) const {
+  switch (eventType) {
+  case TOF:
+    splitByEventTimeHelper(splitter, outputs, this->events, timeOfEvent);
+    break;
+  case WEIGHTED:
+    splitByEventTimeHelper(splitter, outputs, this->weightedEvents, timeOfEvent);
+    break;
+  case WEIGHTED_NOTIME:
+    break;
+  }
+  // Each output holds some of the events, in the same order
+  for (auto *opeventlist : outputs) {
+    if (opeventlist)
+      opeventlist->setSortOrder(PULSETIMETOF_SORT);
+  }
+}
 
-    // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
-      break;
-  } // END-WHILE Splitter
+//------------------------------------------------------------------------------------------------
+/** Split the event list into n outputs by event's full time (tof + pulse time)
+ *
+ * @param splitter :: an EventSplitter giving where to split
+ * @param outputs :: an event list for each output of splitter, in the order
+ *of its targets. The events of the outputs that are nullptr are dropped.
+ * @param docorrection :: a boolean to indiciate whether it is need to do
+ *correction
+ * @param toffactor:  a correction factor for each TOF to multiply with
+ * @param tofshift:  a correction shift for each TOF to add with
+ */
+void EventList::splitByFullTime(const EventSplitter &splitter, const std::vector<EventList *> &outputs,
+                                bool docorrection, double toffactor, double tofshift) const {
+  prepareSplitOutputs(splitter, outputs);
+  if (docorrection) {
+    splitByEventTime(splitter, outputs, [toffactor, tofshift](const auto &event) {
+      return calculateCorrectedFullTime(event, toffactor, tofshift);
+    });
+  } else {
+    splitByEventTime(splitter, outputs, [](const auto &event) {
+      return event.pulseTime().totalNanoseconds() + static_cast<int64_t>(event.tof() * 1000);
+    });
+  }
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4068,42 +4528,8 @@ void EventList::splitByFullTimeHelper(Kernel::TimeSplitterType &splitter, std::m
  */
 void EventList::splitByFullTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
                                 bool docorrection, double toffactor, double tofshift) const {
-  if (eventType == WEIGHTED_NOTIME)
-    throw std::runtime_error("EventList::splitByTime() called on an EventList "
-                             "that no longer has time information.");
-
-  // 1. Start by sorting the event list by pulse time.
-  this->sortPulseTimeTOF();
-
-  // 2. Initialize all the outputs
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
-    opeventlist->clear();
-    opeventlist->setDetectorIDs(this->getDetectorIDs());
-    opeventlist->setHistogram(m_histogram);
-    // Match the output event type.
-    opeventlist->switchTo(eventType);
-  }
-
-  // Do nothing if there are no entries
-  if (splitter.empty()) {
-    // 3A. Copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
-    // this->duplicate(outputs[-1]);
-  } else {
-    // 3B. Split
-    switch (eventType) {
-    case TOF:
-      splitByFullTimeHelper(splitter, outputs, this->events, docorrection, toffactor, tofshift);
-      break;
-    case WEIGHTED:
-      splitByFullTimeHelper(splitter, outputs, this->weightedEvents, docorrection, toffactor, tofshift);
-      break;
-    case WEIGHTED_NOTIME:
-      break;
-    }
-  }
+  const EventSplitter eventSplitter(splitter);
+  splitByFullTime(eventSplitter, eventSplitter.selectOutputs(outputs), docorrection, toffactor, tofshift);
 }
 
 //------------------------------------------------------------------------------------------------
@@ -4290,6 +4716,7 @@ std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t>
                                                      const std::vector<int> &vecgroups,
                                                      std::map<int, EventList *> vec_outputEventList, bool docorrection,
                                                      double toffactor, double tofshift) const {
+  this->unpackEvents();
   // Check validity
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4351,108 +4778,24 @@ std::string EventList::splitByFullTimeMatrixSplitter(const std::vector<int64_t>
   return debugmessage;
 }
 
-//-------------------------------------------
-//--------------------------------------------------
+//----------------------------------------------------------------------------------------------
 /** Split the event list into n outputs by each event's pulse time only
+ *
+ * @param splitter :: an EventSplitter giving where to split
+ * @param outputs :: an event list for each output of splitter, in the order
+ *of its targets. The events of the outputs that are nullptr are dropped.
  */
-template <class T>
-void EventList::splitByPulseTimeHelper(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs,
-                                       typename std::vector<T> &events) const {
-  // Prepare to TimeSplitter Iterate through the splitter at the same time
-  auto itspl = splitter.begin();
-  auto itspl_end = splitter.end();
-  Types::Core::DateAndTime start, stop;
-
-  // Prepare to Events Iterate through all events (sorted by tof)
-  auto itev = events.begin();
-  auto itev_end = events.end();
-
-  // Iterate (loop) on all splitters
-  while (itspl != itspl_end) {
-    // Get the splitting interval times and destination group
-    start = itspl->start().totalNanoseconds();
-    stop = itspl->stop().totalNanoseconds();
-    const int index = itspl->index();
-
-    // Skip the events before the start of the time and put to 'unfiltered'
-    // EventList
-    EventList *myOutput = outputs[-1];
-    while (itev != itev_end) {
-      if (itev->m_pulsetime < start) {
-        // Record to index = -1 space
-        const T eventCopy(*itev);
-        myOutput->addEventQuickly(eventCopy);
-        ++itev;
-      } else {
-        // Event within a splitter interval
-        break;
-      }
-    }
-
-    // Go through all the events that are in the interval (if any)
-    while (itev != itev_end) {
-
-      if (itev->m_pulsetime < stop) {
-        outputs[index]->addEventQuickly(*itev);
-        ++itev;
-      } else {
-        // Out of interval
-        break;
-      }
-    }
-
-    // Go to the next interval
-    ++itspl;
-    // But if we reached the end, then we are done.
-    if (itspl == itspl_end)
-      break;
-
-    // No need to keep looping through the filter if we are out of events
-    if (itev == itev_end)
-      break;
-  } // END-WHILE Splitter
+void EventList::splitByPulseTime(const EventSplitter &splitter, const std::vector<EventList *> &outputs) const {
+  prepareSplitOutputs(splitter, outputs);
+  splitByEventTime(splitter, outputs, [](const auto &event) { return event.pulseTime().totalNanoseconds(); });
 }
 
 //----------------------------------------------------------------------------------------------
 /** Split the event list by pulse time
  */
 void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<int, EventList *> outputs) const {
-  // Check for supported event type
-  if (eventType == WEIGHTED_NOTIME)
-    throw std::runtime_error("EventList::splitByTime() called on an EventList "
-                             "that no longer has time information.");
-
-  // Start by sorting the event list by pulse time.
-  this->sortPulseTimeTOF();
-
-  // Initialize all the output event lists
-  std::map<int, EventList *>::iterator outiter;
-  for (outiter = outputs.begin(); outiter != outputs.end(); ++outiter) {
-    EventList *opeventlist = outiter->second;
-    opeventlist->clear();
-    opeventlist->setDetectorIDs(this->getDetectorIDs());
-    opeventlist->setHistogram(m_histogram);
-    // Match the output event type.
-    opeventlist->switchTo(eventType);
-  }
-
-  // Split
-  if (splitter.empty()) {
-    // No splitter: copy all events to group workspace = -1
-    (*outputs[-1]) = (*this);
-  } else {
-    // Split
-    switch (eventType) {
-    case TOF:
-      splitByPulseTimeHelper(splitter, outputs, this->events);
-      break;
-    case WEIGHTED:
-      splitByPulseTimeHelper(splitter, outputs, this->weightedEvents);
-      break;
-    case WEIGHTED_NOTIME:
-      break;
-    }
-  }
+  const EventSplitter eventSplitter(splitter);
+  splitByPulseTime(eventSplitter, eventSplitter.selectOutputs(outputs));
 }
 
 //----------------------------------------------------------------------------------------------
@@ -4461,6 +4804,7 @@ void EventList::splitByPulseTime(Kernel::TimeSplitterType &splitter, std::map<in
 // TODO/NOW - TEST
 void EventList::splitByPulseTimeWithMatrix(const std::vector<int64_t> &vec_times, const std::vector<int> &vec_target,
                                            std::map<int, EventList *> outputs) const {
+  this->unpackEvents();
   // Check for supported event type
   if (eventType == WEIGHTED_NOTIME)
     throw std::runtime_error("EventList::splitByTime() called on an EventList "
@@ -4605,13 +4949,19 @@ void getEventsFrom(const EventList &el, std::vector<WeightedEventNoTime> const *
 template <class T>
 void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events, Mantid::Kernel::Unit *fromUnit,
                                          Mantid::Kernel::Unit *toUnit) {
-  auto itev = events.begin();
-  auto itev_end = events.end();
-  for (; itev != itev_end; itev++) {
-    // Conver to TOF
-    double tof = fromUnit->singleToTOF(itev->m_tof);
-    // And back from TOF to whatever
-    itev->m_tof = toUnit->singleFromTOF(tof);
+  // Gather the tofs in blocks so the units convert whole arrays rather than
+  // paying a virtual call per event per unit
+  constexpr size_t blockSize = 1024;
+  std::array<double, blockSize> buffer;
+  const size_t numEvents = events.size();
+  for (size_t start = 0; start < numEvents; start += blockSize) {
+    const size_t count = std::min(blockSize, numEvents - start);
+    for (size_t i = 0; i < count; ++i)
+      buffer[i] = events[start + i].m_tof;
+    fromUnit->valuesToTOF(buffer.data(), buffer.data(), count);
+    toUnit->valuesFromTOF(buffer.data(), buffer.data(), count);
+    for (size_t i = 0; i < count; ++i)
+      events[start + i].m_tof = buffer[i];
   }
 }
 
@@ -4624,6 +4974,8 @@ void EventList::convertUnitsViaTofHelper(typename std::vector<T> &events, Mantid
  * @param toUnit :: the Unit describing the output unit. Must be initialized.
  */
 void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit, Mantid::Kernel::Unit *toUnit) {
+  this->unpackCompact();
+  this->unpackMapped();
   // Check for initialized
   if (!fromUnit || !toUnit)
     throw std::runtime_error("EventList::convertUnitsViaTof(): one of the units is NULL!");
@@ -4632,6 +4984,11 @@ void EventList::convertUnitsViaTof(Mantid::Kernel::Unit *fromUnit, Mantid::Kerne
   if (!toUnit->isInitialized())
     throw std::runtime_error("EventList::convertUnitsViaTof(): toUnit is not initialized!");
 
+  if (m_columns) {
+    m_columns->convertUnitsViaTof(*fromUnit, *toUnit);
+    return;
+  }
+
   switch (eventType) {
   case TOF:
     convertUnitsViaTofHelper(this->events, fromUnit, toUnit);
@@ -4667,6 +5024,7 @@ void EventList::convertUnitsQuicklyHelper(typename std::vector<T> &events, const
  *  @param power :: the Power b to apply to the conversion
  */
 void EventList::convertUnitsQuickly(const double &factor, const double &power) {
+  this->unpackEvents();
   switch (eventType) {
   case TOF:
     convertUnitsQuicklyHelper(this->events, factor, power);
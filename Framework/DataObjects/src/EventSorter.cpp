@@ -0,0 +1,204 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventSorter.h"
+
+#include "tbb/parallel_for.h"
+#include "tbb/task_arena.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Mantid {
+namespace DataObjects {
+using Types::Event::TofEvent;
+
+namespace {
+/// Number of bits of the key distributed in one pass
+constexpr unsigned DIGIT_BITS = 11;
+/// Number of buckets of a pass
+constexpr size_t NUM_BUCKETS = size_t{1} << DIGIT_BITS;
+/// Vectors smaller than this are sorted with std::sort
+constexpr size_t MIN_RADIX_SIZE = 1024;
+/// Fewest events counted and scattered by one thread
+constexpr size_t MIN_BLOCK_SIZE = 1 << 16;
+/// The sign bit of a 64-bit key
+constexpr uint64_t SIGN_BIT = uint64_t{1} << 63;
+
+/// Map a double to an unsigned integer in the same order
+inline uint64_t sortableKey(const double value) {
+  uint64_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+}
+
+/// Map a float to an unsigned integer in the same order
+inline uint64_t sortableKey(const float value) {
+  uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  constexpr uint32_t floatSignBit = uint32_t{1} << 31;
+  return (bits & floatSignBit) ? ~bits : bits | floatSignBit;
+}
+
+/// Map a signed integer to an unsigned integer in the same order
+inline uint64_t sortableKey(const int64_t value) { return static_cast<uint64_t>(value) ^ SIGN_BIT; }
+
+/// The key of the time-of-flight of an event
+struct TofKey {
+  template <typename T> uint64_t operator()(const T &event) const { return sortableKey(event.tof()); }
+};
+
+/// The key of the first member of a pair
+struct FirstKey {
+  template <typename T> uint64_t operator()(const T &pair) const { return sortableKey(pair.first); }
+};
+
+/// The key of the pulse time of an event
+struct PulseTimeKey {
+  template <typename T> uint64_t operator()(const T &event) const {
+    return sortableKey(event.pulseTime().totalNanoseconds());
+  }
+};
+
+/** Stable LSD radix sort of values by key. Each pass counts the digits of the
+ * blocks of values in parallel, works out where each block writes each digit,
+ * then scatters the blocks in parallel. Digits shared by all the values are
+ * skipped.
+ * @param values :: the values to sort
+ * @param buffer :: scratch space, the same size as values
+ * @param key :: maps a value to an unsigned integer key
+ */
+template <typename T, typename Key> void radixSort(std::vector<T> &values, std::vector<T> &buffer, const Key &key) {
+  const size_t numValues = values.size();
+  const auto maxBlocks = 4 * static_cast<size_t>(std::max(1, tbb::this_task_arena::max_concurrency()));
+  const size_t numBlocks = std::max(size_t{1}, std::min(numValues / MIN_BLOCK_SIZE, maxBlocks));
+  const size_t blockSize = numValues / numBlocks + (numValues % numBlocks != 0);
+  const auto forEachBlock = [numValues, numBlocks, blockSize](const auto &function) {
+    tbb::parallel_for(size_t{0}, numBlocks, [&function, numValues, blockSize](const size_t block) {
+      function(block, block * blockSize, std::min(numValues, (block + 1) * blockSize));
+    });
+  };
+
+  // The bits that differ between values
+  std::vector<uint64_t> blockAnd(numBlocks, ~uint64_t{0});
+  std::vector<uint64_t> blockOr(numBlocks, 0);
+  forEachBlock([&](const size_t block, const size_t begin, const size_t end) {
+    uint64_t andKeys = ~uint64_t{0};
+    uint64_t orKeys = 0;
+    for (size_t i = begin; i < end; ++i) {
+      const uint64_t valueKey = key(values[i]);
+      andKeys &= valueKey;
+      orKeys |= valueKey;
+    }
+    blockAnd[block] = andKeys;
+    blockOr[block] = orKeys;
+  });
+  uint64_t allAnd = ~uint64_t{0};
+  uint64_t allOr = 0;
+  for (size_t block = 0; block < numBlocks; ++block) {
+    allAnd &= blockAnd[block];
+    allOr |= blockOr[block];
+  }
+  const uint64_t varyingBits = allAnd ^ allOr;
+
+  T *source = values.data();
+  T *destination = buffer.data();
+  std::vector<size_t> offsets(numBlocks * NUM_BUCKETS);
+  for (unsigned shift = 0; shift < 64; shift += DIGIT_BITS) {
+    if (((varyingBits >> shift) & (NUM_BUCKETS - 1)) == 0)
+      continue;
+    const auto digit = [&key, shift](const T &value) { return (key(value) >> shift) & (NUM_BUCKETS - 1); };
+
+    std::fill(offsets.begin(), offsets.end(), 0);
+    forEachBlock([&](const size_t block, const size_t begin, const size_t end) {
+      size_t *counts = offsets.data() + block * NUM_BUCKETS;
+      for (size_t i = begin; i < end; ++i)
+        ++counts[digit(source[i])];
+    });
+    // Each block writes a digit after the earlier digits and the earlier
+    // blocks with the same digit, so the pass is stable
+    size_t position = 0;
+    for (size_t bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+      for (size_t block = 0; block < numBlocks; ++block) {
+        const size_t count = offsets[block * NUM_BUCKETS + bucket];
+        offsets[block * NUM_BUCKETS + bucket] = position;
+        position += count;
+      }
+    }
+    forEachBlock([&](const size_t block, const size_t begin, const size_t end) {
+      size_t *next = offsets.data() + block * NUM_BUCKETS;
+      for (size_t i = begin; i < end; ++i)
+        destination[next[digit(source[i])]++] = source[i];
+    });
+    std::swap(source, destination);
+  }
+
+  if (source != values.data())
+    values.swap(buffer);
+}
+
+/** Sort values by one key
+ * @param values :: the values to sort
+ * @param key :: maps a value to an unsigned integer key
+ */
+template <typename T, typename Key> void sortByKey(std::vector<T> &values, const Key &key) {
+  if (values.size() < MIN_RADIX_SIZE) {
+    std::sort(values.begin(), values.end(), [&key](const T &lhs, const T &rhs) { return key(lhs) < key(rhs); });
+    return;
+  }
+  std::vector<T> buffer(values.size());
+  radixSort(values, buffer, key);
+}
+
+/** Sort events by pulse time, then by tof
+ * @param events :: the events to sort
+ */
+template <typename T> void sortByPulseTimeTof(std::vector<T> &events) {
+  const PulseTimeKey pulseTimeKey;
+  const TofKey tofKey;
+  if (events.size() < MIN_RADIX_SIZE) {
+    std::sort(events.begin(), events.end(), [&](const T &lhs, const T &rhs) {
+      const auto lhsPulseTime = pulseTimeKey(lhs);
+      const auto rhsPulseTime = pulseTimeKey(rhs);
+      return lhsPulseTime < rhsPulseTime || (lhsPulseTime == rhsPulseTime && tofKey(lhs) < tofKey(rhs));
+    });
+    return;
+  }
+  std::vector<T> buffer(events.size());
+  radixSort(events, buffer, tofKey);
+  radixSort(events, buffer, pulseTimeKey);
+}
+} // namespace
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<TofEvent> &events) { sortByKey(events, TofKey()); }
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<WeightedEvent> &events) { sortByKey(events, TofKey()); }
+
+/// Sort events by time-of-flight
+void EventSorter::sortTof(std::vector<WeightedEventNoTime> &events) { sortByKey(events, TofKey()); }
+
+/// Sort (tof, index) pairs by time-of-flight
+void EventSorter::sortTof(std::vector<std::pair<double, size_t>> &keys) { sortByKey(keys, FirstKey()); }
+
+/// Sort (tof, pulse index) pairs by time-of-flight
+void EventSorter::sortTof(std::vector<std::pair<float, uint32_t>> &events) { sortByKey(events, FirstKey()); }
+
+/// Sort events by pulse time
+void EventSorter::sortPulseTime(std::vector<TofEvent> &events) { sortByKey(events, PulseTimeKey()); }
+
+/// Sort events by pulse time
+void EventSorter::sortPulseTime(std::vector<WeightedEvent> &events) { sortByKey(events, PulseTimeKey()); }
+
+/// Sort events by pulse time, then by time-of-flight
+void EventSorter::sortPulseTimeTof(std::vector<TofEvent> &events) { sortByPulseTimeTof(events); }
+
+/// Sort events by pulse time, then by time-of-flight
+void EventSorter::sortPulseTimeTof(std::vector<WeightedEvent> &events) { sortByPulseTimeTof(events); }
+
+} // namespace DataObjects
+} // namespace Mantid
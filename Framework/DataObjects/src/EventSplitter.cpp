@@ -0,0 +1,100 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/EventSplitter.h"
+#include "MantidKernel/TimeSplitter.h"
+
+#include <set>
+#include <stdexcept>
+#include <string>
+
+namespace Mantid {
+namespace DataObjects {
+
+namespace {
+/// Target of the events that are in no splitting interval
+constexpr int UNFILTERED_TARGET = -1;
+} // namespace
+
+/** Compile a splitter
+ * @param splitter :: the splitting intervals, in time order
+ */
+EventSplitter::EventSplitter(const Kernel::TimeSplitterType &splitter) {
+  std::set<int> targets{UNFILTERED_TARGET};
+  for (const auto &interval : splitter)
+    targets.insert(interval.index());
+  m_targets.assign(targets.cbegin(), targets.cend());
+
+  const size_t unfiltered = outputIndex(UNFILTERED_TARGET);
+  m_boundaries.emplace_back(std::numeric_limits<int64_t>::min());
+  m_outputs.emplace_back(unfiltered);
+  if (splitter.empty())
+    return;
+
+  // An interval starting before the end of the previous one only keeps what
+  // is after it, as the events it shares were already taken.
+  int64_t end = std::numeric_limits<int64_t>::min();
+  for (const auto &interval : splitter) {
+    const int64_t start = std::max(interval.start().totalNanoseconds(), end);
+    const int64_t stop = interval.stop().totalNanoseconds();
+    if (start > end)
+      addRegion(end, unfiltered);
+    if (stop > start) {
+      addRegion(start, outputIndex(interval.index()));
+      end = stop;
+    } else {
+      end = start;
+    }
+  }
+  addRegion(end, NO_OUTPUT);
+}
+
+/** Add a region ending the last one
+ * @param start :: start of the region in nanoseconds
+ * @param output :: output of the region
+ */
+void EventSplitter::addRegion(const int64_t start, const size_t output) {
+  if (start == m_boundaries.back()) {
+    // The last region is empty
+    m_outputs.back() = output;
+    if (m_outputs.size() > 1 && m_outputs[m_outputs.size() - 2] == output) {
+      m_boundaries.pop_back();
+      m_outputs.pop_back();
+    }
+  } else if (output != m_outputs.back()) {
+    m_boundaries.emplace_back(start);
+    m_outputs.emplace_back(output);
+  }
+}
+
+/** @param target :: a target index
+ * @return the output of the target
+ * @throw std::invalid_argument if no interval has the target
+ */
+size_t EventSplitter::outputIndex(const int target) const {
+  const auto it = std::lower_bound(m_targets.cbegin(), m_targets.cend(), target);
+  if (it == m_targets.cend() || *it != target)
+    throw std::invalid_argument("EventSplitter: no splitting interval has the target " + std::to_string(target));
+  return static_cast<size_t>(std::distance(m_targets.cbegin(), it));
+}
+
+/** Order some event lists as the outputs of the splitter
+ * @param outputs :: an event list for each target index
+ * @return the list of each output, or nullptr for targets that are not in
+ * outputs
+ */
+std::vector<EventList *> EventSplitter::selectOutputs(const std::map<int, EventList *> &outputs) const {
+  std::vector<EventList *> selected(m_targets.size(), nullptr);
+  for (size_t i = 0; i < m_targets.size(); ++i) {
+    const auto output = outputs.find(m_targets[i]);
+    if (output != outputs.cend())
+      selected[i] = output->second;
+  }
+  return selected;
+}
+
+} // namespace DataObjects
+} // namespace Mantid
@@ -13,7 +13,9 @@
 #include "MantidAPI/SpectraAxis.h"
 #include "MantidAPI/SpectrumInfo.h"
 #include "MantidAPI/WorkspaceFactory.h"
+#include "MantidDataObjects/CompactEvents.h"
 #include "MantidDataObjects/EventWorkspaceMRU.h"
+#include "MantidDataObjects/MappedEventFile.h"
 #include "MantidGeometry/IDetector.h"
 #include "MantidGeometry/Instrument.h"
 #include "MantidKernel/CPUTimer.h"
@@ -469,6 +471,81 @@ void EventWorkspace::switchEventType(const Mantid::API::EventType type) {
     eventList->switchTo(type);
 }
 
+/** Switch the storage of all event lists between event vectors and columns.
+ * See EventList::setColumnStorage().
+ *
+ * @param useColumns :: true to store the events as columns
+ */
+void EventWorkspace::setColumnStorage(const bool useColumns) {
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < static_cast<int>(this->data.size()); wksp_index++) {
+    this->data[wksp_index]->setColumnStorage(useColumns);
+  }
+}
+
+/** Switch the storage of the TofEvent lists between event vectors and the
+ * compact storage of EventList::setCompactStorage(). One table of pulse times
+ * is shared by all the lists. Lists with weights are left as they are.
+ *
+ * @param useCompact :: true to store the events compactly
+ */
+void EventWorkspace::setCompactStorage(const bool useCompact) {
+  const auto numLists = static_cast<int>(this->data.size());
+  if (!useCompact) {
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int wksp_index = 0; wksp_index < numLists; wksp_index++) {
+      this->data[wksp_index]->setCompactStorage(false);
+    }
+    return;
+  }
+
+  // The pulse times of each list, then of all of them
+  std::vector<std::shared_ptr<const CompactEvents::PulseTimeTable>> listPulseTimes(this->data.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < numLists; wksp_index++) {
+    const auto &eventList = *this->data[wksp_index];
+    if (eventList.getEventType() == Mantid::API::TOF && !eventList.hasCompactStorage())
+      listPulseTimes[wksp_index] = CompactEvents::makePulseTimeTable(eventList.getEvents());
+  }
+  auto pulseTimes = std::make_shared<CompactEvents::PulseTimeTable>();
+  for (const auto &table : listPulseTimes) {
+    if (table)
+      pulseTimes->insert(pulseTimes->end(), table->cbegin(), table->cend());
+  }
+  listPulseTimes.clear();
+  std::sort(pulseTimes->begin(), pulseTimes->end());
+  pulseTimes->erase(std::unique(pulseTimes->begin(), pulseTimes->end()), pulseTimes->end());
+  pulseTimes->shrink_to_fit();
+  std::shared_ptr<const CompactEvents::PulseTimeTable> table = std::move(pulseTimes);
+
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int wksp_index = 0; wksp_index < numLists; wksp_index++) {
+    auto &eventList = *this->data[wksp_index];
+    if (eventList.getEventType() == Mantid::API::TOF)
+      eventList.setCompactStorage(true, table);
+  }
+}
+
+/** Make every event list a read-only view of the events of the same spectrum
+ * in a mapped file, and take the spectrum numbers and detector IDs from the
+ * file. See EventList::setMappedEvents().
+ *
+ * @param file :: the mapped file
+ * @throw std::invalid_argument if the file has a different number of spectra
+ */
+void EventWorkspace::setMappedEvents(const std::shared_ptr<const MappedEventFile> &file) {
+  if (file->getNumberHistograms() != this->data.size())
+    throw std::invalid_argument("EventWorkspace::setMappedEvents: " + file->filename() + " has " +
+                                std::to_string(file->getNumberHistograms()) + " spectra, the workspace has " +
+                                std::to_string(this->data.size()));
+  for (size_t wksp_index = 0; wksp_index < this->data.size(); wksp_index++) {
+    auto &eventList = *this->data[wksp_index];
+    eventList.setMappedEvents(file->getEvents(wksp_index));
+    eventList.setSpectrumNo(file->getSpectrumNo(wksp_index));
+    eventList.setDetectorIDs(file->getDetectorIDs(wksp_index));
+  }
+}
+
 /// Returns true always - an EventWorkspace always represents histogramm-able
 /// data
 /// @returns If the data is a histogram - always true for an eventWorkspace
@@ -629,17 +706,18 @@ void EventWorkspace::resetAllXToSingleBin() {
 class EventSortingTask {
 public:
   /// ctor
-  EventSortingTask(const EventWorkspace *WS, EventSortType sortType, Mantid::API::Progress *prog)
-      : m_sortType(sortType), m_WS(WS), prog(prog) {}
+  EventSortingTask(const EventWorkspace *WS, const std::vector<size_t> &order, EventSortType sortType,
+                   Mantid::API::Progress *prog)
+      : m_sortType(sortType), m_WS(WS), m_order(order), prog(prog) {}
 
   // Execute the sort as specified.
   void operator()(const tbb::blocked_range<size_t> &range) const {
-    for (size_t wi = range.begin(); wi < range.end(); ++wi) {
-      m_WS->getSpectrum(wi).sort(m_sortType);
+    for (size_t i = range.begin(); i < range.end(); ++i) {
+      m_WS->getSpectrum(m_order[i]).sort(m_sortType);
     }
     // Report progress
     if (prog)
-      prog->report("Sorting");
+      prog->reportIncrement(range.size(), "Sorting");
   }
 
 private:
@@ -647,6 +725,8 @@ private:
   EventSortType m_sortType;
   /// EventWorkspace on which to sort
   const EventWorkspace *m_WS;
+  /// Workspace indices in the order to sort them
+  const std::vector<size_t> &m_order;
   /// Optional Progress dialog.
   Mantid::API::Progress *prog;
 };
@@ -678,8 +758,14 @@ void EventWorkspace::sortAll(EventSortType sortType, Mantid::API::Progress *prog
     return;
   }
 
-  // Create the thread pool, and optimize by doing the longest sorts first.
-  EventSortingTask task(this, sortType, prog);
+  // Optimize by doing the longest sorts first, so that a few large lists are
+  // not left until the end. A large list is itself sorted by several threads.
+  std::vector<size_t> order(data.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](const size_t lhs, const size_t rhs) {
+    return data[lhs]->getNumberEvents() > data[rhs]->getNumberEvents();
+  });
+  EventSortingTask task(this, order, sortType, prog);
   tbb::parallel_for(tbb::blocked_range<size_t>(0, data.size()), task);
 }
 
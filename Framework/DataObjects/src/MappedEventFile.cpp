@@ -0,0 +1,453 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#include "MantidDataObjects/MappedEventFile.h"
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventWorkspace.h"
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace Mantid {
+namespace DataObjects {
+using API::EventType;
+using Types::Event::TofEvent;
+
+// The events are used in place, so their layout is part of the file format
+static_assert(std::is_trivially_copyable<TofEvent>::value && sizeof(TofEvent) == 16,
+              "The layout of TofEvent is part of the mapped event file format");
+static_assert(std::is_trivially_copyable<WeightedEvent>::value && sizeof(WeightedEvent) == 24,
+              "The layout of WeightedEvent is part of the mapped event file format");
+static_assert(std::is_trivially_copyable<WeightedEventNoTime>::value && sizeof(WeightedEventNoTime) == 16,
+              "The layout of WeightedEventNoTime is part of the mapped event file format");
+
+namespace {
+/// Identifies a mapped event file
+constexpr char MAGIC[8] = {'M', 'T', 'D', 'E', 'V', 'M', 'A', 'P'};
+/// Written as is, to check that the file has the byte order of the machine
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+/// The events of each spectrum start on this boundary
+constexpr uint64_t EVENT_ALIGNMENT = 64;
+
+/// The header at the start of the file
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  uint64_t numSpectra;
+  uint64_t recordsOffset;
+};
+static_assert(sizeof(FileHeader) == 32, "Unexpected padding of the mapped event file header");
+
+/// Size of one event of a type
+size_t eventSize(const EventType eventType) {
+  switch (eventType) {
+  case API::TOF:
+    return sizeof(TofEvent);
+  case API::WEIGHTED:
+    return sizeof(WeightedEvent);
+  case API::WEIGHTED_NOTIME:
+    return sizeof(WeightedEventNoTime);
+  }
+  throw std::runtime_error("MappedEventFile: invalid event type value was found.");
+}
+
+/// Round an offset up to the alignment of the events
+uint64_t alignEvents(const uint64_t offset) {
+  return (offset + EVENT_ALIGNMENT - 1) / EVENT_ALIGNMENT * EVENT_ALIGNMENT;
+}
+
+/// Write zeros up to an offset of the file
+void padTo(std::ofstream &out, const uint64_t offset) {
+  static const char zeros[EVENT_ALIGNMENT] = {};
+  const auto position = static_cast<uint64_t>(out.tellp());
+  out.write(zeros, static_cast<std::streamsize>(offset - position));
+}
+
+/// Write a vector as raw bytes
+template <typename T> void writeVector(std::ofstream &out, const std::vector<T> &values) {
+  out.write(reinterpret_cast<const char *>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+/// Index of the first event of each bin, and of the first event after the
+/// last bin, of events sorted by tof
+template <typename T> std::vector<const T *> binStarts(const T *first, const T *last, const MantidVec &X) {
+  std::vector<const T *> starts(X.size());
+  const T *event = first;
+  for (size_t i = 0; i < X.size(); ++i) {
+    event = std::lower_bound(event, last, X[i], [](const T &lhs, const double tof) { return lhs.tof() < tof; });
+    starts[i] = event;
+  }
+  return starts;
+}
+
+/// The events between minX and maxX, or all of them
+template <typename T>
+std::pair<const T *, const T *> eventsInRange(const T *first, const T *last, const double minX, const double maxX,
+                                              const bool entireRange) {
+  if (entireRange)
+    return {first, last};
+  if (maxX < minX)
+    return {first, first};
+  first = std::lower_bound(first, last, minX, [](const T &lhs, const double tof) { return lhs.tof() < tof; });
+  last = std::upper_bound(first, last, maxX, [](const double tof, const T &rhs) { return tof < rhs.tof(); });
+  return {first, last};
+}
+} // namespace
+
+/// The spectrum records of the file
+struct MappedEventFile::SpectrumRecord {
+  uint64_t eventsOffset;
+  uint64_t numEvents;
+  uint64_t detectorIdsOffset;
+  uint64_t numDetectorIds;
+  int32_t spectrumNo;
+  uint32_t eventType;
+};
+
+/// The mapping of the file, which unmaps it when destroyed
+struct MappedEventFile::Mapping {
+  boost::interprocess::file_mapping file;
+  boost::interprocess::mapped_region region;
+};
+
+//----------------------------------------------------------------------------------------------
+/** Write the events of a workspace to a file that can be mapped. The events
+ * of each spectrum are sorted by tof as they are written; the workspace
+ * itself is not changed.
+ * @param workspace :: the workspace to save
+ * @param filename :: the file to write. An existing file is replaced.
+ * @throw std::runtime_error if the file cannot be written
+ */
+void MappedEventFile::save(const EventWorkspace &workspace, const std::string &filename) {
+  const size_t numSpectra = workspace.getNumberHistograms();
+
+  // Lay out the file
+  std::vector<SpectrumRecord> records(numSpectra);
+  uint64_t offset = sizeof(FileHeader) + numSpectra * sizeof(SpectrumRecord);
+  for (size_t i = 0; i < numSpectra; ++i) {
+    const auto &eventList = workspace.getSpectrum(i);
+    auto &record = records[i];
+    record.spectrumNo = eventList.getSpectrumNo();
+    record.eventType = static_cast<uint32_t>(eventList.getEventType());
+    record.numDetectorIds = eventList.getDetectorIDs().size();
+    record.detectorIdsOffset = offset;
+    offset += record.numDetectorIds * sizeof(detid_t);
+    record.numEvents = eventList.getNumberEvents();
+    record.eventsOffset = alignEvents(offset);
+    offset = record.eventsOffset + record.numEvents * eventSize(eventList.getEventType());
+  }
+
+  std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("MappedEventFile: cannot open " + filename + " for writing");
+  FileHeader header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrderMark = BYTE_ORDER_MARK;
+  header.numSpectra = numSpectra;
+  header.recordsOffset = sizeof(FileHeader);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  writeVector(out, records);
+
+  for (size_t i = 0; i < numSpectra; ++i) {
+    const auto &detectorIDs = workspace.getSpectrum(i).getDetectorIDs();
+    writeVector(out, std::vector<detid_t>(detectorIDs.cbegin(), detectorIDs.cend()));
+    padTo(out, records[i].eventsOffset);
+    // Sort a copy, so that the workspace keeps its order and storage
+    EventList eventList(workspace.getSpectrum(i));
+    eventList.sortTof();
+    switch (eventList.getEventType()) {
+    case API::TOF:
+      writeVector(out, eventList.getEvents());
+      break;
+    case API::WEIGHTED:
+      writeVector(out, eventList.getWeightedEvents());
+      break;
+    case API::WEIGHTED_NOTIME:
+      writeVector(out, eventList.getWeightedEventsNoTime());
+      break;
+    }
+  }
+  if (!out)
+    throw std::runtime_error("MappedEventFile: error writing " + filename);
+}
+
+/** Map a file written by save().
+ * @param filename :: the file to map
+ * @return the mapped file
+ * @throw std::runtime_error if the file cannot be mapped or is not a valid
+ * mapped event file
+ */
+std::shared_ptr<const MappedEventFile> MappedEventFile::open(const std::string &filename) {
+  return std::shared_ptr<const MappedEventFile>(new MappedEventFile(filename));
+}
+
+/** Map the file and check its header and table of spectra
+ * @param filename :: the file to map
+ */
+MappedEventFile::MappedEventFile(const std::string &filename)
+    : m_filename(filename), m_mapping(std::make_unique<Mapping>()), m_data(nullptr), m_size(0), m_numSpectra(0),
+      m_records(nullptr) {
+  static_assert(sizeof(SpectrumRecord) == 40, "Unexpected padding of the mapped event file records");
+  using namespace boost::interprocess;
+  try {
+    m_mapping->file = file_mapping(filename.c_str(), read_only);
+    m_mapping->region = mapped_region(m_mapping->file, read_only);
+  } catch (const interprocess_exception &error) {
+    throw std::runtime_error("MappedEventFile: cannot map " + filename + ": " + error.what());
+  }
+  m_data = static_cast<const char *>(m_mapping->region.get_address());
+  m_size = m_mapping->region.get_size();
+
+  const std::string invalidFile = "MappedEventFile: " + filename + " is not a valid mapped event file";
+  if (m_size < sizeof(FileHeader))
+    throw std::runtime_error(invalidFile);
+  FileHeader header;
+  std::memcpy(&header, m_data, sizeof(header));
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error(invalidFile);
+  if (header.byteOrderMark != BYTE_ORDER_MARK)
+    throw std::runtime_error(invalidFile + " for the byte order of this machine");
+  if (header.version != VERSION)
+    throw std::runtime_error(invalidFile + " of version " + std::to_string(VERSION));
+  if (header.recordsOffset % alignof(SpectrumRecord) != 0 || header.recordsOffset > m_size ||
+      header.numSpectra > (m_size - header.recordsOffset) / sizeof(SpectrumRecord))
+    throw std::runtime_error(invalidFile);
+  m_numSpectra = static_cast<size_t>(header.numSpectra);
+  m_records = reinterpret_cast<const SpectrumRecord *>(m_data + header.recordsOffset);
+
+  // Check the arrays of every spectrum are within the file, so that they can
+  // be used without further checks
+  for (size_t i = 0; i < m_numSpectra; ++i) {
+    const auto &spectrum = m_records[i];
+    if (spectrum.eventType > API::WEIGHTED_NOTIME || spectrum.eventsOffset % EVENT_ALIGNMENT != 0 ||
+        spectrum.detectorIdsOffset % alignof(detid_t) != 0 || spectrum.eventsOffset > m_size ||
+        spectrum.detectorIdsOffset > m_size ||
+        spectrum.numEvents > (m_size - spectrum.eventsOffset) / eventSize(EventType(spectrum.eventType)) ||
+        spectrum.numDetectorIds > (m_size - spectrum.detectorIdsOffset) / sizeof(detid_t))
+      throw std::runtime_error(invalidFile);
+  }
+}
+
+MappedEventFile::~MappedEventFile() = default;
+
+/// Number of spectra in the file
+size_t MappedEventFile::getNumberHistograms() const { return m_numSpectra; }
+
+/** @param index :: index of the spectrum
+ * @return the record of a spectrum
+ * @throw std::out_of_range if the index is too large
+ */
+const MappedEventFile::SpectrumRecord &MappedEventFile::record(const size_t index) const {
+  if (index >= m_numSpectra)
+    throw std::out_of_range("MappedEventFile: spectrum index out of range");
+  return m_records[index];
+}
+
+/** @param index :: index of the spectrum
+ * @return the spectrum number of a spectrum
+ */
+specnum_t MappedEventFile::getSpectrumNo(const size_t index) const { return record(index).spectrumNo; }
+
+/** @param index :: index of the spectrum
+ * @return the detector IDs of a spectrum
+ */
+std::set<detid_t> MappedEventFile::getDetectorIDs(const size_t index) const {
+  const auto &spectrum = record(index);
+  const auto first = reinterpret_cast<const detid_t *>(m_data + spectrum.detectorIdsOffset);
+  return std::set<detid_t>(first, first + spectrum.numDetectorIds);
+}
+
+/** @param index :: index of the spectrum
+ * @return a view of the events of a spectrum, which keeps the file mapped
+ */
+MappedEvents MappedEventFile::getEvents(const size_t index) const {
+  const auto &spectrum = record(index);
+  return MappedEvents(shared_from_this(), EventType(spectrum.eventType), m_data + spectrum.eventsOffset,
+                      static_cast<size_t>(spectrum.numEvents));
+}
+
+//----------------------------------------------------------------------------------------------
+/** Constructor
+ * @param file :: the file holding the events
+ * @param eventType :: the type of the events
+ * @param events :: the first event
+ * @param size :: the number of events
+ */
+MappedEvents::MappedEvents(std::shared_ptr<const MappedEventFile> file, const API::EventType eventType,
+                           const void *events, const size_t size)
+    : m_file(std::move(file)), m_eventType(eventType), m_events(events), m_size(size) {}
+
+/** Memory used by the view. The mapped events are not included: they are
+ * paged in from the file, and shared with any other process mapping it.
+ * @return :: the memory used, in bytes.
+ */
+size_t MappedEvents::getMemorySize() const { return sizeof(MappedEvents); }
+
+/// @return the events, if they are TofEvents
+const TofEvent *MappedEvents::tofEvents() const {
+  if (m_eventType != API::TOF)
+    throw std::runtime_error("MappedEvents: the events are not TofEvents");
+  return static_cast<const TofEvent *>(m_events);
+}
+
+/// @return the events, if they are WeightedEvents
+const WeightedEvent *MappedEvents::weightedEvents() const {
+  if (m_eventType != API::WEIGHTED)
+    throw std::runtime_error("MappedEvents: the events are not WeightedEvents");
+  return static_cast<const WeightedEvent *>(m_events);
+}
+
+/// @return the events, if they are WeightedEventNoTimes
+const WeightedEventNoTime *MappedEvents::weightedEventsNoTime() const {
+  if (m_eventType != API::WEIGHTED_NOTIME)
+    throw std::runtime_error("MappedEvents: the events are not WeightedEventNoTimes");
+  return static_cast<const WeightedEventNoTime *>(m_events);
+}
+
+/** Call a function with the range of events, as pointers to their type
+ * @param function :: called with the first and last pointers of the events
+ * @return what the function returns
+ */
+template <typename Function> auto MappedEvents::visit(const Function &function) const {
+  switch (m_eventType) {
+  case API::WEIGHTED:
+    return function(weightedEvents(), weightedEvents() + m_size);
+  case API::WEIGHTED_NOTIME:
+    return function(weightedEventsNoTime(), weightedEventsNoTime() + m_size);
+  default:
+    return function(tofEvents(), tofEvents() + m_size);
+  }
+}
+
+/// @return the smallest tof, or the largest double if there are no events.
+double MappedEvents::getTofMin() const {
+  if (empty())
+    return std::numeric_limits<double>::max();
+  return visit([](const auto first, const auto) { return first->tof(); });
+}
+
+/// @return the largest tof, or the lowest double if there are no events.
+double MappedEvents::getTofMax() const {
+  if (empty())
+    return std::numeric_limits<double>::lowest();
+  return visit([](const auto, const auto last) { return (last - 1)->tof(); });
+}
+
+/** Fill a vector with the tofs of the events
+ * @param tofs :: the vector to fill
+ */
+void MappedEvents::getTofs(std::vector<double> &tofs) const {
+  tofs.clear();
+  tofs.reserve(m_size);
+  visit([&tofs](const auto first, const auto last) {
+    std::transform(first, last, std::back_inserter(tofs), [](const auto &event) { return event.tof(); });
+  });
+}
+
+/** Fill a vector with the weights of the events. Unweighted events have a
+ * weight of 1.
+ * @param weights :: the vector to fill
+ */
+void MappedEvents::getWeights(std::vector<double> &weights) const {
+  weights.clear();
+  weights.reserve(m_size);
+  visit([&weights](const auto first, const auto last) {
+    std::transform(first, last, std::back_inserter(weights), [](const auto &event) { return event.weight(); });
+  });
+}
+
+/** Fill a vector with the errors of the events. Unweighted events have an
+ * error of 1.
+ * @param weightErrors :: the vector to fill
+ */
+void MappedEvents::getWeightErrors(std::vector<double> &weightErrors) const {
+  weightErrors.clear();
+  weightErrors.reserve(m_size);
+  visit([&weightErrors](const auto first, const auto last) {
+    std::transform(first, last, std::back_inserter(weightErrors), [](const auto &event) { return event.error(); });
+  });
+}
+
+/** Fill a counts histogram, ignoring any weights
+ * @param X :: the bin edges
+ * @param Y :: the generated counts, resized to X.size()-1 and overwritten
+ */
+void MappedEvents::generateCountsHistogram(const MantidVec &X, MantidVec &Y) const {
+  if (X.size() <= 1) {
+    Y.resize(0, 0);
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  visit([&X, &Y](const auto first, const auto last) {
+    const auto starts = binStarts(first, last, X);
+    for (size_t bin = 0; bin + 1 < starts.size(); ++bin)
+      Y[bin] = static_cast<double>(std::distance(starts[bin], starts[bin + 1]));
+  });
+}
+
+/** Fill a histogram of the weights of the events and their errors
+ * @param X :: the bin edges
+ * @param Y :: the summed weights, resized to X.size()-1 and overwritten
+ * @param E :: the errors, resized to X.size()-1 and overwritten
+ */
+void MappedEvents::generateWeightedHistogram(const MantidVec &X, MantidVec &Y, MantidVec &E) const {
+  if (X.size() <= 1) {
+    Y.resize(0, 0);
+    E.resize(0, 0);
+    return;
+  }
+  Y.assign(X.size() - 1, 0.0);
+  E.assign(X.size() - 1, 0.0);
+  visit([&X, &Y, &E](const auto first, const auto last) {
+    const auto starts = binStarts(first, last, X);
+    for (size_t bin = 0; bin + 1 < starts.size(); ++bin) {
+      double weight = 0.;
+      double errorSquared = 0.;
+      for (auto event = starts[bin]; event != starts[bin + 1]; ++event) {
+        weight += event->weight();
+        errorSquared += event->errorSquared();
+      }
+      Y[bin] = weight;
+      E[bin] = std::sqrt(errorSquared);
+    }
+  });
+}
+
+/** Integrate the events between a range of X values, or all events.
+ * @param minX :: minimum X bin to use in integrating.
+ * @param maxX :: maximum X bin to use in integrating.
+ * @param entireRange :: set to true to use the entire range.
+ * @param sum :: the summed weights
+ * @param error :: the error of the sum
+ */
+void MappedEvents::integrate(const double minX, const double maxX, const bool entireRange, double &sum,
+                             double &error) const {
+  sum = 0;
+  error = 0;
+  visit([&](const auto first, const auto last) {
+    const auto range = eventsInRange(first, last, minX, maxX, entireRange);
+    for (auto event = range.first; event != range.second; ++event) {
+      sum += event->weight();
+      error += event->errorSquared();
+    }
+  });
+  error = std::sqrt(error);
+}
+
+} // namespace DataObjects
+} // namespace Mantid
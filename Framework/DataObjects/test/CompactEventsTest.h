@@ -0,0 +1,137 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/CompactEvents.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::MantidVec;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class CompactEventsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static CompactEventsTest *createSuite() { return new CompactEventsTest(); }
+  static void destroySuite(CompactEventsTest *suite) { delete suite; }
+
+  void test_pack_and_unpack() {
+    const std::vector<TofEvent> events{TofEvent(100, 400), TofEvent(3.5, 200), TofEvent(50, 400)};
+    const auto pulseTimes = CompactEvents::makePulseTimeTable(events);
+    TS_ASSERT_EQUALS(*pulseTimes, CompactEvents::PulseTimeTable({DateAndTime(200), DateAndTime(400)}));
+
+    CompactEvents compact(events, pulseTimes);
+    TS_ASSERT_EQUALS(compact.size(), 3);
+    TS_ASSERT_EQUALS(compact.tofs(), std::vector<float>({100.f, 3.5f, 50.f}));
+
+    std::vector<TofEvent> unpacked;
+    compact.unpack(unpacked);
+    TS_ASSERT_EQUALS(unpacked, events);
+  }
+
+  void test_tofs_are_rounded_to_float() {
+    const std::vector<TofEvent> events{TofEvent(0.1, 1)};
+    CompactEvents compact(events, CompactEvents::makePulseTimeTable(events));
+    std::vector<TofEvent> unpacked;
+    compact.unpack(unpacked);
+    TS_ASSERT_EQUALS(unpacked[0].tof(), static_cast<double>(0.1f));
+    TS_ASSERT_EQUALS(unpacked[0].pulseTime(), DateAndTime(1));
+  }
+
+  void test_pulse_time_missing_from_table_throws() {
+    const std::vector<TofEvent> events{TofEvent(1, 100), TofEvent(2, 300)};
+    const auto pulseTimes = std::make_shared<const CompactEvents::PulseTimeTable>(
+        CompactEvents::PulseTimeTable({DateAndTime(100), DateAndTime(200)}));
+    TS_ASSERT_THROWS(CompactEvents(events, pulseTimes), const std::invalid_argument &);
+    TS_ASSERT_THROWS(CompactEvents(events, nullptr), const std::invalid_argument &);
+  }
+
+  void test_memory_is_half_of_TofEvent() {
+    const auto events = makeEvents();
+    CompactEvents compact(events, CompactEvents::makePulseTimeTable(events));
+    TS_ASSERT_LESS_THAN_EQUALS(compact.getMemorySize(), events.size() * sizeof(TofEvent) / 2 + sizeof(CompactEvents));
+  }
+
+  void test_sortTof_keeps_pulse_times_with_tofs() {
+    const std::vector<TofEvent> events{TofEvent(30, 3), TofEvent(10, 1), TofEvent(20, 2)};
+    CompactEvents compact(events, CompactEvents::makePulseTimeTable(events));
+    compact.sortTof();
+    std::vector<TofEvent> unpacked;
+    compact.unpack(unpacked);
+    TS_ASSERT_EQUALS(unpacked, std::vector<TofEvent>({TofEvent(10, 1), TofEvent(20, 2), TofEvent(30, 3)}));
+    TS_ASSERT_EQUALS(compact.getTofMin(true), 10.);
+    TS_ASSERT_EQUALS(compact.getTofMax(true), 30.);
+  }
+
+  void test_EventList_is_transparent() {
+    EventList el;
+    for (const auto &event : makeEvents())
+      el += event;
+    const auto expected = el.getEvents();
+
+    el.setCompactStorage(true);
+    TS_ASSERT(el.hasCompactStorage());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), expected.size());
+    TS_ASSERT_EQUALS(el.getEvents(), expected);
+    TS_ASSERT(!el.hasCompactStorage());
+  }
+
+  void test_EventList_histograms_match() {
+    MantidVec X;
+    for (double x = 100.; x <= 20000.; x += 25.)
+      X.emplace_back(x);
+    const MantidVec logX{100., 200., 400., 800., 1600., 3200., 6400., 12800.};
+    const MantidVec irregularX{0., 10., 5000., 5001., 20000.};
+
+    for (const auto &bins : {X, logX, irregularX}) {
+      EventList events;
+      for (const auto &event : makeEvents())
+        events += event;
+      MantidVec expectedY, expectedE;
+      events.generateHistogram(bins, expectedY, expectedE);
+
+      EventList compact(events);
+      compact.setCompactStorage(true);
+      MantidVec Y, E;
+      compact.generateHistogram(bins, Y, E);
+      TS_ASSERT(compact.hasCompactStorage());
+      TS_ASSERT_EQUALS(Y, expectedY);
+      TS_ASSERT_EQUALS(E, expectedE);
+
+      compact.sortTof();
+      compact.generateHistogram(bins, Y, E);
+      TS_ASSERT(compact.hasCompactStorage());
+      TS_ASSERT_EQUALS(Y, expectedY);
+      TS_ASSERT_EQUALS(E, expectedE);
+    }
+  }
+
+  void test_EventList_with_weights_throws() {
+    EventList el;
+    el += TofEvent(1.0, 2);
+    el.multiply(2.0);
+    TS_ASSERT_THROWS(el.setCompactStorage(true), const std::runtime_error &);
+    TS_ASSERT(!el.hasCompactStorage());
+  }
+
+private:
+  /// Unsorted events with float tofs, a few to each pulse
+  std::vector<TofEvent> makeEvents() {
+    std::vector<TofEvent> events;
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<float> tof(0.f, 21000.f);
+    for (int i = 0; i < 10000; ++i)
+      events.emplace_back(tof(generator), DateAndTime(i / 7));
+    return events;
+  }
+};
@@ -161,6 +161,29 @@ public:
     compare(3, out, expected);
   }
 
+  void test_applyToPoints_matches_apply() {
+    CoordTransformAffine ct(4, 2);
+    Matrix<coord_t> mat(3, 5);
+    for (size_t row = 0; row < 2; ++row)
+      for (size_t col = 0; col < 5; ++col)
+        mat[row][col] = 0.37f * static_cast<coord_t>(row + 1) - 0.11f * static_cast<coord_t>(col);
+    mat[2][4] = 1;
+    ct.setMatrix(mat);
+
+    // points 6 coordinates apart, like the centers of a list of events
+    std::vector<coord_t> input(6 * 7);
+    for (size_t i = 0; i < input.size(); ++i)
+      input[i] = 0.5f * static_cast<coord_t>(i) - 3.f;
+    std::vector<coord_t> output(2 * 7);
+    ct.applyToPoints(input.data() + 2, 6 * sizeof(coord_t), 7, output.data());
+    for (size_t i = 0; i < 7; ++i) {
+      coord_t expected[2];
+      ct.apply(input.data() + 2 + 6 * i, expected);
+      TS_ASSERT_EQUALS(output[2 * i], expected[0]);
+      TS_ASSERT_EQUALS(output[2 * i + 1], expected[1]);
+    }
+  }
+
   //-----------------------------------------------------------------------------------------------
   /** Test a case of a rotation 0.1 radians around +Z,
    * and a projection into the XY plane */
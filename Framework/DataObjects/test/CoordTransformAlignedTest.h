@@ -69,6 +69,26 @@ public:
     TS_ASSERT_DELTA(output[2], 3.0, 1e-6);
   }
 
+  void test_applyToPoints_matches_apply() {
+    size_t dimToBinFrom[3] = {3, 1, 0};
+    coord_t origin[3] = {5, 10, 15};
+    coord_t scaling[3] = {1, 2, 3};
+    CoordTransformAligned ct(4, 3, dimToBinFrom, origin, scaling);
+
+    // points 5 coordinates apart, like the centers of a list of events
+    std::vector<coord_t> input(5 * 4);
+    for (size_t i = 0; i < input.size(); ++i)
+      input[i] = 1.5f * static_cast<coord_t>(i);
+    std::vector<coord_t> output(3 * 4);
+    ct.applyToPoints(input.data(), 5 * sizeof(coord_t), 4, output.data());
+    for (size_t i = 0; i < 4; ++i) {
+      coord_t expected[3];
+      ct.apply(input.data() + 5 * i, expected);
+      for (size_t d = 0; d < 3; ++d)
+        TS_ASSERT_EQUALS(output[3 * i + d], expected[d]);
+    }
+  }
+
   /// Clone the transform, check that it still works
   void test_clone() {
     size_t dimToBinFrom[3] = {3, 1, 0};
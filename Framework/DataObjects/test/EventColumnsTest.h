@@ -0,0 +1,149 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventColumns.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <limits>
+
+using namespace Mantid::DataObjects;
+using Mantid::MantidVec;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventColumnsTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventColumnsTest *createSuite() { return new EventColumnsTest(); }
+  static void destroySuite(EventColumnsTest *suite) { delete suite; }
+
+  void test_pack_and_unpack_TofEvent() {
+    const std::vector<TofEvent> events{TofEvent(100, 200), TofEvent(3.5, 400), TofEvent(50, 60)};
+    EventColumns columns(events);
+    TS_ASSERT_EQUALS(columns.getEventType(), Mantid::API::TOF);
+    TS_ASSERT_EQUALS(columns.size(), 3);
+    TS_ASSERT(columns.weights().empty());
+    TS_ASSERT_EQUALS(columns.pulseTimes()[1], 400);
+
+    std::vector<TofEvent> unpacked;
+    columns.unpack(unpacked);
+    TS_ASSERT_EQUALS(unpacked, events);
+  }
+
+  void test_pack_and_unpack_WeightedEvent() {
+    const std::vector<WeightedEvent> events{WeightedEvent(100, DateAndTime(200), 2.0, 3.0),
+                                            WeightedEvent(3.5, DateAndTime(400), 1.5, 0.5)};
+    EventColumns columns(events);
+    TS_ASSERT_EQUALS(columns.getEventType(), Mantid::API::WEIGHTED);
+    TS_ASSERT_EQUALS(columns.weights()[0], 2.0f);
+    TS_ASSERT_EQUALS(columns.errorSquareds()[1], 0.5f);
+
+    std::vector<WeightedEvent> unpacked;
+    columns.unpack(unpacked);
+    TS_ASSERT_EQUALS(unpacked, events);
+  }
+
+  void test_pack_and_unpack_WeightedEventNoTime() {
+    const std::vector<WeightedEventNoTime> events{WeightedEventNoTime(100, 2.0, 3.0),
+                                                  WeightedEventNoTime(3.5, 1.5, 0.5)};
+    EventColumns columns(events);
+    TS_ASSERT_EQUALS(columns.getEventType(), Mantid::API::WEIGHTED_NOTIME);
+    TS_ASSERT(columns.pulseTimes().empty());
+
+    std::vector<WeightedEventNoTime> unpacked;
+    columns.unpack(unpacked);
+    TS_ASSERT_EQUALS(unpacked, events);
+  }
+
+  void test_sortTof_keeps_columns_together() {
+    EventColumns columns(std::vector<WeightedEvent>{WeightedEvent(30, DateAndTime(3), 3.0, 9.0),
+                                                    WeightedEvent(10, DateAndTime(1), 1.0, 1.0),
+                                                    WeightedEvent(20, DateAndTime(2), 2.0, 4.0)});
+    columns.sortTof();
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({10., 20., 30.}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({1, 2, 3}));
+    TS_ASSERT_EQUALS(columns.weights(), std::vector<float>({1.f, 2.f, 3.f}));
+    TS_ASSERT_EQUALS(columns.errorSquareds(), std::vector<float>({1.f, 4.f, 9.f}));
+  }
+
+  void test_convertTof() {
+    EventColumns columns(std::vector<TofEvent>{TofEvent(1.0), TofEvent(2.0)});
+    columns.convertTof(2.5, 1.0);
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({3.5, 6.0}));
+    columns.convertTof([](double tof) { return tof * tof; });
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({12.25, 36.0}));
+  }
+
+  void test_maskTof_removes_inclusive_range() {
+    EventColumns columns(makeUniformEvents());
+    TS_ASSERT_EQUALS(columns.maskTof(2.0, 4.0), 3);
+    TS_ASSERT_EQUALS(columns.tofs(), std::vector<double>({0., 1., 5., 6., 7., 8., 9.}));
+    TS_ASSERT_EQUALS(columns.pulseTimes(), std::vector<int64_t>({0, 1, 5, 6, 7, 8, 9}));
+    TS_ASSERT_EQUALS(columns.maskTof(20.0, 30.0), 0);
+  }
+
+  void test_getTofMin_getTofMax() {
+    EventColumns columns(std::vector<TofEvent>{TofEvent(5.0), TofEvent(-1.0), TofEvent(3.0)});
+    TS_ASSERT_EQUALS(columns.getTofMin(false), -1.0);
+    TS_ASSERT_EQUALS(columns.getTofMax(false), 5.0);
+    EventColumns empty;
+    TS_ASSERT_EQUALS(empty.getTofMin(false), std::numeric_limits<double>::max());
+    TS_ASSERT_EQUALS(empty.getTofMax(false), std::numeric_limits<double>::lowest());
+  }
+
+  void test_generateCountsHistogram() {
+    EventColumns columns(makeUniformEvents());
+    const MantidVec X{-1.0, 0.5, 2.0, 2.5, 8.0};
+    MantidVec Y(7, 42.0);
+    columns.generateCountsHistogram(X, Y);
+    TS_ASSERT_EQUALS(Y, MantidVec({1., 1., 1., 5.}));
+  }
+
+  void test_generateCountsHistogram_without_X() {
+    EventColumns columns(makeUniformEvents());
+    MantidVec Y(3, 1.0);
+    columns.generateCountsHistogram(MantidVec{1.0}, Y);
+    TS_ASSERT(Y.empty());
+  }
+
+  void test_generateWeightedHistogram() {
+    EventColumns columns(std::vector<WeightedEventNoTime>{WeightedEventNoTime(0.5, 2.0, 4.0),
+                                                          WeightedEventNoTime(1.5, 1.0, 1.0),
+                                                          WeightedEventNoTime(1.7, 3.0, 8.0)});
+    const MantidVec X{0.0, 1.0, 2.0};
+    MantidVec Y, E;
+    columns.generateWeightedHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y, MantidVec({2.0, 4.0}));
+    TS_ASSERT_DELTA(E[0], 2.0, 1e-12);
+    TS_ASSERT_DELTA(E[1], 3.0, 1e-12);
+  }
+
+  void test_integrate() {
+    EventColumns columns(makeUniformEvents());
+    double sum(0), error(0);
+    columns.integrate(2.0, 4.0, false, sum, error);
+    TS_ASSERT_EQUALS(sum, 3.0);
+    TS_ASSERT_DELTA(error, std::sqrt(3.0), 1e-12);
+    columns.integrate(4.0, 2.0, false, sum, error);
+    TS_ASSERT_EQUALS(sum, 0.0);
+    columns.integrate(4.0, 2.0, true, sum, error);
+    TS_ASSERT_EQUALS(sum, 10.0);
+  }
+
+private:
+  /// Ten events with tof 0, 1, ..., 9 and the same pulse time
+  std::vector<TofEvent> makeUniformEvents() {
+    std::vector<TofEvent> events;
+    for (int i = 0; i < 10; ++i)
+      events.emplace_back(static_cast<double>(i), DateAndTime(i));
+    return events;
+  }
+};
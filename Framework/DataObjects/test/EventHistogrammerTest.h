@@ -0,0 +1,186 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventHistogrammer.h"
+#include "MantidDataObjects/EventList.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::MantidVec;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventHistogrammerTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventHistogrammerTest *createSuite() { return new EventHistogrammerTest(); }
+  static void destroySuite(EventHistogrammerTest *suite) { delete suite; }
+
+  void test_recognises_linear_bins() {
+    const MantidVec X{0., 10., 20., 30., 40.};
+    TS_ASSERT_EQUALS(EventHistogrammer(X).binning(), EventHistogrammer::Binning::Linear);
+  }
+
+  void test_recognises_linear_bins_with_short_last_bin() {
+    const MantidVec X{0., 10., 20., 30., 35.};
+    TS_ASSERT_EQUALS(EventHistogrammer(X).binning(), EventHistogrammer::Binning::Linear);
+  }
+
+  void test_recognises_logarithmic_bins() {
+    const MantidVec X{1., 2., 4., 8., 16., 32.};
+    TS_ASSERT_EQUALS(EventHistogrammer(X).binning(), EventHistogrammer::Binning::Logarithmic);
+  }
+
+  void test_irregular_bins() {
+    TS_ASSERT(!EventHistogrammer(MantidVec{0., 1., 5., 6., 20.}).isRegular());
+    TS_ASSERT(!EventHistogrammer(MantidVec{0., 1., 1., 2.}).isRegular());
+    TS_ASSERT(!EventHistogrammer(MantidVec{1.}).isRegular());
+    TS_ASSERT(!EventHistogrammer(MantidVec{}).isRegular());
+    TS_ASSERT(!EventHistogrammer(MantidVec{0., std::numeric_limits<double>::infinity()}).isRegular());
+  }
+
+  void test_histogram_throws_for_irregular_bins() {
+    const MantidVec X{0., 1., 5., 6., 20.};
+    MantidVec Y;
+    TS_ASSERT_THROWS(EventHistogrammer(X).histogram(std::vector<double>{1.}, Y), const std::runtime_error &);
+  }
+
+  void test_events_on_edges_follow_lower_edge() {
+    const MantidVec X{0., 0.1, 0.2, 0.3};
+    const std::vector<double> tofs{0.3, 0.2, 0.1, 0.0, -0.1, 0.29999999, std::nan("")};
+    MantidVec Y;
+    EventHistogrammer(X).histogram(tofs, Y);
+    TS_ASSERT_EQUALS(Y, MantidVec({1., 1., 2.}));
+  }
+
+  void test_counts_match_sorted_histogram() {
+    for (const auto &X : {linearBins(), logarithmicBins()}) {
+      EventList unsorted = makeEventList();
+      MantidVec Y, E;
+      unsorted.generateHistogram(X, Y, E);
+      TS_ASSERT_EQUALS(unsorted.getSortType(), UNSORTED);
+
+      EventList sorted = makeEventList();
+      sorted.sortTof();
+      MantidVec expectedY, expectedE;
+      sorted.generateHistogram(X, expectedY, expectedE);
+      TS_ASSERT_EQUALS(Y, expectedY);
+      TS_ASSERT_EQUALS(E, expectedE);
+    }
+  }
+
+  void test_weights_match_sorted_histogram() {
+    for (const auto &X : {linearBins(), logarithmicBins()}) {
+      EventList unsorted = makeEventList();
+      unsorted.multiply(2.0, 0.5);
+      MantidVec Y, E;
+      unsorted.generateHistogram(X, Y, E);
+
+      EventList sorted = makeEventList();
+      sorted.multiply(2.0, 0.5);
+      sorted.sortTof();
+      MantidVec expectedY, expectedE;
+      sorted.generateHistogram(X, expectedY, expectedE);
+      TS_ASSERT_EQUALS(Y.size(), expectedY.size());
+      for (size_t i = 0; i < Y.size(); ++i) {
+        TS_ASSERT_DELTA(Y[i], expectedY[i], 1e-6);
+        TS_ASSERT_DELTA(E[i], expectedE[i], 1e-6);
+      }
+    }
+  }
+
+  void test_column_storage_matches_event_storage() {
+    const MantidVec X = linearBins();
+    EventList events = makeEventList();
+    MantidVec expectedY, expectedE;
+    events.generateHistogram(X, expectedY, expectedE);
+
+    EventList columns = makeEventList();
+    columns.setColumnStorage(true);
+    MantidVec Y, E;
+    columns.generateHistogram(X, Y, E);
+    TS_ASSERT_EQUALS(Y, expectedY);
+    TS_ASSERT_EQUALS(E, expectedE);
+  }
+
+  void test_accumulate_adds_to_histograms_for_regular_and_irregular_bins() {
+    MantidVec irregular{100., 150., 1000., 1001., 19990.};
+    for (const auto &X : {linearBins(), logarithmicBins(), irregular}) {
+      const EventHistogrammer histogrammer(X);
+      const std::vector<double> tofs = makeEventList().getTofs();
+      EventList sorted = makeEventList();
+      sorted.sortTof();
+      MantidVec expectedY, expectedE;
+      sorted.generateHistogram(X, expectedY, expectedE);
+
+      // unit weights, added twice
+      MantidVec Y(X.size() - 1, 0.), E2(X.size() - 1, 0.);
+      histogrammer.accumulate(tofs, {}, {}, Y, E2);
+      histogrammer.accumulate(tofs, {}, {}, Y, E2);
+      for (size_t i = 0; i < Y.size(); ++i) {
+        TS_ASSERT_EQUALS(Y[i], 2. * expectedY[i]);
+        TS_ASSERT_EQUALS(E2[i], 2. * expectedY[i]);
+      }
+
+      const std::vector<double> weights(tofs.size(), 2.0), errorSquareds(tofs.size(), 0.5);
+      std::fill(Y.begin(), Y.end(), 0.);
+      std::fill(E2.begin(), E2.end(), 0.);
+      histogrammer.accumulate(tofs, weights, errorSquareds, Y, E2);
+      for (size_t i = 0; i < Y.size(); ++i) {
+        TS_ASSERT_EQUALS(Y[i], 2. * expectedY[i]);
+        TS_ASSERT_EQUALS(E2[i], 0.5 * expectedY[i]);
+      }
+    }
+  }
+
+  void test_accumulate_throws_for_wrongly_sized_histograms() {
+    const MantidVec X = linearBins();
+    const EventHistogrammer histogrammer(X);
+    MantidVec Y(X.size()), E2(X.size());
+    TS_ASSERT_THROWS(histogrammer.accumulate({1000.}, {}, {}, Y, E2), const std::invalid_argument &);
+  }
+
+private:
+  /// Rebin-like linear bins with a shorter last bin
+  MantidVec linearBins() {
+    MantidVec X;
+    for (double x = 100.; x < 19990.; x += 25.)
+      X.emplace_back(x);
+    X.emplace_back(19990.);
+    return X;
+  }
+
+  /// Rebin-like logarithmic bins with a 1% step
+  MantidVec logarithmicBins() {
+    MantidVec X;
+    for (double x = 100.; x < 20000.; x *= 1.01)
+      X.emplace_back(x);
+    X.emplace_back(20000.);
+    return X;
+  }
+
+  /// Unsorted events spread over, and slightly beyond, the bins
+  EventList makeEventList() {
+    EventList el;
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> tof(0., 21000.);
+    for (int i = 0; i < 10000; ++i)
+      el += TofEvent(tof(generator), DateAndTime(i));
+    // Events exactly on some of the edges
+    el += TofEvent(100.);
+    el += TofEvent(125.);
+    el += TofEvent(19990.);
+    return el;
+  }
+};
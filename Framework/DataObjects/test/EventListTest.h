@@ -8,8 +8,10 @@
 
 #include "MantidAPI/FrameworkManager.h"
 #include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventSplitter.h"
 #include "MantidDataObjects/EventWorkspace.h"
 #include "MantidDataObjects/Histogram1D.h"
+#include "MantidHistogramData/LinearGenerator.h"
 #include "MantidKernel/CPUTimer.h"
 #include "MantidKernel/Timer.h"
 #include "MantidKernel/Unit.h"
@@ -1882,6 +1884,67 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  /** Split events into many slices with an EventSplitter, by full time with
+   * a TOF correction and by pulse time. The full times are not sorted, as the
+   * TOFs are longer than the time between pulses.
+   */
+  void test_split_with_EventSplitter_into_many_slices() {
+    constexpr int64_t period = 16666667; // 60 Hz
+    const auto splitter = makeSlices(2000, period, 7);
+    const EventSplitter eventSplitter(splitter);
+    TS_ASSERT_EQUALS(eventSplitter.numberOfOutputs(), 8);
+
+    for (int this_type = 0; this_type < 2; this_type++) {
+      el = EventList();
+      srand(1234); // Fixed random seed
+      for (int i = 0; i < 20000; ++i)
+        el += TofEvent(rand() % 40000, DateAndTime(static_cast<int64_t>(i / 10 + 5) * period));
+      el.switchTo(static_cast<EventType>(this_type));
+
+      for (const bool byPulseTime : {false, true}) {
+        std::vector<EventList> outputs(eventSplitter.numberOfOutputs());
+        std::vector<EventList *> outputPtrs;
+        for (auto &output : outputs)
+          outputPtrs.emplace_back(&output);
+        if (byPulseTime)
+          el.splitByPulseTime(eventSplitter, outputPtrs);
+        else
+          el.splitByFullTime(eventSplitter, outputPtrs, true, 0.9, 1.e-4);
+
+        // Search the slice of each event
+        std::vector<size_t> expected(eventSplitter.numberOfOutputs(), 0);
+        for (size_t i = 0; i < el.getNumberEvents(); ++i) {
+          const auto event = el.getEvent(i);
+          int64_t time = event.pulseTime().totalNanoseconds();
+          if (!byPulseTime)
+            time += static_cast<int64_t>(0.9 * (event.tof() * 1.0E3) + 1.e-4 * 1.0E9);
+          const int target = findSlice(splitter, time);
+          if (target != NO_SLICE)
+            ++expected[eventSplitter.outputIndex(target)];
+        }
+        TS_ASSERT_LESS_THAN(expected[eventSplitter.outputIndex(-1)], el.getNumberEvents());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+          TS_ASSERT_EQUALS(outputs[i].getNumberEvents(), expected[i]);
+          TS_ASSERT_EQUALS(outputs[i].getEventType(), el.getEventType());
+          TS_ASSERT_EQUALS(outputs[i].getSortType(), PULSETIMETOF_SORT);
+        }
+      }
+    }
+  }
+
+  void test_split_with_EventSplitter_drops_events_without_output() {
+    fake_uniform_time_sns_data();
+    TimeSplitterType split{SplittingInterval(100000000, 200000000, 1), SplittingInterval(300000000, 400000000, 2)};
+    const EventSplitter eventSplitter(split);
+    EventList unfiltered, second;
+    el.splitByPulseTime(eventSplitter, {&unfiltered, nullptr, &second});
+    // The events after the last splitter are dropped too
+    TS_ASSERT_EQUALS(unfiltered.getNumberEvents(), 200);
+    TS_ASSERT_EQUALS(second.getNumberEvents(), 100);
+    TS_ASSERT_THROWS(el.splitByPulseTime(eventSplitter, {&unfiltered, &second}), const std::invalid_argument &);
+  }
+
   //-----------------------------------------------------------------------------------------------
   void test_splitByTime_allTypes() {
     // Go through each possible EventType as the input
@@ -2424,6 +2487,83 @@ public:
     return;
   }
 
+  //-----------------------------------------------------------------------------------------------
+  void test_columnStorage_matches_event_storage_allTypes() {
+    DummyUnit1 fromUnit;
+    DummyUnit2 toUnit;
+    fromUnit.initialize(1, 2, {});
+    toUnit.initialize(1, 2, {});
+    for (int this_type = 0; this_type < 3; this_type++) {
+      this->fake_uniform_data();
+      el.switchTo(static_cast<EventType>(this_type));
+      el.setHistogram(BinEdges(NUMBINS + 1, LinearGenerator(0.0, BIN_DELTA)));
+
+      EventList columns(el);
+      columns.setColumnStorage(true);
+      TS_ASSERT(columns.hasColumnStorage());
+      TS_ASSERT(!el.hasColumnStorage());
+      TS_ASSERT_EQUALS(columns.getNumberEvents(), el.getNumberEvents());
+      TS_ASSERT_EQUALS(columns.getTofMin(), el.getTofMin());
+      TS_ASSERT_EQUALS(columns.getTofMax(), el.getTofMax());
+
+      // tof-only operations stay in column storage
+      columns.convertTof(2.5, 1.);
+      el.convertTof(2.5, 1.);
+      columns.convertUnitsViaTof(&fromUnit, &toUnit);
+      el.convertUnitsViaTof(&fromUnit, &toUnit);
+      columns.maskTof(MAX_TOF * 0.25, MAX_TOF * 0.5);
+      el.maskTof(MAX_TOF * 0.25, MAX_TOF * 0.5);
+      TSM_ASSERT_EQUALS(this_type, columns.histogram().y().rawData(), el.histogram().y().rawData());
+      TSM_ASSERT_EQUALS(this_type, columns.histogram().e().rawData(), el.histogram().e().rawData());
+      TS_ASSERT_EQUALS(columns.integrate(0, MAX_TOF, false), el.integrate(0, MAX_TOF, false));
+      TS_ASSERT_EQUALS(columns.getTofs(), el.getTofs());
+      TS_ASSERT_EQUALS(columns.getWeights(), el.getWeights());
+      TS_ASSERT(columns.hasColumnStorage());
+
+      // anything else transparently goes back to event storage
+      TS_ASSERT_EQUALS(columns.getPulseTimes(), el.getPulseTimes());
+      TS_ASSERT(!columns.hasColumnStorage());
+      TS_ASSERT_EQUALS(columns, el);
+    }
+  }
+
+  void test_columnStorage_adding_events_switches_back() {
+    this->fake_uniform_data();
+    const size_t numEvents = el.getNumberEvents();
+    el.setColumnStorage(true);
+    el.addEventQuickly(TofEvent(123.0, 456));
+    TS_ASSERT(!el.hasColumnStorage());
+    TS_ASSERT_EQUALS(el.getNumberEvents(), numEvents + 1);
+    TS_ASSERT_EQUALS(el.getEvents().back(), TofEvent(123.0, 456));
+  }
+
+  void test_columnStorage_clear() {
+    this->fake_uniform_data();
+    el.setColumnStorage(true);
+    TS_ASSERT(!el.empty());
+    el.clear();
+    TS_ASSERT(!el.hasColumnStorage());
+    TS_ASSERT(el.empty());
+  }
+
+  void test_columnStorage_unpacked_from_several_threads() {
+    this->fake_uniform_data();
+    const auto expected = el.getPulseTimes();
+    for (int trial = 0; trial < 20; ++trial) {
+      EventList columns(el);
+      columns.setColumnStorage(true);
+      // The first thread to read the pulse times unpacks the list for all
+      std::vector<size_t> sizes(16);
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < static_cast<int>(sizes.size()); ++i)
+        sizes[i] = columns.getPulseTimes().size();
+      for (const auto size : sizes)
+        TS_ASSERT_EQUALS(size, expected.size());
+      TS_ASSERT(!columns.hasColumnStorage());
+      TS_ASSERT_EQUALS(columns, el);
+    }
+  }
+
   //==================================================================================
   // Mocking functions
   //==================================================================================
@@ -2594,6 +2734,34 @@ public:
     }
   }
 
+  /// Target of the times after the last slice
+  static constexpr int NO_SLICE = -2;
+
+  /** Make slices of 80% of a period, one every period, cycling through a number
+   * of targets
+   */
+  TimeSplitterType makeSlices(const int numSlices, const int64_t period, const int numTargets) {
+    TimeSplitterType splitter;
+    for (int i = 0; i < numSlices; ++i) {
+      const int64_t start = (i + 100) * period;
+      splitter.emplace_back(DateAndTime(start), DateAndTime(start + period * 4 / 5), i % numTargets);
+    }
+    return splitter;
+  }
+
+  /// Target of a time for sorted slices, by searching them
+  int findSlice(const TimeSplitterType &splitter, const int64_t time) {
+    const auto after = std::find_if(splitter.cbegin(), splitter.cend(), [time](const auto &slice) {
+      return slice.start().totalNanoseconds() > time;
+    });
+    if (after == splitter.cbegin())
+      return -1;
+    const auto &slice = *std::prev(after);
+    if (time < slice.stop().totalNanoseconds())
+      return slice.index();
+    return after == splitter.cend() ? NO_SLICE : -1;
+  }
+
   void fake_data_only_two_times(DateAndTime time1, DateAndTime time2) {
     // Clear the list
     el = EventList();
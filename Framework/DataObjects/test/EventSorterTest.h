@@ -0,0 +1,115 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventSorter.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+using namespace Mantid::DataObjects;
+using Mantid::Types::Core::DateAndTime;
+using Mantid::Types::Event::TofEvent;
+
+class EventSorterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventSorterTest *createSuite() { return new EventSorterTest(); }
+  static void destroySuite(EventSorterTest *suite) { delete suite; }
+
+  void test_sortTof_small_and_large() {
+    for (const size_t numEvents : {0, 1, 100, 5000, 300000}) {
+      auto events = makeEvents<TofEvent>(numEvents);
+      auto expected = events;
+      std::stable_sort(expected.begin(), expected.end());
+      EventSorter::sortTof(events);
+      TS_ASSERT(std::is_sorted(events.cbegin(), events.cend()));
+      if (numEvents >= 5000) {
+        // The radix sort is stable
+        TS_ASSERT_EQUALS(events, expected);
+      }
+    }
+  }
+
+  void test_sortTof_negative_tofs() {
+    std::vector<TofEvent> events;
+    for (int i = 0; i < 3000; ++i)
+      events.emplace_back(static_cast<double>((i * 7919) % 3000) - 1500.25, DateAndTime(i));
+    EventSorter::sortTof(events);
+    TS_ASSERT(std::is_sorted(events.cbegin(), events.cend()));
+    TS_ASSERT_EQUALS(events.front().tof(), -1500.25);
+    TS_ASSERT_EQUALS(events.back().tof(), 1498.75);
+  }
+
+  void test_sortTof_WeightedEvent_keeps_weights() {
+    auto events = makeEvents<WeightedEvent>(5000);
+    for (auto &event : events)
+      event = WeightedEvent(event, event.tof() * 2., event.tof());
+    EventSorter::sortTof(events);
+    TS_ASSERT(std::is_sorted(events.cbegin(), events.cend()));
+    for (const auto &event : events) {
+      TS_ASSERT_DELTA(event.weight(), event.tof() * 2., event.tof() * 1e-6);
+    }
+  }
+
+  void test_sortTof_WeightedEventNoTime() {
+    std::vector<WeightedEventNoTime> events;
+    for (const auto &event : makeEvents<TofEvent>(5000))
+      events.emplace_back(event.tof(), 1.0, 1.0);
+    EventSorter::sortTof(events);
+    TS_ASSERT(std::is_sorted(events.cbegin(), events.cend()));
+  }
+
+  void test_sortPulseTime() {
+    for (const size_t numEvents : {100, 300000}) {
+      auto events = makeEvents<TofEvent>(numEvents);
+      EventSorter::sortPulseTime(events);
+      TS_ASSERT(std::is_sorted(events.cbegin(), events.cend(), [](const TofEvent &lhs, const TofEvent &rhs) {
+        return lhs.pulseTime() < rhs.pulseTime();
+      }));
+    }
+  }
+
+  void test_sortPulseTimeTof() {
+    for (const size_t numEvents : {100, 300000}) {
+      auto events = makeEvents<WeightedEvent>(numEvents);
+      EventSorter::sortPulseTimeTof(events);
+      TS_ASSERT(std::is_sorted(events.cbegin(), events.cend(), [](const TofEvent &lhs, const TofEvent &rhs) {
+        return lhs.pulseTime() < rhs.pulseTime() || (lhs.pulseTime() == rhs.pulseTime() && lhs.tof() < rhs.tof());
+      }));
+    }
+  }
+
+  void test_sortTof_pairs() {
+    std::vector<std::pair<double, size_t>> keys;
+    for (const auto &event : makeEvents<TofEvent>(5000))
+      keys.emplace_back(event.tof(), keys.size());
+    auto expected = keys;
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    EventSorter::sortTof(keys);
+    TS_ASSERT_EQUALS(keys, expected);
+  }
+
+private:
+  /// Unsorted events, many of them sharing a tof or a pulse time
+  template <typename T> std::vector<T> makeEvents(const size_t numEvents) {
+    std::vector<T> events;
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> tof(0., 21000.);
+    std::uniform_int_distribution<int64_t> pulse(0, 1000);
+    for (size_t i = 0; i < numEvents; ++i) {
+      const double eventTof = i % 5 == 0 ? std::floor(tof(generator) / 100.) : tof(generator);
+      events.emplace_back(TofEvent(eventTof, DateAndTime(1000000000 + pulse(generator) * 16666667)));
+    }
+    return events;
+  }
+};
@@ -0,0 +1,111 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventSplitter.h"
+#include "MantidKernel/TimeSplitter.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <limits>
+
+using namespace Mantid::DataObjects;
+using Mantid::Kernel::SplittingInterval;
+using Mantid::Kernel::TimeSplitterType;
+using Mantid::Types::Core::DateAndTime;
+
+class EventSplitterTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static EventSplitterTest *createSuite() { return new EventSplitterTest(); }
+  static void destroySuite(EventSplitterTest *suite) { delete suite; }
+
+  void test_empty_splitter_sends_everything_to_unfiltered() {
+    const EventSplitter splitter(TimeSplitterType{});
+    TS_ASSERT_EQUALS(splitter.targets(), std::vector<int>{-1});
+    TS_ASSERT_EQUALS(splitter.numberOfRegions(), 1);
+    TS_ASSERT_EQUALS(splitter.regionOutput(0), 0);
+    TS_ASSERT_EQUALS(splitter.findRegion(std::numeric_limits<int64_t>::max(), 0), 0);
+  }
+
+  void test_regions() {
+    const EventSplitter splitter(makeSplitter({{10, 20, 3}, {20, 30, 0}, {40, 50, 3}}));
+    TS_ASSERT_EQUALS(splitter.targets(), std::vector<int>({-1, 0, 3}));
+    assertRegions(splitter, {{MIN, 0}, {10, 2}, {20, 1}, {30, 0}, {40, 2}, {50, EventSplitter::NO_OUTPUT}});
+  }
+
+  void test_regions_are_merged() {
+    // Consecutive intervals with the same target, and intervals with the
+    // unfiltered target
+    const EventSplitter splitter(makeSplitter({{10, 20, 1}, {20, 30, 1}, {30, 40, -1}, {50, 60, 2}, {60, 60, 1}}));
+    TS_ASSERT_EQUALS(splitter.targets(), std::vector<int>({-1, 1, 2}));
+    assertRegions(splitter, {{MIN, 0}, {10, 1}, {30, 0}, {50, 2}, {60, EventSplitter::NO_OUTPUT}});
+  }
+
+  void test_overlapping_intervals_keep_what_is_after_the_previous_ones() {
+    const EventSplitter splitter(makeSplitter({{10, 30, 1}, {20, 40, 2}, {25, 35, 3}, {50, 60, 4}}));
+    TS_ASSERT_EQUALS(splitter.targets(), std::vector<int>({-1, 1, 2, 3, 4}));
+    assertRegions(splitter, {{MIN, 0}, {10, 1}, {30, 2}, {40, 0}, {50, 4}, {60, EventSplitter::NO_OUTPUT}});
+  }
+
+  void test_findRegion_from_any_hint() {
+    TimeSplitterType intervals;
+    for (int i = 0; i < 50; ++i)
+      intervals.emplace_back(DateAndTime(int64_t(100 * i)), DateAndTime(int64_t(100 * i + 60)), i % 3);
+    const EventSplitter splitter(intervals);
+    TS_ASSERT_EQUALS(splitter.numberOfRegions(), 101);
+    for (int64_t time = -10; time < 5100; time += 7) {
+      // The last region starting at or before the time
+      size_t expected = 0;
+      while (expected + 1 < splitter.numberOfRegions() && splitter.regionStart(expected + 1) <= time)
+        ++expected;
+      for (size_t hint = 0; hint < splitter.numberOfRegions(); ++hint)
+        TS_ASSERT_EQUALS(splitter.findRegion(time, hint), expected);
+    }
+  }
+
+  void test_outputIndex() {
+    const EventSplitter splitter(makeSplitter({{10, 20, 5}, {20, 30, 2}}));
+    TS_ASSERT_EQUALS(splitter.outputIndex(-1), 0);
+    TS_ASSERT_EQUALS(splitter.outputIndex(2), 1);
+    TS_ASSERT_EQUALS(splitter.outputIndex(5), 2);
+    TS_ASSERT_THROWS(splitter.outputIndex(3), const std::invalid_argument &);
+  }
+
+  void test_selectOutputs() {
+    const EventSplitter splitter(makeSplitter({{10, 20, 5}, {20, 30, 2}}));
+    EventList unfiltered, five, other;
+    const auto outputs = splitter.selectOutputs({{-1, &unfiltered}, {5, &five}, {7, &other}});
+    TS_ASSERT_EQUALS(outputs, std::vector<EventList *>({&unfiltered, nullptr, &five}));
+  }
+
+private:
+  static constexpr int64_t MIN = std::numeric_limits<int64_t>::min();
+
+  struct Interval {
+    int64_t start;
+    int64_t stop;
+    int index;
+  };
+
+  TimeSplitterType makeSplitter(const std::vector<Interval> &intervals) {
+    TimeSplitterType splitter;
+    for (const auto &interval : intervals)
+      splitter.emplace_back(DateAndTime(interval.start), DateAndTime(interval.stop), interval.index);
+    return splitter;
+  }
+
+  void assertRegions(const EventSplitter &splitter, const std::vector<std::pair<int64_t, size_t>> &regions) {
+    TS_ASSERT_EQUALS(splitter.numberOfRegions(), regions.size());
+    for (size_t i = 0; i < std::min(regions.size(), splitter.numberOfRegions()); ++i) {
+      TS_ASSERT_EQUALS(splitter.regionStart(i), regions[i].first);
+      TS_ASSERT_EQUALS(splitter.regionOutput(i), regions[i].second);
+    }
+  }
+};
@@ -0,0 +1,159 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/MDEventSpatialIndex.h"
+#include "MantidTestHelpers/MDEventsTestHelper.h"
+
+#include <cxxtest/TestSuite.h>
+#include <random>
+
+using namespace Mantid;
+using namespace Mantid::DataObjects;
+
+class MDEventSpatialIndexTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDEventSpatialIndexTest *createSuite() { return new MDEventSpatialIndexTest(); }
+  static void destroySuite(MDEventSpatialIndexTest *suite) { delete suite; }
+
+  void test_constructor_throws_for_unsupported_dimensions() {
+    auto ws = MDEventsTestHelper::makeMDEW<2>(4, 0.0, 10.0, 1);
+    TS_ASSERT_THROWS((MDEventSpatialIndex<MDLeanEvent<2>, 2>(*ws)), const std::invalid_argument &);
+  }
+
+  void test_numBoxes_counts_leaves_with_events() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(4, 0.0, 10.0, 1);
+    MDEventSpatialIndex<MDLeanEvent<3>, 3> index(*ws);
+    TS_ASSERT_EQUALS(index.numBoxes(), 64);
+  }
+
+  void test_sphere_finds_the_events_in_the_sphere() {
+    auto ws = createWorkspace<3>();
+    MDEventSpatialIndex<MDLeanEvent<3>, 3> index(*ws);
+    const coord_t center[3] = {2.5f, 3.f, 7.f};
+    for (const coord_t radius : {0.1f, 0.5f, 2.f, 6.f, 20.f}) {
+      MDQuerySphere<3> sphere(center, radius);
+      checkQuery(*ws, index, sphere);
+    }
+  }
+
+  void test_box_finds_the_events_in_the_box() {
+    auto ws = createWorkspace<4>();
+    MDEventSpatialIndex<MDLeanEvent<4>, 4> index(*ws);
+    const coord_t min[4] = {1.f, 0.f, 2.5f, 4.f};
+    const coord_t max[4] = {4.f, 10.f, 3.5f, 9.f};
+    checkQuery(*ws, index, MDQueryBox<4>(min, max));
+  }
+
+  void test_sphere_finds_the_events_in_the_sphere_in_4D() {
+    auto ws = createWorkspace<4>();
+    MDEventSpatialIndex<MDLeanEvent<4>, 4> index(*ws);
+    const coord_t center[4] = {2.5f, 5.f, 3.f, 6.5f};
+    checkQuery(*ws, index, MDQuerySphere<4>(center, 3.f));
+  }
+
+  void test_ellipsoid_finds_the_events_in_the_ellipsoid() {
+    auto ws = createWorkspace<3>();
+    MDEventSpatialIndex<MDLeanEvent<3>, 3> index(*ws);
+    const coord_t center[3] = {1.f, 1.5f, 2.f};
+    const double s = 1. / std::sqrt(2.);
+    const std::vector<std::vector<double>> axes{{s, s, 0.}, {-s, s, 0.}, {0., 0., 1.}};
+    checkQuery(*ws, index, MDQueryEllipsoid<3>(center, axes, {3., 0.5, 1.}));
+  }
+
+  void test_ellipsoid_throws_for_bad_axes() {
+    const coord_t center[3] = {0.f, 0.f, 0.f};
+    TS_ASSERT_THROWS(MDQueryEllipsoid<3>(center, {{1., 0., 0.}, {0., 1., 0.}}, {1., 1., 1.}),
+                     const std::invalid_argument &);
+    TS_ASSERT_THROWS(MDQueryEllipsoid<3>(center, {{1., 0., 0.}, {0., 1., 0.}, {0., 0., 1.}}, {1., 0., 1.}),
+                     const std::invalid_argument &);
+  }
+
+  void test_masked_boxes_are_skipped() {
+    auto ws = MDEventsTestHelper::makeMDEW<3>(4, 0.0, 10.0, 1);
+    MDEventSpatialIndex<MDLeanEvent<3>, 3> index(*ws);
+    const coord_t center[3] = {1.25f, 1.25f, 1.25f};
+    MDQuerySphere<3> sphere(center, 0.5f);
+    signal_t signal(0), errorSquared(0);
+    index.integrate(sphere, signal, errorSquared);
+    TS_ASSERT_DELTA(signal, 1.0, 1e-6);
+
+    std::vector<API::IMDNode *> boxes;
+    ws->getBox()->getBoxes(boxes, 1000, true);
+    for (auto *box : boxes)
+      box->mask();
+    signal = 0;
+    index.integrate(sphere, signal, errorSquared);
+    TS_ASSERT_EQUALS(signal, 0.0);
+  }
+
+  void test_batched_integrate_matches_single_queries() {
+    auto ws = createWorkspace<3>();
+    MDEventSpatialIndex<MDLeanEvent<3>, 3> index(*ws);
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<coord_t> position(0.f, 10.f);
+    std::vector<MDQuerySphere<3>> spheres;
+    for (size_t i = 0; i < 200; ++i) {
+      const coord_t center[3] = {position(generator), position(generator), position(generator)};
+      spheres.emplace_back(center, 0.1f * static_cast<coord_t>(i % 20 + 1));
+    }
+    const auto result = index.integrate(spheres);
+    TS_ASSERT_EQUALS(result.size(), spheres.size());
+    for (size_t i = 0; i < spheres.size(); ++i) {
+      signal_t signal(0), errorSquared(0);
+      index.integrate(spheres[i], signal, errorSquared);
+      TS_ASSERT_EQUALS(result[i].first, signal);
+      TS_ASSERT_EQUALS(result[i].second, errorSquared);
+    }
+  }
+
+private:
+  /// A workspace with boxes split to different depths
+  template <size_t nd> std::shared_ptr<MDEventWorkspace<MDLeanEvent<nd>, nd>> createWorkspace() {
+    auto ws = MDEventsTestHelper::makeMDEW<nd>(4, 0.0, 10.0, 1);
+    std::mt19937 generator(nd);
+    std::uniform_real_distribution<coord_t> everywhere(0.f, 10.f);
+    std::normal_distribution<coord_t> cluster(2.f, 0.7f);
+    for (size_t i = 0; i < 20000; ++i) {
+      coord_t center[nd];
+      for (size_t d = 0; d < nd; ++d)
+        center[d] = (i % 2 == 0) ? everywhere(generator) : std::min(std::max(cluster(generator), 0.f), 9.99f);
+      ws->addEvent(MDLeanEvent<nd>(1.0f, 2.0f, center));
+    }
+    ws->splitAllIfNeeded(nullptr);
+    ws->refreshCache();
+    return ws;
+  }
+
+  /// Compares the events found by the index with those found going through all events
+  template <size_t nd, typename Query>
+  void checkQuery(MDEventWorkspace<MDLeanEvent<nd>, nd> &ws, const MDEventSpatialIndex<MDLeanEvent<nd>, nd> &index,
+                  const Query &query) {
+    std::vector<API::IMDNode *> boxes;
+    ws.getBox()->getBoxes(boxes, 1000, true);
+    size_t expected = 0;
+    for (auto *node : boxes) {
+      auto *box = dynamic_cast<MDBox<MDLeanEvent<nd>, nd> *>(node);
+      for (const auto &event : box->getConstEvents()) {
+        if (query.contains(event.getCenter()))
+          ++expected;
+      }
+    }
+    TS_ASSERT_LESS_THAN(0, expected);
+
+    size_t found = 0;
+    index.forEachEvent(query, [&found](const MDLeanEvent<nd> &) { ++found; });
+    TS_ASSERT_EQUALS(found, expected);
+
+    signal_t signal(0), errorSquared(0);
+    index.integrate(query, signal, errorSquared);
+    TS_ASSERT_DELTA(signal, static_cast<double>(expected), 1e-6);
+    TS_ASSERT_DELTA(errorSquared, 2.0 * static_cast<double>(expected), 1e-6);
+  }
+};
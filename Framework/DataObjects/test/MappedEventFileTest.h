@@ -0,0 +1,180 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include "MantidDataObjects/EventList.h"
+#include "MantidDataObjects/EventWorkspace.h"
+#include "MantidDataObjects/MappedEventFile.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cxxtest/TestSuite.h>
+
+#include <Poco/TemporaryFile.h>
+
+#include <fstream>
+
+using namespace Mantid::DataObjects;
+using Mantid::MantidVec;
+using Mantid::Types::Event::TofEvent;
+
+class MappedEventFileTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MappedEventFileTest *createSuite() { return new MappedEventFileTest(); }
+  static void destroySuite(MappedEventFileTest *suite) { delete suite; }
+
+  void test_save_and_open() {
+    const auto ws = makeWorkspace();
+    Poco::TemporaryFile file;
+    MappedEventFile::save(*ws, file.path());
+
+    const auto mapped = MappedEventFile::open(file.path());
+    TS_ASSERT_EQUALS(mapped->getNumberHistograms(), ws->getNumberHistograms());
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      const auto &eventList = ws->getSpectrum(i);
+      TS_ASSERT_EQUALS(mapped->getSpectrumNo(i), eventList.getSpectrumNo());
+      TS_ASSERT_EQUALS(mapped->getDetectorIDs(i), eventList.getDetectorIDs());
+      const auto events = mapped->getEvents(i);
+      TS_ASSERT_EQUALS(events.getEventType(), eventList.getEventType());
+      TS_ASSERT_EQUALS(events.size(), eventList.getNumberEvents());
+    }
+    TS_ASSERT_THROWS(mapped->getEvents(ws->getNumberHistograms()), const std::out_of_range &);
+  }
+
+  void test_save_does_not_change_the_workspace() {
+    const auto ws = makeWorkspace();
+    ws->getSpectrum(0).setSortOrder(UNSORTED);
+    ws->getSpectrum(3).setCompactStorage(true);
+    Poco::TemporaryFile file;
+    MappedEventFile::save(*ws, file.path());
+    TS_ASSERT_EQUALS(ws->getSpectrum(0).getSortType(), UNSORTED);
+    TS_ASSERT(ws->getSpectrum(3).hasCompactStorage());
+  }
+
+  void test_mapped_workspace_matches() {
+    const auto ws = makeWorkspace();
+    Poco::TemporaryFile file;
+    MappedEventFile::save(*ws, file.path());
+    const auto mappedWS = makeWorkspace();
+    mappedWS->setMappedEvents(MappedEventFile::open(file.path()));
+
+    MantidVec X;
+    for (double x = 0.; x <= 100.; x += 0.5)
+      X.emplace_back(x);
+    const MantidVec irregularX{0., 1., 10., 10.5, 100.};
+    for (size_t i = 0; i < ws->getNumberHistograms(); ++i) {
+      const auto &expected = ws->getSpectrum(i);
+      const auto &eventList = mappedWS->getSpectrum(i);
+      TS_ASSERT(eventList.hasMappedStorage());
+      TS_ASSERT_EQUALS(eventList.getEventType(), expected.getEventType());
+      TS_ASSERT_EQUALS(eventList.getNumberEvents(), expected.getNumberEvents());
+      TS_ASSERT_EQUALS(eventList.getSortType(), TOF_SORT);
+      TS_ASSERT_EQUALS(eventList.getTofMin(), expected.getTofMin());
+      TS_ASSERT_EQUALS(eventList.getTofMax(), expected.getTofMax());
+      TS_ASSERT_DELTA(eventList.integrate(0., 0., true), expected.integrate(0., 0., true), 1e-9);
+      TS_ASSERT_DELTA(eventList.integrate(2., 30., false), expected.integrate(2., 30., false), 1e-9);
+      for (const auto &bins : {X, irregularX}) {
+        MantidVec Y, E, expectedY, expectedE;
+        eventList.generateHistogram(bins, Y, E);
+        expected.generateHistogram(bins, expectedY, expectedE);
+        TS_ASSERT_EQUALS(Y, expectedY);
+        TS_ASSERT_EQUALS(E, expectedE);
+      }
+      // Fewer than two bin edges give empty outputs
+      MantidVec Y(3, 1.), E(3, 1.);
+      eventList.generateHistogram(MantidVec{1.}, Y, E);
+      TS_ASSERT(Y.empty());
+      TS_ASSERT(E.empty());
+      // Reading does not copy the events
+      TS_ASSERT(eventList.hasMappedStorage());
+      if (!expected.empty())
+        TS_ASSERT_LESS_THAN(eventList.getMemorySize(), expected.getMemorySize());
+    }
+  }
+
+  void test_changing_a_list_copies_its_events() {
+    const auto ws = makeWorkspace();
+    Poco::TemporaryFile file;
+    MappedEventFile::save(*ws, file.path());
+    const auto mappedWS = makeWorkspace();
+    mappedWS->setMappedEvents(MappedEventFile::open(file.path()));
+
+    auto &eventList = mappedWS->getSpectrum(0);
+    eventList.addEventQuickly(TofEvent(1.5, 100));
+    TS_ASSERT(!eventList.hasMappedStorage());
+    TS_ASSERT_EQUALS(eventList.getNumberEvents(), ws->getSpectrum(0).getNumberEvents() + 1);
+
+    auto &scaled = mappedWS->getSpectrum(1);
+    scaled *= 2.;
+    TS_ASSERT(!scaled.hasMappedStorage());
+    TS_ASSERT_DELTA(scaled.integrate(0., 0., true), 2. * ws->getSpectrum(1).integrate(0., 0., true), 1e-9);
+
+    // The other lists are untouched
+    TS_ASSERT(mappedWS->getSpectrum(2).hasMappedStorage());
+    TS_ASSERT(mappedWS->getSpectrum(2) == ws->getSpectrum(2));
+  }
+
+  void test_lists_keep_the_file_mapped() {
+    const auto ws = makeWorkspace();
+    Poco::TemporaryFile file;
+    MappedEventFile::save(*ws, file.path());
+    EventList copy;
+    {
+      const auto mappedWS = makeWorkspace();
+      mappedWS->setMappedEvents(MappedEventFile::open(file.path()));
+      copy = mappedWS->getSpectrum(3);
+    }
+    TS_ASSERT(copy.hasMappedStorage());
+    TS_ASSERT(copy == ws->getSpectrum(3));
+  }
+
+  void test_wrong_number_of_spectra_throws() {
+    const auto ws = makeWorkspace();
+    Poco::TemporaryFile file;
+    MappedEventFile::save(*ws, file.path());
+    const auto smallWS = WorkspaceCreationHelper::createEventWorkspace(2, 10);
+    TS_ASSERT_THROWS(smallWS->setMappedEvents(MappedEventFile::open(file.path())), const std::invalid_argument &);
+  }
+
+  void test_invalid_files_throw() {
+    Poco::TemporaryFile file;
+    TS_ASSERT_THROWS(MappedEventFile::open(file.path()), const std::runtime_error &);
+    {
+      std::ofstream out(file.path(), std::ios::binary);
+      out << "This is not a mapped event file, but it is long enough for its header";
+    }
+    TS_ASSERT_THROWS(MappedEventFile::open(file.path()), const std::runtime_error &);
+
+    // A truncated file
+    const auto ws = makeWorkspace();
+    MappedEventFile::save(*ws, file.path());
+    std::string content;
+    {
+      std::ifstream in(file.path(), std::ios::binary);
+      content.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    {
+      std::ofstream out(file.path(), std::ios::binary | std::ios::trunc);
+      out.write(content.data(), static_cast<std::streamsize>(content.size() / 2));
+    }
+    TS_ASSERT_THROWS(MappedEventFile::open(file.path()), const std::runtime_error &);
+  }
+
+private:
+  /// An event workspace with unsorted TofEvents, weighted and unweighted
+  /// events, and an empty list
+  EventWorkspace_sptr makeWorkspace() {
+    auto ws = WorkspaceCreationHelper::createEventWorkspace(6, 10, 50, 0.0, 1.0, 3);
+    ws->getSpectrum(0).addEventQuickly(TofEvent(0.25, 20));
+    ws->getSpectrum(1).switchTo(Mantid::API::WEIGHTED);
+    ws->getSpectrum(1) *= 1.5;
+    ws->getSpectrum(2).compressEvents(0.5, &ws->getSpectrum(2));
+    ws->getSpectrum(5).clear(false);
+    return ws;
+  }
+};
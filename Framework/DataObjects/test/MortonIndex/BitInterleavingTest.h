@@ -124,4 +124,34 @@ public:
     TS_ASSERT_EQUALS(integerC, result[2]);
     TS_ASSERT_EQUALS(integerD, result[3]);
   }
+
+  void test_padBits_matches_pad_specialisation() {
+    for (const uint32_t v : {integerA, integerB, integerC, integerD}) {
+      TS_ASSERT_EQUALS((pad<3, uint32_t, uint128_t>(v)), (padBits<3, uint32_t, uint128_t>(v)));
+      TS_ASSERT_EQUALS((compact<3, uint32_t, uint128_t>(pad<3, uint32_t, uint128_t>(v))),
+                       (compactBits<3, uint32_t, uint128_t>(padBits<3, uint32_t, uint128_t>(v))));
+    }
+  }
+
+  void test_interleave_deinterleave_2_32_64() {
+    const auto z = interleave<2, uint32_t, uint64_t>({integerA, integerB});
+    TS_ASSERT_EQUALS(z & 1u, integerA & 1u);
+    TS_ASSERT_EQUALS((z >> 1) & 1u, integerB & 1u);
+    TS_ASSERT_EQUALS(z >> 62, ((integerB >> 31) << 1) | (integerA >> 31));
+
+    const auto result = deinterleave<2, uint32_t, uint64_t>(z);
+    TS_ASSERT_EQUALS(integerA, result[0]);
+    TS_ASSERT_EQUALS(integerB, result[1]);
+  }
+
+  void test_interleave_deinterleave_5_32_256() {
+    IntArray<5, uint32_t> coord;
+    coord << integerA, integerB, integerC, integerD, integerA ^ integerD;
+    const auto z = interleave<5, uint32_t, uint256_t>(coord);
+    TS_ASSERT_EQUALS(z >> 160, uint256_t(0));
+
+    const auto result = deinterleave<5, uint32_t, uint256_t>(z);
+    for (size_t i = 0; i < 5; ++i)
+      TS_ASSERT_EQUALS(coord[i], result[i]);
+  }
 };
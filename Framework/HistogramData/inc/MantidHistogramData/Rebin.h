@@ -6,12 +6,49 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
+#include "MantidHistogramData/BinEdges.h"
 #include "MantidHistogramData/DllConfig.h"
+
+#include <vector>
+
 namespace Mantid {
 namespace HistogramData {
 class Histogram;
-class BinEdges;
 
 MANTID_HISTOGRAMDATA_DLL Histogram rebin(const Histogram &input, const BinEdges &binEdges);
+
+/** Rebinner : rebins histograms sharing one set of bin edges onto another set
+  of bin edges.
+
+  The overlaps of the old and new bins are worked out once, when the Rebinner
+  is created. Rebinning a histogram then sums, for each new bin, the weighted
+  values of the consecutive old bins overlapping it, without comparing any bin
+  edges, so workspaces with common bins are best rebinned with one Rebinner
+  per set of input bin edges rather than calling rebin() for each spectrum.
+*/
+class MANTID_HISTOGRAMDATA_DLL Rebinner {
+public:
+  Rebinner(const BinEdges &oldEdges, const BinEdges &newEdges);
+
+  Histogram rebin(const Histogram &input) const;
+
+private:
+  Histogram rebinCounts(const Histogram &input) const;
+  Histogram rebinFrequencies(const Histogram &input) const;
+
+  BinEdges m_oldEdges;
+  BinEdges m_newEdges;
+  /// Index of the first old bin overlapping each new bin
+  std::vector<size_t> m_firstOld;
+  /// Start of the overlaps of each new bin in the weights, followed by the end
+  std::vector<size_t> m_offsets;
+  /// Overlap as a fraction of the width of the old bin, for counts
+  std::vector<double> m_countWeights;
+  /// Overlap as a fraction of the width of the new bin, for frequencies
+  std::vector<double> m_frequencyWeights;
+  /// Weight of the squared frequency errors
+  std::vector<double> m_frequencyVarianceWeights;
+};
+
 } // namespace HistogramData
 } // namespace Mantid
@@ -9,6 +9,8 @@
 #include "MantidHistogramData/Exception.h"
 #include "MantidHistogramData/Histogram.h"
 #include <algorithm>
+#include <cfloat>
+#include <cmath>
 #include <numeric>
 
 using Mantid::HistogramData::BinEdges;
@@ -18,32 +20,38 @@ using Mantid::HistogramData::CountVariances;
 using Mantid::HistogramData::Frequencies;
 using Mantid::HistogramData::FrequencyStandardDeviations;
 using Mantid::HistogramData::Histogram;
+using Mantid::HistogramData::Rebinner;
 using Mantid::HistogramData::Exception::InvalidBinEdgesError;
 
 namespace {
-Histogram rebinCounts(const Histogram &input, const BinEdges &binEdges) {
-  auto &xold = input.x();
-  auto &yold = input.y();
-  auto &eold = input.e();
-
-  auto &xnew = binEdges.rawData();
-  Counts newCounts(xnew.size() - 1);
-  CountVariances newCountVariances(xnew.size() - 1);
-  auto &ynew = newCounts.mutableData();
-  auto &enew = newCountVariances.mutableData();
+void checkModes(const Histogram &input) {
+  if (input.xMode() != Histogram::XMode::BinEdges)
+    throw std::runtime_error("XMode must be Histogram::XMode::BinEdges for input histogram");
+  if (input.yMode() == Histogram::YMode::Uninitialized)
+    throw std::runtime_error("YMode must be defined for input histogram.");
+}
 
-  auto size_yold = yold.size();
-  auto size_ynew = ynew.size();
+/** Call overlap(iold, inew, delta, owidth, nwidth) for every pair of old and
+ * new bins that overlap, by increasing old bin for each new bin.
+ * @param xold :: the old bin edges
+ * @param xnew :: the new bin edges
+ * @param overlap :: called with the indices of the bins, the width of their
+ * overlap and the widths of the old and new bins
+ * @throws InvalidBinEdgesError for non-positive input/output bin widths
+ */
+template <typename Overlap>
+void forEachOverlap(const std::vector<double> &xold, const std::vector<double> &xnew, const Overlap &overlap) {
+  const size_t size_yold = xold.empty() ? 0 : xold.size() - 1;
+  const size_t size_ynew = xnew.empty() ? 0 : xnew.size() - 1;
   size_t iold = 0;
   size_t inew = 0;
-
   while ((inew < size_ynew) && (iold < size_yold)) {
-    auto xo_low = xold[iold];
-    auto xo_high = xold[iold + 1];
-    auto xn_low = xnew[inew];
-    auto xn_high = xnew[inew + 1];
-    auto owidth = xo_high - xo_low;
-    auto nwidth = xn_high - xn_low;
+    const auto xo_low = xold[iold];
+    const auto xo_high = xold[iold + 1];
+    const auto xn_low = xnew[inew];
+    const auto xn_high = xnew[inew + 1];
+    const auto owidth = xo_high - xo_low;
+    const auto nwidth = xn_high - xn_low;
 
     if (owidth <= 0.0 || nwidth <= 0.0) {
       if (xo_high == -DBL_MAX && xo_low == -DBL_MAX) {
@@ -64,9 +72,7 @@ Histogram rebinCounts(const Histogram &input, const BinEdges &binEdges) {
       // delta is the overlap of the bins on the x axis
       auto delta = xo_high < xn_high ? xo_high : xn_high;
       delta -= xo_low > xn_low ? xo_low : xn_low;
-
-      ynew[inew] += yold[iold] * delta / owidth;
-      enew[inew] += eold[iold] * eold[iold] * delta / owidth;
+      overlap(iold, inew, delta, owidth, nwidth);
 
       if (xn_high > xo_high) {
         iold++;
@@ -75,64 +81,53 @@ Histogram rebinCounts(const Histogram &input, const BinEdges &binEdges) {
       }
     }
   }
-
-  return Histogram(binEdges, newCounts, CountStandardDeviations(std::move(newCountVariances)));
 }
 
-Histogram rebinFrequencies(const Histogram &input, const BinEdges &binEdges) {
-  auto &xold = input.x();
-  auto &yold = input.y();
-  auto &eold = input.e();
-
-  auto &xnew = binEdges.rawData();
-  Frequencies newFrequencies(xnew.size() - 1);
-  FrequencyStandardDeviations newFrequencyStdDev(xnew.size() - 1);
-  auto &ynew = newFrequencies.mutableData();
-  auto &enew = newFrequencyStdDev.mutableData();
-
-  auto size_yold = yold.size();
-  auto size_ynew = ynew.size();
-  size_t iold = 0;
-  size_t inew = 0;
+/// Weight of the counts (and their variances) of an old bin in a new bin
+double countWeight(const double delta, const double owidth) { return delta / owidth; }
+/// Weight of the frequencies of an old bin in a new bin
+double frequencyWeight(const double delta, const double nwidth) { return delta / nwidth; }
+/// Weight of the squared frequency errors of an old bin in a new bin
+double frequencyVarianceWeight(const double delta, const double owidth, const double nwidth) {
+  return delta * owidth / (nwidth * nwidth);
+}
 
-  while ((inew < size_ynew) && (iold < size_yold)) {
-    auto xo_low = xold[iold];
-    auto xo_high = xold[iold + 1];
-    auto xn_low = xnew[inew];
-    auto xn_high = xnew[inew + 1];
+Histogram rebinCounts(const Histogram &input, const BinEdges &binEdges) {
+  const auto &yold = input.y();
+  const auto &eold = input.e();
 
-    auto owidth = xo_high - xo_low;
-    auto nwidth = xn_high - xn_low;
+  Counts newCounts(binEdges.size() - 1);
+  CountVariances newCountVariances(binEdges.size() - 1);
+  auto &ynew = newCounts.mutableData();
+  auto &enew = newCountVariances.mutableData();
 
-    if (owidth <= 0.0 || nwidth <= 0.0)
-      throw InvalidBinEdgesError("Negative or zero bin widths not allowed.");
+  forEachOverlap(input.x().rawData(), binEdges.rawData(),
+                 [&](const size_t iold, const size_t inew, const double delta, const double owidth, const double) {
+                   const auto weight = countWeight(delta, owidth);
+                   ynew[inew] += yold[iold] * weight;
+                   enew[inew] += eold[iold] * eold[iold] * weight;
+                 });
 
-    if (xn_high <= xo_low)
-      inew++; /* old and new bins do not overlap */
-    else if (xo_high <= xn_low)
-      iold++; /* old and new bins do not overlap */
-    else {
-      //        delta is the overlap of the bins on the x axis
-      auto delta = xo_high < xn_high ? xo_high : xn_high;
-      delta -= xo_low > xn_low ? xo_low : xn_low;
+  return Histogram(binEdges, newCounts, CountStandardDeviations(std::move(newCountVariances)));
+}
 
-      ynew[inew] += yold[iold] * delta;
-      enew[inew] += eold[iold] * eold[iold] * delta * owidth;
+Histogram rebinFrequencies(const Histogram &input, const BinEdges &binEdges) {
+  const auto &yold = input.y();
+  const auto &eold = input.e();
 
-      if (xn_high > xo_high) {
-        iold++;
-      } else {
-        inew++;
-      }
-    }
-  }
+  Frequencies newFrequencies(binEdges.size() - 1);
+  FrequencyStandardDeviations newFrequencyStdDev(binEdges.size() - 1);
+  auto &ynew = newFrequencies.mutableData();
+  auto &enew = newFrequencyStdDev.mutableData();
 
-  for (size_t i = 0; i < size_ynew; ++i) {
-    auto width = xnew[i + 1] - xnew[i];
-    auto factor = 1 / width;
-    ynew[i] *= factor;
-    enew[i] = sqrt(enew[i]) * factor;
-  }
+  forEachOverlap(input.x().rawData(), binEdges.rawData(),
+                 [&](const size_t iold, const size_t inew, const double delta, const double owidth,
+                     const double nwidth) {
+                   ynew[inew] += yold[iold] * frequencyWeight(delta, nwidth);
+                   enew[inew] += eold[iold] * eold[iold] * frequencyVarianceWeight(delta, owidth, nwidth);
+                 });
+  for (auto &e : enew)
+    e = std::sqrt(e);
 
   return Histogram(binEdges, newFrequencies, newFrequencyStdDev);
 }
@@ -149,14 +144,110 @@ namespace HistogramData {
  * the input yMode is undefined, or for non-positive input/output bin widths
  */
 Histogram rebin(const Histogram &input, const BinEdges &binEdges) {
-  if (input.xMode() != Histogram::XMode::BinEdges)
-    throw std::runtime_error("XMode must be Histogram::XMode::BinEdges for input histogram");
+  checkModes(input);
   if (input.yMode() == Histogram::YMode::Counts)
     return rebinCounts(input, binEdges);
-  else if (input.yMode() == Histogram::YMode::Frequencies)
-    return rebinFrequencies(input, binEdges);
-  else
-    throw std::runtime_error("YMode must be defined for input histogram.");
+  return rebinFrequencies(input, binEdges);
+}
+
+/** Works out the overlaps of two sets of bin edges.
+ * @param oldEdges :: bin edges of the histograms to be rebinned.
+ * @param newEdges :: bin edges of the rebinned histograms.
+ * @throws InvalidBinEdgesError for non-positive input/output bin widths
+ */
+Rebinner::Rebinner(const BinEdges &oldEdges, const BinEdges &newEdges)
+    : m_oldEdges(oldEdges), m_newEdges(newEdges) {
+  const auto &xnew = m_newEdges.rawData();
+  const size_t size_ynew = xnew.empty() ? 0 : xnew.size() - 1;
+  m_firstOld.resize(size_ynew, 0);
+  m_offsets.resize(size_ynew + 1, 0);
+
+  forEachOverlap(m_oldEdges.rawData(), xnew,
+                 [this](const size_t iold, const size_t inew, const double delta, const double owidth,
+                        const double nwidth) {
+                   // The old bins overlapping a new bin are consecutive, so
+                   // only the first one and their number are kept
+                   if (m_offsets[inew + 1] == 0)
+                     m_firstOld[inew] = iold;
+                   ++m_offsets[inew + 1];
+                   m_countWeights.emplace_back(countWeight(delta, owidth));
+                   m_frequencyWeights.emplace_back(frequencyWeight(delta, nwidth));
+                   m_frequencyVarianceWeights.emplace_back(frequencyVarianceWeight(delta, owidth, nwidth));
+                 });
+  std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+}
+
+/** Rebins a histogram onto the new bin edges.
+ * @param input :: input histogram data to be rebinned. Its bin edges must be
+ * the old bin edges of the Rebinner.
+ * @returns The rebinned histogram, sharing the new bin edges.
+ * @throws std::runtime_error if the input histogram xmode is not BinEdges,
+ * the input yMode is undefined, or the input bin edges are not the old ones
+ */
+Histogram Rebinner::rebin(const Histogram &input) const {
+  checkModes(input);
+  if (input.sharedX() != m_oldEdges.cowData() && input.x().rawData() != m_oldEdges.rawData())
+    throw std::runtime_error("The bin edges of the input histogram are not those the Rebinner was created for.");
+  if (input.yMode() == Histogram::YMode::Counts)
+    return rebinCounts(input);
+  return rebinFrequencies(input);
+}
+
+Histogram Rebinner::rebinCounts(const Histogram &input) const {
+  const auto &yold = input.y();
+  const auto &eold = input.e();
+
+  const size_t size_ynew = m_firstOld.size();
+  Counts newCounts(size_ynew);
+  CountVariances newCountVariances(size_ynew);
+  auto &ynew = newCounts.mutableData();
+  auto &enew = newCountVariances.mutableData();
+
+  for (size_t inew = 0; inew < size_ynew; ++inew) {
+    const auto *y = yold.rawData().data() + m_firstOld[inew];
+    const auto *e = eold.rawData().data() + m_firstOld[inew];
+    const auto *weight = m_countWeights.data() + m_offsets[inew];
+    const size_t overlaps = m_offsets[inew + 1] - m_offsets[inew];
+    double ysum = 0.0;
+    double esum = 0.0;
+    for (size_t i = 0; i < overlaps; ++i) {
+      ysum += y[i] * weight[i];
+      esum += e[i] * e[i] * weight[i];
+    }
+    ynew[inew] = ysum;
+    enew[inew] = esum;
+  }
+
+  return Histogram(m_newEdges, newCounts, CountStandardDeviations(std::move(newCountVariances)));
+}
+
+Histogram Rebinner::rebinFrequencies(const Histogram &input) const {
+  const auto &yold = input.y();
+  const auto &eold = input.e();
+
+  const size_t size_ynew = m_firstOld.size();
+  Frequencies newFrequencies(size_ynew);
+  FrequencyStandardDeviations newFrequencyStdDev(size_ynew);
+  auto &ynew = newFrequencies.mutableData();
+  auto &enew = newFrequencyStdDev.mutableData();
+
+  for (size_t inew = 0; inew < size_ynew; ++inew) {
+    const auto *y = yold.rawData().data() + m_firstOld[inew];
+    const auto *e = eold.rawData().data() + m_firstOld[inew];
+    const auto *weight = m_frequencyWeights.data() + m_offsets[inew];
+    const auto *varianceWeight = m_frequencyVarianceWeights.data() + m_offsets[inew];
+    const size_t overlaps = m_offsets[inew + 1] - m_offsets[inew];
+    double ysum = 0.0;
+    double esum = 0.0;
+    for (size_t i = 0; i < overlaps; ++i) {
+      ysum += y[i] * weight[i];
+      esum += e[i] * e[i] * varianceWeight[i];
+    }
+    ynew[inew] = ysum;
+    enew[inew] = std::sqrt(esum);
+  }
+
+  return Histogram(m_newEdges, newFrequencies, newFrequencyStdDev);
 }
 
 } // namespace HistogramData
@@ -353,6 +353,112 @@ public:
     TS_ASSERT_EQUALS(outFreq.e()[2], 0);
   }
 
+  void testRebinnerMatchesOverlapsOfRandomBins() {
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<double> width(0.1, 2.0);
+    std::uniform_real_distribution<double> value(0.0, 100.0);
+    const auto randomEdges = [&](const double start, const size_t n) {
+      std::vector<double> edges{start};
+      for (size_t i = 0; i < n; ++i)
+        edges.emplace_back(edges.back() + width(gen));
+      return BinEdges(std::move(edges));
+    };
+    const BinEdges oldEdges = randomEdges(0., 200);
+    const BinEdges newEdges = randomEdges(-5., 150);
+    Histogram hist(oldEdges, Counts(200, 0.), CountStandardDeviations(200, 0.));
+    Histogram histFreq(oldEdges, Frequencies(200, 0.), FrequencyStandardDeviations(200, 0.));
+    for (size_t i = 0; i < 200; ++i) {
+      hist.mutableY()[i] = value(gen);
+      hist.mutableE()[i] = std::sqrt(hist.y()[i]);
+      histFreq.mutableY()[i] = value(gen);
+      histFreq.mutableE()[i] = std::sqrt(histFreq.y()[i]);
+    }
+
+    const Rebinner rebinner(oldEdges, newEdges);
+    const auto outCounts = rebinner.rebin(hist);
+    const auto outFreq = rebinner.rebin(histFreq);
+
+    for (size_t inew = 0; inew + 1 < newEdges.size(); ++inew) {
+      double counts = 0., variance = 0., freq = 0., freqVariance = 0.;
+      const double nwidth = newEdges[inew + 1] - newEdges[inew];
+      for (size_t iold = 0; iold + 1 < oldEdges.size(); ++iold) {
+        const double owidth = oldEdges[iold + 1] - oldEdges[iold];
+        const double overlap =
+            std::min(oldEdges[iold + 1], newEdges[inew + 1]) - std::max(oldEdges[iold], newEdges[inew]);
+        if (overlap <= 0.)
+          continue;
+        counts += hist.y()[iold] * overlap / owidth;
+        variance += hist.e()[iold] * hist.e()[iold] * overlap / owidth;
+        freq += histFreq.y()[iold] * overlap / nwidth;
+        freqVariance += histFreq.e()[iold] * histFreq.e()[iold] * overlap * owidth / (nwidth * nwidth);
+      }
+      TS_ASSERT_DELTA(outCounts.y()[inew], counts, 1e-10);
+      TS_ASSERT_DELTA(outCounts.e()[inew], std::sqrt(variance), 1e-10);
+      TS_ASSERT_DELTA(outFreq.y()[inew], freq, 1e-10);
+      TS_ASSERT_DELTA(outFreq.e()[inew], std::sqrt(freqVariance), 1e-10);
+    }
+  }
+
+  void testRebinnerMatchesRebinExactly() {
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> width(0.01, 3.7);
+    std::uniform_real_distribution<double> value(0.0, 1000.0);
+    const auto randomEdges = [&](const double start, const size_t n) {
+      std::vector<double> edges{start};
+      for (size_t i = 0; i < n; ++i)
+        edges.emplace_back(edges.back() + width(gen));
+      return BinEdges(std::move(edges));
+    };
+    for (int trial = 0; trial < 10; ++trial) {
+      const BinEdges oldEdges = randomEdges(-0.3 * trial, 500);
+      const BinEdges newEdges = randomEdges(-3.14, 300 + 50 * trial);
+      Histogram hist(oldEdges, Counts(500, 0.), CountStandardDeviations(500, 0.));
+      Histogram histFreq(oldEdges, Frequencies(500, 0.), FrequencyStandardDeviations(500, 0.));
+      for (size_t i = 0; i < 500; ++i) {
+        hist.mutableY()[i] = value(gen);
+        hist.mutableE()[i] = std::sqrt(hist.y()[i]);
+        histFreq.mutableY()[i] = value(gen);
+        histFreq.mutableE()[i] = std::sqrt(histFreq.y()[i]);
+      }
+
+      const Rebinner rebinner(oldEdges, newEdges);
+      const auto sharedCounts = rebinner.rebin(hist);
+      const auto sharedFreq = rebinner.rebin(histFreq);
+      const auto outCounts = rebin(hist, newEdges);
+      const auto outFreq = rebin(histFreq, newEdges);
+      TS_ASSERT_EQUALS(sharedCounts.y().rawData(), outCounts.y().rawData());
+      TS_ASSERT_EQUALS(sharedCounts.e().rawData(), outCounts.e().rawData());
+      TS_ASSERT_EQUALS(sharedFreq.y().rawData(), outFreq.y().rawData());
+      TS_ASSERT_EQUALS(sharedFreq.e().rawData(), outFreq.e().rawData());
+    }
+  }
+
+  void testRebinnerSharesNewBinEdges() {
+    const auto hist = getCountsHistogram();
+    const BinEdges edges(5, LinearGenerator(0, 2));
+    const Rebinner rebinner(hist.binEdges(), edges);
+
+    const auto out1 = rebinner.rebin(hist);
+    const auto out2 = rebinner.rebin(getCountsHistogram());
+
+    TS_ASSERT_EQUALS(out1.sharedX(), edges.cowData());
+    TS_ASSERT_EQUALS(out2.sharedX(), edges.cowData());
+    TS_ASSERT_EQUALS(out1.y(), rebin(hist, edges).y());
+    TS_ASSERT_EQUALS(out2.y(), out1.y());
+  }
+
+  void testRebinnerThrowsForOtherBinEdges() {
+    const Rebinner rebinner(BinEdges(10, LinearGenerator(0, 0.5)), BinEdges(5, LinearGenerator(0, 2)));
+    TS_ASSERT_THROWS(rebinner.rebin(getCountsHistogram()), const std::runtime_error &);
+  }
+
+  void testRebinnerThrowsForInvalidBinEdges() {
+    std::vector<double> binEdges{1, 2, 3, 3, 5, 7};
+    BinEdges edges(binEdges);
+    TS_ASSERT_THROWS(Rebinner(getCountsHistogram().binEdges(), edges), const InvalidBinEdgesError &);
+    TS_ASSERT_THROWS(Rebinner(edges, getCountsHistogram().binEdges()), const InvalidBinEdgesError &);
+  }
+
 private:
   Histogram getCountsHistogram() {
     return Histogram(BinEdges(10, LinearGenerator(0, 1)), Counts{10.5, 11.2, 19.3, 25.4, 36.8, 40.3, 17.7, 9.3, 4.6},
@@ -399,6 +505,18 @@ public:
       rebin(histFreq, lgBins);
   }
 
+  void testRebinnerCountsSmallerBins() {
+    const Rebinner rebinner(hist.binEdges(), smBins);
+    for (size_t i = 0; i < nIters; i++)
+      rebinner.rebin(hist);
+  }
+
+  void testRebinnerCountsLargerBins() {
+    const Rebinner rebinner(hist.binEdges(), lgBins);
+    for (size_t i = 0; i < nIters; i++)
+      rebinner.rebin(hist);
+  }
+
 private:
   const size_t binSize = 10000;
   const size_t nIters = 10000;
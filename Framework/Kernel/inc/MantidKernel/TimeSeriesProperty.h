@@ -14,7 +14,10 @@
 #include "MantidKernel/ITimeSeriesProperty.h"
 #include "MantidKernel/Property.h"
 #include "MantidKernel/Statistics.h"
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <mutex>
 #include <utility>
 
 // Forward declare
@@ -101,6 +104,8 @@ public:
   TimeSeriesProperty(const std::string &name, const std::vector<Types::Core::DateAndTime> &times,
                      const std::vector<TYPE> &values);
 
+  /// Copy constructor
+  TimeSeriesProperty(const TimeSeriesProperty<TYPE> &other);
   /// Virtual destructor
   ~TimeSeriesProperty() override;
   /// "Virtual" copy constructor
@@ -147,6 +152,11 @@ public:
   /// New split method
   void splitByTimeVector(const std::vector<Types::Core::DateAndTime> &splitter_time_vec,
                          const std::vector<int> &target_vec, const std::vector<TimeSeriesProperty *> &outputs);
+  /// Split as splitByTimeVector, leaving the outputs to copy their values
+  /// from this property's when they are first used
+  void splitByTimeVectorDeferred(const std::vector<Types::Core::DateAndTime> &splitter_time_vec,
+                                 const std::vector<int> &target_vec,
+                                 const std::vector<TimeSeriesProperty *> &outputs) const;
 
   /// Fill a TimeSplitterType that will filter the events by matching
   void makeFilterByValue(std::vector<SplittingInterval> &split, double min, double max, double TimeTolerance = 0.0,
@@ -248,9 +258,9 @@ public:
   /// Returns the value at a particular time
   TYPE getSingleValue(const Types::Core::DateAndTime &t, int &index) const;
 
-  /// Returns n-th valid time interval, in a very inefficient way.
+  /// Returns n-th valid time interval
   TimeInterval nthInterval(int n) const;
-  /// Returns n-th value of n-th interval in an incredibly inefficient way.
+  /// Returns n-th value of n-th interval
   TYPE nthValue(int n) const;
   /// Returns n-th time. NOTE: Complexity is order(n)! regardless of filter
   Types::Core::DateAndTime nthTime(int n) const;
@@ -315,6 +325,14 @@ private:
   bool isTimeFiltered(const Types::Core::DateAndTime &time) const;
   /// Time weighted mean and standard deviation
   std::pair<double, double> timeAverageValueAndStdDev() const;
+  /// Drop the time integrals after the values change
+  void clearTimeIntegrals() const;
+  /// The time integrals of the values, built if needed
+  const std::vector<double> &timeIntegrals() const;
+  /// Values waiting to be copied from a split property
+  struct DeferredSplit;
+  /// Copy the values of a deferred split, if there is one
+  void applyDeferredSplit() const;
 
   /// Holds the time series data
   mutable std::vector<TimeValueUnit<TYPE>> m_values;
@@ -332,6 +350,18 @@ private:
   mutable std::vector<std::pair<size_t, size_t>> m_filterQuickRef;
   /// True if a filter has been applied
   mutable bool m_filterApplied;
+
+  /// Integrals over time of the values, relative to the first value, from the
+  /// first time to the time of each entry. Built on demand by the averages.
+  mutable std::vector<double> m_timeIntegrals;
+  /// Guards building the time integrals from const methods
+  mutable std::mutex m_timeIntegralsMutex;
+  /// The values still to be added from a deferred split
+  mutable std::shared_ptr<const DeferredSplit> m_deferredSplit;
+  /// True while m_deferredSplit is set, so readers only lock when it is
+  mutable std::atomic<bool> m_hasDeferredSplit;
+  /// Guards applying a deferred split from const methods
+  mutable std::mutex m_deferredSplitMutex;
 };
 
 /// Function filtering double TimeSeriesProperties according to the requested
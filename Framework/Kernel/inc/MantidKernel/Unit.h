@@ -172,6 +172,23 @@ public:
    */
   virtual double singleFromTOF(const double tof) const = 0;
 
+  /** Convert an array of X values to TOF. The unit must have been initialized.
+   * Gives the same result as calling singleToTOF() on each value but costs one
+   * virtual call per array rather than per value.
+   * @param x :: the values to convert
+   * @param tof :: output array of the same length; may be the same as x
+   * @param count :: the number of values
+   */
+  virtual void valuesToTOF(const double *x, double *tof, const size_t count) const;
+
+  /** Convert an array of tof values to this unit. The unit must have been
+   * initialized. Gives the same result as calling singleFromTOF() on each value.
+   * @param tof :: the values to convert
+   * @param x :: output array of the same length; may be the same as tof
+   * @param count :: the number of values
+   */
+  virtual void valuesFromTOF(const double *tof, double *x, const size_t count) const;
+
   /// @return true if the unit was initialized and so can use singleToTOF()
   bool isInitialized() const { return initialized; }
 
@@ -290,6 +307,8 @@ public:
   void init() override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   Unit *clone() const override;
   ///@return -DBL_MAX as ToF convertible to TOF for in any time range
   double conversionTOFMin() const override;
@@ -307,6 +326,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -336,6 +357,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -361,6 +384,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -387,6 +412,8 @@ public:
   const UnitLabel label() const override;
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -415,6 +442,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -442,6 +471,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -464,6 +495,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
   double conversionTOFMax() const override;
@@ -482,6 +515,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
 
@@ -543,6 +578,8 @@ public:
 
   double singleToTOF(const double ki) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -571,6 +608,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
@@ -593,6 +632,8 @@ public:
 
   double singleToTOF(const double x) const override;
   double singleFromTOF(const double tof) const override;
+  void valuesToTOF(const double *x, double *tof, const size_t count) const override;
+  void valuesFromTOF(const double *tof, double *x, const size_t count) const override;
   void init() override;
   Unit *clone() const override;
   double conversionTOFMin() const override;
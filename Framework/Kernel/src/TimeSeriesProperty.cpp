@@ -22,8 +22,56 @@ namespace Kernel {
 namespace {
 /// static Logger definition
 Logger g_log("TimeSeriesProperty");
+
+/** Fill the integrals over time, in seconds, of the values of a sorted series
+ * from the first time to the time of each entry. Each value holds until the
+ * next time, and is taken relative to the first value to limit the rounding
+ * of the sums.
+ * @param values :: the sorted values, at least one
+ * @param integrals :: the integrals of the values
+ */
+template <typename TYPE>
+void makeTimeIntegrals(const std::vector<TimeValueUnit<TYPE>> &values, std::vector<double> &integrals) {
+  const auto first = static_cast<double>(values.front().value());
+  integrals.assign(values.size(), 0.0);
+  for (size_t i = 1; i < values.size(); ++i) {
+    const double value = static_cast<double>(values[i - 1].value()) - first;
+    const double duration = DateAndTime::secondsFromDuration(values[i].time() - values[i - 1].time());
+    integrals[i] = integrals[i - 1] + value * duration;
+  }
+}
+
+/** The integral made by makeTimeIntegrals() from the first time to any time.
+ * The first value also holds before the first time.
+ * @param values :: the sorted values
+ * @param integrals :: the integrals of the values at each entry
+ * @param time :: the end of the integral
+ * @return the integral of the values
+ */
+template <typename TYPE>
+double timeIntegralTo(const std::vector<TimeValueUnit<TYPE>> &values, const std::vector<double> &integrals,
+                      const DateAndTime &time) {
+  // The last entry at or before the time
+  const auto next = std::upper_bound(
+      values.cbegin(), values.cend(), time,
+      [](const DateAndTime &t, const TimeValueUnit<TYPE> &entry) { return t < entry.time(); });
+  const auto index =
+      next == values.cbegin() ? size_t{0} : static_cast<size_t>(std::distance(values.cbegin(), next)) - 1;
+  const double value = static_cast<double>(values[index].value()) - static_cast<double>(values.front().value());
+  return integrals[index] + value * DateAndTime::secondsFromDuration(time - values[index].time());
+}
 } // namespace
 
+/// Values waiting to be copied from a split property. Each range starts at an
+/// entry of the values and ends at the first entry after its stop time.
+template <typename TYPE> struct TimeSeriesProperty<TYPE>::DeferredSplit {
+  using Range = std::pair<size_t, DateAndTime>;
+  /// The sorted values of the split property, shared by all of its outputs
+  std::shared_ptr<const std::vector<TimeValueUnit<TYPE>>> values;
+  /// The index of the first entry and the stop time of each range
+  std::vector<Range> ranges;
+};
+
 /**
  * Constructor
  *  @param name :: The name to assign to the property
@@ -31,7 +79,7 @@ Logger g_log("TimeSeriesProperty");
 template <typename TYPE>
 TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name)
     : Property(name, typeid(std::vector<TimeValueUnit<TYPE>>)), m_values(), m_size(), m_propSortedFlag(),
-      m_filterApplied() {}
+      m_filterApplied(), m_hasDeferredSplit(false) {}
 
 /**
  * Constructor
@@ -47,6 +95,29 @@ TimeSeriesProperty<TYPE>::TimeSeriesProperty(const std::string &name,
   addValues(times, values);
 }
 
+/**
+ * Copy constructor. The values and time integrals are copied under the locks
+ * of the other property, as another thread may be adding a deferred split to
+ * them or building them. A deferred split is shared with the copy.
+ * @param other :: the property to copy
+ */
+template <typename TYPE>
+TimeSeriesProperty<TYPE>::TimeSeriesProperty(const TimeSeriesProperty<TYPE> &other)
+    : Property(other), ITimeSeriesProperty(other), m_size(), m_propSortedFlag(), m_filterApplied(),
+      m_hasDeferredSplit(false) {
+  std::lock_guard<std::mutex> splitLock(other.m_deferredSplitMutex);
+  m_values = other.m_values;
+  m_size = other.m_size;
+  m_propSortedFlag = other.m_propSortedFlag;
+  m_filter = other.m_filter;
+  m_filterQuickRef = other.m_filterQuickRef;
+  m_filterApplied = other.m_filterApplied;
+  m_deferredSplit = other.m_deferredSplit;
+  m_hasDeferredSplit = m_deferredSplit != nullptr;
+  std::lock_guard<std::mutex> integralsLock(other.m_timeIntegralsMutex);
+  m_timeIntegrals = other.m_timeIntegrals;
+}
+
 /// Virtual destructor
 template <typename TYPE> TimeSeriesProperty<TYPE>::~TimeSeriesProperty() {}
 
@@ -85,6 +156,7 @@ template <typename TYPE> Property *TimeSeriesProperty<TYPE>::cloneWithTimeShift(
  *
  */
 template <typename TYPE> std::unique_ptr<TimeSeriesProperty<double>> TimeSeriesProperty<TYPE>::getDerivative() const {
+  applyDeferredSplit();
 
   if (this->m_values.size() < 2) {
     throw std::runtime_error("Derivative is not defined for a time-series "
@@ -121,8 +193,12 @@ template <> std::unique_ptr<TimeSeriesProperty<double>> TimeSeriesProperty<std::
  * Return the memory used by the property, in bytes
  * */
 template <typename TYPE> size_t TimeSeriesProperty<TYPE>::getMemorySize() const {
-  // Rough estimate
-  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime));
+  // Rough estimate. The values of a deferred split are shared with the split
+  // property, so only the ranges are counted.
+  std::lock_guard<std::mutex> splitLock(m_deferredSplitMutex);
+  std::lock_guard<std::mutex> integralsLock(m_timeIntegralsMutex);
+  return m_values.size() * (sizeof(TYPE) + sizeof(DateAndTime)) + m_timeIntegrals.capacity() * sizeof(double) +
+         (m_deferredSplit ? m_deferredSplit->ranges.size() * sizeof(typename DeferredSplit::Range) : 0);
 }
 
 /**
@@ -140,12 +216,15 @@ template <typename TYPE> TimeSeriesProperty<TYPE> &TimeSeriesProperty<TYPE>::mer
  * @return the sum
  */
 template <typename TYPE> TimeSeriesProperty<TYPE> &TimeSeriesProperty<TYPE>::operator+=(Property const *right) {
+  applyDeferredSplit();
   auto const *rhs = dynamic_cast<TimeSeriesProperty<TYPE> const *>(right);
 
   if (rhs) {
+    rhs->applyDeferredSplit();
     if (this->operator!=(*rhs)) {
       m_values.insert(m_values.end(), rhs->m_values.begin(), rhs->m_values.end());
       m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+      clearTimeIntegrals();
     } else {
       // Do nothing if appending yourself to yourself. The net result would be
       // the same anyway
@@ -170,6 +249,7 @@ template <typename TYPE> TimeSeriesProperty<TYPE> &TimeSeriesProperty<TYPE>::ope
  */
 template <typename TYPE> bool TimeSeriesProperty<TYPE>::operator==(const TimeSeriesProperty<TYPE> &right) const {
   sortIfNecessary();
+  right.applyDeferredSplit();
 
   if (this->name() != right.name()) // should this be done?
   {
@@ -259,6 +339,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::setName(const std::strin
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &start,
                                             const Types::Core::DateAndTime &stop) {
+  applyDeferredSplit();
   // 0. Sort
   sortIfNecessary();
 
@@ -307,6 +388,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
 
   // 4. Make size consistent
   m_size = static_cast<int>(m_values.size());
+  clearTimeIntegrals();
 }
 
 /**
@@ -316,6 +398,7 @@ void TimeSeriesProperty<TYPE>::filterByTime(const Types::Core::DateAndTime &star
  */
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval> &splittervec) {
+  applyDeferredSplit();
   // 1. Sort
   sortIfNecessary();
 
@@ -380,6 +463,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
   mp_copy.clear();
 
   m_size = static_cast<int>(m_values.size());
+  clearTimeIntegrals();
 }
 
 /**
@@ -399,6 +483,7 @@ void TimeSeriesProperty<TYPE>::filterByTimes(const std::vector<SplittingInterval
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &splitter, std::vector<Property *> outputs,
                                            bool isPeriodic) const {
+  applyDeferredSplit();
   // 0. Sort if necessary
   sortIfNecessary();
 
@@ -413,6 +498,7 @@ void TimeSeriesProperty<TYPE>::splitByTime(std::vector<SplittingInterval> &split
     auto *myOutput = dynamic_cast<TimeSeriesProperty<TYPE> *>(outputs[i]);
     if (myOutput) {
       outputs_tsp.emplace_back(myOutput);
+      myOutput->clearTimeIntegrals();
       if (this->m_values.size() == 1) {
         // Special case for TSP with a single entry = just copy.
         myOutput->m_values = this->m_values;
@@ -517,6 +603,7 @@ template <typename TYPE>
 void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime> &timeToFilterTo,
                                                  const std::vector<int> &inputWorkspaceIndicies,
                                                  const std::vector<TimeSeriesProperty *> &output) {
+  applyDeferredSplit();
 
   // check inputs
   if (timeToFilterTo.size() != inputWorkspaceIndicies.size() + 1) {
@@ -617,6 +704,80 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
   }
 }
 
+/** Split this property as splitByTimeVector() does, without copying any value
+ * into the outputs. The outputs share one copy of this property's values and
+ * only take theirs when they are first used, so the logs that are never read
+ * after a split cost a range per splitter rather than a copy of their entries.
+ * @param timeToFilterTo :: the boundaries of the splitters
+ * @param inputWorkspaceIndicies :: the output of each splitter
+ * @param output :: the properties to split into. They are not cleared.
+ * @throw std::runtime_error if there is not one more time than targets
+ * @throw std::out_of_range if a target has no output
+ */
+template <typename TYPE>
+void TimeSeriesProperty<TYPE>::splitByTimeVectorDeferred(const std::vector<DateAndTime> &timeToFilterTo,
+                                                         const std::vector<int> &inputWorkspaceIndicies,
+                                                         const std::vector<TimeSeriesProperty *> &output) const {
+  if (timeToFilterTo.size() != inputWorkspaceIndicies.size() + 1) {
+    throw std::runtime_error("Input time vector's size does not match(one more larger than) target "
+                             "workspace index vector's size inputWorkspaceIndicies.size() \n");
+  }
+  if (output.empty() || realSize() == 0)
+    return;
+  for (const int index : inputWorkspaceIndicies) {
+    if (index < 0 || static_cast<size_t>(index) >= output.size())
+      throw std::out_of_range("TimeSeriesProperty::splitByTimeVectorDeferred: no output for target " +
+                              std::to_string(index));
+  }
+
+  sortIfNecessary();
+
+  // The first splitter is the one holding the first entry
+  auto firstSplitter = std::lower_bound(timeToFilterTo.cbegin(), timeToFilterTo.cend(), m_values.front().time());
+  if (firstSplitter == timeToFilterTo.cend())
+    return;
+  if (firstSplitter != timeToFilterTo.cbegin())
+    --firstSplitter;
+  if (m_values.back().time() < *firstSplitter) {
+    // All the splitters are after the last entry
+    for (auto &i : output)
+      i->addValue(m_values.back().time(), m_values.back().value());
+    return;
+  }
+
+  // Each splitter starts at the last entry before its start time, or at it
+  // for all but the first splitter
+  auto values = std::make_shared<const std::vector<TimeValueUnit<TYPE>>>(m_values);
+  std::vector<std::vector<typename DeferredSplit::Range>> ranges(output.size());
+  const auto firstIndex = static_cast<size_t>(std::distance(timeToFilterTo.cbegin(), firstSplitter));
+  const auto isBefore = [](const TimeValueUnit<TYPE> &entry, const DateAndTime &time) { return entry.time() < time; };
+  const auto isAfter = [](const DateAndTime &time, const TimeValueUnit<TYPE> &entry) { return time < entry.time(); };
+  for (size_t i = firstIndex; i < inputWorkspaceIndicies.size(); ++i) {
+    auto entry = i == firstIndex ? std::lower_bound(values->cbegin(), values->cend(), timeToFilterTo[i], isBefore)
+                                 : std::upper_bound(values->cbegin(), values->cend(), timeToFilterTo[i], isAfter);
+    if (entry != values->cbegin())
+      --entry;
+    ranges[inputWorkspaceIndicies[i]].emplace_back(std::distance(values->cbegin(), entry), timeToFilterTo[i + 1]);
+  }
+
+  for (size_t i = 0; i < output.size(); ++i) {
+    // Keep what the output holds before the split
+    output[i]->applyDeferredSplit();
+    if (!ranges[i].empty()) {
+      auto split = std::make_shared<DeferredSplit>();
+      split->values = values;
+      split->ranges = std::move(ranges[i]);
+      std::lock_guard<std::mutex> lock(output[i]->m_deferredSplitMutex);
+      output[i]->m_deferredSplit = std::move(split);
+      output[i]->m_hasDeferredSplit = true;
+    } else if (output[i]->size() == 0) {
+      std::stringstream errss;
+      errss << "entry " << m_name << " has 0 size, whose first entry is at " << this->firstTime().toSimpleString();
+      g_log.warning(errss.str());
+    }
+  }
+}
+
 // The makeFilterByValue & expandFilterToRange methods generate a bunch of
 // warnings when the template type is the wider integer types
 // (when it's being assigned back to a double such as in a call to minValue or
@@ -649,6 +810,7 @@ void TimeSeriesProperty<TYPE>::splitByTimeVector(const std::vector<DateAndTime>
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::makeFilterByValue(std::vector<SplittingInterval> &split, double min, double max,
                                                  double TimeTolerance, bool centre) const {
+  applyDeferredSplit();
   const bool emptyMin = (min == EMPTY_DBL());
   const bool emptyMax = (max == EMPTY_DBL());
 
@@ -748,6 +910,7 @@ void TimeSeriesProperty<std::string>::makeFilterByValue(std::vector<SplittingInt
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::expandFilterToRange(std::vector<SplittingInterval> &split, double min, double max,
                                                    const TimeInterval &range) const {
+  applyDeferredSplit();
   const bool emptyMin = (min == EMPTY_DBL());
   const bool emptyMax = (max == EMPTY_DBL());
 
@@ -802,6 +965,7 @@ void TimeSeriesProperty<std::string>::expandFilterToRange(std::vector<SplittingI
  *  @return The time-weighted average value of the log.
  */
 template <typename TYPE> double TimeSeriesProperty<TYPE>::timeAverageValue() const {
+  applyDeferredSplit();
   double retVal = 0.0;
   try {
     const auto &filter = getSplittingIntervals();
@@ -815,12 +979,15 @@ template <typename TYPE> double TimeSeriesProperty<TYPE>::timeAverageValue() con
 
 /** Calculates the time-weighted average of a property in a filtered range.
  *  This is written for that case of logs whose values start at the times given.
+ *  The integrals of the values over time are kept between calls, so each range
+ *  of the filter costs O(log n).
  *  @param filter The splitter/filter restricting the range of values included
  *  @return The time-weighted average value of the log in the range within the
  * filter.
  */
 template <typename TYPE>
 double TimeSeriesProperty<TYPE>::averageValueInFilter(const std::vector<SplittingInterval> &filter) const {
+  applyDeferredSplit();
   // TODO: Consider logs that aren't giving starting values.
 
   // First of all, if the log or the filter is empty, return NaN
@@ -833,32 +1000,19 @@ double TimeSeriesProperty<TYPE>::averageValueInFilter(const std::vector<Splittin
     return static_cast<double>(m_values.front().value());
   }
 
-  sortIfNecessary();
+  const auto &integrals = timeIntegrals();
 
   double numerator(0.0), totalTime(0.0);
   // Loop through the filter ranges
   for (const auto &time : filter) {
     // Calculate the total time duration (in seconds) within by the filter
     totalTime += time.duration();
-
-    // Get the log value and index at the start time of the filter
-    int index;
-    double value = getSingleValue(time.start(), index);
-    DateAndTime startTime = time.start();
-
-    while (index < realSize() - 1 && m_values[index + 1].time() < time.stop()) {
-      ++index;
-      numerator += DateAndTime::secondsFromDuration(m_values[index].time() - startTime) * value;
-      startTime = m_values[index].time();
-      value = static_cast<double>(m_values[index].value());
-    }
-
-    // Now close off with the end of the current filter range
-    numerator += DateAndTime::secondsFromDuration(time.stop() - startTime) * value;
+    numerator += timeIntegralTo(m_values, integrals, time.stop()) - timeIntegralTo(m_values, integrals, time.start());
   }
 
-  // 'Normalise' by the total time
-  return numerator / totalTime;
+  // 'Normalise' by the total time. The integrals are relative to the first
+  // value.
+  return static_cast<double>(m_values.front().value()) + numerator / totalTime;
 }
 
 /** Function specialization for TimeSeriesProperty<std::string>
@@ -871,6 +1025,7 @@ template <> double TimeSeriesProperty<std::string>::averageValueInFilter(const T
 }
 
 template <typename TYPE> std::pair<double, double> TimeSeriesProperty<TYPE>::timeAverageValueAndStdDev() const {
+  applyDeferredSplit();
   std::pair<double, double> retVal{0., 0.}; // mean and stddev
   try {
     const auto &filter = getSplittingIntervals();
@@ -885,6 +1040,7 @@ template <typename TYPE> std::pair<double, double> TimeSeriesProperty<TYPE>::tim
 template <typename TYPE>
 std::pair<double, double>
 TimeSeriesProperty<TYPE>::averageAndStdDevInFilter(const std::vector<SplittingInterval> &filter) const {
+  applyDeferredSplit();
   // the mean to calculate the standard deviation about
   // this will sort the log as necessary as well
   const double mean = this->averageValueInFilter(filter);
@@ -950,6 +1106,7 @@ TimeSeriesProperty<std::string>::averageAndStdDevInFilter(const TimeSplitterType
  * @return time series property values as map
  */
 template <typename TYPE> std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::valueAsCorrectMap() const {
+  applyDeferredSplit();
   // 1. Sort if necessary
   sortIfNecessary();
 
@@ -969,6 +1126,7 @@ template <typename TYPE> std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::v
  *  @return the time series's values as a vector<TYPE>
  */
 template <typename TYPE> std::vector<TYPE> TimeSeriesProperty<TYPE>::valuesAsVector() const {
+  applyDeferredSplit();
   sortIfNecessary();
 
   std::vector<TYPE> out;
@@ -987,6 +1145,7 @@ template <typename TYPE> std::vector<TYPE> TimeSeriesProperty<TYPE>::valuesAsVec
  * can be recorded against the same time stamp but all must be present.
  */
 template <typename TYPE> std::multimap<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::valueAsMultiMap() const {
+  applyDeferredSplit();
   std::multimap<DateAndTime, TYPE> asMultiMap;
 
   if (!m_values.empty()) {
@@ -1002,6 +1161,7 @@ template <typename TYPE> std::multimap<DateAndTime, TYPE> TimeSeriesProperty<TYP
  * @return A vector of DateAndTime objects
  */
 template <typename TYPE> std::vector<DateAndTime> TimeSeriesProperty<TYPE>::timesAsVector() const {
+  applyDeferredSplit();
   sortIfNecessary();
 
   std::vector<DateAndTime> out;
@@ -1019,6 +1179,7 @@ template <typename TYPE> std::vector<DateAndTime> TimeSeriesProperty<TYPE>::time
  * @return A vector of DateAndTime objects
  */
 template <typename TYPE> std::vector<DateAndTime> TimeSeriesProperty<TYPE>::filteredTimesAsVector() const {
+  applyDeferredSplit();
   if (m_filter.empty()) {
     return this->timesAsVector(); // no filtering to do
   }
@@ -1043,6 +1204,7 @@ template <typename TYPE> std::vector<DateAndTime> TimeSeriesProperty<TYPE>::filt
  * seconds since the start.
  */
 template <typename TYPE> std::vector<double> TimeSeriesProperty<TYPE>::timesAsVectorSeconds() const {
+  applyDeferredSplit();
   // 1. Sort if necessary
   sortIfNecessary();
 
@@ -1065,6 +1227,7 @@ template <typename TYPE> std::vector<double> TimeSeriesProperty<TYPE>::timesAsVe
  */
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time, const TYPE value) {
+  applyDeferredSplit();
   TimeValueUnit<TYPE> newvalue(time, value);
   // Add the value to the back of the vector
   m_values.emplace_back(newvalue);
@@ -1086,6 +1249,7 @@ void TimeSeriesProperty<TYPE>::addValue(const Types::Core::DateAndTime &time, co
   }
 
   m_filterApplied = false;
+  clearTimeIntegrals();
 }
 
 /** Add a value to the map
@@ -1118,14 +1282,17 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::addValue(const std::time
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::addValues(const std::vector<Types::Core::DateAndTime> &times,
                                          const std::vector<TYPE> &values) {
+  applyDeferredSplit();
   size_t length = std::min(times.size(), values.size());
   m_size += static_cast<int>(length);
   for (size_t i = 0; i < length; ++i) {
     m_values.emplace_back(times[i], values[i]);
   }
 
-  if (!values.empty())
+  if (!values.empty()) {
     m_propSortedFlag = TimeSeriesSortStatus::TSUNKNOWN;
+    clearTimeIntegrals();
+  }
 }
 
 /** replace vectors of values to the map. First we clear the vectors
@@ -1145,6 +1312,7 @@ void TimeSeriesProperty<TYPE>::replaceValues(const std::vector<Types::Core::Date
  * @return Value
  */
 template <typename TYPE> DateAndTime TimeSeriesProperty<TYPE>::lastTime() const {
+  applyDeferredSplit();
   if (m_values.empty()) {
     const std::string error("lastTime(): TimeSeriesProperty '" + name() + "' is empty");
     g_log.debug(error);
@@ -1160,6 +1328,7 @@ template <typename TYPE> DateAndTime TimeSeriesProperty<TYPE>::lastTime() const
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
+  applyDeferredSplit();
   if (m_values.empty()) {
     const std::string error("firstValue(): TimeSeriesProperty '" + name() + "' is empty");
     g_log.debug(error);
@@ -1175,6 +1344,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::firstValue() const {
  *  @return Value
  */
 template <typename TYPE> DateAndTime TimeSeriesProperty<TYPE>::firstTime() const {
+  applyDeferredSplit();
   if (m_values.empty()) {
     const std::string error("firstTime(): TimeSeriesProperty '" + name() + "' is empty");
     g_log.debug(error);
@@ -1191,6 +1361,7 @@ template <typename TYPE> DateAndTime TimeSeriesProperty<TYPE>::firstTime() const
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
+  applyDeferredSplit();
   if (m_values.empty()) {
     const std::string error("lastValue(): TimeSeriesProperty '" + name() + "' is empty");
     g_log.debug(error);
@@ -1203,10 +1374,12 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::lastValue() const {
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::minValue() const {
+  applyDeferredSplit();
   return std::min_element(m_values.begin(), m_values.end(), TimeValueUnit<TYPE>::valueCmp)->value();
 }
 
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::maxValue() const {
+  applyDeferredSplit();
   return std::max_element(m_values.begin(), m_values.end(), TimeValueUnit<TYPE>::valueCmp)->value();
 }
 
@@ -1218,19 +1391,26 @@ template <typename TYPE> double TimeSeriesProperty<TYPE>::mean() const {
 
 /// Returns the number of values at UNIQUE time intervals in the time series
 /// @returns The number of unique time interfaces
-template <typename TYPE> int TimeSeriesProperty<TYPE>::size() const { return m_size; }
+template <typename TYPE> int TimeSeriesProperty<TYPE>::size() const {
+  applyDeferredSplit();
+  return m_size;
+}
 
 /**
  * Returns the real size of the time series property map:
  * the number of entries, including repeated ones.
  */
-template <typename TYPE> int TimeSeriesProperty<TYPE>::realSize() const { return static_cast<int>(m_values.size()); }
+template <typename TYPE> int TimeSeriesProperty<TYPE>::realSize() const {
+  applyDeferredSplit();
+  return static_cast<int>(m_values.size());
+}
 
 /*
  * Get the time series property as a string of 'time  value'
  * @return time series property as a string
  */
 template <typename TYPE> std::string TimeSeriesProperty<TYPE>::value() const {
+  applyDeferredSplit();
   sortIfNecessary();
 
   std::stringstream ins;
@@ -1254,6 +1434,7 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::value() const {
  * @return time series property values as a string vector "<time_t> value"
  */
 template <typename TYPE> std::vector<std::string> TimeSeriesProperty<TYPE>::time_tValue() const {
+  applyDeferredSplit();
   sortIfNecessary();
 
   std::vector<std::string> values;
@@ -1276,6 +1457,7 @@ template <typename TYPE> std::vector<std::string> TimeSeriesProperty<TYPE>::time
  * @return time series property values as map
  */
 template <typename TYPE> std::map<DateAndTime, TYPE> TimeSeriesProperty<TYPE>::valueAsMap() const {
+  applyDeferredSplit();
   // 1. Sort if necessary
   sortIfNecessary();
 
@@ -1336,9 +1518,15 @@ std::string TimeSeriesProperty<TYPE>::setDataItem(const std::shared_ptr<DataItem
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
   m_size = 0;
   m_values.clear();
+  {
+    std::lock_guard<std::mutex> lock(m_deferredSplitMutex);
+    m_deferredSplit.reset();
+    m_hasDeferredSplit = false;
+  }
 
   m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
   m_filterApplied = false;
+  clearTimeIntegrals();
 }
 
 /** Clears out all but the last value in the property.
@@ -1349,6 +1537,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clear() {
  * requirement.
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearOutdated() {
+  applyDeferredSplit();
   if (realSize() > 1) {
     auto lastValue = m_values.back();
     clear();
@@ -1419,6 +1608,7 @@ void TimeSeriesProperty<TYPE>::create(const std::vector<Types::Core::DateAndTime
  *  @return Value at time \a t
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t) const {
+  applyDeferredSplit();
   if (m_values.empty()) {
     const std::string error("getSingleValue(): TimeSeriesProperty '" + name() + "' is empty");
     g_log.debug(error);
@@ -1466,6 +1656,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Typ
  */
 template <typename TYPE>
 TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t, int &index) const {
+  applyDeferredSplit();
   if (m_values.empty()) {
     const std::string error("getSingleValue(): TimeSeriesProperty '" + name() + "' is empty");
     g_log.debug(error);
@@ -1519,6 +1710,7 @@ TYPE TimeSeriesProperty<TYPE>::getSingleValue(const Types::Core::DateAndTime &t,
  *  @return n-th time interval
  */
 template <typename TYPE> TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int n) const {
+  applyDeferredSplit();
   // 0. Throw exception
   if (m_values.empty()) {
     const std::string error("nthInterval(): TimeSeriesProperty '" + name() + "' is empty");
@@ -1630,6 +1822,7 @@ template <typename TYPE> TimeInterval TimeSeriesProperty<TYPE>::nthInterval(int
  *  @return Value
  */
 template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
+  applyDeferredSplit();
   TYPE value;
 
   // 1. Throw error if property is empty
@@ -1683,6 +1876,7 @@ template <typename TYPE> TYPE TimeSeriesProperty<TYPE>::nthValue(int n) const {
  *  @return DateAndTime
  */
 template <typename TYPE> Types::Core::DateAndTime TimeSeriesProperty<TYPE>::nthTime(int n) const {
+  applyDeferredSplit();
   sortIfNecessary();
 
   if (m_values.empty()) {
@@ -1715,6 +1909,7 @@ template <typename TYPE> Types::Core::DateAndTime TimeSeriesProperty<TYPE>::nthT
    @param filter :: The filter mask to apply
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::filterWith(const TimeSeriesProperty<bool> *filter) {
+  applyDeferredSplit();
   // 1. Clear the current
   m_filter.clear();
   m_filterQuickRef.clear();
@@ -1784,6 +1979,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::filterWith(const TimeSer
  * Restores the property to the unsorted & unfiltered state
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::clearFilter() {
+  applyDeferredSplit();
   m_filter.clear();
   m_filterQuickRef.clear();
 }
@@ -1792,6 +1988,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::clearFilter() {
  * Updates size()
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::countSize() const {
+  applyDeferredSplit();
   if (m_filter.empty()) {
     // 1. Not filter
     m_size = int(m_values.size());
@@ -1848,6 +2045,7 @@ template <typename TYPE> bool TimeSeriesProperty<TYPE>::isDefault() const { retu
  * N.B. This method DOES take filtering into account
  */
 template <typename TYPE> TimeSeriesPropertyStatistics TimeSeriesProperty<TYPE>::getStatistics() const {
+  applyDeferredSplit();
   TimeSeriesPropertyStatistics out;
   Mantid::Kernel::Statistics raw_stats = Mantid::Kernel::getStatistics(this->filteredValuesAsVector());
   out.mean = raw_stats.mean;
@@ -1878,6 +2076,7 @@ template <typename TYPE> TimeSeriesPropertyStatistics TimeSeriesProperty<TYPE>::
  * If there is any, keep one of them
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
+  applyDeferredSplit();
   // 1. Sort if necessary
   sortIfNecessary();
 
@@ -1907,6 +2106,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
 
   // update m_size
   countSize();
+  clearTimeIntegrals();
 
   // 3. Finish
   g_log.warning() << "Log " << this->name() << " has " << numremoved << " entries removed due to duplicated time. "
@@ -1917,6 +2117,7 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::eliminateDuplicates() {
  * Print the content to string
  */
 template <typename TYPE> std::string TimeSeriesProperty<TYPE>::toString() const {
+  applyDeferredSplit();
   std::stringstream ss;
   for (size_t i = 0; i < m_values.size(); ++i)
     ss << m_values[i].time() << "\t\t" << m_values[i].value() << "\n";
@@ -1934,6 +2135,7 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::toString() const
  * sorted.
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::sortIfNecessary() const {
+  applyDeferredSplit();
   if (m_propSortedFlag == TimeSeriesSortStatus::TSUNKNOWN) {
     bool sorted = is_sorted(m_values.begin(), m_values.end());
     if (sorted)
@@ -1946,9 +2148,80 @@ template <typename TYPE> void TimeSeriesProperty<TYPE>::sortIfNecessary() const
     g_log.information("TimeSeriesProperty is not sorted.  Sorting is operated on it. ");
     std::stable_sort(m_values.begin(), m_values.end());
     m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+    clearTimeIntegrals();
   }
 }
 
+/// Drop the time integrals of the values, to be rebuilt when next needed
+template <typename TYPE> void TimeSeriesProperty<TYPE>::clearTimeIntegrals() const {
+  std::lock_guard<std::mutex> lock(m_timeIntegralsMutex);
+  m_timeIntegrals.clear();
+}
+
+/** The integrals of the values made by makeTimeIntegrals(), built when first
+ * needed. Several threads may read the averages of a log at once, so the
+ * integrals are built under a lock.
+ * @return the integrals, which stay valid until the values change
+ */
+template <typename TYPE> const std::vector<double> &TimeSeriesProperty<TYPE>::timeIntegrals() const {
+  sortIfNecessary();
+  std::lock_guard<std::mutex> lock(m_timeIntegralsMutex);
+  if (m_timeIntegrals.size() != m_values.size())
+    makeTimeIntegrals(m_values, m_timeIntegrals);
+  return m_timeIntegrals;
+}
+
+/** Function specialization for TimeSeriesProperty<std::string>
+ *  @throws Kernel::Exception::NotImplementedError always
+ */
+template <> const std::vector<double> &TimeSeriesProperty<std::string>::timeIntegrals() const {
+  throw Exception::NotImplementedError("TimeSeriesProperty::"
+                                       "timeIntegrals is not "
+                                       "implemented for string properties");
+}
+
+/** Add the values of a deferred split, as splitByTimeVector() adds them: the
+ * entries of each range that are after the last time already in the property.
+ * Every method reading the values calls this first. Const readers may call it
+ * from several threads at once, so the split is applied by one of them under
+ * a lock while the others wait, and nothing here may call back into a method
+ * that applies it.
+ */
+template <typename TYPE> void TimeSeriesProperty<TYPE>::applyDeferredSplit() const {
+  if (!m_hasDeferredSplit.load(std::memory_order_acquire))
+    return;
+  std::lock_guard<std::mutex> lock(m_deferredSplitMutex);
+  // Another thread may have applied it while this one waited
+  if (!m_deferredSplit)
+    return;
+
+  const auto &values = *m_deferredSplit->values;
+  // The last time so far, which lastTime() would give
+  DateAndTime last = DateAndTime::minimum();
+  for (const auto &entry : m_values)
+    last = std::max(last, entry.time());
+  for (const auto &range : m_deferredSplit->ranges) {
+    for (size_t i = range.first; i < values.size(); ++i) {
+      const DateAndTime time = values[i].time();
+      // avoid to add duplicate entry
+      if (m_size == 0 || last < time) {
+        m_values.emplace_back(values[i]);
+        last = time;
+        if (++m_size == 1)
+          m_propSortedFlag = TimeSeriesSortStatus::TSSORTED;
+        else if (m_values.back() < *(m_values.rbegin() + 1))
+          m_propSortedFlag = TimeSeriesSortStatus::TSUNSORTED;
+      }
+      if (time > range.second)
+        break;
+    }
+  }
+  m_filterApplied = false;
+  clearTimeIntegrals();
+  m_deferredSplit.reset();
+  m_hasDeferredSplit.store(false, std::memory_order_release);
+}
+
 /** Find the index of the entry of time t in the mP vector (sorted)
  *  Return @ if t is within log.begin and log.end, then the index of the log
  * equal or just smaller than t
@@ -2034,6 +2307,7 @@ int TimeSeriesProperty<TYPE>::upperBound(Types::Core::DateAndTime t, int istart,
  *altered
  */
 template <typename TYPE> void TimeSeriesProperty<TYPE>::applyFilter() const {
+  applyDeferredSplit();
   // 1. Check and reset
   if (m_filterApplied)
     return;
@@ -2155,14 +2429,21 @@ template <typename TYPE> size_t TimeSeriesProperty<TYPE>::findNthIndexFromQuickR
     // 2A.  Out side of boundary
     index = m_filterQuickRef.size();
   } else {
-    // 2B. Inside
-    for (size_t i = 0; i < m_filterQuickRef.size(); i += 4) {
-      if (static_cast<size_t>(n) >= m_filterQuickRef[i].second &&
-          static_cast<size_t>(n) < m_filterQuickRef[i + 3].second) {
-        index = i;
-        break;
-      }
+    // 2B. Inside. The regions are groups of four entries whose counts of
+    // intervals never decrease, so the first region ending after n is found
+    // by bisection.
+    const size_t numRegions = m_filterQuickRef.size() / 4;
+    size_t first = 0;
+    size_t last = numRegions;
+    while (first < last) {
+      const size_t middle = first + (last - first) / 2;
+      if (m_filterQuickRef[4 * middle + 3].second <= static_cast<size_t>(n))
+        first = middle + 1;
+      else
+        last = middle;
     }
+    if (first < numRegions && static_cast<size_t>(n) >= m_filterQuickRef[4 * first].second)
+      index = 4 * first;
   }
 
   return index;
@@ -2180,12 +2461,20 @@ template <typename TYPE> std::string TimeSeriesProperty<TYPE>::setValueFromPrope
   if (!prop) {
     return "Could not set value: properties have different type.";
   }
-  m_values = prop->m_values;
-  m_size = prop->m_size;
-  m_propSortedFlag = prop->m_propSortedFlag;
-  m_filter = prop->m_filter;
-  m_filterQuickRef = prop->m_filterQuickRef;
-  m_filterApplied = prop->m_filterApplied;
+  if (prop == this)
+    return "";
+  {
+    std::scoped_lock lock(prop->m_deferredSplitMutex, m_deferredSplitMutex);
+    m_values = prop->m_values;
+    m_size = prop->m_size;
+    m_propSortedFlag = prop->m_propSortedFlag;
+    m_filter = prop->m_filter;
+    m_filterQuickRef = prop->m_filterQuickRef;
+    m_filterApplied = prop->m_filterApplied;
+    m_deferredSplit = prop->m_deferredSplit;
+    m_hasDeferredSplit = m_deferredSplit != nullptr;
+  }
+  clearTimeIntegrals();
   return "";
 }
 
@@ -2251,6 +2540,7 @@ template <> void TimeSeriesProperty<bool>::saveProperty(::NeXus::File *file) {
 }
 
 template <typename TYPE> void TimeSeriesProperty<TYPE>::saveProperty(::NeXus::File *file) {
+  applyDeferredSplit();
   auto value = this->valuesAsVector();
   if (value.empty())
     return;
@@ -2282,6 +2572,7 @@ template <typename TYPE> Json::Value TimeSeriesProperty<TYPE>::valueAsJson() con
 template <typename TYPE>
 void TimeSeriesProperty<TYPE>::histogramData(const Types::Core::DateAndTime &tMin, const Types::Core::DateAndTime &tMax,
                                              std::vector<double> &counts) const {
+  applyDeferredSplit();
 
   size_t nPoints = counts.size();
   if (nPoints == 0)
@@ -2321,6 +2612,7 @@ void TimeSeriesProperty<std::string>::histogramData(const Types::Core::DateAndTi
  * @returns :: Vector of included values only
  */
 template <typename TYPE> std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredValuesAsVector() const {
+  applyDeferredSplit();
   if (m_filter.empty()) {
     return this->valuesAsVector(); // no filtering to do
   }
@@ -2349,6 +2641,7 @@ template <typename TYPE> std::vector<TYPE> TimeSeriesProperty<TYPE>::filteredVal
  * excludes it.
  */
 template <typename TYPE> bool TimeSeriesProperty<TYPE>::isTimeFiltered(const Types::Core::DateAndTime &time) const {
+  applyDeferredSplit();
   // Each time/value pair in the filter defines a point where the region defined
   // after that time is either included/excluded depending on the boolean value.
   // By definition of the filter construction the region before a given filter
@@ -2379,6 +2672,7 @@ template <typename TYPE> bool TimeSeriesProperty<TYPE>::isTimeFiltered(const Typ
  * @returns :: Vector of splitting intervals
  */
 template <typename TYPE> std::vector<SplittingInterval> TimeSeriesProperty<TYPE>::getSplittingIntervals() const {
+  applyDeferredSplit();
   std::vector<SplittingInterval> intervals;
   // Case where there is no filter
   if (m_filter.empty()) {
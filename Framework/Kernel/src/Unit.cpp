@@ -12,6 +12,7 @@
 #include "MantidKernel/PhysicalConstants.h"
 #include "MantidKernel/UnitFactory.h"
 #include "MantidKernel/UnitLabelTypes.h"
+#include <algorithm>
 #include <cfloat>
 #include <limits>
 #include <sstream>
@@ -34,6 +35,22 @@ bool ParamPresentAndSet(const UnitParametersMap *params, UnitParams param, doubl
     return false;
   }
 }
+
+/// Convert an array to TOF with a non-virtual call to the singleToTOF() of the
+/// concrete unit, which lets the compiler inline the conversion into the loop
+template <class UnitType>
+void convertValuesToTOF(const UnitType &unit, const double *x, double *tof, const size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = unit.UnitType::singleToTOF(x[i]);
+}
+
+/// Convert an array from TOF with a non-virtual call to the singleFromTOF() of
+/// the concrete unit
+template <class UnitType>
+void convertValuesFromTOF(const UnitType &unit, const double *tof, double *x, const size_t count) {
+  for (size_t i = 0; i < count; ++i)
+    x[i] = unit.UnitType::singleFromTOF(tof[i]);
+}
 } // namespace
 
 /**
@@ -155,9 +172,7 @@ void Unit::toTOF(std::vector<double> &xdata, std::vector<double> &ydata, const d
                  const UnitParametersMap &params) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _emode, params);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleToTOF(xdata[i]);
+  this->valuesToTOF(xdata.data(), xdata.data(), xdata.size());
 }
 
 /** Convert a single value to TOF
@@ -185,9 +200,7 @@ void Unit::fromTOF(std::vector<double> &xdata, std::vector<double> &ydata, const
                    const UnitParametersMap &params) {
   UNUSED_ARG(ydata);
   this->initialize(_l1, _emode, params);
-  size_t numX = xdata.size();
-  for (size_t i = 0; i < numX; i++)
-    xdata[i] = this->singleFromTOF(xdata[i]);
+  this->valuesFromTOF(xdata.data(), xdata.data(), xdata.size());
 }
 
 /** Convert a single value from TOF
@@ -202,6 +215,16 @@ double Unit::convertSingleFromTOF(const double xvalue, const double &l1, const i
   return this->singleFromTOF(xvalue);
 }
 
+void Unit::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = this->singleToTOF(x[i]);
+}
+
+void Unit::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  for (size_t i = 0; i < count; ++i)
+    x[i] = this->singleFromTOF(tof[i]);
+}
+
 std::pair<double, double> Unit::conversionRange() const {
   double u1 = this->singleFromTOF(this->conversionTOFMin());
   double u2 = this->singleFromTOF(this->conversionTOFMax());
@@ -291,6 +314,16 @@ double TOF::singleFromTOF(const double tof) const {
   return tof;
 }
 
+void TOF::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  if (x != tof)
+    std::copy(x, x + count, tof);
+}
+
+void TOF::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  if (tof != x)
+    std::copy(tof, tof + count, x);
+}
+
 Unit *TOF::clone() const { return new TOF(*this); }
 double TOF::conversionTOFMin() const { return -DBL_MAX; }
 ///@return DBL_MAX as ToF convetanble to TOF for in any time range
@@ -398,6 +431,19 @@ double Wavelength::singleFromTOF(const double tof) const {
   x *= factorFrom;
   return x;
 }
+
+void Wavelength::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  // the energy mode is fixed for the whole array so keep it out of the loop
+  const double offset = (emode == 1 || emode == 2) ? sfpTo : 0.;
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = x[i] * factorTo + offset;
+}
+
+void Wavelength::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  const double offset = do_sfpFrom ? sfpFrom : 0.;
+  for (size_t i = 0; i < count; ++i)
+    x[i] = (tof[i] - offset) * factorFrom;
+}
 ///@return  Minimal time of flight, which can be reversively converted into
 /// wavelength
 double Wavelength::conversionTOFMin() const {
@@ -480,6 +526,14 @@ double Energy::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void Energy::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 Unit *Energy::clone() const { return new Energy(*this); }
 
 // ============================================================================================
@@ -547,6 +601,14 @@ double Energy_inWavenumber::singleFromTOF(const double tof) const {
   return factorFrom / (temp * temp);
 }
 
+void Energy_inWavenumber::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void Energy_inWavenumber::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 Unit *Energy_inWavenumber::clone() const { return new Energy_inWavenumber(*this); }
 
 // ==================================================================================================
@@ -696,6 +758,35 @@ double dSpacing::singleFromTOF(const double tof) const {
     return c / (0.5 * difc * (-1 - sqrt(sqrtTerm)));
 }
 
+void dSpacing::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  if (!isInitialized())
+    throw std::runtime_error("dSpacingBase::valuesToTOF called before object "
+                             "has been initialized.");
+  for (size_t i = 0; i < count; ++i)
+    tof[i] = difa * x[i] * x[i] + difc * x[i] + tzero;
+}
+
+void dSpacing::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  if (!isInitialized())
+    throw std::runtime_error("dSpacingBase::valuesFromTOF called before object "
+                             "has been initialized.");
+  if (!toDSpacingError.empty())
+    throw std::runtime_error(toDSpacingError);
+  if (difa != 0. || !(difc * difc > 0.)) {
+    convertValuesFromTOF(*this, tof, x, count);
+    return;
+  }
+  // Without DIFA the quadratic in singleFromTOF reduces to d = (TOF - T0) / DIFC.
+  // The root is computed the same way so the results are identical, including
+  // the infinite d-spacing returned for TOF < T0.
+  const double positiveRootDenominator = 0.5 * difc * (-1. + 1.);
+  const double negativeRootDenominator = 0.5 * difc * (-1. - 1.);
+  for (size_t i = 0; i < count; ++i) {
+    const double c = tzero - tof[i];
+    x[i] = (c == 0.) ? 0. : c / ((c > 0.) ? positiveRootDenominator : negativeRootDenominator);
+  }
+}
+
 double dSpacing::conversionTOFMin() const {
   // quadratic only has a min if difa is positive
   if (difa > 0) {
@@ -795,6 +886,15 @@ double dSpacingPerpendicular::singleFromTOF(const double tof) const {
   double temp = tof / factorFrom;
   return sqrt(temp * temp - sfpFrom);
 }
+
+void dSpacingPerpendicular::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void dSpacingPerpendicular::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 double dSpacingPerpendicular::conversionTOFMin() const { return sqrt(-1.0 * sfpFrom); }
 double dSpacingPerpendicular::conversionTOFMax() const { return sqrt(std::numeric_limits<double>::max()) / factorFrom; }
 
@@ -846,6 +946,14 @@ double MomentumTransfer::singleToTOF(const double x) const { return 2. * M_PI *
 //
 double MomentumTransfer::singleFromTOF(const double tof) const { return 2. * M_PI * difc / tof; }
 
+void MomentumTransfer::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void MomentumTransfer::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 double MomentumTransfer::conversionTOFMin() const { return 2. * M_PI * difc / DBL_MAX; }
 double MomentumTransfer::conversionTOFMax() const { return DBL_MAX; }
 
@@ -868,6 +976,14 @@ QSquared::QSquared() : MomentumTransfer() {
 double QSquared::singleToTOF(const double x) const { return MomentumTransfer::singleToTOF(sqrt(x)); }
 double QSquared::singleFromTOF(const double tof) const { return pow(MomentumTransfer::singleFromTOF(tof), 2); }
 
+void QSquared::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void QSquared::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 double QSquared::conversionTOFMin() const { return 2 * M_PI * difc / sqrt(DBL_MAX); }
 double QSquared::conversionTOFMax() const {
   double tofmax = 2 * M_PI * difc / sqrt(DBL_MIN);
@@ -995,6 +1111,14 @@ double DeltaE::singleFromTOF(const double tof) const {
     return DBL_MAX;
 }
 
+void DeltaE::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void DeltaE::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 double DeltaE::conversionTOFMin() const {
   double time(DBL_MAX); // impossible for elastic, this units do not work for elastic
   if (emode == 1 || emode == 2)
@@ -1184,6 +1308,14 @@ double Momentum::singleFromTOF(const double tof) const {
   return factorFrom / x;
 }
 
+void Momentum::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void Momentum::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 Unit *Momentum::clone() const { return new Momentum(*this); }
 
 // ============================================================================================
@@ -1234,6 +1366,14 @@ double SpinEchoLength::singleFromTOF(const double tof) const {
   return x;
 }
 
+void SpinEchoLength::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void SpinEchoLength::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 Unit *SpinEchoLength::clone() const { return new SpinEchoLength(*this); }
 
 // ============================================================================================
@@ -1278,6 +1418,14 @@ double SpinEchoTime::singleFromTOF(const double tof) const {
   return x;
 }
 
+void SpinEchoTime::valuesToTOF(const double *x, double *tof, const size_t count) const {
+  convertValuesToTOF(*this, x, tof, count);
+}
+
+void SpinEchoTime::valuesFromTOF(const double *tof, double *x, const size_t count) const {
+  convertValuesFromTOF(*this, tof, x, count);
+}
+
 Unit *SpinEchoTime::clone() const { return new SpinEchoTime(*this); }
 
 // ================================================================================
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "MantidKernel/Exception.h"
+#include "MantidKernel/MultiThreaded.h"
 #include "MantidKernel/PropertyWithValue.h"
 #include "MantidKernel/TimeSeriesProperty.h"
 #include "MantidKernel/TimeSplitter.h"
@@ -17,6 +18,7 @@
 #include <cmath>
 #include <json/value.h>
 #include <memory>
+#include <random>
 #include <vector>
 
 using namespace Mantid::Kernel;
@@ -642,6 +644,78 @@ public:
     delete intLog;
   }
 
+  void test_averageValueInFilter_matches_summing_over_the_entries() {
+    // An irregular log with repeated times, and a filter with ranges before,
+    // between and after its entries
+    TimeSeriesProperty<double> log("IrregularLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    double seconds = 0.;
+    for (int i = 0; i < 1000; ++i) {
+      seconds += (i % 7 == 3) ? 0. : 0.1 * (1 + i % 5);
+      log.addValue(start + seconds, std::sin(0.1 * i) + 100.);
+    }
+    TimeSplitterType filter;
+    filter.emplace_back(start - 10.0, start + 1.05);
+    for (int i = 0; i < 20; ++i)
+      filter.emplace_back(start + (7.3 * i + 2.0), start + (7.3 * i + 5.5));
+    filter.emplace_back(start + 290.0, start + 400.0);
+
+    const auto expected = averageAndStdDevOverEntries(log, filter);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), expected.first, 1e-9);
+    const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+    TS_ASSERT_DELTA(meanAndStdDev.first, expected.first, 1e-9);
+    TS_ASSERT_DELTA(meanAndStdDev.second, expected.second, 1e-9);
+
+    // The averages follow changes of the log
+    log.addValue(start + 350.0, 200.);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), averageAndStdDevOverEntries(log, filter).first, 1e-9);
+    log.filterByTime(start + 100.0, start + 500.0);
+    TS_ASSERT_DELTA(log.averageValueInFilter(filter), averageAndStdDevOverEntries(log, filter).first, 1e-9);
+  }
+
+  void test_averageAndStdDevInFilter_of_a_constant_log() {
+    TimeSeriesProperty<double> log("ConstantLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    for (int i = 0; i < 100; ++i)
+      log.addValue(start + static_cast<double>(i), 1.0e6 + 0.1);
+    TimeSplitterType filter{SplittingInterval(start + 10.5, start + 20.5)};
+    const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+    TS_ASSERT_EQUALS(meanAndStdDev.first, 1.0e6 + 0.1);
+    TS_ASSERT_EQUALS(meanAndStdDev.second, 0.0);
+  }
+
+  void test_averageAndStdDevInFilter_with_a_large_offset_from_the_first_value() {
+    // The values in the filter are far from the first one and spread little
+    TimeSeriesProperty<double> log("OffsetLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    log.addValue(start, 0.0);
+    for (int i = 1; i < 1000; ++i)
+      log.addValue(start + static_cast<double>(i), 1.0e9 + 0.01 * std::sin(0.1 * i));
+    TimeSplitterType filter{SplittingInterval(start + 10.5, start + 500.5)};
+    const auto expected = averageAndStdDevOverEntries(log, filter);
+    const auto meanAndStdDev = log.averageAndStdDevInFilter(filter);
+    TS_ASSERT_DELTA(meanAndStdDev.first, expected.first, 1e-6);
+    TS_ASSERT_DELTA(meanAndStdDev.second, expected.second, 1e-9);
+    TS_ASSERT_LESS_THAN(0.005, meanAndStdDev.second);
+  }
+
+  void test_averages_from_several_threads() {
+    TimeSeriesProperty<double> log("SharedLog");
+    const DateAndTime start("2007-11-30T16:17:00");
+    for (int i = 0; i < 10000; ++i)
+      log.addValue(start + static_cast<double>(i), std::sin(0.01 * i));
+    TimeSplitterType filter{SplittingInterval(start + 100.5, start + 9000.5)};
+    const auto expected = TimeSeriesProperty<double>(log).averageValueInFilter(filter);
+
+    // The time integrals are built by whichever thread gets there first
+    std::vector<double> averages(64);
+    PARALLEL_FOR_NO_WSP_CHECK()
+    for (int i = 0; i < static_cast<int>(averages.size()); ++i)
+      averages[i] = log.averageValueInFilter(filter);
+    for (const auto average : averages)
+      TS_ASSERT_EQUALS(average, expected);
+  }
+
   void test_averageValueInFilter_throws_for_string_property() {
     TimeSplitterType splitter;
     TS_ASSERT_THROWS(sProp->averageValueInFilter(splitter), const Exception::NotImplementedError &);
@@ -1020,6 +1094,122 @@ public:
     return;
   }
 
+  //----------------------------------------------------------------------------
+  void test_splitByTimeVectorDeferred_matches_splitByTimeVector() {
+    std::mt19937 generator(21836);
+    std::uniform_int_distribution<int64_t> times(0, 1000);
+    std::uniform_int_distribution<int> numbers(0, 20);
+    for (int trial = 0; trial < 200; ++trial) {
+      // A log with repeated and unsorted times, and splitters that may start
+      // before or end after it
+      TimeSeriesProperty<int> log("log");
+      const int numEntries = numbers(generator) + 1;
+      for (int i = 0; i < numEntries; ++i)
+        log.addValue(DateAndTime(times(generator)), i);
+      std::vector<DateAndTime> splitTimes;
+      const int numSplitters = numbers(generator);
+      for (int i = 0; i <= numSplitters; ++i)
+        splitTimes.emplace_back(times(generator) + 200 * (trial % 3) - 200);
+      std::sort(splitTimes.begin(), splitTimes.end());
+      std::vector<int> targets;
+      for (int i = 0; i < numSplitters; ++i)
+        targets.emplace_back(numbers(generator) % 4);
+
+      std::vector<std::unique_ptr<TimeSeriesProperty<int>>> expected, deferred;
+      std::vector<TimeSeriesProperty<int> *> expectedOutputs, deferredOutputs;
+      for (int i = 0; i < 4; ++i) {
+        expected.emplace_back(std::make_unique<TimeSeriesProperty<int>>("out"));
+        deferred.emplace_back(std::make_unique<TimeSeriesProperty<int>>("out"));
+        expectedOutputs.emplace_back(expected.back().get());
+        deferredOutputs.emplace_back(deferred.back().get());
+      }
+      log.splitByTimeVectorDeferred(splitTimes, targets, deferredOutputs);
+      log.splitByTimeVector(splitTimes, targets, expectedOutputs);
+      for (int i = 0; i < 4; ++i) {
+        TS_ASSERT_EQUALS(deferred[i]->size(), expected[i]->size());
+        TS_ASSERT_EQUALS(deferred[i]->timesAsVector(), expected[i]->timesAsVector());
+        TS_ASSERT_EQUALS(deferred[i]->valuesAsVector(), expected[i]->valuesAsVector());
+      }
+    }
+  }
+
+  void test_splitByTimeVectorDeferred_copies_values_on_first_use() {
+    TimeSeriesProperty<double> log("log");
+    const DateAndTime start("2017-11-10T03:12:06");
+    for (int i = 0; i < 1000; ++i)
+      log.addValue(start + static_cast<double>(i), static_cast<double>(i));
+    const std::vector<DateAndTime> splitTimes{start + 100., start + 600., start + 800.};
+    TimeSeriesProperty<double> first("first"), second("second");
+    log.splitByTimeVectorDeferred(splitTimes, {0, 1}, {&first, &second});
+
+    // Only the ranges are held before the values are used
+    TS_ASSERT_LESS_THAN(first.getMemorySize(), 100);
+    // The values are kept if the split log changes
+    log.clear();
+    const std::unique_ptr<TimeSeriesProperty<double>> copy(second.clone());
+    TS_ASSERT_EQUALS(first.size(), 503);
+    TS_ASSERT_EQUALS(first.firstValue(), 99.);
+    TS_ASSERT_EQUALS(first.lastValue(), 601.);
+    TS_ASSERT_EQUALS(second.realSize(), 202);
+    TS_ASSERT_EQUALS(copy->nthValue(0), 600.);
+    TS_ASSERT_EQUALS(*copy, second);
+
+    // Adding a value keeps those of the split
+    TimeSeriesProperty<double> third("third");
+    log.addValue(start, 1.);
+    log.addValue(start + 10., 2.);
+    log.splitByTimeVectorDeferred({start, start + 5.}, {0}, {&third});
+    third.addValue(start + 20., 3.);
+    TS_ASSERT_EQUALS(third.valuesAsVector(), std::vector<double>({1., 2., 3.}));
+  }
+
+  void test_splitByTimeVectorDeferred_read_from_several_threads() {
+    TimeSeriesProperty<double> log("log");
+    const DateAndTime start("2017-11-10T03:12:06");
+    for (int i = 0; i < 1000; ++i)
+      log.addValue(start + static_cast<double>(i), static_cast<double>(i));
+    const std::vector<DateAndTime> splitTimes{start + 100., start + 600.};
+    for (int trial = 0; trial < 20; ++trial) {
+      TimeSeriesProperty<double> output("output");
+      log.splitByTimeVectorDeferred(splitTimes, {0}, {&output});
+      // The first thread to read the output copies the values for all of them
+      std::vector<int> sizes(16);
+      std::vector<DateAndTime> firstTimes(sizes.size());
+      PARALLEL_FOR_NO_WSP_CHECK()
+      for (int i = 0; i < static_cast<int>(sizes.size()); ++i) {
+        sizes[i] = output.size();
+        firstTimes[i] = output.firstTime();
+      }
+      for (size_t i = 0; i < sizes.size(); ++i) {
+        TS_ASSERT_EQUALS(sizes[i], 503);
+        TS_ASSERT_EQUALS(firstTimes[i], start + 99.);
+      }
+    }
+  }
+
+  void test_splitByTimeVectorDeferred_throws_for_targets_without_output() {
+    TimeSeriesProperty<int> log("log");
+    log.addValue(DateAndTime("2017-11-10T03:12:06"), 1);
+    TimeSeriesProperty<int> output("output");
+    const std::vector<DateAndTime> splitTimes{DateAndTime("2017-11-10T03:12:00"), DateAndTime("2017-11-10T03:13:00")};
+    TS_ASSERT_THROWS(log.splitByTimeVectorDeferred(splitTimes, {1}, {&output}), const std::out_of_range &);
+    TS_ASSERT_THROWS(log.splitByTimeVectorDeferred(splitTimes, {0, 0}, {&output}), const std::runtime_error &);
+  }
+
+  void test_setValueFromProperty_of_itself_keeps_the_values() {
+    TimeSeriesProperty<double> log("log");
+    const DateAndTime start("2017-11-10T03:12:06");
+    log.addValue(start, 1.);
+    log.addValue(start + 10., 2.);
+    Property &property = log;
+    TS_ASSERT_EQUALS(property.setValueFromProperty(log), "");
+    TS_ASSERT_EQUALS(log.valuesAsVector(), std::vector<double>({1., 2.}));
+
+    TimeSeriesProperty<double> copy("copy");
+    TS_ASSERT_EQUALS(static_cast<Property &>(copy).setValueFromProperty(log), "");
+    TS_ASSERT_EQUALS(copy.valuesAsVector(), log.valuesAsVector());
+  }
+
   //----------------------------------------------------------------------------
   void test_statistics() {
     TimeSeriesProperty<double> *log = new TimeSeriesProperty<double>("MydoubleLog");
@@ -1853,6 +2043,31 @@ public:
     return;
   }
 
+  void test_nthValue_and_nthInterval_with_many_filter_regions() {
+    // One value a second, and a filter allowing 10 seconds in every 20
+    const DateAndTime start("2007-11-30T16:17:00");
+    TimeSeriesProperty<double> log("BaseProperty");
+    for (int i = 0; i < 200; ++i)
+      log.addValue(start + static_cast<double>(i), static_cast<double>(i));
+    TimeSeriesProperty<bool> filter("Filter");
+    for (int i = 0; i < 10; ++i) {
+      filter.addValue(start + (20.0 * i + 0.5), true);
+      filter.addValue(start + (20.0 * i + 10.5), false);
+    }
+    log.filterWith(&filter);
+    TS_ASSERT_EQUALS(log.size(), 110);
+
+    // Each region holds 11 intervals: the first starts with the filter
+    for (int n = 0; n < 109; ++n) {
+      const int region = n / 11;
+      const double value = 20.0 * region + n % 11;
+      TS_ASSERT_EQUALS(log.nthValue(n), value);
+      const auto interval = log.nthInterval(n);
+      TS_ASSERT_EQUALS(interval.begin(), start + (n % 11 == 0 ? value + 0.5 : value));
+      TS_ASSERT_EQUALS(interval.end(), start + (n % 11 == 10 ? value + 0.5 : value + 1.0));
+    }
+  }
+
   void test_filter_with_single_value_in_series() {
     auto p1 = std::make_shared<TimeSeriesProperty<double>>("SingleValueTSP");
     p1->addValue("2007-11-30T16:17:00", 1.5);
@@ -2339,6 +2554,32 @@ private:
     return log;
   }
 
+  /// The time-weighted mean and standard deviation of a log in a filter,
+  /// found by adding up the overlap of each entry with each range
+  std::pair<double, double> averageAndStdDevOverEntries(const TimeSeriesProperty<double> &log,
+                                                        const TimeSplitterType &filter) {
+    const auto times = log.timesAsVector();
+    const auto values = log.valuesAsVector();
+    // Each value holds until the next time; the first and last hold forever
+    const auto overlap = [&times](const size_t i, const SplittingInterval &range) {
+      const DateAndTime begin = (i == 0 || times[i] < range.start()) ? range.start() : times[i];
+      const DateAndTime end = (i + 1 == times.size() || times[i + 1] > range.stop()) ? range.stop() : times[i + 1];
+      return end > begin ? DateAndTime::secondsFromDuration(end - begin) : 0.0;
+    };
+    double sum(0.0), totalTime(0.0);
+    for (const auto &range : filter) {
+      totalTime += range.duration();
+      for (size_t i = 0; i < values.size(); ++i)
+        sum += values[i] * overlap(i, range);
+    }
+    const double mean = sum / totalTime;
+    double squares(0.0);
+    for (const auto &range : filter)
+      for (size_t i = 0; i < values.size(); ++i)
+        squares += (values[i] - mean) * (values[i] - mean) * overlap(i, range);
+    return {mean, std::sqrt(squares / totalTime)};
+  }
+
   TimeSeriesProperty<int> *iProp;
   TimeSeriesProperty<double> *dProp;
   TimeSeriesProperty<std::string> *sProp;
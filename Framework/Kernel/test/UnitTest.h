@@ -1606,7 +1606,75 @@ public:
     TS_ASSERT(check_vector_conversion(vec, 1.0));
   }
 
+  //----------------------------------------------------------------------
+  // Array conversion tests
+  //----------------------------------------------------------------------
+
+  void test_dSpacing_valuesToTOF_and_valuesFromTOF_match_single_conversions() {
+    d.initialize(1.0, 0, {{UnitParams::difc, 2000.0}, {UnitParams::tzero, 5.0}});
+    // includes tofs below and at tzero, which have special cases in the quadratic
+    checkArrayConversionsMatchSingle(d, {0.5, 1.0, 2.5, 3.0}, {1.0, 5.0, 1000.0, 2005.0, 19999.5});
+
+    d.initialize(1.0, 0, {{UnitParams::difc, 2000.0}, {UnitParams::difa, 3.0}, {UnitParams::tzero, 5.0}});
+    checkArrayConversionsMatchSingle(d, {0.5, 1.0, 2.5, 3.0}, {5.0, 1000.0, 2005.0, 19999.5});
+
+    d.initialize(1.0, 0, {{UnitParams::difc, -1.0}});
+    std::vector<double> tofs(3, 1000.);
+    TS_ASSERT_THROWS(d.valuesFromTOF(tofs.data(), tofs.data(), tofs.size()), const std::runtime_error &)
+  }
+
+  void test_valuesToTOF_and_valuesFromTOF_match_single_conversions() {
+    const std::vector<double> tofs{1000.5, 2001.0, 4250.0, 9999.0};
+    lambda.initialize(10.0, 0, {{UnitParams::l2, 2.0}});
+    checkArrayConversionsMatchSingle(lambda, {0.5, 1.5, 4.0}, tofs);
+    lambda.initialize(1.0, 1, {{UnitParams::l2, 1.0}, {UnitParams::efixed, 1.0}});
+    checkArrayConversionsMatchSingle(lambda, {0.5, 1.5, 4.0}, tofs);
+
+    dE.initialize(1.5, 1, {{UnitParams::l2, 2.5}, {UnitParams::efixed, 4.0}});
+    checkArrayConversionsMatchSingle(dE, {-1.0, 1.1, 3.9, 5.0}, tofs);
+    dEk.initialize(1.5, 2, {{UnitParams::l2, 2.5}, {UnitParams::efixed, 4.0}});
+    checkArrayConversionsMatchSingle(dEk, {-1.0, 1.1, 3.9}, tofs);
+
+    const double difc =
+        2.0 * Mantid::PhysicalConstants::NeutronMass * sin(1.0 / 2) * (1.0 + 1.0) * 1e-4 / Mantid::PhysicalConstants::h;
+    q2.initialize(1.0, 1, {{UnitParams::difc, difc}});
+    checkArrayConversionsMatchSingle(q2, {0.5, 4.0, 9.0}, tofs);
+    k_i.initialize(1.0, 1, {{UnitParams::l2, 1.0}, {UnitParams::efixed, 1.0}});
+    checkArrayConversionsMatchSingle(k_i, {0.5, 4.0, 9.0}, tofs);
+    delta.initialize(1.0, 0, {{UnitParams::l2, 1.0}, {UnitParams::efixed, 2.0}});
+    checkArrayConversionsMatchSingle(delta, {0.5, 4.5}, tofs);
+  }
+
 private:
+  /// Check the array conversions of an initialized unit give the same values
+  /// as the per-value ones, both into a separate array and in place
+  void checkArrayConversionsMatchSingle(const Unit &unit, const std::vector<double> &xValues,
+                                        const std::vector<double> &tofValues) {
+    std::vector<double> tofs(xValues.size());
+    unit.valuesToTOF(xValues.data(), tofs.data(), xValues.size());
+    for (size_t i = 0; i < xValues.size(); ++i)
+      assertSameValue(tofs[i], unit.singleToTOF(xValues[i]));
+    std::vector<double> inPlace(xValues);
+    unit.valuesToTOF(inPlace.data(), inPlace.data(), inPlace.size());
+    TS_ASSERT_EQUALS(inPlace, tofs)
+
+    std::vector<double> xs(tofValues.size());
+    unit.valuesFromTOF(tofValues.data(), xs.data(), tofValues.size());
+    for (size_t i = 0; i < tofValues.size(); ++i)
+      assertSameValue(xs[i], unit.singleFromTOF(tofValues[i]));
+    inPlace = tofValues;
+    unit.valuesFromTOF(inPlace.data(), inPlace.data(), inPlace.size());
+    TS_ASSERT_EQUALS(inPlace, xs)
+  }
+
+  /// The array kernels may be vectorized, so allow for rounding differences
+  void assertSameValue(const double actual, const double expected) {
+    if (std::isfinite(expected))
+      TS_ASSERT_DELTA(actual, expected, 1e-12 * std::abs(expected))
+    else
+      TS_ASSERT_EQUALS(actual, expected)
+  }
+
   Units::Label label;
   Units::TOF tof;
   Units::Wavelength lambda;
@@ -59,12 +59,27 @@ private:
   /// Run the algorithm
   void exec() override;
 
+  /// The arrays the signal, error squared and number of events are summed into
+  struct BinArrays {
+    signal_t *signals;
+    signal_t *errors;
+    signal_t *numEvents;
+  };
+
   /// Helper method
   template <typename MDE, size_t nd> void binByIterating(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
 
+  /// Bin the output in chunks along one dimension, one chunk per thread
+  template <typename MDE, size_t nd>
+  void binByChunks(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws, bool doParallel);
+
+  /// Bin the boxes in parallel, each thread summing into its own histogram
+  template <typename MDE, size_t nd> void binByBoxes(typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws);
+
   /// Method to bin a single MDBox
   template <typename MDE, size_t nd>
-  void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax);
+  void binMDBox(DataObjects::MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax,
+                const BinArrays &bins);
 
   /// The output MDHistoWorkspace
   Mantid::DataObjects::MDHistoWorkspace_sptr outWS;
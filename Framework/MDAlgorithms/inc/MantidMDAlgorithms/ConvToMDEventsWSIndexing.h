@@ -8,9 +8,6 @@
 
 #include "MantidMDAlgorithms/ConvToMDEventsWS.h"
 #include "MantidMDAlgorithms/MDEventTreeBuilder.h"
-#include <mutex>
-#include <queue>
-#include <thread>
 
 namespace Mantid {
 // Forward declarations
@@ -24,7 +21,9 @@ namespace MDAlgorithms {
  * coordinate and than assigns the groups of them to the
  * spatial tree-like box structure. The difference with
  * the ConvToMDEventsWS is in using the spatial index (Morton
- * numbers) for speeding up the procedure.
+ * numbers) for speeding up the procedure. When appending to
+ * a workspace which already holds events, the box structure
+ * is rebuilt from the existing and the converted events.
  */
 class ConvToMDEventsWSIndexing : public ConvToMDEventsWS {
   enum MD_EVENT_TYPE { LEAN, REGULAR, NONE };
@@ -69,6 +68,9 @@ private:
   template <typename EventType, size_t ND, template <size_t> class MDEventType>
   std::vector<MDEventType<ND>> convertEvents();
 
+  template <size_t ND, template <size_t> class MDEventType>
+  void takeExistingEvents(std::vector<MDEventType<ND>> &mdEvents);
+
   template <size_t ND, template <size_t> class MDEventType> struct MDEventMaker {
     static MDEventType<ND> makeMDEvent(const double &sig, const double &err, const uint16_t &expInfoIndex,
                                        const uint16_t &goniometer_index, const uint32_t &det_id, coord_t *coord) {
@@ -155,13 +157,44 @@ std::vector<MDEventType<ND>> ConvToMDEventsWSIndexing::convertEvents() {
   return mdEvents;
 }
 
+/**
+ * Moves the events already held by the output workspace to the end of
+ * mdEvents, so that they are distributed into the new box structure together
+ * with the converted events.
+ * @param mdEvents :: the converted events
+ */
+template <size_t ND, template <size_t> class MDEventType>
+void ConvToMDEventsWSIndexing::takeExistingEvents(std::vector<MDEventType<ND>> &mdEvents) {
+  auto *pws = dynamic_cast<DataObjects::MDEventWorkspace<MDEventType<ND>, ND> *>(m_OutWSWrapper->pWorkspace().get());
+  if (!pws || pws->getNPoints() == 0)
+    return;
+  if (pws->isFileBacked())
+    throw std::runtime_error("Can't append events to a file backed workspace with the indexed converter");
+
+  std::vector<API::IMDNode *> boxes;
+  pws->getBox()->getBoxes(boxes, std::numeric_limits<size_t>::max(), true);
+  mdEvents.reserve(mdEvents.size() + pws->getNPoints());
+  for (auto *node : boxes) {
+    auto *box = dynamic_cast<DataObjects::MDBox<MDEventType<ND>, ND> *>(node);
+    if (!box)
+      continue;
+    const auto &events = box->getConstEvents();
+    mdEvents.insert(mdEvents.end(), events.cbegin(), events.cend());
+    box->releaseEvents();
+    box->clear();
+  }
+}
+
 template <typename EventType, size_t ND, template <size_t> class MDEventType>
 void ConvToMDEventsWSIndexing::appendEvents(API::Progress *pProgress, const API::BoxController_sptr &bc) {
-  bc->clearBoxesCounter(1);
-  bc->clearGridBoxesCounter(0);
   pProgress->resetNumSteps(2, 0, 1);
 
   std::vector<MDEventType<ND>> mdEvents = convertEvents<EventType, ND, MDEventType>();
+  takeExistingEvents<ND, MDEventType>(mdEvents);
+  for (size_t depth = 0; depth <= bc->getMaxDepth(); ++depth) {
+    bc->clearBoxesCounter(depth);
+    bc->clearGridBoxesCounter(depth);
+  }
 
   morton_index::MDSpaceBounds<ND> space;
   const auto &pws = m_OutWSWrapper->pWorkspace();
@@ -11,10 +11,10 @@
 #include "MantidKernel/Matrix.h"
 #include "MantidKernel/V3D.h"
 
+#include <atomic>
 #include <memory>
-
+#include <mutex>
 #include <tuple>
-#include <unordered_map>
 #include <vector>
 
 namespace Mantid {
@@ -45,15 +45,17 @@ struct IntegrationParameters {
  determined from the standard deviations in the directions of the
  principal axes.
 
+ The events of all peaks are kept in a single buffer, grouped by peak in
+ the order of the sorted peak keys, rather than in one list per peak.
+ Events added with addEvents are appended to a staging buffer and merged
+ into the grouped buffer the first time the events of a peak are needed,
+ after which the integration methods may be called from several threads.
+
  @author Dennis Mikkelson
  @date   2012-12-19
 
  */
 
-using EventListMap =
-    std::unordered_map<int64_t, std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>>>;
-using PeakQMap = std::unordered_map<int64_t, Mantid::Kernel::V3D>;
-
 class DLLExport Integrate3DEvents {
 public:
   /// Construct object to store events around peaks and integrate peaks
@@ -97,9 +99,38 @@ public:
                                     bool forceSpherical = false, double sphericityTol = 0.02);
 
 private:
-  /// Get a list of events for a given Q
-  const std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> *
-  getEvents(const Mantid::Kernel::V3D &peak_q);
+  /// An event: the signal and error squared, and the Q-vector
+  using Event = std::pair<std::pair<double, double>, Mantid::Kernel::V3D>;
+
+  /// A view of the contiguous events stored for one peak
+  class EventRange {
+  public:
+    EventRange() = default;
+    EventRange(const Event *first, const Event *last) : m_begin(first), m_end(last) {}
+    const Event *begin() const { return m_begin; }
+    const Event *end() const { return m_end; }
+    size_t size() const { return static_cast<size_t>(m_end - m_begin); }
+    bool empty() const { return m_begin == m_end; }
+
+  private:
+    const Event *m_begin = nullptr;
+    const Event *m_end = nullptr;
+  };
+
+  /// Store the peak Q-vectors sorted by their keys
+  void setPeaks(std::vector<std::pair<int64_t, Mantid::Kernel::V3D>> peaks);
+
+  /// Find the index of the peak with the given key
+  size_t findPeak(int64_t key) const;
+
+  /// Merge the staged events into the buffer of events grouped by peak
+  void groupEvents();
+
+  /// Get the events for a given Q, or no events if there are too few of them
+  EventRange getEvents(const Mantid::Kernel::V3D &peak_q);
+
+  /// Get the events for a given key, or no events if there are too few of them
+  EventRange getEvents(int64_t key);
 
   bool correctForDetectorEdges(std::tuple<double, double, double> &radii,
                                const std::vector<Mantid::Kernel::V3D> &E1Vecs, const Mantid::Kernel::V3D &peak_q,
@@ -107,19 +138,19 @@ private:
                                const std::vector<double> &bkgOuterRadii);
 
   /// Calculate the number of events in an ellipsoid centered at 0,0,0
-  static std::pair<double, double>
-  numInEllipsoid(std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> const &events,
-                 std::vector<Mantid::Kernel::V3D> const &directions, std::vector<double> const &sizes);
+  static std::pair<double, double> numInEllipsoid(EventRange const &events,
+                                                  std::vector<Mantid::Kernel::V3D> const &directions,
+                                                  std::vector<double> const &sizes);
 
   /// Calculate the number of events in an ellipsoid centered at 0,0,0
-  static std::pair<double, double>
-  numInEllipsoidBkg(std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> const &events,
-                    std::vector<Mantid::Kernel::V3D> const &directions, std::vector<double> const &sizes,
-                    std::vector<double> const &sizesIn, const bool useOnePercentBackgroundCorrection);
+  static std::pair<double, double> numInEllipsoidBkg(EventRange const &events,
+                                                     std::vector<Mantid::Kernel::V3D> const &directions,
+                                                     std::vector<double> const &sizes,
+                                                     std::vector<double> const &sizesIn,
+                                                     const bool useOnePercentBackgroundCorrection);
 
   /// Calculate the 3x3 covariance matrix of a list of Q-vectors at 0,0,0
-  static void makeCovarianceMatrix(std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> const &events,
-                                   Kernel::DblMatrix &matrix, double radius);
+  static void makeCovarianceMatrix(EventRange const &events, Kernel::DblMatrix &matrix, double radius);
 
   /// Calculate the eigen vectors of a 3x3 real symmetric matrix
   static void getEigenVectors(Kernel::DblMatrix const &cov_matrix, std::vector<Mantid::Kernel::V3D> &eigen_vectors,
@@ -142,8 +173,7 @@ private:
 
   /// Find the net integrated intensity of a list of Q's using ellipsoids
   std::shared_ptr<const Mantid::DataObjects::PeakShapeEllipsoid>
-  ellipseIntegrateEvents(const std::vector<Kernel::V3D> &E1Vec, Kernel::V3D const &peak_q,
-                         std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> const &ev_list,
+  ellipseIntegrateEvents(const std::vector<Kernel::V3D> &E1Vec, Kernel::V3D const &peak_q, EventRange const &ev_list,
                          std::vector<Mantid::Kernel::V3D> const &directions, std::vector<double> const &sigmas,
                          bool specify_size, double peak_radius, double back_inner_radius, double back_outer_radius,
                          std::vector<double> &axes_radii, double &inti, double &sigi);
@@ -157,9 +187,15 @@ private:
 
   // Private data members
 
-  PeakQMap m_peak_qs;         // hashtable with peak Q-vectors
-  EventListMap m_event_lists; // hashtable with lists of events for each peak
-  Kernel::DblMatrix m_UBinv;  // matrix mapping from Q to h,k,l
+  std::vector<int64_t> m_peak_keys;        // sorted keys of the peaks
+  std::vector<Kernel::V3D> m_peak_qs;      // peak Q-vectors, in the order of m_peak_keys
+  std::vector<Event> m_events;             // events of all peaks, grouped by peak
+  std::vector<size_t> m_event_offsets;     // start of the events of each peak in m_events
+  std::vector<Event> m_new_events;         // events added since they were last grouped
+  std::vector<uint32_t> m_new_event_peaks; // peak index of each of m_new_events
+  std::atomic<bool> m_events_grouped;      // false if there are new events to group
+  std::mutex m_group_mutex;                // guards grouping the new events
+  Kernel::DblMatrix m_UBinv;               // matrix mapping from Q to h,k,l
   Kernel::DblMatrix m_ModHKL; // matrix mapping from Q to m,n,p
   double m_radius;            // size of sphere to use for events around a peak
   double s_radius;            // size of sphere to use for events around a peak
@@ -10,6 +10,7 @@
 #include "MantidAPI/CompositeFunction.h"
 #include "MantidAPI/IMDEventWorkspace_fwd.h"
 #include "MantidAPI/IPeaksWorkspace.h"
+#include "MantidDataObjects/MDEventSpatialIndex.h"
 #include "MantidDataObjects/MDEventWorkspace.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidDataObjects/Workspace2D.h"
@@ -64,6 +65,7 @@ private:
   // matrix that defines an ellipsoid.
   template <typename MDE, size_t nd>
   void findEllipsoid(const typename DataObjects::MDEventWorkspace<MDE, nd>::sptr ws,
+                     const DataObjects::MDEventSpatialIndex<MDE, nd> *index,
                      const Mantid::API::CoordTransform &getRadiusSq, const Mantid::Kernel::V3D &pos,
                      const coord_t &radiusSquared, const bool &qAxisBool, const bool &useCentroid,
                      const double &bgDensity, std::vector<Mantid::Kernel::V3D> &eigenvects,
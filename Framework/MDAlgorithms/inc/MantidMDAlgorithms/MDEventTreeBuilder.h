@@ -6,20 +6,22 @@
 // SPDX - License - Identifier: GPL - 3.0 +
 #pragma once
 
-#include <queue>
+#include <limits>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 #include <tbb/task_arena.h>
-#include <thread>
+#include <tbb/task_group.h>
 
 namespace Mantid {
 namespace MDAlgorithms {
 
 /**
  * Class to create the box structure of MDWorkspace. The algorithm:
- * The MASTER thread starting to build tree structure recursively,
- * if it finds the subtask to distribute N events N < threshold, the
- * it delegates this independent subtask to other tread, syncronisation
- * is implemented with queue and mutex.
+ * the events are sorted by Morton index with a radix partition on the
+ * leading bits of the index followed by sorting every partition, then the
+ * tree structure is built recursively from the sorted range. The subtrees
+ * holding at least threshold events are built as separate tasks, so that
+ * idle workers can steal them.
  * @tparam ND :: number of Dimensions
  * @tparam MDEventType :: Type of created MDEvent [MDLeanEvent, MDEvent]
  * @tparam EventIterator :: Iterator of sorted collection storing the converted
@@ -37,7 +39,6 @@ template <size_t ND, template <size_t> class MDEventType, typename EventIterator
 public:
   using EventAccessType = DataObjects::EventAccessor;
   using IndexCoordinateSwitcher = typename MDEvent::template AccessFor<EventDistributor>;
-  enum WORKER_TYPE { MASTER, SLAVE };
   /**
    * Structure to store the subtask of creating subtree from the
    * range of events
@@ -71,17 +72,14 @@ private:
                                                 const morton_index::MDSpaceBounds<ND> &space);
   void sortEvents(std::vector<MDEventType<ND>> &mdEvents);
   BoxBase *doDistributeEvents(std::vector<MDEventType<ND>> &mdEvents);
-  void distributeEvents(Task &tsk, const WORKER_TYPE &wtp);
-  void pushTask(Task &&tsk);
-  std::unique_ptr<Task> popTask();
-  void waitAndLaunchSlave();
+  void distributeEvents(Task &tsk, tbb::task_group &tasks);
 
 private:
+  /// Number of leading bits of the Morton index used to partition the events
+  static constexpr size_t RADIX_BITS = 12;
+
   const int m_numWorkers;
   const size_t m_eventsThreshold;
-  std::queue<Task> m_tasks;
-  std::mutex m_mutex;
-  std::atomic<bool> m_masterFinished;
 
   const morton_index::MDSpaceBounds<ND> &m_space;
   std::vector<Mantid::Geometry::MDDimensionExtents<coord_t>> m_extents;
@@ -95,7 +93,7 @@ template <size_t ND, template <size_t> class MDEventType, typename EventIterator
 MDEventTreeBuilder<ND, MDEventType, EventIterator>::MDEventTreeBuilder(const int numWorkers, const size_t threshold,
                                                                        const API::BoxController_sptr &bc,
                                                                        const morton_index::MDSpaceBounds<ND> &space)
-    : m_numWorkers(numWorkers), m_eventsThreshold(threshold), m_masterFinished{false}, m_space{space}, m_bc{bc},
+    : m_numWorkers(numWorkers), m_eventsThreshold(threshold), m_space{space}, m_bc{bc},
       m_mortonMin{morton_index::calculateDefaultBound<ND, IntT, MortonT>(std::numeric_limits<IntT>::min())},
       m_mortonMax{morton_index::calculateDefaultBound<ND, IntT, MortonT>(std::numeric_limits<IntT>::max())} {
   for (size_t ax = 0; ax < ND; ++ax) {
@@ -123,20 +121,12 @@ MDEventTreeBuilder<ND, MDEventType, EventIterator>::doDistributeEvents(std::vect
     auto root = new DataObjects::MDGridBox<MDEvent, ND>(m_bc.get(), 0, m_extents);
     Task tsk{root, mdEvents.begin(), mdEvents.end(), m_mortonMin, m_mortonMax, m_bc->getMaxDepth() + 1, 1};
 
-    if (m_numWorkers == 1)
-      distributeEvents(tsk, SLAVE);
-    else {
-      std::vector<std::thread> workers;
-      workers.emplace_back([this, &tsk]() {
-        distributeEvents(tsk, MASTER);
-        m_masterFinished = true;
-        waitAndLaunchSlave();
-      });
-      for (auto i = 1; i < m_numWorkers; ++i)
-        workers.emplace_back(&MDEventTreeBuilder::waitAndLaunchSlave, this);
-      for (auto &worker : workers)
-        worker.join();
-    }
+    tbb::task_arena limited_arena(m_numWorkers);
+    limited_arena.execute([&]() {
+      tbb::task_group tasks;
+      distributeEvents(tsk, tasks);
+      tasks.wait();
+    });
     return root;
   }
 }
@@ -164,56 +154,88 @@ MDEventTreeBuilder<ND, MDEventType, EventIterator>::convertToIndex(std::vector<M
   return maxErr;
 }
 
+/**
+ * Sorts the events by Morton index. The events are first scattered to
+ * 2^RADIX_BITS partitions by the leading bits of their index, each worker
+ * handling a contiguous chunk of the input, and then every partition is
+ * sorted on its own. If there is not enough memory for the scatter the
+ * events are sorted in place instead.
+ */
 template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
 void MDEventTreeBuilder<ND, MDEventType, EventIterator>::sortEvents(std::vector<MDEventType<ND>> &mdEvents) {
+  const auto byIndex = [](const MDEventType<ND> &a, const MDEventType<ND> &b) {
+    return IndexCoordinateSwitcher::getIndex(a) < IndexCoordinateSwitcher::getIndex(b);
+  };
 
   tbb::task_arena limited_arena(m_numWorkers);
   limited_arena.execute([&]() {
-    tbb::parallel_sort(mdEvents.begin(), mdEvents.end(), [](const MDEventType<ND> &a, const MDEventType<ND> &b) {
-      return IndexCoordinateSwitcher::getIndex(a) < IndexCoordinateSwitcher::getIndex(b);
-    });
-  });
-}
+    std::vector<MDEventType<ND>> partitioned;
+    try {
+      partitioned.resize(mdEvents.size());
+    } catch (std::bad_alloc &) {
+      tbb::parallel_sort(mdEvents.begin(), mdEvents.end(), byIndex);
+      return;
+    }
 
-template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
-void MDEventTreeBuilder<ND, MDEventType, EventIterator>::pushTask(
-    MDEventTreeBuilder<ND, MDEventType, EventIterator>::Task &&tsk) {
-  std::lock_guard<std::mutex> g(m_mutex);
-  m_tasks.emplace(tsk);
-}
+    constexpr size_t numBuckets = size_t{1} << RADIX_BITS;
+    // the index interleaves the bits of the ND integer coordinates
+    constexpr int shift = static_cast<int>(ND * std::numeric_limits<IntT>::digits - RADIX_BITS);
+    const auto bucketOf = [](const MDEventType<ND> &event) {
+      return static_cast<size_t>(IndexCoordinateSwitcher::getIndex(event) >> shift);
+    };
+
+    // count the events of every bucket in every chunk of the input
+    const size_t numChunks = static_cast<size_t>(m_numWorkers);
+    const size_t chunkSize = (mdEvents.size() + numChunks - 1) / numChunks;
+    std::vector<std::vector<size_t>> offsets(numChunks, std::vector<size_t>(numBuckets, 0));
+    tbb::parallel_for(size_t{0}, numChunks, [&](size_t chunk) {
+      const auto end = std::min(mdEvents.size(), (chunk + 1) * chunkSize);
+      for (size_t i = chunk * chunkSize; i < end; ++i)
+        ++offsets[chunk][bucketOf(mdEvents[i])];
+    });
 
-template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
-std::unique_ptr<typename MDEventTreeBuilder<ND, MDEventType, EventIterator>::Task>
-MDEventTreeBuilder<ND, MDEventType, EventIterator>::popTask() {
-  std::lock_guard<std::mutex> g(m_mutex);
-  if (m_tasks.empty())
-    return {nullptr};
-  else {
-    auto task = std::make_unique<Task>(m_tasks.front());
-    m_tasks.pop();
-    return task;
-  }
-}
+    // turn the counts into the positions every chunk writes its buckets to
+    std::vector<size_t> bucketStart(numBuckets + 1, 0);
+    size_t position = 0;
+    for (size_t bucket = 0; bucket < numBuckets; ++bucket) {
+      bucketStart[bucket] = position;
+      for (size_t chunk = 0; chunk < numChunks; ++chunk) {
+        const auto count = offsets[chunk][bucket];
+        offsets[chunk][bucket] = position;
+        position += count;
+      }
+    }
+    bucketStart[numBuckets] = position;
 
-template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
-void MDEventTreeBuilder<ND, MDEventType, EventIterator>::waitAndLaunchSlave() {
-  while (true) {
-    auto pTsk = popTask();
-    if (pTsk)
-      distributeEvents(*pTsk.get(), SLAVE);
-    else if (m_masterFinished)
-      break;
-    else
-      std::this_thread::sleep_for(std::chrono::nanoseconds(100));
-  }
+    tbb::parallel_for(size_t{0}, numChunks, [&](size_t chunk) {
+      const auto end = std::min(mdEvents.size(), (chunk + 1) * chunkSize);
+      auto &next = offsets[chunk];
+      for (size_t i = chunk * chunkSize; i < end; ++i)
+        partitioned[next[bucketOf(mdEvents[i])]++] = mdEvents[i];
+    });
+    mdEvents.swap(partitioned);
+    std::vector<MDEventType<ND>>().swap(partitioned);
+
+    // large buckets are sorted in parallel themselves
+    const size_t largeBucket = mdEvents.size() / numChunks;
+    tbb::parallel_for(size_t{0}, numBuckets, [&](size_t bucket) {
+      const auto first = mdEvents.begin() + bucketStart[bucket];
+      const auto last = mdEvents.begin() + bucketStart[bucket + 1];
+      if (bucketStart[bucket + 1] - bucketStart[bucket] > largeBucket)
+        tbb::parallel_sort(first, last, byIndex);
+      else
+        std::sort(first, last, byIndex);
+    });
+  });
 }
 
 /**
- * Does actual work on creating tasks in MASTER mode and
- * executing tasks in SLAVE mode
+ * Creates the child boxes of the task root and recurses into them. The
+ * children holding at least m_eventsThreshold events are given to the task
+ * group to be built by any worker, the others are built by this one.
  */
 template <size_t ND, template <size_t> class MDEventType, typename EventIterator>
-void MDEventTreeBuilder<ND, MDEventType, EventIterator>::distributeEvents(Task &tsk, const WORKER_TYPE &wtp) {
+void MDEventTreeBuilder<ND, MDEventType, EventIterator>::distributeEvents(Task &tsk, tbb::task_group &tasks) {
   const size_t childBoxCount = m_bc->getNumSplit();
   const size_t splitThreshold = m_bc->getSplitThreshold();
 
@@ -310,10 +332,14 @@ void MDEventTreeBuilder<ND, MDEventType, EventIterator>::distributeEvents(Task &
                  ch.mortonBounds.second,
                  tsk.maxDepth,
                  tsk.level};
-    if (wtp == MASTER && (size_t)std::distance(newTask.begin, newTask.end) < m_eventsThreshold)
-      pushTask(std::move(newTask));
+    if (static_cast<size_t>(std::distance(newTask.begin, newTask.end)) >= m_eventsThreshold &&
+        static_cast<size_t>(std::distance(newTask.begin, newTask.end)) > splitThreshold)
+      tasks.run([this, newTask, &tasks]() {
+        Task subtask(newTask);
+        distributeEvents(subtask, tasks);
+      });
     else
-      distributeEvents(newTask, wtp);
+      distributeEvents(newTask, tasks);
   }
 }
 
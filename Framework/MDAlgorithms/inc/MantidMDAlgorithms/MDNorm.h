@@ -58,8 +58,12 @@ private:
   std::vector<coord_t> getValuesFromOtherDimensions(bool &skipNormalization, uint16_t expInfoIndex = 0) const;
 
   void cacheDimensionXValues();
-  void calculateNormalization(const std::vector<coord_t> &otherValues, const Geometry::SymmetryOperation &so,
-                              uint16_t expInfoIndex, size_t soIndex);
+  void calculateNormalization(const std::vector<coord_t> &otherValues,
+                              const std::vector<Geometry::SymmetryOperation> &symmetryOps, uint16_t expInfoIndex,
+                              std::vector<std::atomic<signal_t>> &signalArray,
+                              std::vector<std::atomic<signal_t>> &bkgdSignalArray);
+  void addNormalization(const std::vector<std::atomic<signal_t>> &signalArray, DataObjects::MDHistoWorkspace &normWS,
+                        const bool accumulate);
 
   void calculateIntersections(std::vector<std::array<double, 4>> &intersections, const double theta, const double phi,
                               const Kernel::DblMatrix &transform, double lowvalue, double highvalue);
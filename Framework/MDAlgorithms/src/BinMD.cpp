@@ -23,6 +23,8 @@
 #include "MantidKernel/Utils.h"
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+
 namespace Mantid {
 namespace MDAlgorithms {
 
@@ -34,6 +36,12 @@ using namespace Mantid::API;
 using namespace Mantid::Geometry;
 using namespace Mantid::DataObjects;
 
+namespace {
+/// The largest number of bins, summed over the threads, of the histograms the
+/// threads bin the boxes into. Larger outputs are binned in chunks instead.
+constexpr size_t MAX_THREAD_HISTOGRAM_BINS = 1 << 24;
+} // namespace
+
 //----------------------------------------------------------------------------------------------
 /** Constructor
  */
@@ -66,8 +74,8 @@ void BinMD::init() {
                   "bins.");
   setPropertyGroup("IterateEvents", grp);
 
-  declareProperty(std::make_unique<PropertyWithValue<bool>>("Parallel", false, Direction::Input),
-                  "Temporary parameter: true to run in parallel. This is ignored for "
+  declareProperty(std::make_unique<PropertyWithValue<bool>>("Parallel", true, Direction::Input),
+                  "True to run in parallel. This is ignored for "
                   "file-backed workspaces, where running in parallel makes things slower "
                   "due to disk thrashing.");
   setPropertyGroup("Parallel", grp);
@@ -90,9 +98,12 @@ void BinMD::init() {
  *(inclusive)
  * @param chunkMax :: the maximum index in each dimension to consider "valid"
  *(exclusive)
+ * @param bins :: the arrays to add the signal, error squared and number of
+ *events to
  */
 template <typename MDE, size_t nd>
-inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax) {
+inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, const size_t *const chunkMax,
+                            const BinArrays &bins) {
   // An array to hold the rotated/transformed coordinates
   auto outCenter = std::vector<coord_t>(m_outD);
 
@@ -155,11 +166,11 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, c
       //        std::cout << "Box at " << box->getExtentsStr() << " is within a
       //        single bin.\n";
       // Add the CACHED signal from the entire box
-      signals[lastLinearIndex] += box->getSignal();
-      errors[lastLinearIndex] += box->getErrorSquared();
+      bins.signals[lastLinearIndex] += box->getSignal();
+      bins.errors[lastLinearIndex] += box->getErrorSquared();
       // TODO: If DataObjects get a weight, this would need to get the summed
       // weight.
-      numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
+      bins.numEvents[lastLinearIndex] += static_cast<signal_t>(box->getNPoints());
 
       // And don't bother looking at each event. This may save lots of time
       // loading from disk.
@@ -171,41 +182,45 @@ inline void BinMD::binMDBox(MDBox<MDE, nd> *box, const size_t *const chunkMin, c
   // same bin.
   // So you need to iterate through events.
   const std::vector<MDE> &events = box->getConstEvents();
-  for (auto it = events.begin(); it != events.end(); ++it) {
-    // Cache the center of the event (again for speed)
-    const coord_t *inCenter = it->getCenter();
-
-    // Now transform to the output dimensions
-    m_transform->apply(inCenter, outCenter.data());
+  // The events are transformed to the output dimensions a block at a time
+  constexpr size_t blockSize = 256;
+  auto outCenters = std::vector<coord_t>(std::min(blockSize, events.size()) * m_outD);
+  for (size_t first = 0; first < events.size(); first += blockSize) {
+    const size_t numInBlock = std::min(blockSize, events.size() - first);
+    m_transform->applyToPoints(events[first].getCenter(), sizeof(MDE), numInBlock, outCenters.data());
+
+    for (size_t i = 0; i < numInBlock; ++i) {
+      const coord_t *outCenter = outCenters.data() + i * m_outD;
+      // To build up the linear index
+      size_t linearIndex = 0;
+      // To mark events outside range
+      bool badOne = false;
 
-    // To build up the linear index
-    size_t linearIndex = 0;
-    // To mark events outside range
-    bool badOne = false;
+      /// Loop through the dimensions on which we bin
+      for (size_t bd = 0; bd < m_outD; bd++) {
+        // What is the bin index in that dimension
+        coord_t x = outCenter[bd];
+        auto ix = size_t(x);
+        // Within range (for this chunk)?
+        if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
+          // Build up the linear index
+          linearIndex += indexMultiplier[bd] * ix;
+        } else {
+          // Outside the range
+          badOne = true;
+          break;
+        }
+      } // (for each dim in MDHisto)
 
-    /// Loop through the dimensions on which we bin
-    for (size_t bd = 0; bd < m_outD; bd++) {
-      // What is the bin index in that dimension
-      coord_t x = outCenter[bd];
-      auto ix = size_t(x);
-      // Within range (for this chunk)?
-      if ((x >= 0) && (ix >= chunkMin[bd]) && (ix < chunkMax[bd])) {
-        // Build up the linear index
-        linearIndex += indexMultiplier[bd] * ix;
-      } else {
-        // Outside the range
-        badOne = true;
-        break;
+      if (!badOne) {
+        const MDE &event = events[first + i];
+        // Sum the signals as doubles to preserve precision
+        bins.signals[linearIndex] += static_cast<signal_t>(event.getSignal());
+        bins.errors[linearIndex] += static_cast<signal_t>(event.getErrorSquared());
+        // TODO: If DataObjects get a weight, this would need to get the summed
+        // weight.
+        bins.numEvents[linearIndex] += 1.0;
       }
-    } // (for each dim in MDHisto)
-
-    if (!badOne) {
-      // Sum the signals as doubles to preserve precision
-      signals[linearIndex] += static_cast<signal_t>(it->getSignal());
-      errors[linearIndex] += static_cast<signal_t>(it->getErrorSquared());
-      // TODO: If DataObjects get a weight, this would need to get the summed
-      // weight.
-      numEvents[linearIndex] += 1.0;
     }
   }
   // Done with the events list
@@ -243,6 +258,41 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
     outWS->setTo(0.0, 0.0, 0.0);
   }
 
+  // Do we actually do it in parallel?
+  bool doParallel = getProperty("Parallel");
+  // Not if file-backed!
+  if (bc->isFileBacked())
+    doParallel = false;
+
+  // Each thread needs its own copy of the output to bin the boxes in parallel.
+  // Otherwise the output is split into chunks along one dimension.
+  const auto numThreads = static_cast<size_t>(PARALLEL_GET_MAX_THREADS);
+  if (doParallel && numThreads > 1 && numThreads * outWS->getNPoints() <= MAX_THREAD_HISTOGRAM_BINS)
+    binByBoxes<MDE, nd>(ws);
+  else
+    binByChunks<MDE, nd>(ws, doParallel);
+
+  // Now the implicit function
+  if (implicitFunction) {
+    if (prog)
+      prog->report("Applying implicit function.");
+    signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
+    outWS->applyImplicitFunction(implicitFunction.get(), nan, nan);
+  }
+}
+
+//----------------------------------------------------------------------------------------------
+/** Bin the boxes of the workspace in chunks along the first output dimension,
+ * running the chunks in parallel if requested.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ * @param doParallel :: true to bin the chunks in parallel
+ */
+template <typename MDE, size_t nd>
+void BinMD::binByChunks(typename MDEventWorkspace<MDE, nd>::sptr ws, bool doParallel) {
+  BoxController_sptr bc = ws->getBoxController();
+  const BinArrays bins{signals, errors, numEvents};
+
   // The dimension (in the output workspace) along which we chunk for parallel
   // processing
   // TODO: Find the smartest dimension to chunk against
@@ -254,11 +304,6 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
   if (chunkNumBins < 1)
     chunkNumBins = 1;
 
-  // Do we actually do it in parallel?
-  bool doParallel = getProperty("Parallel");
-  // Not if file-backed!
-  if (bc->isFileBacked())
-    doParallel = false;
   if (!doParallel)
     chunkNumBins = int(m_binDimensions[chunkDimension]->getNBins());
 
@@ -318,7 +363,7 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
         auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxe);
         // Perform the binning in this separate method.
         if (box && !box->getIsMasked())
-          this->binMDBox(box, chunkMin.data(), chunkMax.data());
+          this->binMDBox(box, chunkMin.data(), chunkMax.data(), bins);
 
         // Progress reporting
         if (prog)
@@ -330,14 +375,65 @@ template <typename MDE, size_t nd> void BinMD::binByIterating(typename MDEventWo
       PARALLEL_END_INTERUPT_REGION
     } // for each chunk in parallel
     PARALLEL_CHECK_INTERUPT_REGION
+}
 
-    // Now the implicit function
-    if (implicitFunction) {
-      if (prog)
-        prog->report("Applying implicit function.");
-      signal_t nan = std::numeric_limits<signal_t>::quiet_NaN();
-      outWS->applyImplicitFunction(implicitFunction.get(), nan, nan);
+//----------------------------------------------------------------------------------------------
+/** Bin the boxes of the workspace in parallel. Every thread sums the boxes it
+ * bins into its own histogram, and the histograms are added to the output
+ * at the end, so the work is shared evenly however few bins the output has
+ * in any dimension.
+ *
+ * @param ws :: MDEventWorkspace of the given type.
+ */
+template <typename MDE, size_t nd> void BinMD::binByBoxes(typename MDEventWorkspace<MDE, nd>::sptr ws) {
+  std::vector<size_t> binMin(m_outD, 0);
+  std::vector<size_t> binMax(m_outD);
+  for (size_t bd = 0; bd < m_outD; bd++)
+    binMax[bd] = m_binDimensions[bd]->getNBins();
+
+  // All the leaf boxes touching the output
+  auto function = this->getImplicitFunctionForChunk(binMin.data(), binMax.data());
+  std::vector<API::IMDNode *> boxes;
+  ws->getBox()->getBoxes(boxes, 1000, true, function.get());
+  g_log.debug() << "Found " << boxes.size() << " boxes within the implicit function.\n";
+  if (prog) {
+    prog->setNotifyStep(0.1);
+    prog->resetNumSteps(boxes.size() + 1, 0.00, 1.0);
+  }
+
+  // The histograms of the threads hold the signals, then the errors, then the
+  // numbers of events. They are only allocated by the threads that bin a box.
+  const size_t numBins = outWS->getNPoints();
+  std::vector<std::vector<signal_t>> threadHistograms(PARALLEL_GET_MAX_THREADS);
+
+  PRAGMA_OMP(parallel for schedule(dynamic, 1))
+  for (int64_t i = 0; i < static_cast<int64_t>(boxes.size()); ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    auto *box = dynamic_cast<MDBox<MDE, nd> *>(boxes[i]);
+    if (box && !box->getIsMasked()) {
+      auto &histogram = threadHistograms[PARALLEL_THREAD_NUMBER];
+      if (histogram.empty())
+        histogram.resize(3 * numBins, 0.0);
+      const BinArrays bins{histogram.data(), histogram.data() + numBins, histogram.data() + 2 * numBins};
+      this->binMDBox(box, binMin.data(), binMax.data(), bins);
     }
+    if (prog)
+      prog->report();
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  // Add the histograms of the threads to the output
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int64_t i = 0; i < static_cast<int64_t>(numBins); ++i) {
+    for (const auto &histogram : threadHistograms) {
+      if (histogram.empty())
+        continue;
+      signals[i] += histogram[i];
+      errors[i] += histogram[numBins + i];
+      numEvents[i] += histogram[2 * numBins + i];
+    }
+  }
 }
 
 //----------------------------------------------------------------------------------------------
@@ -7,9 +7,9 @@
 #include "MantidMDAlgorithms/CentroidPeaksMD2.h"
 #include "MantidAPI/IMDEventWorkspace.h"
 #include "MantidAPI/IPeaksWorkspace.h"
-#include "MantidDataObjects/CoordTransformDistance.h"
 #include "MantidDataObjects/LeanElasticPeaksWorkspace.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDEventSpatialIndex.h"
 #include "MantidDataObjects/PeaksWorkspace.h"
 #include "MantidKernel/ListValidator.h"
 #include "MantidKernel/System.h"
@@ -70,6 +70,9 @@ template <typename MDE, size_t nd> void CentroidPeaksMD2::integrate(typename MDE
   /// Radius to use around peaks
   double PeakRadius = getProperty("PeakRadius");
 
+  // Index of the boxes to find the events around each peak
+  const MDEventSpatialIndex<MDE, nd> index(*ws);
+
   // cppcheck-suppress syntaxError
     PRAGMA_OMP(parallel for schedule(dynamic, 10) )
     for (int i = 0; i < int(peakWS->getNumberPeaks()); ++i) {
@@ -89,14 +92,11 @@ template <typename MDE, size_t nd> void CentroidPeaksMD2::integrate(typename MDE
       else if (CoordinatesToUse == 3) //"HKL"
         pos = p.getHKL();
 
-      // Build the sphere transformation
-      bool dimensionsUsed[nd];
+      // Build the sphere
       coord_t center[nd];
-      for (size_t d = 0; d < nd; ++d) {
-        dimensionsUsed[d] = true; // Use all dimensions
+      for (size_t d = 0; d < nd; ++d)
         center[d] = static_cast<coord_t>(pos[d]);
-      }
-      CoordTransformDistance sphere(nd, center, dimensionsUsed);
+      const MDQuerySphere<nd> sphere(center, static_cast<coord_t>(PeakRadius));
 
       // Initialize the centroid to 0.0
       signal_t signal = 0;
@@ -105,7 +105,12 @@ template <typename MDE, size_t nd> void CentroidPeaksMD2::integrate(typename MDE
         centroid[d] = 0.0;
 
       // Perform centroid
-      ws->getBox()->centroidSphere(sphere, static_cast<coord_t>(PeakRadius * PeakRadius), centroid, signal);
+      index.forEachEvent(sphere, [&signal, &centroid](const MDE &event) {
+        const auto eventSignal = static_cast<coord_t>(event.getSignal());
+        signal += eventSignal;
+        for (size_t d = 0; d < nd; d++)
+          centroid[d] += event.getCenter(d) * eventSignal;
+      });
 
       // Normalize by signal
       if (signal != 0.0) {
@@ -10,6 +10,7 @@
 #include "MantidGeometry/Crystal/IndexingUtils.h"
 
 #include <boost/math/special_functions/round.hpp>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <memory>
@@ -49,13 +50,16 @@ using Mantid::Kernel::V3D;
 Integrate3DEvents::Integrate3DEvents(
     const std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> &peak_q_list,
     Kernel::DblMatrix const &UBinv, double radius, const bool useOnePercentBackgroundCorrection)
-    : m_UBinv(UBinv), m_radius(radius), maxOrder(0), crossterm(0),
+    : m_events_grouped(true), m_UBinv(UBinv), m_radius(radius), maxOrder(0), crossterm(0),
       m_useOnePercentBackgroundCorrection(useOnePercentBackgroundCorrection) {
+  std::vector<std::pair<int64_t, V3D>> peaks;
+  peaks.reserve(peak_q_list.size());
   for (size_t it = 0; it != peak_q_list.size(); ++it) {
     int64_t hkl_key = getHklKey(peak_q_list[it].second);
     if (hkl_key != 0) // only save if hkl != (0,0,0)
-      m_peak_qs[hkl_key] = peak_q_list[it].second;
+      peaks.emplace_back(hkl_key, peak_q_list[it].second);
   }
+  setPeaks(std::move(peaks));
 }
 
 /**
@@ -85,16 +89,92 @@ Integrate3DEvents::Integrate3DEvents(
     std::vector<V3D> const &hkl_list, std::vector<V3D> const &mnp_list, Kernel::DblMatrix const &UBinv,
     Kernel::DblMatrix const &ModHKL, double radius_m, double radius_s, int MaxO, const bool CrossT,
     const bool useOnePercentBackgroundCorrection)
-    : m_UBinv(UBinv), m_ModHKL(ModHKL), m_radius(radius_m), s_radius(radius_s), maxOrder(MaxO), crossterm(CrossT),
-      m_useOnePercentBackgroundCorrection(useOnePercentBackgroundCorrection) {
+    : m_events_grouped(true), m_UBinv(UBinv), m_ModHKL(ModHKL), m_radius(radius_m), s_radius(radius_s),
+      maxOrder(MaxO), crossterm(CrossT), m_useOnePercentBackgroundCorrection(useOnePercentBackgroundCorrection) {
+  std::vector<std::pair<int64_t, V3D>> peaks;
+  peaks.reserve(peak_q_list.size());
   for (size_t it = 0; it != peak_q_list.size(); ++it) {
     int64_t hklmnp_key =
         getHklMnpKey(boost::math::iround<double>(hkl_list[it][0]), boost::math::iround<double>(hkl_list[it][1]),
                      boost::math::iround<double>(hkl_list[it][2]), boost::math::iround<double>(mnp_list[it][0]),
                      boost::math::iround<double>(mnp_list[it][1]), boost::math::iround<double>(mnp_list[it][2]));
     if (hklmnp_key != 0) // only save if hkl != (0,0,0)
-      m_peak_qs[hklmnp_key] = peak_q_list[it].second;
+      peaks.emplace_back(hklmnp_key, peak_q_list[it].second);
+  }
+  setPeaks(std::move(peaks));
+}
+
+/**
+ * Store the peak Q-vectors sorted by their keys, so that the events of the
+ * peaks can be stored in the same order. If several peaks have the same key
+ * the last one is kept.
+ *
+ * @param peaks  The keys and Q-vectors of the peaks
+ */
+void Integrate3DEvents::setPeaks(std::vector<std::pair<int64_t, V3D>> peaks) {
+  std::stable_sort(peaks.begin(), peaks.end(),
+                   [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+  for (const auto &peak : peaks) {
+    if (!m_peak_keys.empty() && m_peak_keys.back() == peak.first) {
+      m_peak_qs.back() = peak.second;
+    } else {
+      m_peak_keys.emplace_back(peak.first);
+      m_peak_qs.emplace_back(peak.second);
+    }
+  }
+  m_event_offsets.assign(m_peak_keys.size() + 1, 0);
+}
+
+/**
+ * Find the index of the peak with the given key.
+ *
+ * @param key  The key of the peak
+ * @return The index of the peak or the number of peaks if there is none
+ */
+size_t Integrate3DEvents::findPeak(int64_t key) const {
+  const auto it = std::lower_bound(m_peak_keys.cbegin(), m_peak_keys.cend(), key);
+  if (it == m_peak_keys.cend() || *it != key)
+    return m_peak_keys.size();
+  return static_cast<size_t>(std::distance(m_peak_keys.cbegin(), it));
+}
+
+/**
+ * Merge the events added since the last call into the buffer holding the
+ * events of all peaks, so that the events of each peak are contiguous and
+ * in the order they were added. This is done once, the first time events are
+ * requested after adding some, and is safe to call from several threads.
+ */
+void Integrate3DEvents::groupEvents() {
+  if (m_events_grouped.load(std::memory_order_acquire))
+    return;
+  std::lock_guard<std::mutex> lock(m_group_mutex);
+  if (m_events_grouped.load(std::memory_order_relaxed))
+    return;
+
+  // count the events of each peak to find where they start
+  const size_t numPeaks = m_peak_keys.size();
+  std::vector<size_t> offsets(numPeaks + 1, 0);
+  for (size_t peak = 0; peak < numPeaks; ++peak)
+    offsets[peak + 1] = m_event_offsets[peak + 1] - m_event_offsets[peak];
+  for (const auto peak : m_new_event_peaks)
+    ++offsets[peak + 1];
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+  // the events grouped before go first, then the new ones
+  std::vector<Event> events(offsets.back());
+  std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+  for (size_t peak = 0; peak < numPeaks; ++peak) {
+    for (size_t i = m_event_offsets[peak]; i < m_event_offsets[peak + 1]; ++i)
+      events[next[peak]++] = m_events[i];
   }
+  for (size_t i = 0; i < m_new_events.size(); ++i)
+    events[next[m_new_event_peaks[i]]++] = m_new_events[i];
+
+  m_events.swap(events);
+  m_event_offsets.swap(offsets);
+  std::vector<Event>().swap(m_new_events);
+  std::vector<uint32_t>().swap(m_new_event_peaks);
+  m_events_grouped.store(true, std::memory_order_release);
 }
 
 /**
@@ -116,6 +196,7 @@ Integrate3DEvents::Integrate3DEvents(
  */
 void Integrate3DEvents::addEvents(std::vector<std::pair<std::pair<double, double>, V3D>> const &event_qs,
                                   bool hkl_integ) {
+  m_events_grouped.store(false, std::memory_order_relaxed);
   if (!maxOrder)
     for (const auto &event_q : event_qs)
       addEvent(event_q, hkl_integ);
@@ -130,11 +211,7 @@ Integrate3DEvents::integrateStrongPeak(const IntegrationParameters &params, cons
 
   inti = 0.0; // default values, in case something
   sigi = 0.0; // is wrong with the peak.
-  auto result = getEvents(peak_q);
-  if (!result)
-    return std::make_pair(std::make_shared<NoShape>(), make_tuple(0., 0., 0.));
-
-  const auto &events = *result;
+  const auto events = getEvents(peak_q);
   if (events.empty())
     return std::make_pair(std::make_shared<NoShape>(), make_tuple(0., 0., 0.));
 
@@ -210,12 +287,10 @@ Integrate3DEvents::integrateWeakPeak(const IntegrationParameters &params, PeakSh
   inti = 0.0; // default values, in case something
   sigi = 0.0; // is wrong with the peak.
 
-  auto result = getEvents(center);
-  if (!result)
+  const auto events = getEvents(center);
+  if (events.empty())
     return std::make_shared<NoShape>();
 
-  const auto &events = *result;
-
   const auto &directions = shape->directions();
   auto abcBackgroundInnerRadii = shape->abcRadiiBackgroundInner();
   auto abcBackgroundOuterRadii = shape->abcRadiiBackgroundOuter();
@@ -265,11 +340,7 @@ Integrate3DEvents::integrateWeakPeak(const IntegrationParameters &params, PeakSh
 double Integrate3DEvents::estimateSignalToNoiseRatio(const IntegrationParameters &params, const V3D &center,
                                                      bool forceSpherical, double sphericityTol) {
 
-  auto result = getEvents(center);
-  if (!result)
-    return .0;
-
-  const auto &events = *result;
+  const auto events = getEvents(center);
   if (events.empty())
     return .0;
 
@@ -324,23 +395,29 @@ double Integrate3DEvents::estimateSignalToNoiseRatio(const IntegrationParameters
   return inti / sigi;
 }
 
-const std::vector<std::pair<std::pair<double, double>, V3D>> *Integrate3DEvents::getEvents(const V3D &peak_q) {
+Integrate3DEvents::EventRange Integrate3DEvents::getEvents(const V3D &peak_q) {
   auto hkl_key = getHklKey(peak_q);
   if (maxOrder)
     hkl_key = getHklMnpKey(peak_q);
 
-  if (hkl_key == 0)
-    return nullptr;
+  return getEvents(hkl_key);
+}
 
-  const auto pos = m_event_lists.find(hkl_key);
+Integrate3DEvents::EventRange Integrate3DEvents::getEvents(int64_t key) {
+  if (key == 0)
+    return EventRange();
 
-  if (m_event_lists.end() == pos)
-    return nullptr;
+  const auto peak = findPeak(key);
+  if (peak == m_peak_keys.size())
+    return EventRange();
 
-  if (pos->second.size() < 3) // if there are not enough events
-    return nullptr;
+  groupEvents();
+  const auto first = m_event_offsets[peak];
+  const auto last = m_event_offsets[peak + 1];
+  if (last - first < 3) // if there are not enough events
+    return EventRange();
 
-  return &(pos->second);
+  return EventRange(m_events.data() + first, m_events.data() + last);
 }
 
 bool Integrate3DEvents::correctForDetectorEdges(std::tuple<double, double, double> &radii,
@@ -421,15 +498,9 @@ Integrate3DEvents::ellipseIntegrateEvents(const std::vector<V3D> &E1Vec, V3D con
     return std::make_shared<NoShape>();
   }
 
-  auto pos = m_event_lists.find(hkl_key);
-  if (m_event_lists.end() == pos)
-    return std::make_shared<NoShape>();
-  ;
-
-  std::vector<std::pair<std::pair<double, double>, V3D>> &some_events = pos->second;
-
-  if (some_events.size() < 3) // if there are not enough events to
-  {                           // find covariance matrix, return
+  const auto some_events = getEvents(hkl_key);
+  if (some_events.empty()) // if there are not enough events to
+  {                        // find covariance matrix, return
     return std::make_shared<NoShape>();
   }
 
@@ -473,15 +544,9 @@ Integrate3DEvents::ellipseIntegrateModEvents(const std::vector<V3D> &E1Vec, V3D
     return std::make_shared<NoShape>();
   }
 
-  auto pos = m_event_lists.find(hkl_key);
-  if (m_event_lists.end() == pos)
-    return std::make_shared<NoShape>();
-  ;
-
-  std::vector<std::pair<std::pair<double, double>, V3D>> &some_events = pos->second;
-
-  if (some_events.size() < 3) // if there are not enough events to
-  {                           // find covariance matrix, return
+  const auto some_events = getEvents(hkl_key);
+  if (some_events.empty()) // if there are not enough events to
+  {                        // find covariance matrix, return
     return std::make_shared<NoShape>();
   }
 
@@ -523,9 +588,9 @@ Integrate3DEvents::ellipseIntegrateModEvents(const std::vector<V3D> &E1Vec, V3D
  *                     of the three axes of the ellisoid.
  * @return Then number of events that are in or on the specified ellipsoid.
  */
-std::pair<double, double>
-Integrate3DEvents::numInEllipsoid(std::vector<std::pair<std::pair<double, double>, V3D>> const &events,
-                                  std::vector<V3D> const &directions, std::vector<double> const &sizes) {
+std::pair<double, double> Integrate3DEvents::numInEllipsoid(EventRange const &events,
+                                                            std::vector<V3D> const &directions,
+                                                            std::vector<double> const &sizes) {
 
   std::pair<double, double> count(0, 0);
   for (const auto &event : events) {
@@ -559,10 +624,11 @@ Integrate3DEvents::numInEllipsoid(std::vector<std::pair<std::pair<double, double
  correction should be used.
  * @return Then number of events that are in or on the specified ellipsoid.
  */
-std::pair<double, double>
-Integrate3DEvents::numInEllipsoidBkg(std::vector<std::pair<std::pair<double, double>, V3D>> const &events,
-                                     std::vector<V3D> const &directions, std::vector<double> const &sizes,
-                                     std::vector<double> const &sizesIn, const bool useOnePercentBackgroundCorrection) {
+std::pair<double, double> Integrate3DEvents::numInEllipsoidBkg(EventRange const &events,
+                                                               std::vector<V3D> const &directions,
+                                                               std::vector<double> const &sizes,
+                                                               std::vector<double> const &sizesIn,
+                                                               const bool useOnePercentBackgroundCorrection) {
   std::pair<double, double> count(0, 0);
   std::vector<std::pair<double, double>> eventVec;
   for (const auto &event : events) {
@@ -621,8 +687,7 @@ Integrate3DEvents::numInEllipsoidBkg(std::vector<std::pair<std::pair<double, dou
  *                   calculating the covariance matrix.
  */
 
-void Integrate3DEvents::makeCovarianceMatrix(std::vector<std::pair<std::pair<double, double>, V3D>> const &events,
-                                             DblMatrix &matrix, double radius) {
+void Integrate3DEvents::makeCovarianceMatrix(EventRange const &events, DblMatrix &matrix, double radius) {
   double totalCounts;
   for (int row = 0; row < 3; row++) {
     for (int col = 0; col < 3; col++) {
@@ -931,16 +996,15 @@ int64_t Integrate3DEvents::getHklMnpKey(V3D const &q_vector) {
 
 /**
  * Add an event to the appropriate vector of events for the closest h,k,l,
- * if it is within the required radius of the corresponding peak in the
- * PeakQMap.
+ * if it is within the required radius of the corresponding peak.
  *
  * NOTE: The event passed in may be modified by this method.  In particular,
  * if it corresponds to one of the specified peak_qs, the corresponding peak q
  * will be subtracted from the event and the event will be added to that
- * peak's vector in the event_lists map.
+ * peak's events.
  *
  * @param event_Q      The Q-vector for the event that may be added to the
- *                     event_lists map, if it is close enough to some peak
+ *                     events of a peak, if it is close enough to it
  * @param hkl_integ
  */
 void Integrate3DEvents::addEvent(std::pair<std::pair<double, double>, V3D> event_Q, bool hkl_integ) {
@@ -953,15 +1017,17 @@ void Integrate3DEvents::addEvent(std::pair<std::pair<double, double>, V3D> event
   if (hkl_key == 0) // don't keep events associated with 0,0,0
     return;
 
-  auto peak_it = m_peak_qs.find(hkl_key);
-  if (peak_it != m_peak_qs.end()) {
-    if (!peak_it->second.nullVector()) {
+  const auto peak = findPeak(hkl_key);
+  if (peak != m_peak_keys.size()) {
+    const auto &peak_q = m_peak_qs[peak];
+    if (!peak_q.nullVector()) {
       if (hkl_integ)
-        event_Q.second = event_Q.second - m_UBinv * peak_it->second;
+        event_Q.second = event_Q.second - m_UBinv * peak_q;
       else
-        event_Q.second = event_Q.second - peak_it->second;
+        event_Q.second = event_Q.second - peak_q;
       if (event_Q.second.norm() < m_radius) {
-        m_event_lists[hkl_key].emplace_back(event_Q);
+        m_new_events.emplace_back(event_Q);
+        m_new_event_peaks.emplace_back(static_cast<uint32_t>(peak));
       }
     }
   }
@@ -969,16 +1035,15 @@ void Integrate3DEvents::addEvent(std::pair<std::pair<double, double>, V3D> event
 
 /**
  * Add an event to the appropriate vector of events for the closest h,k,l,
- * if it is within the required radius of the corresponding peak in the
- * PeakQMap.
+ * if it is within the required radius of the corresponding peak.
  *
  * NOTE: The event passed in may be modified by this method.  In particular,
  * if it corresponds to one of the specified peak_qs, the corresponding peak q
  * will be subtracted from the event and the event will be added to that
- * peak's vector in the event_lists map.
+ * peak's events.
  *
  * @param event_Q      The Q-vector for the event that may be added to the
- *                     event_lists map, if it is close enough to some peak
+ *                     events of a peak, if it is close enough to it
  * @param hkl_integ
  */
 void Integrate3DEvents::addModEvent(std::pair<std::pair<double, double>, V3D> event_Q, bool hkl_integ) {
@@ -992,19 +1057,19 @@ void Integrate3DEvents::addModEvent(std::pair<std::pair<double, double>, V3D> ev
   if (hklmnp_key == 0) // don't keep events associated with 0,0,0
     return;
 
-  auto peak_it = m_peak_qs.find(hklmnp_key);
-  if (peak_it != m_peak_qs.end()) {
-    if (!peak_it->second.nullVector()) {
+  const auto peak = findPeak(hklmnp_key);
+  if (peak != m_peak_keys.size()) {
+    const auto &peak_q = m_peak_qs[peak];
+    if (!peak_q.nullVector()) {
       if (hkl_integ)
-        event_Q.second = event_Q.second - m_UBinv * peak_it->second;
+        event_Q.second = event_Q.second - m_UBinv * peak_q;
       else
-        event_Q.second = event_Q.second - peak_it->second;
+        event_Q.second = event_Q.second - peak_q;
 
-      if (hklmnp_key % 10000 == 0) {
-        if (event_Q.second.norm() < m_radius)
-          m_event_lists[hklmnp_key].emplace_back(event_Q);
-      } else if (event_Q.second.norm() < s_radius) {
-        m_event_lists[hklmnp_key].emplace_back(event_Q);
+      const double radius = (hklmnp_key % 10000 == 0) ? m_radius : s_radius;
+      if (event_Q.second.norm() < radius) {
+        m_new_events.emplace_back(event_Q);
+        m_new_event_peaks.emplace_back(static_cast<uint32_t>(peak));
       }
     }
   }
@@ -1048,10 +1113,9 @@ void Integrate3DEvents::addModEvent(std::pair<std::pair<double, double>, V3D> ev
  *
  */
 PeakShapeEllipsoid_const_sptr Integrate3DEvents::ellipseIntegrateEvents(
-    const std::vector<V3D> &E1Vec, V3D const &peak_q,
-    std::vector<std::pair<std::pair<double, double>, Mantid::Kernel::V3D>> const &ev_list,
-    std::vector<V3D> const &directions, std::vector<double> const &sigmas, bool specify_size, double peak_radius,
-    double back_inner_radius, double back_outer_radius, std::vector<double> &axes_radii, double &inti, double &sigi) {
+    const std::vector<V3D> &E1Vec, V3D const &peak_q, EventRange const &ev_list, std::vector<V3D> const &directions,
+    std::vector<double> const &sigmas, bool specify_size, double peak_radius, double back_inner_radius,
+    double back_outer_radius, std::vector<double> &axes_radii, double &inti, double &sigi) {
   // r1, r2 and r3 will give the sizes of the major axis of
   // the peak ellipsoid, and of the inner and outer surface
   // of the background ellipsoidal shell, respectively.
@@ -202,11 +202,21 @@ void IntegrateEllipsoidsTwoStep::exec() {
   std::vector<std::pair<int, V3D>> weakPeaks, strongPeaks;
 
   // Compute signal to noise ratio for all peaks
-  for (int index = 0; static_cast<size_t>(index) < qList.size(); ++index) {
-    const auto &item = qList[index];
-    const auto center = item.second;
+  const int numPeaks = static_cast<int>(qList.size());
+  std::vector<double> sig2noiseRatios(qList.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int index = 0; index < numPeaks; ++index) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto center = qList[index].second;
     IntegrationParameters params = makeIntegrationParameters(center);
-    auto sig2noise = integrator.estimateSignalToNoiseRatio(params, center);
+    sig2noiseRatios[index] = integrator.estimateSignalToNoiseRatio(params, center);
+    PARALLEL_END_INTERUPT_REGION
+  }
+  PARALLEL_CHECK_INTERUPT_REGION
+
+  for (int index = 0; index < numPeaks; ++index) {
+    const auto center = qList[index].second;
+    const auto sig2noise = sig2noiseRatios[index];
 
     auto &peak = peak_ws->getPeak(index);
     peak.setIntensity(0);
@@ -224,23 +234,29 @@ void IntegrateEllipsoidsTwoStep::exec() {
     }
   }
 
-  std::vector<std::pair<std::shared_ptr<const Geometry::PeakShape>, std::tuple<double, double, double>>> shapeLibrary;
+  std::vector<std::pair<std::shared_ptr<const Geometry::PeakShape>, std::tuple<double, double, double>>> shapeLibrary(
+      strongPeaks.size());
 
   // Integrate strong peaks
-  for (const auto &item : strongPeaks) {
-    const auto index = item.first;
-    const auto &q = item.second;
+  const int numStrongPeaks = static_cast<int>(strongPeaks.size());
+  PARALLEL_FOR_NO_WSP_CHECK()
+  for (int i = 0; i < numStrongPeaks; ++i) {
+    PARALLEL_START_INTERUPT_REGION
+    const auto index = strongPeaks[i].first;
+    const auto &q = strongPeaks[i].second;
     double inti, sigi;
 
     IntegrationParameters params = makeIntegrationParameters(q);
     const auto result = integrator.integrateStrongPeak(params, q, inti, sigi);
-    shapeLibrary.emplace_back(result);
+    shapeLibrary[i] = result;
 
     auto &peak = peak_ws->getPeak(index);
     peak.setIntensity(inti);
     peak.setSigmaIntensity(sigi);
     peak.setPeakShape(std::get<0>(result));
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
 
   std::vector<Eigen::Vector3d> points;
   std::transform(strongPeaks.begin(), strongPeaks.end(), std::back_inserter(points),
@@ -22,6 +22,7 @@
 #include "MantidDataObjects/LeanElasticPeaksWorkspace.h"
 #include "MantidDataObjects/MDBoxIterator.h"
 #include "MantidDataObjects/MDEventFactory.h"
+#include "MantidDataObjects/MDEventSpatialIndex.h"
 #include "MantidDataObjects/Peak.h"
 #include "MantidDataObjects/PeakShapeEllipsoid.h"
 #include "MantidDataObjects/PeakShapeSpherical.h"
@@ -458,22 +459,25 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
   double volumeBkg = 4.0 / 3.0 * M_PI * (std::pow(BackgroundOuterRadius[0], 3) - std::pow(BackgroundOuterRadius[0], 3));
   // volume of PeakRadius sphere
   double volumeRadius = 4.0 / 3.0 * M_PI * std::pow(PeakRadius[0], 3);
+  // Index of the boxes to find the events around each peak for the ellipsoids,
+  // which can only be built for 3 and 4 dimensions
+  std::unique_ptr<MDEventSpatialIndex<MDE, nd>> spatialIndex;
+  if (isEllipse && PeakRadius.size() == 1 && (nd == 3 || nd == 4))
+    spatialIndex = std::make_unique<MDEventSpatialIndex<MDE, nd>>(*ws);
   //
-  // If the following OMP pragma is included, this algorithm seg faults
-  // sporadically when processing multiple TOPAZ runs in a script, on
-  // Scientific Linux 6.2.  Typically, it seg faults after 2 to 6 runs are
-  // processed, though occasionally it will process all 8 requested in the
-  // script without crashing.  Since the lower level codes already use OpenMP,
-  // parallelizing at this level is only marginally useful, giving about a
-  // 5-10% speedup.  Perhaps is should just be removed permanantly, but for
-  // now it is commented out to avoid the seg faults.  Refs #5533
-  // PRAGMA_OMP(parallel for schedule(dynamic, 10) )
+  // The peaks are integrated in parallel when the events are all in memory,
+  // as integrating a peak only reads the boxes and writes to its own peak.
+  // The events of a file-backed box are released to the disk buffer after
+  // each integration, which may then write out a box another thread is still
+  // reading, and the cylinder integration fits the profiles and writes the
+  // fits to a single file in peak order, so those are integrated serially.
+  const bool integrateInParallel = !cylinderBool && !ws->isFileBacked();
   // Initialize progress reporting
   int nPeaks = peakWS->getNumberPeaks();
   Progress progress(this, 0., 1., nPeaks);
+  PRAGMA_OMP(parallel for schedule(dynamic) if (integrateInParallel))
   for (int i = 0; i < nPeaks; ++i) {
-    if (this->getCancel())
-      break; // User cancellation
+    PARALLEL_START_INTERUPT_REGION
     progress.report();
 
     // Get a direct ref to that peak.
@@ -572,8 +576,9 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
         V3D translation(0.0, 0.0, 0.0); // translation from peak pos to centroid
         if (PeakRadius.size() == 1) {
           V3D mean(0.0, 0.0, 0.0); // vector to hold centroid
-          findEllipsoid<MDE, nd>(ws, getRadiusSq, pos, static_cast<coord_t>(pow(PeakRadiusVector[i], 2)), qAxisIsFixed,
-                                 useCentroid, bgDensity, eigenvects, eigenvals, mean, maxCovarIter);
+          findEllipsoid<MDE, nd>(ws, spatialIndex.get(), getRadiusSq, pos,
+                                 static_cast<coord_t>(pow(PeakRadiusVector[i], 2)), qAxisIsFixed, useCentroid,
+                                 bgDensity, eigenvects, eigenvals, mean, maxCovarIter);
           if (!majorAxisLengthFixed) {
             // replace radius for this peak with 3*stdev along major axis
             auto max_stdev = sqrt(*std::max_element(eigenvals.begin(), eigenvals.end()));
@@ -892,7 +897,9 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
     g_log.information() << "Peak " << i << " at " << pos << ": signal " << signal << " (sig^2 " << errorSquared
                         << "), with background " << bgSignal + ratio * background_total << " (sig^2 "
                         << bgErrorSquared + ratio * ratio * std::fabs(background_total) << ") subtracted.\n";
+    PARALLEL_END_INTERUPT_REGION
   }
+  PARALLEL_CHECK_INTERUPT_REGION
   // This flag is used by the PeaksWorkspace to evaluate whether it has
   // been integrated.
   peakWS->mutableRun().addProperty("PeaksIntegrated", 1, true);
@@ -926,6 +933,7 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
  * vectors provided
  *
  *  @param ws             input workspace
+ *  @param index          index of the boxes of ws, or null to walk the boxes
  *  @param getRadiusSq    Coord transfrom for sphere
  *  @param pos            V3D of peak centre
  *  @param radiusSquared  radius that defines spherical region for covarariance
@@ -939,62 +947,71 @@ template <typename MDE, size_t nd> void IntegratePeaksMD2::integrate(typename MD
  */
 template <typename MDE, size_t nd>
 void IntegratePeaksMD2::findEllipsoid(const typename MDEventWorkspace<MDE, nd>::sptr ws,
-                                      const CoordTransform &getRadiusSq, const V3D &pos, const coord_t &radiusSquared,
-                                      const bool &qAxisIsFixed, const bool &useCentroid, const double &bgDensity,
-                                      std::vector<V3D> &eigenvects, std::vector<double> &eigenvals, V3D &mean,
-                                      const int maxIter) {
-
-  // get leaf-only iterators over all boxes in ws
-  auto function = std::make_unique<Geometry::MDAlgorithms::MDBoxMaskFunction>(pos, radiusSquared);
-  MDBoxBase<MDE, nd> *baseBox = ws->getBox();
-  MDBoxIterator<MDE, nd> MDiter(baseBox, 1000, true, function.get());
+                                      const MDEventSpatialIndex<MDE, nd> *index, const CoordTransform &getRadiusSq,
+                                      const V3D &pos, const coord_t &radiusSquared, const bool &qAxisIsFixed,
+                                      const bool &useCentroid, const double &bgDensity, std::vector<V3D> &eigenvects,
+                                      std::vector<double> &eigenvals, V3D &mean, const int maxIter) {
 
   // get initial vector of events inside sphere
   std::vector<std::pair<V3D, double>> peak_events;
 
-  do {
-    auto *box = dynamic_cast<MDBox<MDE, nd> *>(MDiter.getBox());
-    if (box && !box->getIsMasked()) {
-
-      // simple check whether box is defintely not contained
-      coord_t boxCenter[nd];
-      box->getCenter(boxCenter);
-      V3D displacement;   // vector between peak pos and box center
-      coord_t rboxSq = 0; // dist from center to vertex sq
+  const auto addEvents = [&](const MDBox<MDE, nd> &box, const std::vector<MDE> &events) {
+    auto bg = bgDensity / (static_cast<double>(events.size()) * (box.getInverseVolume()));
+    // For each event
+    for (const auto &evnt : events) {
+
+      coord_t center_array[nd];
       for (size_t d = 0; d < nd; ++d) {
-        auto dim = box->getExtents(d);
-        rboxSq += static_cast<coord_t>(0.25 * dim.getSize() * dim.getSize());
-        displacement[d] = pos[d] - static_cast<double>(boxCenter[d]);
+        center_array[d] = evnt.getCenter(d);
       }
-
-      if (displacement.norm() < static_cast<double>(sqrt(rboxSq)) + static_cast<double>(sqrt(radiusSquared))) {
-        // box MIGHT intersect peak spherical region so go through events
-        const std::vector<MDE> &events = box->getConstEvents();
-        auto bg = bgDensity / (static_cast<double>(events.size()) * (box->getInverseVolume()));
-        // For each event
-        for (const auto &evnt : events) {
-
-          coord_t center_array[nd];
-          for (size_t d = 0; d < nd; ++d) {
-            center_array[d] = evnt.getCenter(d);
-          }
-          coord_t out[1];
-          auto *cen_ptr = center_array; // pointer to first element
-          getRadiusSq.apply(cen_ptr, out);
-
-          if (evnt.getSignal() > bg && out[0] < radiusSquared) {
-            // need in V3D for matrix maths later
-            V3D center;
-            for (size_t d = 0; d < nd; ++d) {
-              center[d] = static_cast<double>(center_array[d]);
-            }
-            peak_events.emplace_back(center, evnt.getSignal() - bg);
-          }
+      coord_t out[1];
+      auto *cen_ptr = center_array; // pointer to first element
+      getRadiusSq.apply(cen_ptr, out);
+
+      if (evnt.getSignal() > bg && out[0] < radiusSquared) {
+        // need in V3D for matrix maths later
+        V3D center;
+        for (size_t d = 0; d < std::min(nd, size_t(3)); ++d) {
+          center[d] = static_cast<double>(center_array[d]);
         }
+        peak_events.emplace_back(center, evnt.getSignal() - bg);
       }
     }
-    box->releaseEvents();
-  } while (MDiter.next());
+  };
+
+  coord_t peakCenter[nd];
+  for (size_t d = 0; d < nd; ++d) {
+    peakCenter[d] = d < 3 ? static_cast<coord_t>(pos[d]) : 0;
+  }
+  if (index) {
+    // go through the events of the boxes that MIGHT intersect peak spherical region
+    index->forEachBox(MDQuerySphere<nd>(peakCenter, std::sqrt(radiusSquared)), addEvents);
+  } else {
+    // get leaf-only iterators over all boxes in ws
+    auto function = std::make_unique<Geometry::MDAlgorithms::MDBoxMaskFunction>(pos, radiusSquared);
+    MDBoxBase<MDE, nd> *baseBox = ws->getBox();
+    MDBoxIterator<MDE, nd> MDiter(baseBox, 1000, true, function.get());
+    do {
+      auto *box = dynamic_cast<MDBox<MDE, nd> *>(MDiter.getBox());
+      if (box && !box->getIsMasked()) {
+        // simple check whether box is defintely not contained
+        coord_t boxCenter[nd];
+        box->getCenter(boxCenter);
+        coord_t displacementSq = 0; // dist from peak pos to box center sq
+        coord_t rboxSq = 0;         // dist from center to vertex sq
+        for (size_t d = 0; d < nd; ++d) {
+          auto dim = box->getExtents(d);
+          rboxSq += static_cast<coord_t>(0.25 * dim.getSize() * dim.getSize());
+          displacementSq += (peakCenter[d] - boxCenter[d]) * (peakCenter[d] - boxCenter[d]);
+        }
+        if (sqrt(displacementSq) < sqrt(rboxSq) + sqrt(radiusSquared)) {
+          // box MIGHT intersect peak spherical region so go through events
+          addEvents(*box, box->getConstEvents());
+        }
+        box->releaseEvents();
+      }
+    } while (MDiter.next());
+  }
   calcCovar(peak_events, pos, radiusSquared, qAxisIsFixed, useCentroid, eigenvects, eigenvals, mean, maxIter);
 }
 
@@ -514,6 +514,16 @@ void MDNorm::exec() {
   }
 
   m_numExptInfos = outputDataWS->getNumExperimentInfo();
+  // The normalization of all experiment infos and symmetry operations is
+  // accumulated here, then added to the normalization workspaces once
+  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
+  const size_t numNPoints = (m_backgroundWS) ? m_bkgdNormWS->getNPoints() : 0;
+  if (m_backgroundWS && numNPoints != m_normWS->getNPoints()) {
+    throw std::runtime_error("N points are different");
+  }
+  std::vector<std::atomic<signal_t>> bkgdSignalArray(numNPoints);
+  const bool addToNormalization = m_accumulate;
+  bool normalized = false;
   // loop over all experiment infos
   for (uint16_t expInfoIndex = 0; expInfoIndex < m_numExptInfos; expInfoIndex++) {
     // Check for other dimensions if we could measure anything in the original
@@ -524,12 +534,8 @@ void MDNorm::exec() {
     cacheDimensionXValues();
 
     if (!skipNormalization) {
-      size_t symmOpsIndex = 0;
-      for (const auto &so : symmetryOps) {
-        calculateNormalization(otherValues, so, expInfoIndex, symmOpsIndex);
-        symmOpsIndex++;
-      }
-
+      calculateNormalization(otherValues, symmetryOps, expInfoIndex, signalArray, bkgdSignalArray);
+      normalized = true;
     } else {
       g_log.warning("Binning limits are outside the limits of the MDWorkspace. "
                     "Not applying normalization.");
@@ -537,6 +543,12 @@ void MDNorm::exec() {
     // if more than one experiment info, keep accumulating
     m_accumulate = true;
   }
+  if (normalized) {
+    addNormalization(signalArray, *m_normWS, addToNormalization);
+    // [Task 89] Process background
+    if (m_backgroundWS)
+      addNormalization(bkgdSignalArray, *m_bkgdNormWS, addToNormalization);
+  }
 
   API::IMDWorkspace_sptr out(nullptr);
 
@@ -1458,15 +1470,19 @@ inline void MDNorm::calcSingleDetectorNorm(const std::vector<std::array<double,
 }
 
 /**
- * Computed the normalization for the input workspace. Results are stored in
- * m_normWS
+ * Computed the normalization of an experiment info for all the symmetry
+ * operations. Each thread takes detectors and goes through the symmetry
+ * operations for each of them, reusing its intersection vectors.
  * @param otherValues - values for dimensions other than Q or DeltaE
- * @param so - symmetry operation
+ * @param symmetryOps - symmetry operations
  * @param expInfoIndex - current experiment info index
- * @param soIndex - the index of symmetry operation (for progress purposes only)
+ * @param signalArray - (output) normalization to add to
+ * @param bkgdSignalArray - (output) background normalization to add to
  */
-void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, const Geometry::SymmetryOperation &so,
-                                    uint16_t expInfoIndex, size_t soIndex) {
+void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues,
+                                    const std::vector<Geometry::SymmetryOperation> &symmetryOps,
+                                    uint16_t expInfoIndex, std::vector<std::atomic<signal_t>> &signalArray,
+                                    std::vector<std::atomic<signal_t>> &bkgdSignalArray) {
   const auto &currentExptInfo = *(m_inputWS->getExperimentInfo(expInfoIndex));
   std::vector<double> lowValues, highValues;
   auto *lowValuesLog = dynamic_cast<VectorDoubleProperty *>(currentExptInfo.getLog("MDNorm_low"));
@@ -1474,9 +1490,12 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
   auto *highValuesLog = dynamic_cast<VectorDoubleProperty *>(currentExptInfo.getLog("MDNorm_high"));
   highValues = (*highValuesLog)();
 
-  // calculate Q transformation matrix (R * UB * SymmetryOperation * m_W)^-1
+  // calculate Q transformation matrices (R * UB * SymmetryOperation * m_W)^-1
   // in order to calculate intersections
-  DblMatrix Qtransform = calQTransform(currentExptInfo, so);
+  std::vector<DblMatrix> Qtransforms;
+  Qtransforms.reserve(symmetryOps.size());
+  for (const auto &so : symmetryOps)
+    Qtransforms.emplace_back(calQTransform(currentExptInfo, so));
 
   // get proton charges
   const double protonCharge = currentExptInfo.run().getProtonCharge();
@@ -1499,23 +1518,16 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
   const detid2index_map fluxDetToIdx =
       (m_diffraction) ? integrFlux->getDetectorIDToWorkspaceIndexMap() : detid2index_map();
 
-  // Define dimension, signal array
+  // Define dimension
   const size_t vmdDims = (m_diffraction) ? 3 : 4;
-  std::vector<std::atomic<signal_t>> signalArray(m_normWS->getNPoints());
-
-  size_t numNPoints = (m_backgroundWS) ? m_bkgdNormWS->getNPoints() : 0;
-  if (m_backgroundWS && numNPoints != m_normWS->getNPoints()) {
-    throw std::runtime_error("N points are different");
-  }
-  std::vector<std::atomic<signal_t>> bkgdSignalArray(numNPoints);
 
   std::vector<std::array<double, 4>> intersections;
   std::vector<double> xValues, yValues;
   std::vector<coord_t> pos, posNew;
 
   // Progress report
-  double progStep = 0.7 / static_cast<double>(m_numExptInfos * m_numSymmOps);
-  auto progIndex = static_cast<double>(soIndex + expInfoIndex * m_numSymmOps);
+  double progStep = 0.7 / static_cast<double>(m_numExptInfos);
+  auto progIndex = static_cast<double>(expInfoIndex);
   auto prog =
       std::make_unique<API::Progress>(this, 0.3 + progStep * progIndex, 0.3 + progStep * (1. + progIndex), ndets);
   // muliple threading
@@ -1525,7 +1537,7 @@ void MDNorm::calculateNormalization(const std::vector<coord_t> &otherValues, con
   }
 
   // cppcheck-suppress syntaxError
-PRAGMA_OMP(parallel for private(intersections, xValues, yValues, pos, posNew) if (safe))
+PRAGMA_OMP(parallel for schedule(dynamic, 64) private(intersections, xValues, yValues, pos, posNew) if (safe))
 for (int64_t i = 0; i < ndets; i++) {
   PARALLEL_START_INTERUPT_REGION
 
@@ -1551,60 +1563,60 @@ for (int64_t i = 0; i < ndets; i++) {
     }
   }
 
-  // Intersections for sample and background if present
-  this->calculateIntersections(intersections, theta, phi, Qtransform, lowValues[i], highValues[i]);
-
-  // No need to do normalization calculation if there is no intersection
-  if (intersections.empty())
-    continue;
-
-  // Get solid angle for this contribution
-  double solid = protonCharge;
-  // [Task 89]
-  double bkgdSolid = protonChargeBkgd;
-  if (haveSA) {
-    double solid_angle_factor = solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0];
-    //  solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0]
-    solid = solid_angle_factor * protonCharge;
-    // [Task 89]
-    bkgdSolid = solid_angle_factor * protonChargeBkgd;
-  }
-
-  if (m_diffraction) {
-    // -- calculate integrals for the intersection --
-    calcDiffractionIntersectionIntegral(intersections, xValues, yValues, *integrFlux, wsIdx);
-  }
-
   // Compute final position in HKL
   // pre-allocate for efficiency and copy non-hkl dim values into place
   pos.resize(vmdDims + otherValues.size());
   std::copy(otherValues.begin(), otherValues.end(), pos.begin() + vmdDims);
 
-  calcSingleDetectorNorm(intersections, solid, yValues, vmdDims, pos, posNew, signalArray, bkgdSolid,
-                         bkgdSignalArray); // [Task 89] ADD solidBkgd, bkgdYValues, bkgdSignalArray
+  for (const auto &Qtransform : Qtransforms) {
+    // Intersections for sample and background if present
+    this->calculateIntersections(intersections, theta, phi, Qtransform, lowValues[i], highValues[i]);
+
+    // No need to do normalization calculation if there is no intersection
+    if (intersections.empty())
+      continue;
+
+    // Get solid angle for this contribution
+    double solid = protonCharge;
+    // [Task 89]
+    double bkgdSolid = protonChargeBkgd;
+    if (haveSA) {
+      double solid_angle_factor = solidAngleWS->y(solidAngDetToIdx.find(detID)->second)[0];
+      solid = solid_angle_factor * protonCharge;
+      // [Task 89]
+      bkgdSolid = solid_angle_factor * protonChargeBkgd;
+    }
+
+    if (m_diffraction) {
+      // -- calculate integrals for the intersection --
+      calcDiffractionIntersectionIntegral(intersections, xValues, yValues, *integrFlux, wsIdx);
+    }
+
+    calcSingleDetectorNorm(intersections, solid, yValues, vmdDims, pos, posNew, signalArray, bkgdSolid,
+                           bkgdSignalArray); // [Task 89] ADD solidBkgd, bkgdYValues, bkgdSignalArray
+  }
 
   prog->report();
 
   PARALLEL_END_INTERUPT_REGION
 }
 PARALLEL_CHECK_INTERUPT_REGION
-if (m_accumulate) {
-  std::transform(signalArray.cbegin(), signalArray.cend(), m_normWS->getSignalArray(), m_normWS->mutableSignalArray(),
-                 [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-  // [Task 89] Process background
-  if (m_backgroundWS)
-    std::transform(bkgdSignalArray.cbegin(), bkgdSignalArray.cend(), m_bkgdNormWS->getSignalArray(),
-                   m_bkgdNormWS->mutableSignalArray(),
-                   [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
-
-} else {
-  // First time, init
-  std::copy(signalArray.cbegin(), signalArray.cend(), m_normWS->mutableSignalArray());
-  // [Task 89]
-  if (m_backgroundWS)
-    std::copy(bkgdSignalArray.cbegin(), bkgdSignalArray.cend(), m_bkgdNormWS->mutableSignalArray());
 }
-m_accumulate = true;
+
+/**
+ * Add a normalization to a normalization workspace
+ * @param signalArray - the normalization
+ * @param normWS - the normalization workspace
+ * @param accumulate - if false, replace the signal of the workspace
+ */
+void MDNorm::addNormalization(const std::vector<std::atomic<signal_t>> &signalArray,
+                              DataObjects::MDHistoWorkspace &normWS, const bool accumulate) {
+  if (accumulate) {
+    std::transform(signalArray.cbegin(), signalArray.cend(), normWS.getSignalArray(), normWS.mutableSignalArray(),
+                   [](const std::atomic<signal_t> &a, const signal_t &b) { return a + b; });
+  } else {
+    std::copy(signalArray.cbegin(), signalArray.cend(), normWS.mutableSignalArray());
+  }
 }
 
 /**
@@ -892,6 +892,44 @@ public:
     TSM_ASSERT("All basis vectors should have been normalized", binned->allBasisNormalized());
   }
 
+  void test_parallel_matches_serial_for_a_thin_slice() {
+    FrameworkManager::Instance().exec("CreateMDWorkspace", 14, "Dimensions", "3", "Extents", "-10,10,-10,10,-10,10",
+                                      "Names", "x,y,z", "Units", "m,m,m", "SplitInto", "4", "SplitThreshold", "50",
+                                      "OutputWorkspace", "BinMDTest_mdew");
+    FrameworkManager::Instance().exec("FakeMDEventData", 6, "InputWorkspace", "BinMDTest_mdew", "UniformParams",
+                                      "20000", "PeakParams", "5000, 1.0, 2.0, 0.5, 1.5");
+
+    // Few bins along the first dimension, rotated about z
+    std::vector<MDHistoWorkspace_sptr> binned;
+    for (const bool parallel : {false, true}) {
+      BinMD alg;
+      alg.initialize();
+      alg.setPropertyValue("InputWorkspace", "BinMDTest_mdew");
+      alg.setProperty("AxisAligned", false);
+      alg.setPropertyValue("BasisVector0", "tx, m, 0.8, 0.6, 0.0");
+      alg.setPropertyValue("BasisVector1", "ty, m, -0.6, 0.8, 0.0");
+      alg.setPropertyValue("BasisVector2", "tz, m, 0.0, 0.0, 1.0");
+      alg.setPropertyValue("OutputExtents", "-10,10, -10,10, -0.5,0.5");
+      alg.setPropertyValue("OutputBins", "3,200,1");
+      alg.setProperty("Parallel", parallel);
+      alg.setPropertyValue("OutputWorkspace", "BinMDTest_binned");
+      TS_ASSERT_THROWS_NOTHING(alg.execute());
+      binned.emplace_back(AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>("BinMDTest_binned"));
+    }
+
+    TS_ASSERT_EQUALS(binned[0]->getNPoints(), binned[1]->getNPoints());
+    double totalEvents = 0;
+    for (size_t i = 0; i < binned[0]->getNPoints(); ++i) {
+      TS_ASSERT_DELTA(binned[0]->getSignalAt(i), binned[1]->getSignalAt(i), 1e-9);
+      TS_ASSERT_DELTA(binned[0]->getErrorAt(i), binned[1]->getErrorAt(i), 1e-9);
+      TS_ASSERT_EQUALS(binned[0]->getNumEventsAt(i), binned[1]->getNumEventsAt(i));
+      totalEvents += binned[1]->getNumEventsAt(i);
+    }
+    TS_ASSERT_LESS_THAN(0, totalEvents);
+    AnalysisDataService::Instance().remove("BinMDTest_mdew");
+    AnalysisDataService::Instance().remove("BinMDTest_binned");
+  }
+
   void test_filebackend_and_unrecognised_instrument() {
     // The algorithm should still successfully execute, even if the workspace is
     // file-backed and the named instrument doesn't exist
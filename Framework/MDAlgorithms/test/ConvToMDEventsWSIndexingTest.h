@@ -359,6 +359,37 @@ public:
     std::cout << "End test1." << std::endl;
   }
 
+  void test_multithreading_five_dimensions() {
+    constexpr size_t nd = 5;
+    using MDEventStore5D = std::vector<MDEventTml<nd>>;
+    using TreeBuilder5D = Mantid::MDAlgorithms::MDEventTreeBuilder<nd, MDEventTml, MDEventStore5D::iterator>;
+    MDEventStore5D mdEvents(10000);
+    for (size_t k = 0; k < mdEvents.size(); ++k)
+      for (size_t d = 0; d < nd; ++d)
+        mdEvents[k].setCenter(d, static_cast<float>((k * (d + 3) + d) % 97) / 97.f * 8.f);
+
+    Mantid::API::BoxController_sptr bc =
+        std::shared_ptr<Mantid::API::BoxController>(new Mantid::API::BoxController(nd));
+    bc->setMaxDepth(20);
+    bc->setSplitInto(2);
+    bc->setSplitThreshold(splitTreshold);
+    morton_index::MDSpaceBounds<nd> bds{};
+    for (size_t d = 0; d < nd; ++d) {
+      bds(d, 0) = 0.f;
+      bds(d, 1) = 8.f;
+    }
+    TreeBuilder5D tbSingle(1, 0, bc, bds);
+    TreeBuilder5D tbMulti(4, splitTreshold * 2, bc, bds);
+    auto topNodeWithErrorSingle = tbSingle.distribute(mdEvents);
+    auto topNodeWithErrorMulti = tbMulti.distribute(mdEvents);
+
+    TS_ASSERT_EQUALS(topNodeWithErrorSingle.root->getNPoints(), mdEvents.size());
+    bool check = compareTrees(topNodeWithErrorSingle.root, topNodeWithErrorMulti.root);
+    delete topNodeWithErrorSingle.root;
+    delete topNodeWithErrorMulti.root;
+    TS_ASSERT_EQUALS(check, true);
+  }
+
   void test_sructure() {
     std::cout << sizeof(morton_index::uint128_t) << "   sizeof\n";
     static std::vector<std::shared_ptr<InputGenerator>> generators;
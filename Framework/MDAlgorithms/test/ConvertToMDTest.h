@@ -480,7 +480,98 @@ public:
     }
   }
 
+  void test_indexed_conversion_adds_to_existing_MDLeanEvent_workspace() {
+    checkIndexedConversionAddsToExistingEvents("MDLeanEvent");
+  }
+
+  void test_indexed_conversion_adds_to_existing_MDEvent_workspace() {
+    checkIndexedConversionAddsToExistingEvents("MDEvent");
+  }
+
 private:
+  /// Convert two inputs one after the other into the same workspace, and each into its own workspace
+  void checkIndexedConversionAddsToExistingEvents(const std::string &eventType) {
+    auto first = createSampleEventWorkspace(1000);
+    auto second = createSampleEventWorkspace(300);
+
+    auto firstOnly = convertIndexed(first, createEmptyQLabWorkspace("ConvertToMDTest_first", eventType));
+    auto secondOnly = convertIndexed(second, createEmptyQLabWorkspace("ConvertToMDTest_second", eventType));
+    auto both = createEmptyQLabWorkspace("ConvertToMDTest_both", eventType);
+    convertIndexed(first, both);
+    TS_ASSERT_EQUALS(both->getNPoints(), firstOnly->getNPoints());
+    convertIndexed(second, both);
+
+    TS_ASSERT_EQUALS(both->id(), firstOnly->id());
+    TS_ASSERT(firstOnly->getNPoints() > 0);
+    TS_ASSERT(secondOnly->getNPoints() > 0);
+    TS_ASSERT_EQUALS(both->getNPoints(), firstOnly->getNPoints() + secondOnly->getNPoints());
+    const double signal = totalSignal(*both);
+    TS_ASSERT_DELTA(signal, totalSignal(*firstOnly) + totalSignal(*secondOnly), 1e-6 * signal);
+
+    AnalysisDataService::Instance().remove("ConvertToMDTest_first");
+    AnalysisDataService::Instance().remove("ConvertToMDTest_second");
+    AnalysisDataService::Instance().remove("ConvertToMDTest_both");
+  }
+
+  MatrixWorkspace_sptr createSampleEventWorkspace(const int numEvents) {
+    auto alg = AlgorithmManager::Instance().createUnmanaged("CreateSampleWorkspace");
+    alg->initialize();
+    alg->setChild(true);
+    alg->setRethrows(true);
+    alg->setProperty("WorkspaceType", "Event");
+    alg->setProperty("NumEvents", numEvents);
+    alg->setProperty("Random", false);
+    alg->setPropertyValue("OutputWorkspace", "dummy");
+    alg->execute();
+    return alg->getProperty("OutputWorkspace");
+  }
+
+  /// An empty 3D workspace in Q_lab with the splitting the indexed converter requires
+  IMDEventWorkspace_sptr createEmptyQLabWorkspace(const std::string &name, const std::string &eventType) {
+    auto alg = AlgorithmManager::Instance().createUnmanaged("CreateMDWorkspace");
+    alg->initialize();
+    alg->setRethrows(true);
+    alg->setProperty("Dimensions", 3);
+    alg->setPropertyValue("EventType", eventType);
+    alg->setPropertyValue("Extents", "-10,10,-10,10,-10,10");
+    alg->setPropertyValue("Names", "Q_lab_x,Q_lab_y,Q_lab_z");
+    alg->setPropertyValue("Units", "Angstrom^-1,Angstrom^-1,Angstrom^-1");
+    alg->setPropertyValue("Frames", "QLab,QLab,QLab");
+    alg->setPropertyValue("SplitInto", "2");
+    alg->setPropertyValue("SplitThreshold", "10");
+    alg->setPropertyValue("OutputWorkspace", name);
+    alg->execute();
+    return AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(name);
+  }
+
+  double totalSignal(const IMDEventWorkspace &ws) {
+    double signal = 0.;
+    auto it = ws.createIterator();
+    do {
+      signal += it->getSignal();
+    } while (it->next());
+    return signal;
+  }
+
+  /// Add the events of the input to the target workspace with the indexed converter
+  IMDEventWorkspace_sptr convertIndexed(const MatrixWorkspace_sptr &input, const IMDEventWorkspace_sptr &target) {
+    ConvertToMD alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", input);
+    alg.setPropertyValue("OutputWorkspace", target->getName());
+    alg.setProperty("OverwriteExisting", false);
+    alg.setPropertyValue("QDimensions", "Q3D");
+    alg.setPropertyValue("dEAnalysisMode", "Elastic");
+    alg.setPropertyValue("Q3DFrames", "Q_lab");
+    alg.setPropertyValue("SplitInto", "2");
+    alg.setPropertyValue("ConverterType", "Indexed");
+    TS_ASSERT_THROWS_NOTHING(alg.execute());
+    auto output = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(target->getName());
+    TS_ASSERT_EQUALS(output, target);
+    return output;
+  }
+
   void checkHistogramsHaveBeenStored(const std::string &wsName, double val = 0.34, double bin_min = 0.3,
                                      double bin_max = 0.4) {
     IMDEventWorkspace_sptr outputWS = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>(wsName);
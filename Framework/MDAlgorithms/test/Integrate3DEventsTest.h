@@ -114,6 +114,49 @@ public:
     }
   }
 
+  void test_events_added_in_batches_give_same_result_as_one_batch() {
+    const V3D peak_1(10, 0, 0);
+    const V3D peak_2(0, 5, 0);
+    const std::vector<std::pair<std::pair<double, double>, V3D>> peak_q_list{{std::make_pair(1., 1.), peak_1},
+                                                                             {std::make_pair(1., 1.), peak_2}};
+    DblMatrix UBinv(3, 3, false);
+    UBinv.setRow(0, V3D(.1, 0, 0));
+    UBinv.setRow(1, V3D(0, .2, 0));
+    UBinv.setRow(2, V3D(0, 0, .25));
+
+    std::mt19937 gen(7);
+    std::normal_distribution<double> offset(0., 0.2);
+    std::vector<std::pair<std::pair<double, double>, V3D>> event_Qs;
+    for (size_t i = 0; i < 3000; ++i) {
+      const auto &center = (i % 3 == 0) ? peak_2 : peak_1;
+      event_Qs.emplace_back(std::make_pair(1., 1.), center + V3D(offset(gen), offset(gen), offset(gen)));
+    }
+
+    const double radius = 1.;
+    Integrate3DEvents oneBatch(peak_q_list, UBinv, radius);
+    oneBatch.addEvents(event_Qs, false);
+
+    // integrating between batches groups the events added so far
+    Integrate3DEvents manyBatches(peak_q_list, UBinv, radius);
+    const std::vector<Kernel::V3D> E1Vec;
+    std::vector<double> axes_radii;
+    double inti, sigi;
+    for (size_t first = 0; first < event_Qs.size(); first += 700) {
+      const auto last = std::min(first + 700, event_Qs.size());
+      manyBatches.addEvents({event_Qs.begin() + first, event_Qs.begin() + last}, false);
+      manyBatches.ellipseIntegrateEvents(E1Vec, peak_1, false, 0., 0., 0., axes_radii, inti, sigi);
+    }
+
+    for (const auto &peak : peak_q_list) {
+      double expectedInti, expectedSigi;
+      oneBatch.ellipseIntegrateEvents(E1Vec, peak.second, false, 0., 0., 0., axes_radii, expectedInti, expectedSigi);
+      manyBatches.ellipseIntegrateEvents(E1Vec, peak.second, false, 0., 0., 0., axes_radii, inti, sigi);
+      TS_ASSERT_LESS_THAN(0., expectedInti);
+      TS_ASSERT_EQUALS(inti, expectedInti);
+      TS_ASSERT_EQUALS(sigi, expectedSigi);
+    }
+  }
+
   void test_satellites() {
     double inti_all[] = {161, 368.28, 273.28};
     double sigi_all[] = {12.6885, 21.558, 19.2287};
@@ -367,6 +367,38 @@ public:
     TS_ASSERT_DELTA(newPW->getPeak(0).getIntensity(), 1000.0, 1e-2);
   }
 
+  //-------------------------------------------------------------------------------
+  /// Integrate many peaks, which are integrated in parallel
+  void test_exec_many_peaks() {
+    createMDEW();
+    Instrument_sptr inst = ComponentCreationHelper::createTestInstrumentCylindrical(5);
+    PeaksWorkspace_sptr peakWS(new PeaksWorkspace());
+    std::vector<double> numEvents;
+    for (int x = -1; x <= 1; ++x) {
+      for (int y = -1; y <= 1; ++y) {
+        for (int z = -1; z <= 1; ++z) {
+          const auto num = static_cast<size_t>(100 * (peakWS->getNumberPeaks() + 1));
+          const V3D pos(6. * x, 6. * y, 6. * z);
+          addPeak(num, pos[0], pos[1], pos[2], 0.5);
+          peakWS->addPeak(Peak(inst, 1, 1.0, pos));
+          numEvents.emplace_back(static_cast<double>(num));
+        }
+      }
+    }
+    AnalysisDataService::Instance().add("IntegratePeaksMD2Test_peaks", peakWS);
+
+    doRun({1.0}, {0.0});
+
+    TS_ASSERT_EQUALS(peakWS->getNumberPeaks(), 27);
+    for (int i = 0; i < peakWS->getNumberPeaks(); ++i) {
+      TS_ASSERT_DELTA(peakWS->getPeak(i).getIntensity(), numEvents[i], 1e-2);
+      TS_ASSERT_DELTA(peakWS->getPeak(i).getSigmaIntensity(), std::sqrt(numEvents[i]), 1e-2);
+    }
+
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_MDEWS");
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_peaks");
+  }
+
   //-------------------------------------------------------------------------------
   /// Integrate background between start/end background radius
   void test_exec_shellBackground() {
@@ -987,6 +1019,33 @@ public:
     }
   }
 
+  void test_exec_ellipsoid_rejects_a_2D_workspace() {
+    CreateMDWorkspace algC;
+    algC.initialize();
+    algC.setProperty("Dimensions", "2");
+    algC.setProperty("Extents", "-10,10,-10,10");
+    algC.setProperty("Names", "h,k");
+    algC.setProperty("Units", "rlu,rlu");
+    algC.setPropertyValue("OutputWorkspace", "IntegratePeaksMD2Test_MDEWS");
+    TS_ASSERT_THROWS_NOTHING(algC.execute());
+
+    auto peakWS = std::make_shared<LeanElasticPeaksWorkspace>();
+    peakWS->addPeak(LeanElasticPeak(V3D(1.0, 2.0, 0.0)));
+    AnalysisDataService::Instance().addOrReplace("IntegratePeaksMD2Test_peaks", peakWS);
+
+    IntegratePeaksMD2 alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("InputWorkspace", "IntegratePeaksMD2Test_MDEWS");
+    alg.setPropertyValue("PeaksWorkspace", "IntegratePeaksMD2Test_peaks");
+    alg.setPropertyValue("OutputWorkspace", "IntegratePeaksMD2Test_peaks_2D");
+    alg.setProperty("PeakRadius", std::vector<double>{1.0});
+    alg.setProperty("Ellipsoid", true);
+    TS_ASSERT_THROWS_EQUALS(alg.execute(), const std::invalid_argument &e, std::string(e.what()),
+                            "For now, we expect the input MDEventWorkspace to have 3 dimensions only.");
+    AnalysisDataService::Instance().remove("IntegratePeaksMD2Test_MDEWS");
+  }
+
   void test_writes_out_selected_algorithm_parameters() {
     createMDEW();
     const double peakRadius = 2;
@@ -0,0 +1,180 @@
+// Mantid Repository : https://github.com/mantidproject/mantid
+//
+// Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+//   NScD Oak Ridge National Laboratory, European Spallation Source,
+//   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+// SPDX - License - Identifier: GPL - 3.0 +
+#pragma once
+
+#include <cxxtest/TestSuite.h>
+
+#include "MantidAPI/AnalysisDataService.h"
+#include "MantidAPI/IMDEventWorkspace.h"
+#include "MantidAPI/IMDHistoWorkspace.h"
+#include "MantidAPI/Run.h"
+#include "MantidDataObjects/MDHistoWorkspace.h"
+#include "MantidGeometry/Instrument/Goniometer.h"
+#include "MantidMDAlgorithms/ConvertToMD.h"
+#include "MantidMDAlgorithms/MDNorm.h"
+#include "MantidTestHelpers/WorkspaceCreationHelper.h"
+
+#include <cmath>
+
+using Mantid::MDAlgorithms::ConvertToMD;
+using Mantid::MDAlgorithms::MDNorm;
+using namespace Mantid::API;
+using namespace Mantid::DataObjects;
+
+class MDNormTest : public CxxTest::TestSuite {
+public:
+  // This pair of boilerplate methods prevent the suite being created statically
+  // This means the constructor isn't called when running other tests
+  static MDNormTest *createSuite() { return new MDNormTest(); }
+  static void destroySuite(MDNormTest *suite) { delete suite; }
+
+  MDNormTest() {
+    // two runs of the sample at different rotations, and one of the background
+    convertToMD(createInelasticWS(0., 1.), "MDNormTest_sample", "Q_sample");
+    convertToMD(createInelasticWS(30., 2.), "MDNormTest_sample", "Q_sample");
+    convertToMD(createInelasticWS(0., 0.5), "MDNormTest_background", "Q_lab");
+  }
+
+  ~MDNormTest() override { AnalysisDataService::Instance().clear(); }
+
+  void test_Init() {
+    MDNorm alg;
+    TS_ASSERT_THROWS_NOTHING(alg.initialize())
+    TS_ASSERT(alg.isInitialized())
+  }
+
+  void test_input_has_several_experiment_infos() {
+    auto sample = AnalysisDataService::Instance().retrieveWS<IMDEventWorkspace>("MDNormTest_sample");
+    TS_ASSERT_EQUALS(sample->getNumExperimentInfo(), 2);
+  }
+
+  void test_symmetry_operations_together_match_one_at_a_time() {
+    runMDNorm("x,y,z;-x,-y,z", "together");
+
+    runMDNorm("x,y,z", "first");
+    runMDNorm("-x,-y,z", "onebyone", "first");
+
+    for (const std::string suffix : {"_data", "_norm", "_bkgd_data", "_bkgd_norm"}) {
+      TSM_ASSERT(suffix, sumOfSignals("together" + suffix) > 0.);
+      compareSignals("together" + suffix, "onebyone" + suffix, 1.);
+    }
+  }
+
+  void test_accumulation_adds_to_the_temporary_workspaces() {
+    runMDNorm("x,y,z;-x,-y,z", "single");
+    runMDNorm("x,y,z;-x,-y,z", "accumulated", "single");
+
+    for (const std::string suffix : {"_data", "_norm", "_bkgd_data", "_bkgd_norm"}) {
+      TSM_ASSERT(suffix, sumOfSignals("single" + suffix) > 0.);
+      compareSignals("single" + suffix, "accumulated" + suffix, 2.);
+    }
+  }
+
+private:
+  /// An inelastic workspace with the MDNorm limits, a proton charge and a goniometer rotation
+  MatrixWorkspace_sptr createInelasticWS(const double psi, const double protonCharge) {
+    const size_t numberOfDetectors = 6;
+    std::vector<double> L2(numberOfDetectors, 5.), polar(numberOfDetectors), azimuthal(numberOfDetectors);
+    for (size_t i = 0; i < numberOfDetectors; ++i) {
+      polar[i] = 0.2 * static_cast<double>(i + 1);
+      azimuthal[i] = (i % 2 == 0) ? 0.3 : -0.3;
+    }
+    auto ws = WorkspaceCreationHelper::createProcessedInelasticWS(L2, polar, azimuthal, 10, -5., 5., 20.);
+
+    auto &run = ws->mutableRun();
+    run.addProperty("MDNorm_low", std::vector<double>(numberOfDetectors, -5.), true);
+    run.addProperty("MDNorm_high", std::vector<double>(numberOfDetectors, 5.), true);
+    run.setProtonCharge(protonCharge);
+    Mantid::Geometry::Goniometer goniometer;
+    goniometer.pushAxis("psi", 0., 1., 0., psi);
+    run.setGoniometer(goniometer, false);
+    return ws;
+  }
+
+  /// Convert into a 4D workspace, adding to it if it exists
+  void convertToMD(const MatrixWorkspace_sptr &ws, const std::string &outputName, const std::string &frame) {
+    ConvertToMD alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setProperty("InputWorkspace", ws);
+    alg.setPropertyValue("OutputWorkspace", outputName);
+    alg.setPropertyValue("QDimensions", "Q3D");
+    alg.setPropertyValue("dEAnalysisMode", "Direct");
+    alg.setPropertyValue("Q3DFrames", frame);
+    alg.setPropertyValue("MinValues", "-8,-8,-8,-5");
+    alg.setPropertyValue("MaxValues", "8,8,8,5");
+    alg.setProperty("OverwriteExisting", false);
+    alg.execute();
+  }
+
+  /**
+   * Run MDNorm on the sample with the background. The outputs are named after
+   * the prefix, and if given, copies of the outputs of a previous run are used
+   * as temporary workspaces to accumulate into.
+   */
+  void runMDNorm(const std::string &symmetryOperations, const std::string &prefix,
+                 const std::string &temporaryPrefix = "") {
+    MDNorm alg;
+    alg.initialize();
+    alg.setRethrows(true);
+    alg.setPropertyValue("InputWorkspace", "MDNormTest_sample");
+    alg.setPropertyValue("BackgroundWorkspace", "MDNormTest_background");
+    alg.setProperty("RLU", false);
+    alg.setPropertyValue("Dimension0Name", "QDimension0");
+    alg.setPropertyValue("Dimension0Binning", "-6,1,6");
+    alg.setPropertyValue("Dimension1Name", "QDimension1");
+    alg.setPropertyValue("Dimension1Binning", "-6,1,6");
+    alg.setPropertyValue("Dimension2Name", "QDimension2");
+    alg.setPropertyValue("Dimension2Binning", "-6,1,6");
+    alg.setPropertyValue("Dimension3Name", "DeltaE");
+    alg.setPropertyValue("Dimension3Binning", "-5,2,5");
+    alg.setPropertyValue("SymmetryOperations", symmetryOperations);
+    if (!temporaryPrefix.empty()) {
+      alg.setPropertyValue("TemporaryDataWorkspace", copyOf(temporaryPrefix + "_data"));
+      alg.setPropertyValue("TemporaryNormalizationWorkspace", copyOf(temporaryPrefix + "_norm"));
+      alg.setPropertyValue("TemporaryBackgroundDataWorkspace", copyOf(temporaryPrefix + "_bkgd_data"));
+      alg.setPropertyValue("TemporaryBackgroundNormalizationWorkspace", copyOf(temporaryPrefix + "_bkgd_norm"));
+    }
+    alg.setPropertyValue("OutputWorkspace", prefix);
+    alg.setPropertyValue("OutputDataWorkspace", prefix + "_data");
+    alg.setPropertyValue("OutputNormalizationWorkspace", prefix + "_norm");
+    alg.setPropertyValue("OutputBackgroundDataWorkspace", prefix + "_bkgd_data");
+    alg.setPropertyValue("OutputBackgroundNormalizationWorkspace", prefix + "_bkgd_norm");
+    TS_ASSERT_THROWS_NOTHING(alg.execute())
+    TS_ASSERT(alg.isExecuted())
+  }
+
+  /// The temporary workspaces are modified in place, so they are copies
+  std::string copyOf(const std::string &name) {
+    auto ws = AnalysisDataService::Instance().retrieveWS<MDHistoWorkspace>(name);
+    const std::string copyName = name + "_copy";
+    AnalysisDataService::Instance().addOrReplace(copyName, MDHistoWorkspace_sptr(ws->clone()));
+    return copyName;
+  }
+
+  double sumOfSignals(const std::string &name) {
+    auto ws = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>(name);
+    double sum = 0.;
+    for (size_t i = 0; i < ws->getNPoints(); ++i)
+      sum += ws->signalAt(i);
+    return sum;
+  }
+
+  /// Check that the signals of the second workspace are the ones of the first times a factor
+  void compareSignals(const std::string &expectedName, const std::string &actualName, const double factor) {
+    auto expected = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>(expectedName);
+    auto actual = AnalysisDataService::Instance().retrieveWS<IMDHistoWorkspace>(actualName);
+    TS_ASSERT_EQUALS(expected->getNPoints(), actual->getNPoints());
+    if (expected->getNPoints() != actual->getNPoints())
+      return;
+    for (size_t i = 0; i < expected->getNPoints(); ++i) {
+      const double value = factor * expected->signalAt(i);
+      // the normalization is summed in a nondeterministic order
+      TSM_ASSERT_DELTA(actualName, actual->signalAt(i), value, 1e-10 * std::max(1., std::abs(value)));
+    }
+  }
+};
@@ -37,5 +37,9 @@ void export_EventList() {
       .def("__iadd__", (EventList & (EventList::*)(const EventList &)) & EventList::operator+=, return_self<>(),
            (arg("self"), arg("other")))
       .def("__isub__", (EventList & (EventList::*)(const EventList &)) & EventList::operator-=, return_self<>(),
-           (arg("self"), arg("other")));
+           (arg("self"), arg("other")))
+      .def("hasColumnStorage", &EventList::hasColumnStorage, arg("self"),
+           "Returns True if the events are stored as separate arrays of each of their fields.")
+      .def("hasCompactStorage", &EventList::hasCompactStorage, arg("self"),
+           "Returns True if the events are stored in the compact form of EventWorkspace.setCompactStorage.");
 }
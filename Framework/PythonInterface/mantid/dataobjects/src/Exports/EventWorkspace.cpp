@@ -8,6 +8,7 @@
 #include "MantidPythonInterface/api/RegisterWorkspacePtrToPython.h"
 #include "MantidPythonInterface/core/GetPointer.h"
 
+#include <boost/python/args.hpp>
 #include <boost/python/class.hpp>
 #include <boost/python/object/inheritance.hpp>
 
@@ -19,7 +20,13 @@ using namespace boost::python;
 GET_POINTER_SPECIALIZATION(EventWorkspace)
 
 void export_EventWorkspace() {
-  class_<EventWorkspace, bases<IEventWorkspace>, boost::noncopyable>("EventWorkspace", no_init);
+  class_<EventWorkspace, bases<IEventWorkspace>, boost::noncopyable>("EventWorkspace", no_init)
+      .def("setColumnStorage", &EventWorkspace::setColumnStorage, (arg("self"), arg("useColumns")),
+           "Store the events of every spectrum as separate arrays of time-of-flight, pulse time, weight and "
+           "error squared (True), or as lists of events (False).")
+      .def("setCompactStorage", &EventWorkspace::setCompactStorage, (arg("self"), arg("useCompact")),
+           "Store the events without weights in 8 bytes each, with the pulse times in a table shared by the "
+           "workspace (True), or as lists of events (False). Spectra with weighted events are left as they are.");
 
   // register pointers
   RegisterWorkspacePtrToPython<EventWorkspace>();
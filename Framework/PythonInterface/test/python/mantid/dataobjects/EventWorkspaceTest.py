@@ -0,0 +1,54 @@
+# Mantid Repository : https://github.com/mantidproject/mantid
+#
+# Copyright &copy; 2021 ISIS Rutherford Appleton Laboratory UKRI,
+#   NScD Oak Ridge National Laboratory, European Spallation Source,
+#   Institut Laue - Langevin & CSNS, Institute of High Energy Physics, CAS
+# SPDX - License - Identifier: GPL - 3.0 +
+import unittest
+import numpy as np
+
+from testhelpers import WorkspaceCreationHelper
+
+from mantid.dataobjects import EventList
+
+
+class EventWorkspaceTest(unittest.TestCase):
+
+    def test_setColumnStorage_keeps_the_events(self):
+        ws = WorkspaceCreationHelper.createEventWorkspace2(5, 10)
+        tofs = ws.getSpectrum(0).getTofs()
+        y = np.copy(ws.readY(0))
+
+        ws.setColumnStorage(True)
+        el = ws.getSpectrum(0)
+        self.assertTrue(isinstance(el, EventList))
+        self.assertTrue(el.hasColumnStorage())
+        self.assertEqual(ws.getNumberEvents(), 1000)
+        np.testing.assert_array_equal(el.getTofs(), tofs)
+        np.testing.assert_array_equal(ws.readY(0), y)
+
+        ws.setColumnStorage(False)
+        self.assertFalse(ws.getSpectrum(0).hasColumnStorage())
+        np.testing.assert_array_equal(ws.getSpectrum(0).getTofs(), tofs)
+
+    def test_setCompactStorage_keeps_the_events(self):
+        ws = WorkspaceCreationHelper.createEventWorkspace2(5, 10)
+        tofs = ws.getSpectrum(0).getTofs()
+        pulse_times = ws.getSpectrum(0).getPulseTimesAsNumpy()
+        y = np.copy(ws.readY(0))
+
+        ws.setCompactStorage(True)
+        el = ws.getSpectrum(0)
+        self.assertTrue(el.hasCompactStorage())
+        self.assertEqual(ws.getNumberEvents(), 1000)
+        np.testing.assert_allclose(el.getTofs(), tofs, rtol=1e-7)
+        np.testing.assert_array_equal(el.getPulseTimesAsNumpy(), pulse_times)
+        np.testing.assert_array_equal(ws.readY(0), y)
+
+        ws.setCompactStorage(False)
+        self.assertFalse(ws.getSpectrum(0).hasCompactStorage())
+        self.assertEqual(ws.getNumberEvents(), 1000)
+
+
+if __name__ == '__main__':
+    unittest.main()